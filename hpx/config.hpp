@@ -187,6 +187,14 @@
 #  endif
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the size (in number of pointers) of the buffer util::function
+/// uses to store function objects in place. Larger function objects are
+/// allocated on the heap.
+#if !defined(HPX_FUNCTION_STORAGE_SIZE)
+#  define HPX_FUNCTION_STORAGE_SIZE 4
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the type of the parcelport to be used during application
 /// bootstrap. This value can be changed at runtime by the configuration
@@ -224,6 +232,55 @@
 #  define HPX_PARCEL_IPC_DATA_BUFFER_CACHE_SIZE 512
 #endif
 
+/// This defines the number of slots in each of the rings used by the shared
+/// memory parcelport. This value can be changed at runtime by setting the
+/// configuration parameter:
+///
+///   hpx.parcel.shmem.num_slots = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_NUM_SLOTS).
+#if !defined(HPX_PARCEL_SHMEM_NUM_SLOTS)
+#  define HPX_PARCEL_SHMEM_NUM_SLOTS 256
+#endif
+
+/// This defines the size of the largest message the shared memory parcelport
+/// stores directly in a slot of its rings, larger messages are passed
+/// through the arena. This value can be changed at runtime by setting the
+/// configuration parameter:
+///
+///   hpx.parcel.shmem.inline_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_INLINE_SIZE).
+#if !defined(HPX_PARCEL_SHMEM_INLINE_SIZE)
+#  define HPX_PARCEL_SHMEM_INLINE_SIZE 1024
+#endif
+
+/// This defines the size of the arena (in bytes) the shared memory
+/// parcelport allocates for each connection. This value can be changed at
+/// runtime by setting the configuration parameter:
+///
+///   hpx.parcel.shmem.arena_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_ARENA_SIZE).
+#if !defined(HPX_PARCEL_SHMEM_ARENA_SIZE)
+#  define HPX_PARCEL_SHMEM_ARENA_SIZE 67108864
+#endif
+
+/// This defines the number of times the thread receiving parcels through the
+/// shared memory parcelport polls its rings before going to sleep. This
+/// value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.shmem.spin_count = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_SHMEM_SPIN_COUNT).
+#if !defined(HPX_PARCEL_SHMEM_SPIN_COUNT)
+#  define HPX_PARCEL_SHMEM_SPIN_COUNT 4096
+#endif
+
 /// This defines the number of MPI requests in flight
 /// This value can be changed at runtime by setting the configuration parameter:
 ///
@@ -261,6 +318,129 @@
 #  define HPX_PARCEL_MAX_MESSAGE_SIZE 1000000000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of bytes retained by the pool of parcel
+/// buffers. This value can be changed at runtime by setting the
+/// configuration parameter:
+///
+///   hpx.parcel.max_buffer_pool_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_MAX_BUFFER_POOL_SIZE).
+#if !defined(HPX_PARCEL_MAX_BUFFER_POOL_SIZE)
+#  define HPX_PARCEL_MAX_BUFFER_POOL_SIZE 67108864
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the (estimated) size of messages starting at which the
+/// parcels are serialized and sent as a stream of frames, i.e. the
+/// transmission starts before the serialization has finished. Streaming is
+/// disabled if this is set to zero. This value can be changed at runtime by
+/// setting the configuration parameter:
+///
+///   hpx.parcel.streaming_threshold = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_STREAMING_THRESHOLD).
+#if !defined(HPX_PARCEL_STREAMING_THRESHOLD)
+#  define HPX_PARCEL_STREAMING_THRESHOLD 16777216
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the size of the frames used for streaming messages. This
+/// value can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.streaming_frame_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_STREAMING_FRAME_SIZE).
+#if !defined(HPX_PARCEL_STREAMING_FRAME_SIZE)
+#  define HPX_PARCEL_STREAMING_FRAME_SIZE 1048576
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of frames of a streamed message waiting
+/// to be sent (or to be de-serialized). This value can be changed at
+/// runtime by setting the configuration parameter:
+///
+///   hpx.parcel.streaming_max_frames = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_STREAMING_MAX_FRAMES).
+#if !defined(HPX_PARCEL_STREAMING_MAX_FRAMES)
+#  define HPX_PARCEL_STREAMING_MAX_FRAMES 4
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the (estimated) size starting at which the parcels pending
+/// for a connection are split into several messages which are sent using a
+/// single gathered write. Gathered writes are disabled if this is set to
+/// zero. This value can be changed at runtime by setting the configuration
+/// parameter:
+///
+///   hpx.parcel.gather_message_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_GATHER_MESSAGE_SIZE).
+#if !defined(HPX_PARCEL_GATHER_MESSAGE_SIZE)
+#  define HPX_PARCEL_GATHER_MESSAGE_SIZE 65536
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of bytes sent by a single gathered write.
+/// This value can be changed at runtime by setting the configuration
+/// parameter:
+///
+///   hpx.parcel.gather_max_size = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_GATHER_MAX_SIZE).
+#if !defined(HPX_PARCEL_GATHER_MAX_SIZE)
+#  define HPX_PARCEL_GATHER_MAX_SIZE 4194304
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal number of buffers (iovec entries) passed to a
+/// single gathered write. This value can be changed at runtime by setting
+/// the configuration parameter:
+///
+///   hpx.parcel.gather_max_buffers = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_GATHER_MAX_BUFFERS).
+#if !defined(HPX_PARCEL_GATHER_MAX_BUFFERS)
+#  define HPX_PARCEL_GATHER_MAX_BUFFERS 64
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the minimal size of the data of a message (in bytes) which
+/// is compressed by actions using threshold compression (see
+/// HPX_ACTION_USES_THRESHOLD_COMPRESSION). Smaller messages are sent
+/// uncompressed. This value can be changed at runtime by setting the
+/// configuration parameter:
+///
+///   hpx.parcel.compression_threshold = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_COMPRESSION_THRESHOLD).
+#if !defined(HPX_PARCEL_COMPRESSION_THRESHOLD)
+#  define HPX_PARCEL_COMPRESSION_THRESHOLD 4096
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the maximal size of compressed data in percent of the size
+/// of the original data for the compressed data to be sent by actions using
+/// threshold compression. The original data is sent otherwise. This value
+/// can be changed at runtime by setting the configuration parameter:
+///
+///   hpx.parcel.compression_max_ratio = ...
+///
+/// (or by setting the corresponding environment variable
+/// HPX_PARCEL_COMPRESSION_MAX_RATIO).
+#if !defined(HPX_PARCEL_COMPRESSION_MAX_RATIO)
+#  define HPX_PARCEL_COMPRESSION_MAX_RATIO 90
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // This defines the number of bytes of overhead it takes to serialize a
 // parcel.
@@ -292,6 +472,14 @@
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
 #endif
 
+/// This defines the interval (in milliseconds) after which pending reference
+/// count decrements are sent to AGAS even if fewer than
+/// HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS have been collected. A value
+/// of zero disables the periodic flushing.
+#if !defined(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL)
+#  define HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL 10
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the initial global reference count associated with any created
 /// object.
@@ -535,8 +723,11 @@
 #  define HPX_WRAPPER_HEAP_STEP 0xFFFFU
 #endif
 
+/// This defines the number of global ids each locality reserves from its
+/// primary namespace instance while booting. Components created on a locality
+/// draw their ids from this block without contacting AGAS.
 #if !defined(HPX_INITIAL_GID_RANGE)
-#  define HPX_INITIAL_GID_RANGE 0xFFFFU
+#  define HPX_INITIAL_GID_RANGE 0x1000000U
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -571,6 +762,21 @@
 #  define HPX_HUGE_STACK_SIZE     0x2000000       // 32MByte
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the minimal amount of stack space (in bytes) which has to be
+/// left on the current HPX-thread for a continuation to be executed directly
+/// on the thread making its future ready (instead of on a new HPX-thread).
+#if !defined(HPX_CONTINUATION_MIN_STACK_SPACE)
+#  define HPX_CONTINUATION_MIN_STACK_SPACE 0x2000   // 8kByte
+#endif
+
+/// This defines the maximal number of continuations which may be executed
+/// nested inside each other on an OS-thread which is not running an
+/// HPX-thread (for those the available stack space is not known).
+#if !defined(HPX_CONTINUATION_MAX_INLINE_DEPTH)
+#  define HPX_CONTINUATION_MAX_INLINE_DEPTH 16
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Enable usage of std::unique_ptr instead of std::auto_ptr
 #if !defined(HPX_HAVE_CXX11_STD_UNIQUE_PTR)
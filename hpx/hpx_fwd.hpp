@@ -116,6 +116,7 @@ namespace hpx
             connection_portals4 = 2,
             connection_ibverbs = 3,
             connection_mpi = 4,
+            connection_shmem = 5,
             connection_last
         };
 
@@ -187,6 +188,7 @@ namespace hpx
             struct lockfree_lifo;
             struct lockfree_abp_fifo;
             struct lockfree_abp_lifo;
+            struct lockfree_chase_lev;
 
             template <typename Mutex = boost::mutex
                     , typename PendingQueuing = lockfree_fifo
@@ -229,6 +231,15 @@ namespace hpx
             class HPX_EXPORT hierarchy_scheduler;
 #endif
 
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+            template <typename Mutex = boost::mutex
+                    , typename PendingQueuing = lockfree_lifo
+                    , typename StagedQueuing = lockfree_lifo
+                    , typename TerminatedQueuing = lockfree_lifo
+                     >
+            class HPX_EXPORT numa_hierarchy_scheduler;
+#endif
+
             typedef local_priority_queue_scheduler<
                 boost::mutex,
                 lockfree_fifo, // FIFO pending queuing
@@ -257,6 +268,22 @@ namespace hpx
                 lockfree_lifo  // LIFO terminated queuing
             > abp_lifo_priority_queue_scheduler;
 
+            typedef local_priority_queue_scheduler<
+                boost::mutex,
+                lockfree_chase_lev, // LIFO + Chase-Lev pending queuing
+                lockfree_chase_lev, // LIFO + Chase-Lev staged queuing
+                lockfree_lifo  // LIFO terminated queuing
+            > chase_lev_priority_queue_scheduler;
+
+#if defined(HPX_LOCAL_SCHEDULER)
+            typedef local_queue_scheduler<
+                boost::mutex,
+                lockfree_chase_lev, // LIFO + Chase-Lev pending queuing
+                lockfree_chase_lev, // LIFO + Chase-Lev staged queuing
+                lockfree_lifo  // LIFO terminated queuing
+            > chase_lev_local_queue_scheduler;
+#endif
+
             // define the default scheduler to use
             typedef fifo_priority_queue_scheduler queue_scheduler;
 
@@ -398,6 +425,12 @@ namespace hpx
         /// thread specific) self reference to the current HPX thread.
         HPX_API_EXPORT thread_self* get_self_ptr_checked(error_code& ec = throws);
 
+        /// The function \a get_available_stack_space returns the number of
+        /// bytes still available on the stack of the current HPX thread (or
+        /// the maximal value of std::ptrdiff_t if the current thread is not
+        /// a HPX thread).
+        HPX_API_EXPORT std::ptrdiff_t get_available_stack_space();
+
         /// The function \a get_self_id returns the HPX thread id of the current
         /// thread (or zero if the current thread is not a HPX thread).
         HPX_API_EXPORT thread_id_type get_self_id();
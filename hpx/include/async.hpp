@@ -7,6 +7,7 @@
 #define HPX_ASYNC_APR_15_2012_0442PM
 
 #include <hpx/async.hpp>
+#include <hpx/lcos/async_bulk.hpp>
 
 #endif
 
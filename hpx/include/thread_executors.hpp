@@ -11,6 +11,7 @@
 #include <hpx/runtime/threads/executors/default_executor.hpp>
 #include <hpx/runtime/threads/executors/thread_pool_executors.hpp>
 #include <hpx/runtime/threads/executors/service_executor.hpp>
+#include <hpx/runtime/threads/executors/numa_domain_executor.hpp>
 
 #endif
 
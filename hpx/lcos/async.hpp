@@ -15,6 +15,8 @@
 #include <hpx/lcos/packaged_action.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/async_fwd.hpp>
+#include <hpx/lcos/detail/async_local.hpp>
+#include <hpx/util/tuple.hpp>
 
 #include <boost/preprocessor/repeat.hpp>
 #include <boost/preprocessor/iterate.hpp>
@@ -81,6 +83,14 @@ namespace hpx
                 call(gid, addr);
         }
 
+        // local targets don't need a packaged_action
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(
+                gid, addr, util::make_tuple());
+        }
+
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -220,6 +230,14 @@ namespace hpx
                 call(gid, addr, HPX_ENUM_FORWARD_ARGS(N, Arg, arg));
         }
 
+        // local targets don't need a packaged_action
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(HPX_ENUM_FORWARD_ARGS(N, Arg, arg)));
+        }
+
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
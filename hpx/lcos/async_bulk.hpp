@@ -0,0 +1,85 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_ASYNC_BULK_OCT_17_2014_0305PM)
+#define HPX_LCOS_ASYNC_BULK_OCT_17_2014_0305PM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/packaged_task.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/move.hpp>
+#include <hpx/util/result_of.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace hpx
+{
+    namespace detail
+    {
+        template <typename Result>
+        struct async_bulk_tasks
+        {
+            typedef std::vector<
+                lcos::local::futures_factory<Result()>
+            > tasks_type;
+
+            static void call(boost::shared_ptr<tasks_type> const& tasks,
+                std::size_t i)
+            {
+                (*tasks)[i]();
+            }
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Launch \a n instances of the given function object asynchronously,
+    /// passing the index of the instance (0 to \a n - 1) to each of them.
+    /// Returns one future for each of the instances.
+    ///
+    /// All HPX-threads are created at once (see threads#register_work_bulk),
+    /// which is considerably cheaper than calling async \a n times.
+    template <typename F>
+    std::vector<lcos::unique_future<
+        typename util::result_of<typename util::decay<F>::type(std::size_t)>::type
+    > >
+    async_bulk(std::size_t n, F && f)
+    {
+        typedef typename util::decay<F>::type function_type;
+        typedef typename util::result_of<
+            function_type(std::size_t)
+        >::type result_type;
+        typedef detail::async_bulk_tasks<result_type> tasks_helper;
+
+        function_type func(std::forward<F>(f));
+
+        boost::shared_ptr<typename tasks_helper::tasks_type> tasks(
+            boost::make_shared<typename tasks_helper::tasks_type>());
+        tasks->reserve(n);
+
+        std::vector<lcos::unique_future<result_type> > futures;
+        futures.reserve(n);
+
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            tasks->push_back(lcos::local::futures_factory<result_type()>(
+                util::bind(func, i)));
+            futures.push_back(tasks->back().get_future());
+        }
+
+        threads::register_work_bulk(n,
+            util::bind(&tasks_helper::call, tasks, util::placeholders::_1),
+            "async_bulk");
+
+        return futures;
+    }
+}
+
+#endif
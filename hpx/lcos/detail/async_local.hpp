@@ -0,0 +1,122 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_ASYNC_LOCAL_JAN_24_2014_0912AM)
+#define HPX_LCOS_DETAIL_ASYNC_LOCAL_JAN_24_2014_0912AM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/traits/is_future.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/applier/apply_helper.hpp>
+#include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/move.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/not.hpp>
+
+namespace hpx { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Actions invoked on a target which is known to live on this locality
+    // don't need to go through a packaged_action: there is no need for a
+    // globally addressable LCO (which would require an AGAS registration),
+    // nor for a continuation sending the result back through yet another
+    // action. Instead, a new thread directly executes the action and sets
+    // the result on the shared state of the returned future.
+    //
+    // This is used for all actions which are not directly executed and
+    // which do not return a future (those are handled by
+    // sync_local_invoke_N).
+    template <typename Action>
+    struct use_async_local
+      : boost::mpl::and_<
+            boost::mpl::not_<typename Action::direct_execution>,
+            boost::mpl::not_<traits::is_future<typename Action::result_type> >
+        >
+    {};
+
+    template <typename Action, typename Result, typename Arguments>
+    struct async_local_thread_function
+    {
+        typedef lcos::detail::future_data<Result> shared_state_type;
+
+        template <typename Arguments_>
+        async_local_thread_function(
+                boost::intrusive_ptr<shared_state_type> const& state,
+                naming::address::address_type lva, Arguments_ && args)
+          : state_(state), lva_(lva), args_(std::forward<Arguments_>(args))
+        {}
+
+        threads::thread_state_enum operator()(threads::thread_state_ex_enum)
+        {
+            try {
+                state_->set_data(
+                    Action::execute_function(lva_, std::move(args_)));
+            }
+            catch (...) {
+                state_->set_exception(boost::current_exception());
+            }
+            return threads::terminated;
+        }
+
+        boost::intrusive_ptr<shared_state_type> state_;
+        naming::address::address_type lva_;
+        Arguments args_;
+    };
+
+    template <typename Action, typename Result, typename Arguments>
+    lcos::unique_future<Result>
+    async_local(naming::id_type const& gid, naming::address const& addr,
+        Arguments && args)
+    {
+        HPX_ASSERT(components::types_are_compatible(addr.type_,
+            components::get_component_type<
+                typename Action::component_type>()));
+
+        typedef lcos::detail::future_data<Result> shared_state_type;
+        typedef typename util::decay<Arguments>::type arguments_type;
+
+        boost::intrusive_ptr<shared_state_type> state(new shared_state_type());
+
+        // the target id is kept alive by the new thread, this keeps the
+        // component alive until the action has been executed
+        hpx::applier::register_work_plain(
+            Action::decorate_action(
+                async_local_thread_function<Action, Result, arguments_type>(
+                    state, addr.address_, std::forward<Arguments>(args)),
+                addr.address_),
+            gid, actions::detail::get_action_name<Action>(), addr.address_,
+            threads::pending,
+            applier::detail::fix_priority<Action>(
+                actions::action_priority<Action>()),
+            std::size_t(-1),
+            static_cast<threads::thread_stacksize>(
+                traits::action_stacksize<Action>::value));
+
+        using lcos::detail::future_access;
+        return future_access::create<lcos::unique_future<Result> >(
+            std::move(state));
+    }
+
+    template <typename Action>
+    BOOST_FORCEINLINE bool
+    is_async_local(naming::id_type const& gid, naming::address& addr)
+    {
+        return use_async_local<Action>::value &&
+            Action::is_target_valid(gid) &&
+            agas::is_local_address_cached(gid, addr);
+    }
+}}
+
+#endif
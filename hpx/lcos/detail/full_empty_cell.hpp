@@ -0,0 +1,391 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_FULL_EMPTY_CELL_OCT_17_2014_0512PM)
+#define HPX_LCOS_DETAIL_FULL_EMPTY_CELL_OCT_17_2014_0512PM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/util/move.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The full_empty_cell_base holds the complete synchronization state of a
+    // full/empty memory location in a single atomic word: the lowest bit
+    // stores the full/empty state, the next bit is set while the data is
+    // being accessed, and the remaining bits store the head of an intrusive
+    // list of the HPX-threads waiting for the state to change. The list nodes
+    // live on the stacks of the suspended threads, no memory is allocated.
+    //
+    // Enqueueing a waiter and changing the state are single CAS operations.
+    // Whenever the state changes all waiting threads are resumed and retry
+    // their operation; the ones which still can't proceed simply enqueue
+    // themselves again.
+    class HPX_EXPORT full_empty_cell_base : boost::noncopyable
+    {
+    protected:
+        enum cell_state
+        {
+            state_full = 1,         // the cell is full (empty otherwise)
+            state_busy = 2,         // the data is currently being accessed
+            state_mask = 3
+        };
+
+        // one entry in the list of waiting threads
+        struct waiter;
+
+        // Make sure the state gets reset when the data access is finished,
+        // even if the access throws.
+        struct release_on_exit
+        {
+            release_on_exit(full_empty_cell_base& cell, full_empty_state state)
+              : cell_(cell), state_(state)
+            {}
+
+            ~release_on_exit()
+            {
+                cell_.release(state_);
+            }
+
+            full_empty_cell_base& cell_;
+            full_empty_state state_;
+        };
+
+    public:
+        explicit full_empty_cell_base(full_empty_state state = empty)
+          : word_(state == full ? state_full : 0)
+        {}
+
+        ~full_empty_cell_base();
+
+        // returns whether this cell is currently empty
+        bool is_empty() const
+        {
+            return (word_.load(boost::memory_order_acquire) & state_full) == 0;
+        }
+
+        // returns whether any threads are waiting on this cell
+        bool is_used() const
+        {
+            return (word_.load(boost::memory_order_acquire) & ~std::size_t(
+                state_mask)) != 0;
+        }
+
+        // sets this cell to empty or full, re-activates all waiting threads
+        void set_empty()
+        {
+            acquire_any();
+            release(empty);
+        }
+
+        void set_full()
+        {
+            acquire_any();
+            release(full);
+        }
+
+    protected:
+        // Wait for the cell to be in the given state and mark it as busy. This
+        // suspends the calling HPX-thread if the cell is in the opposite
+        // state. Returns false if the wait was aborted (or failed).
+        bool acquire(full_empty_state wait_for, char const* description,
+            error_code& ec);
+
+        // Try to mark the cell as busy if it is in the given state, never
+        // suspends.
+        bool try_acquire(full_empty_state state);
+
+        // Mark the cell as busy regardless of its current state.
+        void acquire_any();
+
+        // Set the new state of a busy cell, resumes all waiting threads if
+        // the state has changed.
+        void release(full_empty_state state);
+
+    private:
+        // Make sure the given (resumed) waiter is not referenced by the list
+        // of waiting threads anymore.
+        void detach(waiter& self);
+
+        // Detaches a waiter when leaving the scope it lives in, even if the
+        // suspension of its thread throws.
+        struct detach_on_exit;
+
+        // Resume all threads in the given list, except \a self.
+        static void resume_waiters(std::size_t list, waiter* self,
+            threads::thread_state_ex_enum state_ex);
+
+        boost::atomic<std::size_t> word_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A full_empty_cell is a compact memory location guarded by a full/empty
+    /// bit. It has the same semantics as the full_empty_entry, but it does
+    /// not need a mutex: the full/empty state and the list of waiting threads
+    /// are packed into one atomic word stored next to the data.
+    ///
+    /// The cell is initially empty unless constructed from a value. If a cell
+    /// goes out of scope while threads are waiting on it, those threads are
+    /// resumed and report \a hpx#yield_aborted.
+    template <typename T>
+    class full_empty_cell : public full_empty_cell_base
+    {
+    public:
+        typedef T value_type;
+
+        full_empty_cell()
+          : full_empty_cell_base(empty), data_()
+        {}
+
+        template <typename T0>
+        explicit full_empty_cell(T0 && t0)
+          : full_empty_cell_base(full), data_(std::forward<T0>(t0))
+        {}
+
+        /// Waits for the cell to become full and then reads it, leaves the
+        /// cell in full state.
+        template <typename Target>
+        void read(Target& dest, error_code& ec = throws)
+        {
+            if (!acquire(full, "full_empty_cell::read", ec))
+                return;
+
+            release_on_exit r(*this, full);
+            dest = data_;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Waits for the cell to become full and then moves its value out,
+        /// leaves the cell in full state.
+        template <typename Target>
+        void move(Target& dest, error_code& ec = throws)
+        {
+            if (!acquire(full, "full_empty_cell::move", ec))
+                return;
+
+            release_on_exit r(*this, full);
+            dest = std::move(data_);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Waits for the cell to become full and then reads it, sets the
+        /// cell to empty.
+        template <typename Target>
+        void read_and_empty(Target& dest, error_code& ec = throws)
+        {
+            if (!acquire(full, "full_empty_cell::read_and_empty", ec))
+                return;
+
+            release_on_exit r(*this, full);
+            dest = std::move(data_);
+            r.state_ = empty;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Waits for the cell to become empty and then fills it.
+        template <typename Target>
+        void write(Target && src, error_code& ec = throws)
+        {
+            if (!acquire(empty, "full_empty_cell::write", ec))
+                return;
+
+            release_on_exit r(*this, empty);
+            data_ = std::forward<Target>(src);
+            r.state_ = full;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Writes the cell and sets it to full without waiting for it to
+        /// become empty.
+        template <typename Target>
+        void set(Target && src)
+        {
+            acquire_any();
+
+            release_on_exit r(*this, empty);
+            data_ = std::forward<Target>(src);
+            r.state_ = full;
+        }
+
+        /// Calls the supplied function passing along the stored data (if
+        /// full). Returns false if the cell is empty, otherwise the return
+        /// value of \p f.
+        template <typename F>
+        bool peek(F f)
+        {
+            if (!try_acquire(full))
+                return false;
+
+            release_on_exit r(*this, full);
+            return f(data_);
+        }
+
+    private:
+        value_type data_;
+    };
+
+    // a full/empty bit without associated data
+    template <>
+    class full_empty_cell<void> : public full_empty_cell_base
+    {
+    public:
+        typedef void value_type;
+
+        full_empty_cell()
+          : full_empty_cell_base(empty)
+        {}
+
+        /// Waits for the cell to become full, leaves it in full state.
+        void read(error_code& ec = throws)
+        {
+            if (!acquire(full, "full_empty_cell::read", ec))
+                return;
+            release(full);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Waits for the cell to become full and sets it to empty.
+        void read_and_empty(error_code& ec = throws)
+        {
+            if (!acquire(full, "full_empty_cell::read_and_empty", ec))
+                return;
+            release(empty);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Waits for the cell to become empty and sets it to full.
+        void write(error_code& ec = throws)
+        {
+            if (!acquire(empty, "full_empty_cell::write", ec))
+                return;
+            release(full);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        /// Sets the cell to full without waiting for it to become empty.
+        void set()
+        {
+            set_full();
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The full_empty_array is a fixed size array of full/empty memory
+    /// locations. Every element occupies just one machine word in addition
+    /// to its value, which makes it suitable for fine grained producer/
+    /// consumer synchronization on large data sets.
+    template <typename T>
+    class full_empty_array : boost::noncopyable
+    {
+    public:
+        typedef full_empty_cell<T> cell_type;
+        typedef T value_type;
+
+        /// Create an array of \a size empty elements.
+        explicit full_empty_array(std::size_t size)
+          : size_(size), cells_(new cell_type[size])
+        {}
+
+        /// Create an array of \a size elements which are all full and
+        /// initialized with \a init.
+        full_empty_array(std::size_t size, T const& init)
+          : size_(size), cells_(new cell_type[size])
+        {
+            for (std::size_t i = 0; i != size_; ++i)
+                cells_[i].set(init);
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        cell_type& operator[](std::size_t i)
+        {
+            HPX_ASSERT(i < size_);
+            return cells_[i];
+        }
+
+        cell_type const& operator[](std::size_t i) const
+        {
+            HPX_ASSERT(i < size_);
+            return cells_[i];
+        }
+
+        bool is_empty(std::size_t i) const
+        {
+            return (*this)[i].is_empty();
+        }
+
+        void set_empty(std::size_t i)
+        {
+            (*this)[i].set_empty();
+        }
+
+        void set_full(std::size_t i)
+        {
+            (*this)[i].set_full();
+        }
+
+        template <typename Target>
+        void read(std::size_t i, Target& dest, error_code& ec = throws)
+        {
+            (*this)[i].read(dest, ec);
+        }
+
+        template <typename Target>
+        void move(std::size_t i, Target& dest, error_code& ec = throws)
+        {
+            (*this)[i].move(dest, ec);
+        }
+
+        template <typename Target>
+        void read_and_empty(std::size_t i, Target& dest, error_code& ec = throws)
+        {
+            (*this)[i].read_and_empty(dest, ec);
+        }
+
+        template <typename Target>
+        void write(std::size_t i, Target && src, error_code& ec = throws)
+        {
+            (*this)[i].write(std::forward<Target>(src), ec);
+        }
+
+        template <typename Target>
+        void set(std::size_t i, Target && src)
+        {
+            (*this)[i].set(std::forward<Target>(src));
+        }
+
+    private:
+        std::size_t size_;
+        boost::scoped_array<cell_type> cells_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,36 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_INLINE_CONTINUATION_OCT_17_2014_0955AM)
+#define HPX_LCOS_DETAIL_INLINE_CONTINUATION_OCT_17_2014_0955AM
+
+#include <hpx/hpx_fwd.hpp>
+
+#include <boost/noncopyable.hpp>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns whether a continuation may be executed directly on the calling
+    // thread. For HPX-threads this is the case if at least
+    // HPX_CONTINUATION_MIN_STACK_SPACE bytes of stack are left. For other
+    // threads the stack space is not known, here the number of continuations
+    // nested on the calling OS-thread has to stay below
+    // HPX_CONTINUATION_MAX_INLINE_DEPTH.
+    HPX_API_EXPORT bool can_run_inline();
+
+    // Marks the extent of the inline execution of a continuation.
+    class HPX_API_EXPORT inline_continuation_scope : boost::noncopyable
+    {
+    public:
+        inline_continuation_scope();
+        ~inline_continuation_scope();
+
+    private:
+        bool counted_;
+    };
+}}}
+
+#endif
@@ -491,6 +491,11 @@ namespace hpx { namespace lcos { namespace detail
         //     ready (has a value or exception stored).
         //   - The continuation launches according to the specified launch
         //     policy or executor.
+        //   - If the launch policy includes launch::sync (as launch::all
+        //     does) the continuation is run directly on the thread making
+        //     the shared state ready, as long as that thread has enough
+        //     stack space left. Otherwise it is run on a new thread, which
+        //     is stackless if the policy is exactly launch::sync.
         //   - When the executor or launch policy is not provided the
         //     continuation inherits the parent's launch policy or executor.
         //   - If the parent was created with std::promise or with a
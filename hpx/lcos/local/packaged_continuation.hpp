@@ -11,6 +11,7 @@
 #include <hpx/util/decay.hpp>
 #include <hpx/util/move.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/lcos/detail/inline_continuation.hpp>
 #include <hpx/lcos/future.hpp>
 
 #include <boost/shared_ptr.hpp>
@@ -143,7 +144,7 @@ namespace hpx { namespace lcos { namespace detail
         }
 
         void async(typename shared_state_ptr_for<Future>::type const& f,
-            error_code& ec)
+            threads::thread_stacksize stacksize, error_code& ec)
         {
             {
                 typename mutex_type::scoped_lock l(this->mtx_);
@@ -163,7 +164,8 @@ namespace hpx { namespace lcos { namespace detail
 
             applier::register_thread_plain(
                 HPX_STD_BIND(async_impl_ptr, std::move(this_), f),
-                "continuation::async");
+                "continuation::async", threads::pending, true,
+                threads::thread_priority_normal, std::size_t(-1), stacksize);
 
             if (&ec != &throws)
                 ec = make_success_code();
@@ -196,9 +198,15 @@ namespace hpx { namespace lcos { namespace detail
                 ec = make_success_code();
         }
 
+        void async(typename shared_state_ptr_for<Future>::type const& f,
+            error_code& ec)
+        {
+            async(f, threads::thread_stacksize_default, ec);
+        }
+
         void async(typename shared_state_ptr_for<Future>::type const& f)
         {
-            async(f, throws);
+            async(f, threads::thread_stacksize_default, throws);
         }
 
         void async(typename shared_state_ptr_for<Future>::type const& f,
@@ -207,6 +215,39 @@ namespace hpx { namespace lcos { namespace detail
             async(f, sched, throws);
         }
 
+        // Run the continuation directly on the thread which made the future
+        // ready, as long as this thread has sufficient stack space left.
+        // Otherwise the continuation is scheduled on a new HPX-thread.
+        void run_inline(typename shared_state_ptr_for<Future>::type const& f)
+        {
+            if (can_run_inline())
+            {
+                inline_continuation_scope scope;
+                run(f, throws);
+            }
+            else
+            {
+                async(f, threads::thread_stacksize_default, throws);
+            }
+        }
+
+        // Continuations attached using launch::sync are expected to be short
+        // and not to suspend. If they can't be run directly on the thread
+        // which made the future ready they are executed on a stackless
+        // HPX-thread, which avoids allocating a stack.
+        void run_sync(typename shared_state_ptr_for<Future>::type const& f)
+        {
+            if (can_run_inline())
+            {
+                inline_continuation_scope scope;
+                run(f, throws);
+            }
+            else
+            {
+                async(f, threads::thread_stacksize_nostack, throws);
+            }
+        }
+
         void deleting_owner()
         {
             typename mutex_type::scoped_lock l(this->mtx_);
@@ -270,8 +311,10 @@ namespace hpx { namespace lcos { namespace detail
             // the continuation
             boost::intrusive_ptr<continuation> this_(this);
             void (continuation::*cb)(shared_state_ptr const&);
-            if (policy & launch::sync)
-                cb = &continuation::run;
+            if (policy == launch::sync)
+                cb = &continuation::run_sync;
+            else if (policy & launch::sync)
+                cb = &continuation::run_inline;
             else
                 cb = &continuation::async;
 
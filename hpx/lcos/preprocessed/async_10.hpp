@@ -60,6 +60,13 @@ namespace hpx
             return detail::sync_local_invoke_1<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -162,6 +169,13 @@ namespace hpx
             return detail::sync_local_invoke_2<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -264,6 +278,13 @@ namespace hpx
             return detail::sync_local_invoke_3<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -366,6 +387,13 @@ namespace hpx
             return detail::sync_local_invoke_4<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -468,6 +496,13 @@ namespace hpx
             return detail::sync_local_invoke_5<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -570,6 +605,13 @@ namespace hpx
             return detail::sync_local_invoke_6<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -672,6 +714,13 @@ namespace hpx
             return detail::sync_local_invoke_7<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -774,6 +823,13 @@ namespace hpx
             return detail::sync_local_invoke_8<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -876,6 +932,13 @@ namespace hpx
             return detail::sync_local_invoke_9<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 ) , std::forward<Arg8>( arg8 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 ) , std::forward<Arg8>( arg8 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -978,6 +1041,13 @@ namespace hpx
             return detail::sync_local_invoke_10<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 ) , std::forward<Arg8>( arg8 ) , std::forward<Arg9>( arg9 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ) , std::forward<Arg5>( arg5 ) , std::forward<Arg6>( arg6 ) , std::forward<Arg7>( arg7 ) , std::forward<Arg8>( arg8 ) , std::forward<Arg9>( arg9 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -60,6 +60,13 @@ namespace hpx
             return detail::sync_local_invoke_1<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -162,6 +169,13 @@ namespace hpx
             return detail::sync_local_invoke_2<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -264,6 +278,13 @@ namespace hpx
             return detail::sync_local_invoke_3<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -366,6 +387,13 @@ namespace hpx
             return detail::sync_local_invoke_4<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -468,6 +496,13 @@ namespace hpx
             return detail::sync_local_invoke_5<action_type, result_type>::
                 call(gid, addr, std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 ));
         }
+        
+        if (detail::has_async_policy(policy) &&
+            detail::is_async_local<action_type>(gid, addr))
+        {
+            return detail::async_local<action_type, result_type>(gid, addr,
+                util::make_tuple(std::forward<Arg0>( arg0 ) , std::forward<Arg1>( arg1 ) , std::forward<Arg2>( arg2 ) , std::forward<Arg3>( arg3 ) , std::forward<Arg4>( arg4 )));
+        }
         lcos::packaged_action<action_type, result_type> p;
         if (policy == launch::sync || detail::has_async_policy(policy))
         {
@@ -0,0 +1,98 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_LZ4_SERIALIZATION_FILTER_OCT_18_2014_1012AM)
+#define HPX_ACTION_LZ4_SERIALIZATION_FILTER_OCT_18_2014_1012AM
+
+#include <hpx/hpx_fwd.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+#include <hpx/config/forceinline.hpp>
+#include <hpx/traits/action_serialization_filter.hpp>
+#include <hpx/runtime/actions/guid_initialization.hpp>
+#include <hpx/util/binary_filter.hpp>
+#include <hpx/util/detail/serialization_registration.hpp>
+
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/export.hpp>
+
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // This filter uses the LZ4 library, which trades some compression ratio
+    // for very high compression and decompression speeds. Setting
+    //
+    //      [hpx.plugins.lz4_serialization_filter]
+    //      high_compression_level = 9
+    //
+    // to a non-zero value makes it use LZ4-HC instead. The compressed data
+    // is decompressed in the same way in both cases.
+    struct HPX_LIBRARY_EXPORT lz4_serialization_filter
+      : public util::binary_filter
+    {
+        lz4_serialization_filter(bool compress = false,
+                util::binary_filter* next_filter = 0)
+          : current_(0), compress_(compress)
+        {}
+        ~lz4_serialization_filter();
+
+        void load(void* dst, std::size_t dst_count);
+        void save(void const* src, std::size_t src_count);
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
+
+        void set_max_length(std::size_t size);
+        std::size_t init_data(char const* buffer,
+            std::size_t size, std::size_t buffer_size);
+
+        /// serialization support
+        static void register_base();
+
+    private:
+        // serialization support
+        friend class boost::serialization::access;
+
+        template <typename Archive>
+        BOOST_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
+
+        std::vector<char> buffer_;
+        std::size_t current_;
+        bool compress_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+HPX_SERIALIZATION_REGISTER_TYPE_DECLARATION(
+    hpx::plugins::compression::lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_ACTION_USES_LZ4_COMPRESSION(action)                               \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_serialization_filter<action>                            \
+        {                                                                     \
+            /* Note that the caller is responsible for deleting the filter */ \
+            /* instance returned from this function */                        \
+            static util::binary_filter* call(parcelset::parcel const& p)      \
+            {                                                                 \
+                return hpx::create_binary_filter(                             \
+                    "lz4_serialization_filter", true);                        \
+            }                                                                 \
+        };                                                                    \
+    }}                                                                        \
+/**/
+
+#else
+
+#define HPX_ACTION_USES_LZ4_COMPRESSION(action)
+
+#endif
+
+#endif
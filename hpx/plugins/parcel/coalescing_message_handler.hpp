@@ -11,25 +11,41 @@
 #if defined(HPX_HAVE_PARCEL_COALESCING)
 
 #include <hpx/runtime/parcelset/policies/message_handler.hpp>
-#include <hpx/util/interval_timer.hpp>
 #include <hpx/util/detail/count_num_args.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 
-#include <hpx/plugins/parcel/message_buffer.hpp>
-
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <string>
 
 #include <hpx/config/warnings_prefix.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace plugins { namespace parcel
 {
+    namespace detail
+    {
+        class coalescing_buffer;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The coalescing_message_handler buffers outgoing parcels and sends them
+    // as one message. In the default (fixed) mode, each handler collects up
+    // to num_messages parcels for its action and destination and flushes
+    // them if no new parcel was buffered during interval microseconds.
+    //
+    // In adaptive mode the number of parcels to combine and the flush
+    // deadline are tuned per destination from the observed arrival rate of
+    // parcels, such that no parcel is delayed by more than interval
+    // microseconds. Parcels are sent right away if not enough of them arrive
+    // to fill a batch within that time. If combine_actions is enabled, the
+    // parcels of all coalescing actions sent to the same destination share
+    // one buffer.
     struct HPX_LIBRARY_EXPORT coalescing_message_handler
       : parcelset::policies::message_handler
     {
     private:
-        coalescing_message_handler* this_() { return this; }
-
         typedef lcos::local::spinlock mutex_type;
 
     public:
@@ -45,15 +61,18 @@ namespace hpx { namespace plugins { namespace parcel
         void flush(bool stop_buffering = false);
 
     protected:
-        bool timer_flush();
-        void flush(mutex_type::scoped_lock& l, bool stop_buffering);
+        boost::shared_ptr<detail::coalescing_buffer> get_buffer(
+            parcelset::parcel const& p);
 
     private:
         mutable mutex_type mtx_;
+        std::string action_name_;
         parcelset::parcelport* pp_;
-        detail::message_buffer buffer_;
-        util::interval_timer timer_;
-        bool stopped_;
+        std::size_t num_messages_;
+        std::size_t interval_;
+        bool adaptive_;
+        bool combine_actions_;
+        boost::shared_ptr<detail::coalescing_buffer> buffer_;
     };
 }}}
 
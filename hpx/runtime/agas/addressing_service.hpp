@@ -11,12 +11,11 @@
 
 #include <hpx/config.hpp>
 
+#include <map>
+#include <set>
 #include <vector>
 
 #include <boost/make_shared.hpp>
-#include <boost/cache/entries/lfu_entry.hpp>
-#include <boost/cache/local_cache.hpp>
-#include <boost/cache/statistics/local_statistics.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/dynamic_bitset.hpp>
@@ -27,10 +26,12 @@
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/locality.hpp>
 #include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/interval_timer.hpp>
 #include <hpx/util/merging_map.hpp>
 
 
@@ -65,19 +66,7 @@ struct HPX_EXPORT addressing_service : boost::noncopyable
     typedef hpx::lcos::local::mutex mutex_type;
     // }}}
 
-    // {{{ gva cache
-    struct gva_cache_key;
-    struct gva_erase_policy;
-    typedef boost::cache::entries::lfu_entry<gva> gva_entry_type;
-
-    typedef boost::cache::local_cache<
-        gva_cache_key, gva_entry_type,
-        std::less<gva_entry_type>,
-        boost::cache::policies::always<gva_entry_type>,
-        std::map<gva_cache_key, gva_entry_type>,
-        boost::cache::statistics::local_statistics
-    > gva_cache_type;
-    // }}}
+    typedef agas::gva_cache gva_cache_type;
 
     typedef util::merging_map<naming::gid_type, boost::int64_t>
         refcnt_requests_type;
@@ -85,7 +74,7 @@ struct HPX_EXPORT addressing_service : boost::noncopyable
     struct bootstrap_data_type;
     struct hosted_data_type;
 
-    mutable cache_mutex_type gva_cache_mtx_;
+    // the cache is safe to use concurrently, lookups don't acquire a lock
     boost::shared_ptr<gva_cache_type> gva_cache_;
 
     mutable mutex_type console_cache_mtx_;
@@ -99,6 +88,14 @@ struct HPX_EXPORT addressing_service : boost::noncopyable
 
     boost::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // sends the pending decrements even if max_refcnt_requests_ has not been
+    // reached yet, runs only while decrements are buffered
+    util::interval_timer refcnt_flush_timer_;
+    bool enable_refcnt_flush_timer_;    // protected by refcnt_requests_mtx_
+
+    // number of credits sent to AGAS, exposed as a performance counter
+    boost::atomic<boost::int64_t> flushed_credits_;
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -121,6 +118,19 @@ struct HPX_EXPORT addressing_service : boost::noncopyable
     naming::address component_ns_addr_;
     naming::address symbol_ns_addr_;
 
+    // The locality ids of the remote primary namespace instances whose
+    // addresses are currently being resolved by the main AGAS instance.
+    cache_mutex_type resolving_instances_mtx_;
+    std::set<boost::uint32_t> resolving_instances_;
+
+    // The ids of symbolic names resolved by this locality. The symbol
+    // namespace instance owning a name tells us once it is unregistered.
+    // The epoch is bumped on every invalidation, replies to resolve requests
+    // which were sent before are not cached.
+    cache_mutex_type symbol_cache_mtx_;
+    std::map<std::string, naming::id_type> symbol_cache_;
+    boost::uint64_t symbol_cache_epoch_;
+
     addressing_service(
         parcelset::parcelport& pp
       , util::runtime_configuration const& ini_
@@ -137,6 +147,10 @@ struct HPX_EXPORT addressing_service : boost::noncopyable
 
     void adjust_local_cache_size();
 
+    /// Start sending the buffered reference count decrements periodically,
+    /// the timer is running only while there are buffered decrements.
+    void start_refcnt_flush_timer();
+
     state get_status() const
     {
         if (!hosted && !bootstrap)
@@ -233,6 +247,14 @@ protected:
       , gva const& g
     );
 
+    void resolve_service_instance_async(
+        naming::gid_type const& id
+        );
+    void resolve_service_instance_postproc(
+        unique_future<response> f
+      , naming::gid_type const& id
+        );
+
 private:
     /// Assumes that \a refcnt_requests_mtx_ is locked.
     void send_refcnt_requests(
@@ -247,7 +269,7 @@ private:
         );
 
     /// Assumes that \a refcnt_requests_mtx_ is locked.
-    std::vector<hpx::unique_future<std::vector<response> > >
+    std::vector<hpx::unique_future<void> >
     send_refcnt_requests_async(
         mutex_type::scoped_lock& l
         );
@@ -258,6 +280,14 @@ private:
       , error_code& ec
         );
 
+    /// Invoked by refcnt_flush_timer_, always stops the timer after sending
+    /// the buffered decrements.
+    bool flush_refcnt_requests();
+
+    // Helper functions to access the reference counting statistics
+    boost::int64_t get_pending_credits(bool);
+    boost::int64_t get_flushed_credits(bool);
+
     // Helper functions to access the current cache statistics
     std::size_t get_cache_hits(bool);
     std::size_t get_cache_misses(bool);
@@ -1434,6 +1464,65 @@ public:
         return resolve_name_async(name).get(ec);
     }
 
+    /// \brief Query for the global addresses associated with several global
+    ///        names.
+    ///
+    /// The names are resolved using one request per symbol namespace
+    /// instance responsible for any of them. Names found in the local
+    /// symbol cache are not sent at all.
+    ///
+    /// \param names      [in] The global names (strings) to resolve.
+    ///
+    /// \returns          The ids associated with the given names, in the
+    ///                   same order. The id of a name which is not registered
+    ///                   is \a naming#invalid_id.
+    lcos::unique_future<std::vector<naming::id_type> > resolve_names_async(
+        std::vector<std::string> const& names
+        );
+
+    std::vector<naming::id_type> resolve_names(
+        std::vector<std::string> const& names
+      , error_code& ec = throws
+        )
+    {
+        return resolve_names_async(names).get(ec);
+    }
+
+    /// \brief Wait for a global name to be registered.
+    ///
+    /// \param name       [in] The global name (string) to wait for.
+    ///
+    /// \returns          A future which becomes ready with the id associated
+    ///                   with \a name as soon as the name is registered
+    ///                   (immediately if it is registered already).
+    lcos::unique_future<naming::id_type> on_symbol_namespace_event(
+        std::string const& name
+        );
+
+    /// \warning This function is for internal use only. It is invoked by
+    ///          the symbol namespace instance owning \a name after the name
+    ///          was unregistered.
+    void invalidate_symbol_cache_entry(
+        std::string const& name
+        );
+
+private:
+    std::vector<naming::id_type> resolve_names_postproc(
+        lcos::unique_future<
+            std::vector<lcos::unique_future<std::vector<response> > >
+        > f
+      , std::vector<naming::id_type> ids
+      , std::vector<std::vector<std::size_t> > const& indices
+      , std::vector<std::string> const& names
+      , boost::uint64_t epoch
+        );
+
+    void erase_symbol_cache_entry(
+        std::string const& name
+        );
+
+public:
+
     /// \warning This function is for internal use only. It is dangerous and
     ///          may break your code if you use it.
     void insert_cache_entry(
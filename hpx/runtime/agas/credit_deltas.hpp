@@ -0,0 +1,104 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_CREDIT_DELTAS_OCT_17_2014_0315PM)
+#define HPX_AGAS_CREDIT_DELTAS_OCT_17_2014_0315PM
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/serialization/tracking.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas
+{
+    /// A list of credit decrements sent to one primary namespace instance in
+    /// a single message.
+    ///
+    /// The ranges have to be added in ascending order of their lower bound.
+    /// Every range is stored as four variable length integers (7 bits per
+    /// byte): the difference of its msb to the msb of the previous range,
+    /// its lsb (relative to the lsb of the previous range if both share the
+    /// same msb), the number of ids in the range minus one and the number of
+    /// credits to remove. Ids allocated close to each other usually encode
+    /// to a handful of bytes.
+    class HPX_EXPORT credit_deltas
+    {
+    public:
+        struct entry
+        {
+            naming::gid_type lower_;
+            naming::gid_type upper_;
+            boost::int64_t credits_;
+        };
+
+        credit_deltas()
+          : size_(0)
+        {}
+
+        /// Append the decrement of \a credits for all ids in [lower, upper].
+        void add(naming::gid_type const& lower, naming::gid_type const& upper,
+            boost::int64_t credits);
+
+        /// Decode all stored decrements.
+        void decode(std::vector<entry>& entries) const;
+
+        /// Return the number of stored decrements.
+        std::size_t size() const { return size_; }
+        bool empty() const { return 0 == size_; }
+
+        /// Return the number of bytes the decrements are encoded with.
+        std::size_t encoded_size() const { return data_.size(); }
+
+    private:
+        void append(naming::gid_type const& lower, boost::uint64_t length,
+            boost::int64_t credits);
+
+        friend class boost::serialization::access;
+
+        template <typename Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            boost::uint64_t size = size_;
+            ar << size << data_;
+        }
+
+        template <typename Archive>
+        void load(Archive& ar, const unsigned int version)
+        {
+            if (version > HPX_AGAS_VERSION)
+            {
+                HPX_THROW_EXCEPTION(version_too_new
+                  , "credit_deltas::load"
+                  , "trying to load credit_deltas with unknown version");
+            }
+
+            boost::uint64_t size = 0;
+            ar >> size >> data_;
+            size_ = static_cast<std::size_t>(size);
+        }
+
+        BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+        std::vector<boost::uint8_t> data_;
+        std::size_t size_;
+        naming::gid_type last_;     // lower bound of the last range, not sent
+    };
+}}
+
+BOOST_CLASS_VERSION(hpx::agas::credit_deltas, HPX_AGAS_VERSION)
+BOOST_CLASS_TRACKING(hpx::agas::credit_deltas, boost::serialization::track_never)
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
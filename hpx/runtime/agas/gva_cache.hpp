@@ -0,0 +1,133 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_GVA_CACHE_OCT_17_2014_1050AM)
+#define HPX_AGAS_GVA_CACHE_OCT_17_2014_1050AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <set>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas
+{
+    /// The client side cache of AGAS, mapping ranges of global ids to their
+    /// global virtual addresses.
+    ///
+    /// The cache is a set associative hash table. Single ids are stored in
+    /// the set selected by their hash, ranges of ids are stored in the sets
+    /// of all blocks of (1 << block_bits) ids they cover (up to max_span
+    /// blocks). Looking up an id probes at most two sets and does not
+    /// acquire any lock: every slot is protected by a sequence counter, and
+    /// readers treat a slot which was modified while being read as a miss.
+    /// Writers serialize on a per-set spinlock. Entries are evicted using the
+    /// CLOCK algorithm within each set.
+    class HPX_EXPORT gva_cache : boost::noncopyable
+    {
+    public:
+        enum
+        {
+            ways = 4,               // slots per set
+            block_bits = 16,        // ids per block of ranges: 64k
+            max_span = 16           // max number of blocks cached per range
+        };
+
+        explicit gva_cache(std::size_t capacity = 0);
+        ~gva_cache();
+
+        /// Return the number of entries the cache can hold.
+        std::size_t capacity() const;
+
+        /// Grow the cache to hold at least \a capacity entries. The current
+        /// contents of the cache are dropped.
+        void reserve(std::size_t capacity);
+
+        /// Look up the given id. Returns the base id and the GVA of the
+        /// cached range the id belongs to.
+        bool get_entry(naming::gid_type const& id, naming::gid_type& base,
+            gva& g) const;
+
+        /// Add the range [id, id + count) if it is not cached yet. Returns
+        /// false and the conflicting range if it overlaps with a different
+        /// cached range.
+        bool insert(naming::gid_type const& id, boost::uint64_t count,
+            gva const& g, naming::gid_type& other_id,
+            boost::uint64_t& other_count);
+
+        /// Add the range [id, id + count), or replace the GVA it is cached
+        /// with. Returns false and the conflicting range if it overlaps with
+        /// a different cached range.
+        bool update(naming::gid_type const& id, boost::uint64_t count,
+            gva const& g, naming::gid_type& other_id,
+            boost::uint64_t& other_count);
+
+        /// Remove all entries from the cache.
+        void clear();
+
+        // access the statistics of the cache
+        std::size_t hits(bool reset);
+        std::size_t misses(bool reset);
+        std::size_t insertions(bool reset);
+        std::size_t evictions(bool reset);
+
+    private:
+        struct entry;
+        struct slot;
+        struct set;
+        struct table;
+
+        struct statistics
+        {
+            statistics()
+              : hits_(0), misses_(0), insertions_(0), evictions_(0)
+            {}
+
+            boost::atomic<std::size_t> hits_;
+            boost::atomic<std::size_t> misses_;
+            boost::atomic<std::size_t> insertions_;
+            boost::atomic<std::size_t> evictions_;
+
+            // keep the counters of different stripes on separate cache lines
+            char pad_[64 - 4 * sizeof(boost::atomic<std::size_t>)];
+        };
+
+        enum { num_statistics = 64 };
+
+        typedef lcos::local::spinlock mutex_type;
+
+        bool store(naming::gid_type const& id, boost::uint64_t count,
+            gva const& g, bool overwrite, naming::gid_type& other_id,
+            boost::uint64_t& other_count);
+
+        naming::locality const* get_endpoint(naming::locality const& l);
+
+        statistics& get_statistics(std::size_t set_index) const;
+
+        std::size_t accumulate(
+            boost::atomic<std::size_t> statistics::* counter, bool reset);
+
+        boost::atomic<table*> table_;
+
+        mutable mutex_type mtx_;            // protects the members below
+        std::vector<table*> retired_;       // tables replaced by reserve()
+        std::set<naming::locality> endpoints_;
+
+        mutable statistics statistics_[num_statistics];
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -17,6 +17,8 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <vector>
+
 namespace hpx { namespace agas
 {
 
@@ -76,6 +78,23 @@ HPX_API_EXPORT lcos::unique_future<naming::id_type> resolve_name(
     std::string const& name
     );
 
+/// Resolve several names at once, sending one request per symbol namespace
+/// instance. Names which are not registered resolve to naming::invalid_id.
+HPX_API_EXPORT std::vector<naming::id_type> resolve_names_sync(
+    std::vector<std::string> const& names
+  , error_code& ec = throws
+    );
+
+HPX_API_EXPORT lcos::unique_future<std::vector<naming::id_type> > resolve_names(
+    std::vector<std::string> const& names
+    );
+
+/// Return a future which becomes ready with the id registered for the given
+/// name as soon as it is registered, avoids polling with resolve_name.
+HPX_API_EXPORT lcos::unique_future<naming::id_type> when_registered(
+    std::string const& name
+    );
+
 ///////////////////////////////////////////////////////////////////////////////
 // HPX_API_EXPORT lcos::unique_future<std::vector<naming::id_type> > get_localities(
 //     components::component_type type = components::component_invalid
@@ -15,6 +15,7 @@
 #include <hpx/traits/action_may_require_id_splitting.hpp>
 #include <hpx/runtime/agas/request.hpp>
 #include <hpx/runtime/agas/response.hpp>
+#include <hpx/runtime/agas/credit_deltas.hpp>
 #include <hpx/runtime/agas/namespace_action_code.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
@@ -126,13 +127,17 @@ struct HPX_EXPORT primary_namespace
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
+    // The GVA table and the reference count table are protected by separate
+    // locks, resolving an address does not have to wait for credit
+    // operations and vice versa. Code needing both locks (decrement_sweep)
+    // always acquires refcnt_mutex_ first.
+    mutex_type gva_mutex_;
     gva_table_type gvas_;
+    mutex_type refcnt_mutex_;
     refcnt_table_type refcnts_;
     std::string instance_name_;
     naming::locality locality_;
+    mutex_type next_id_mutex_;      // protects next_id_
     naming::gid_type next_id_;      // next available gid
     boost::uint32_t locality_id_;   // our locality id
 
@@ -272,6 +277,20 @@ struct HPX_EXPORT primary_namespace
       , error_code& ec
         );
 
+    /// Apply all credit decrements sent by one locality at once.
+    void remote_decrement_credits(
+        credit_deltas const& deltas
+        )
+    {
+        decrement_credits(deltas, throws);
+    }
+
+    /// Apply all credit decrements sent by one locality at once.
+    void decrement_credits(
+        credit_deltas const& deltas
+      , error_code& ec
+        );
+
     /// Register all performance counter types exposed by this component.
     static void register_counter_types(
         error_code& ec = throws
@@ -328,6 +347,7 @@ struct HPX_EXPORT primary_namespace
         );
 
   private:
+    // gva_mutex_ has to be held while calling this function
     boost::fusion::vector3<naming::gid_type, gva, boost::uint32_t>
     resolve_gid_locked(
         naming::gid_type const& gid
@@ -379,6 +399,17 @@ struct HPX_EXPORT primary_namespace
       , error_code& ec
         );
 
+    // refcnt_mutex_ has to be held while calling this function, the dead
+    // objects are appended to free_list
+    void decrement_sweep_locked(
+        mutex_type::scoped_lock& l
+      , std::list<free_entry>& free_list
+      , naming::gid_type const& lower
+      , naming::gid_type const& upper
+      , boost::int64_t credits
+      , error_code& ec
+        );
+
     void free_components_sync(
         std::list<free_entry>& free_list
       , naming::gid_type const& lower
@@ -406,6 +437,7 @@ struct HPX_EXPORT primary_namespace
 
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, remote_service, service_action);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, remote_bulk_service, bulk_service_action);
+    HPX_DEFINE_COMPONENT_ACTION(primary_namespace, remote_decrement_credits, decrement_credits_action);
 
     /// This is the default hook implementation for decorate_action which
     /// does no hooking at all.
@@ -438,6 +470,10 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::bulk_service_action,
     primary_namespace_bulk_service_action)
 
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::decrement_credits_action,
+    primary_namespace_decrement_credits_action)
+
 namespace hpx { namespace traits
 {
     // Parcel routing forwards the message handler request to the routed action
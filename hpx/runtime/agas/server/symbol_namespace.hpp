@@ -22,6 +22,8 @@
 #include <hpx/lcos/local/mutex.hpp>
 
 #include <map>
+#include <set>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -50,11 +52,20 @@ struct HPX_EXPORT symbol_namespace
     > iterate_names_function_type;
 
     typedef std::map<std::string, naming::gid_type> gid_table_type;
+
+    // the localities caching the id of a name
+    typedef std::map<std::string, std::set<boost::uint32_t> > watchers_type;
+
+    // the LCOs waiting for a name to be registered
+    typedef std::multimap<std::string, naming::id_type> on_event_data_type;
     // }}}
 
   private:
+    // mutex_ protects all three tables
     mutex_type mutex_;
     gid_table_type gids_;
+    watchers_type watchers_;
+    on_event_data_type on_event_data_;
     std::string instance_name_;
 
     struct update_time_on_exit;
@@ -202,6 +213,69 @@ struct HPX_EXPORT symbol_namespace
       , error_code& ec = throws
         );
 
+    /// Resolve all given names. If \a watcher is a valid locality id, that
+    /// locality is told once any of the resolved names is unregistered.
+    std::vector<response> remote_resolve_names(
+        std::vector<std::string> const& names
+      , boost::uint32_t watcher
+        )
+    {
+        return resolve_names(names, watcher, throws);
+    }
+
+    std::vector<response> resolve_names(
+        std::vector<std::string> const& names
+      , boost::uint32_t watcher
+      , error_code& ec = throws
+        );
+
+    /// Set the value of \a lco to the id of \a name as soon as the name is
+    /// registered (immediately if it is registered already).
+    void remote_on_event(
+        std::string const& name
+      , naming::id_type const& lco
+        )
+    {
+        on_event(name, lco, throws);
+    }
+
+    void on_event(
+        std::string const& name
+      , naming::id_type const& lco
+      , error_code& ec = throws
+        );
+
+    /// Invoked by the symbol namespace instance owning \a name after it was
+    /// unregistered, removes the name from the cache of this locality.
+    void remote_invalidate(
+        std::string const& name
+        );
+
+    /// Invoked by the locality namespace after the locality \a locality_id
+    /// has left, forgets the names cached there and the LCOs waiting there.
+    void remote_remove_locality(
+        boost::uint32_t locality_id
+        )
+    {
+        remove_locality(locality_id);
+    }
+
+    void remove_locality(
+        boost::uint32_t locality_id
+        );
+
+  private:
+    // notify all localities caching the given name
+    void invalidate_watchers(
+        std::string const& name
+      , std::set<boost::uint32_t> const& watchers
+        );
+
+    // drop all LCOs still waiting for a name to be registered
+    void release_waiting_lcos();
+
+  public:
+
     enum actions
     { // {{{ action enum
         // Actual actions
@@ -218,6 +292,10 @@ struct HPX_EXPORT symbol_namespace
 
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_service, service_action);
     HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_bulk_service, bulk_service_action);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_resolve_names, resolve_names_action);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_on_event, on_event_action);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_invalidate, invalidate_action);
+    HPX_DEFINE_COMPONENT_ACTION(symbol_namespace, remote_remove_locality, remove_locality_action);
 
     /// This is the default hook implementation for decorate_action which 
     /// does no hooking at all.
@@ -239,5 +317,21 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::symbol_namespace::service_action,
     symbol_namespace_service_action)
 
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::resolve_names_action,
+    symbol_namespace_resolve_names_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::on_event_action,
+    symbol_namespace_on_event_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::symbol_namespace::remove_locality_action,
+    symbol_namespace_remove_locality_action)
+
 #endif // HPX_D69CE952_C5D9_4545_B83E_BA3DCFD812EB
 
@@ -81,6 +81,22 @@ struct HPX_EXPORT primary_namespace
         return bulk_service_async(gid, reqs, priority).get(ec);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    static lcos::unique_future<void> decrement_credits_async(
+        naming::id_type const& gid
+      , credit_deltas const& deltas
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
+    /// Fire-and-forget semantics.
+    ///
+    /// \note This is placed out of line to avoid including applier headers.
+    static void decrement_credits_non_blocking(
+        naming::id_type const& gid
+      , credit_deltas const& deltas
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
     static naming::gid_type get_service_instance(naming::gid_type const& dest)
     {
         boost::uint32_t service_locality_id = naming::get_locality_id_from_gid(dest);
@@ -98,6 +98,39 @@ struct HPX_EXPORT symbol_namespace
         return bulk_service_async(gid, reqs, priority).get(ec);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Resolve several names handled by the same symbol namespace instance.
+    /// If \a watcher is a valid locality id, that locality is told once any
+    /// of the resolved names is unregistered.
+    static lcos::unique_future<std::vector<response> > resolve_names_async(
+        naming::id_type const& gid
+      , std::vector<std::string> const& names
+      , boost::uint32_t watcher = naming::invalid_locality_id
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
+    /// Fire-and-forget semantics.
+    static void on_event_non_blocking(
+        naming::id_type const& gid
+      , std::string const& name
+      , naming::id_type const& lco
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
+    /// Fire-and-forget semantics.
+    static void invalidate_non_blocking(
+        naming::id_type const& gid
+      , std::string const& name
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
+    /// Fire-and-forget semantics.
+    static void remove_locality_non_blocking(
+        naming::id_type const& gid
+      , boost::uint32_t locality_id
+      , threads::thread_priority priority = threads::thread_priority_default
+        );
+
     static naming::gid_type get_service_instance(boost::uint32_t service_locality_id)
     {
         naming::gid_type service(HPX_AGAS_SYMBOL_NS_MSB, HPX_AGAS_SYMBOL_NS_LSB);
@@ -23,6 +23,7 @@
 #include <boost/thread.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/serialization.hpp>
@@ -159,6 +160,15 @@ namespace hpx { namespace naming
             return !(lhs < rhs) && !(lhs == rhs);
         }
 
+        // The rank is not hashed: operator== ignores it unless both sides
+        // have one, and equal localities must have equal hash values.
+        friend std::size_t hash_value(locality const& l)
+        {
+            std::size_t seed = boost::hash<std::string>()(l.address_);
+            boost::hash_combine(seed, l.port_);
+            return seed;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         operator util::safe_bool<locality>::result_type() const
         {
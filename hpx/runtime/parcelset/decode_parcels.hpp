@@ -8,6 +8,9 @@
 #define HPX_PARCELSET_DECODE_PARCELS_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/frame_stream.hpp>
 #include <hpx/util/portable_binary_archive.hpp>
 
 #if defined(HPX_HAVE_SECURITY)
@@ -17,6 +20,8 @@
 #include <hpx/components/security/signed_type.hpp>
 #endif
 
+#include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <vector>
@@ -79,6 +84,24 @@ namespace hpx { namespace parcelset {
     }
 #endif
 
+    namespace detail
+    {
+        // create the chunk describing a received zero-copy chunk
+        inline util::serialization_chunk create_received_chunk(
+            std::vector<char> const& chunk, std::size_t size)
+        {
+            HPX_ASSERT(chunk.size() == size);
+            return util::create_pointer_chunk(chunk.data(), size);
+        }
+
+        inline util::serialization_chunk create_received_chunk(
+            util::shared_chunk_buffer const& chunk, std::size_t size)
+        {
+            HPX_ASSERT(chunk.size_ == size);
+            return util::create_shared_chunk(chunk);
+        }
+    }
+
     template <typename Parcelport, typename Buffer>
     bool decode_message(Parcelport & pp,
         boost::shared_ptr<Buffer> buffer,
@@ -248,10 +271,8 @@ namespace hpx { namespace parcelset {
                 transmission_chunk_type& c = buffer->transmission_chunks_[i];
                 boost::uint64_t first = c.first, second = c.second;
 
-                HPX_ASSERT(buffer->chunks_[i].size() == second);
-
-                (*chunks)[first] = util::create_pointer_chunk(
-                        buffer->chunks_[i].data(), second);
+                (*chunks)[first] = detail::create_received_chunk(
+                    buffer->chunks_[i], static_cast<std::size_t>(second));
             }
 
             std::size_t index = 0;
@@ -286,6 +307,174 @@ namespace hpx { namespace parcelset {
             decode_parcels_impl(parcelport, connection, buffer, chunks);
         }
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Create a new instance of the filter described by the first frame
+        // of a streamed message (see create_stream_prologue), returns zero
+        // if the message is not compressed.
+        inline util::binary_filter* load_stream_filter(
+            boost::shared_ptr<std::vector<char> > const& prologue)
+        {
+            util::portable_binary_iarchive archive(*prologue,
+                prologue->size(), boost::archive::no_header);
+
+            util::binary_filter* filter = 0;
+            archive >> filter;
+            return filter;
+        }
+    }
+
+    template <typename Parcelport, typename Buffer>
+    void decode_message_streaming(Parcelport & pp,
+        boost::shared_ptr<util::frame_ring> frames,
+        boost::shared_ptr<Buffer> buffer)
+    {
+        unsigned archive_flags = boost::archive::no_header;
+        if (!pp.allow_array_optimizations()) {
+            archive_flags |= util::disable_array_optimization;
+        }
+        archive_flags |= util::disable_data_chunking;
+
+        util::buffer_pool<char>& pool = get_parcel_buffer_pool();
+        bool succeeded = false;
+
+        // protect from un-handled exceptions bubbling up
+        try {
+            try {
+                // mark start of serialization
+                util::high_resolution_timer timer;
+                boost::int64_t overall_add_parcel_time = 0;
+                performance_counters::parcels::data_point& data =
+                    buffer->data_point_;
+
+                // the first frame describes the filter used for the others
+                util::frame_ring::frame_type prologue;
+                if (!frames->pop(prologue) ||
+                    prologue.size() < util::frame_header_size)
+                {
+                    BOOST_THROW_EXCEPTION(
+                        boost::archive::archive_exception(
+                            boost::archive::archive_exception::input_stream_error,
+                            "archive data bstream is too short"));
+                }
+
+                boost::shared_ptr<std::vector<char> > filter_data =
+                    boost::make_shared<std::vector<char> >(
+                        prologue.begin() + util::frame_header_size,
+                        prologue.end());
+                pool.reclaim_buffer(prologue);
+
+                util::frame_filter_factory create_filter;
+                {
+                    boost::scoped_ptr<util::binary_filter> filter(
+                        detail::load_stream_filter(filter_data));
+                    if (filter)
+                    {
+                        create_filter = HPX_STD_BIND(
+                            &detail::load_stream_filter, filter_data);
+                    }
+                }
+
+                util::iframe_stream stream(*frames, pool, create_filter);
+
+                {
+                    // De-serialize the parcel data while it is received
+                    util::portable_binary_iarchive archive(stream, 0,
+                        archive_flags);
+
+                    std::size_t parcel_count = 0;
+                    archive >> parcel_count; //-V128
+                    for(std::size_t i = 0; i != parcel_count; ++i)
+                    {
+                        // de-serialize parcel and add it to incoming parcel queue
+                        parcel p;
+                        archive >> p;
+
+                        // make sure this parcel ended up on the right locality
+                        HPX_ASSERT(p.get_destination_locality() == pp.here());
+
+                        // be sure not to measure add_parcel as serialization time
+                        boost::int64_t add_parcel_time = timer.elapsed_nanoseconds();
+                        pp.add_received_parcel(p);
+                        overall_add_parcel_time += timer.elapsed_nanoseconds() -
+                            add_parcel_time;
+                    }
+
+                    // complete received data with parcel count
+                    data.num_parcels_ = parcel_count;
+                    data.raw_bytes_ = archive.bytes_read();
+                }
+
+                // wait for the end of the stream, the receiving side has
+                // completed the data point by then
+                util::frame_ring::frame_type frame;
+                while (frames->pop(frame))
+                    pool.reclaim_buffer(frame);
+
+                // store the time required for serialization
+                data.serialization_time_ = timer.elapsed_nanoseconds() -
+                    overall_add_parcel_time;
+
+                pp.add_received_data(data);
+                succeeded = true;
+            }
+            catch (hpx::exception const& e) {
+                // the receiving side has already reported the error if it
+                // has aborted the stream
+                if (!frames->aborted()) {
+                    LPT_(error)
+                        << "decode_message_streaming: caught hpx::exception: "
+                        << e.what();
+                    hpx::report_error(boost::current_exception());
+                }
+            }
+            catch (boost::system::system_error const& e) {
+                LPT_(error)
+                    << "decode_message_streaming: caught boost::system::error: "
+                    << e.what();
+                hpx::report_error(boost::current_exception());
+            }
+            catch (boost::exception const&) {
+                LPT_(error)
+                    << "decode_message_streaming: caught boost::exception.";
+                hpx::report_error(boost::current_exception());
+            }
+            catch (std::exception const& e) {
+                // We have to repackage all exceptions thrown by the
+                // serialization library as otherwise we will loose the
+                // e.what() description of the problem, due to slicing.
+                boost::throw_exception(boost::enable_error_info(
+                    hpx::exception(serialization_error, e.what())));
+            }
+        }
+        catch (...) {
+            LPT_(error)
+                << "decode_message_streaming: caught unknown exception.";
+            hpx::report_error(boost::current_exception());
+        }
+
+        // make the receiving side stop reading the remaining frames
+        if (!succeeded)
+            frames->abort();
+    }
+
+    // Start de-serializing a message which is received as a stream of
+    // frames. The de-serialization waits for the frames to arrive, that's
+    // why it always runs on a separate HPX thread.
+    template <typename Parcelport, typename Buffer>
+    void decode_parcels_streaming(Parcelport & parcelport,
+        boost::shared_ptr<util::frame_ring> frames,
+        boost::shared_ptr<Buffer> buffer)
+    {
+        hpx::applier::register_thread_nullary(
+            HPX_STD_BIND(
+                &decode_message_streaming<Parcelport, Buffer>,
+                    boost::ref(parcelport), frames, buffer),
+            "decode_parcels_streaming",
+            threads::pending, true, threads::thread_priority_critical);
+    }
 }}
 
 #endif
@@ -11,6 +11,8 @@
 #define HPX_PARCELSET_ENCODE_PARCELS_HPP
 
 #include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/frame_stream.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 
 #if defined(HPX_HAVE_SECURITY)
@@ -41,6 +43,17 @@ namespace hpx
 
 namespace hpx { namespace parcelset
 {
+    /// Return the estimated size of the given parcels once serialized
+    inline std::size_t get_parcels_size(std::vector<parcel> const& pv)
+    {
+        std::size_t size = 0;
+        BOOST_FOREACH(parcel const & p, pv)
+        {
+            size += traits::get_type_size(p);
+        }
+        return size;
+    }
+
     template <typename Connection>
     boost::shared_ptr<parcel_buffer<typename Connection::buffer_type> >
     encode_parcels(std::vector<parcel> const &, Connection & connection, int archive_flags_);
@@ -156,10 +169,7 @@ namespace hpx { namespace parcelset
         try {
             try {
                 // preallocate data_
-                BOOST_FOREACH(parcel const & p, pv)
-                {
-                    arg_size += traits::get_type_size(p);
-                }
+                arg_size = get_parcels_size(pv);
 
                 buffer = connection.get_buffer(pv[0], arg_size);
                 buffer->clear();
@@ -299,6 +309,148 @@ namespace hpx { namespace parcelset
 
         return buffer;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The first frame of a streamed message describes the filter used to
+        // compress the remaining frames (if any).
+        inline void create_stream_prologue(util::frame_ring::frame_type& frame,
+            util::binary_filter* filter, int archive_flags)
+        {
+            std::vector<char> data;
+            {
+                util::portable_binary_oarchive archive(data, 0, archive_flags);
+                archive << filter;
+            }
+
+            frame = get_parcel_buffer_pool().get_buffer(
+                util::frame_header_size + data.size());
+            frame.resize(util::frame_header_size);
+            frame.insert(frame.end(), data.begin(), data.end());
+            util::set_frame_header(&frame[0], data.size(), data.size());
+        }
+    }
+
+    // Serialize the parcels into a sequence of frames of the given size.
+    // Every frame is handed to the frame_ring as soon as it is full, which
+    // allows to send it while the serialization is still in progress. This
+    // blocks whenever the ring is full, so it has to be called on an HPX
+    // thread. The ring is aborted if the serialization fails.
+    //
+    // Streamed messages don't use zero-copy chunks, and the serialization
+    // filter (if any) is applied to each of the frames separately.
+    inline void encode_parcels_streaming(std::vector<parcel> const & pv,
+        util::frame_ring& frames, performance_counters::parcels::data_point& data,
+        int archive_flags_, std::size_t frame_size)
+    {
+        boost::uint32_t dest_locality_id = pv[0].get_destination_locality_id();
+        bool succeeded = false;
+
+        // guard against serialization errors
+        try {
+            try {
+                // mark start of serialization
+                util::high_resolution_timer timer;
+
+                HPX_STD_UNIQUE_PTR<util::binary_filter> filter(
+                    pv[0].get_serialization_filter());
+
+                util::frame_filter_factory create_filter;
+                if (filter.get() != 0)
+                {
+                    create_filter = HPX_STD_BIND(
+                        &parcel::get_serialization_filter, pv[0]);
+                }
+
+                util::frame_ring::frame_type prologue;
+                detail::create_stream_prologue(prologue, filter.get(),
+                    archive_flags_);
+
+                std::size_t prologue_size = prologue.size();
+                if (!frames.push(prologue))
+                {
+                    HPX_THROW_EXCEPTION(network_error,
+                        "encode_parcels_streaming",
+                        "the stream of frames was aborted");
+                }
+
+                util::oframe_stream stream(frames, get_parcel_buffer_pool(),
+                    frame_size, create_filter);
+
+                {
+                    // Serialize the data
+                    util::portable_binary_oarchive archive(
+                        stream
+                      , dest_locality_id
+                      , 0
+                      , archive_flags_ | util::disable_data_chunking);
+
+                    std::size_t count = pv.size();
+                    archive << count; //-V128
+
+                    BOOST_FOREACH(parcel const& p, pv)
+                    {
+                        archive << p;
+                    }
+                }
+
+                // send the last (partially filled) frame
+                stream.flush();
+
+                // store the time required for serialization
+                data.serialization_time_ = timer.elapsed_nanoseconds();
+                data.num_parcels_ = pv.size();
+                data.bytes_ = stream.bytes_written();
+                data.raw_bytes_ = prologue_size + stream.bytes_sent();
+
+                succeeded = true;
+            }
+            catch (hpx::exception const& e) {
+                // the sending side has already reported the error if it
+                // has aborted the stream
+                if (!frames.aborted()) {
+                    LPT_(fatal)
+                        << "encode_parcels_streaming: "
+                           "caught hpx::exception: "
+                        << e.what();
+                    hpx::report_error(boost::current_exception());
+                }
+            }
+            catch (boost::system::system_error const& e) {
+                LPT_(fatal)
+                    << "encode_parcels_streaming: "
+                       "caught boost::system::error: "
+                    << e.what();
+                hpx::report_error(boost::current_exception());
+            }
+            catch (boost::exception const&) {
+                LPT_(fatal)
+                    << "encode_parcels_streaming: "
+                       "caught boost::exception";
+                hpx::report_error(boost::current_exception());
+            }
+            catch (std::exception const& e) {
+                // We have to repackage all exceptions thrown by the
+                // serialization library as otherwise we will loose the
+                // e.what() description of the problem, due to slicing.
+                boost::throw_exception(boost::enable_error_info(
+                    hpx::exception(serialization_error, e.what())));
+            }
+        }
+        catch (...) {
+            LPT_(fatal)
+                    << "encode_parcels_streaming: "
+                   "caught unknown exception";
+            hpx::report_error(boost::current_exception());
+        }
+
+        // the sender stops as soon as it sees the stream being aborted
+        if (succeeded)
+            frames.close();
+        else
+            frames.abort();
+    }
 }}
 
 #endif
@@ -150,7 +150,8 @@ namespace hpx { namespace parcelset
         protected:
             void save(util::portable_binary_oarchive& ar, bool has_source_id, bool has_continuation) const;
 
-            void load(util::portable_binary_iarchive& ar, bool has_source_id, bool has_continuation);
+            void load(util::portable_binary_iarchive& ar, bool has_source_id,
+                bool has_continuation, boost::uint32_t source_locality_id);
 
         private:
             friend void intrusive_ptr_add_ref(parcel_data* p);
@@ -10,6 +10,7 @@
 #include <hpx/config.hpp>
 #include <hpx/util/portable_binary_archive.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/util/buffer_pool.hpp>
 
 #include <boost/integer/endian.hpp>
 
@@ -17,6 +18,14 @@
 
 namespace hpx { namespace parcelset
 {
+    /// Return the pool used to recycle the memory of the message buffers
+    /// for sending and receiving parcels.
+    HPX_API_EXPORT util::buffer_pool<char>& get_parcel_buffer_pool();
+
+    /// The value of the size field in the header of a message which is sent
+    /// as a stream of frames (see encode_parcels_streaming).
+    boost::uint64_t const streamed_message_size = ~boost::uint64_t(0);
+
     template <typename BufferType, typename ChunkType = util::serialization_chunk>
     struct parcel_buffer
     {
@@ -401,9 +401,15 @@ namespace hpx { namespace parcelset
         // number of messages sent
         std::size_t get_message_send_count(connection_type, bool) const;
 
+        // number of write operations used to send messages
+        boost::int64_t get_message_write_count(connection_type, bool) const;
+
         // number of parcels routed
         boost::int64_t get_parcel_routed_count(bool);
 
+        // number of parcels delivered locally without being sent
+        boost::int64_t get_parcel_local_count(bool);
+
         // number of parcels received
         std::size_t get_parcel_receive_count(connection_type, bool) const;
 
@@ -498,6 +504,9 @@ namespace hpx { namespace parcelset
 
         /// Count number of (outbound) parcels routed
         boost::atomic<boost::int64_t> count_routed_;
+
+        /// Count number of parcels delivered to this locality directly
+        boost::atomic<boost::int64_t> count_local_;
     };
 }}
 
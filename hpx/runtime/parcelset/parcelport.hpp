@@ -17,6 +17,7 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 
 #include <boost/enable_shared_from_this.hpp>
 
@@ -197,6 +198,12 @@ namespace hpx { namespace parcelset
             return parcels_sent_.num_messages(reset);
         }
 
+        /// number of write operations used to send all messages
+        boost::int64_t get_message_write_count(bool reset)
+        {
+            return util::get_and_reset_value(message_writes_, reset);
+        }
+
         /// number of parcels received
         std::size_t get_parcel_receive_count(bool reset)
         {
@@ -352,6 +359,41 @@ namespace hpx { namespace parcelset
             return async_serialization_;
         }
 
+        /// Return the estimated message size starting at which parcels are
+        /// streamed (zero if streaming is disabled)
+        std::size_t streaming_threshold() const
+        {
+            return streaming_threshold_;
+        }
+
+        std::size_t streaming_frame_size() const
+        {
+            return streaming_frame_size_;
+        }
+
+        std::size_t streaming_max_frames() const
+        {
+            return streaming_max_frames_;
+        }
+
+        /// Return the estimated message size starting at which pending
+        /// parcels are split into several messages sent by a single gathered
+        /// write (zero if gathered writes are disabled)
+        std::size_t gather_message_size() const
+        {
+            return gather_message_size_;
+        }
+
+        std::size_t gather_max_size() const
+        {
+            return gather_max_size_;
+        }
+
+        std::size_t gather_max_buffers() const
+        {
+            return gather_max_buffers_;
+        }
+
     protected:
         /// mutex for all of the member data
         mutable lcos::local::spinlock mtx_;
@@ -388,6 +430,17 @@ namespace hpx { namespace parcelset
         /// async serialization of parcels
         bool async_serialization_;
 
+        /// streaming of large messages
+        std::size_t streaming_threshold_;
+        std::size_t streaming_frame_size_;
+        std::size_t streaming_max_frames_;
+
+        /// gathered writes of several messages
+        std::size_t gather_message_size_;
+        std::size_t gather_max_size_;
+        std::size_t gather_max_buffers_;
+        boost::atomic<boost::int64_t> message_writes_;
+
         /// enable parcelport
         boost::atomic<bool> enable_parcel_handling_;
     };
@@ -11,6 +11,9 @@
 
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
 
 namespace hpx { namespace parcelset {
 
@@ -19,6 +22,50 @@ namespace hpx { namespace parcelset {
     class parcelport_impl;
 
     boost::uint64_t get_max_inbound_size(parcelport&);
+    std::size_t get_streaming_max_frames(parcelport&);
+
+    namespace detail
+    {
+        // The message data of parcelports using std::vector<char> as their
+        // buffer type is taken from (and returned to) the parcel buffer pool.
+        template <typename BufferType>
+        void acquire_buffer(BufferType& data, std::size_t size)
+        {
+            data.reserve(size);
+        }
+
+        inline void acquire_buffer(std::vector<char>& data, std::size_t size)
+        {
+            if (data.capacity() < size)
+            {
+                util::buffer_pool<char>& pool = get_parcel_buffer_pool();
+                pool.reclaim_buffer(data);
+                data = pool.get_buffer(size);
+            }
+        }
+
+        template <typename BufferType>
+        void release_buffer(BufferType&)
+        {
+        }
+
+        inline void release_buffer(std::vector<char>& data)
+        {
+            get_parcel_buffer_pool().reclaim_buffer(data);
+        }
+
+        // hands the message data back to the pool once the last reference
+        // to a parcel_buffer goes out of scope
+        struct parcel_buffer_deleter
+        {
+            template <typename ParcelBuffer>
+            void operator()(ParcelBuffer* p) const
+            {
+                release_buffer(p->data_);
+                delete p;
+            }
+        };
+    }
 
     template <typename Connection, typename BufferType, typename ChunkType = util::serialization_chunk>
     struct parcelport_connection
@@ -81,9 +128,10 @@ namespace hpx { namespace parcelset {
         {
             if(!buffer_)
             {
-                buffer_ = boost::make_shared<parcel_buffer_type>();
-                buffer_->data_.reserve(arg_size);
+                buffer_.reset(new parcel_buffer_type(),
+                    detail::parcel_buffer_deleter());
             }
+            detail::acquire_buffer(buffer_->data_, arg_size);
             return buffer_;
         }
         /// buffer for data
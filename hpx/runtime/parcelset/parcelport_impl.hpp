@@ -19,6 +19,7 @@
 #include <hpx/util/runtime_configuration.hpp>
 
 #include <boost/asio/placeholders.hpp>
+#include <boost/make_shared.hpp>
 
 namespace hpx { namespace parcelset
 {
@@ -668,6 +669,25 @@ namespace hpx { namespace parcelset
                 sender_connection->verify(parcel_locality_id);
             }
 #endif
+            // large messages are sent while they are being encoded, if
+            // supported
+            if (send_streaming_parcels_impl<ConnectionHandler>(
+                    sender_connection, parcels, handlers))
+            {
+                ++this->message_writes_;
+                do_background_work_impl<ConnectionHandler>();
+                return;
+            }
+
+            // many parcels are split into several messages which are sent
+            // using gathered writes, if supported
+            if (send_gathered_parcels_impl<ConnectionHandler>(
+                    sender_connection, parcels, handlers))
+            {
+                do_background_work_impl<ConnectionHandler>();
+                return;
+            }
+
             // encode the parcels
             boost::shared_ptr<parcel_buffer<typename connection::buffer_type> >
                 buffer = encode_parcels(parcels, *sender_connection,
@@ -680,9 +700,179 @@ namespace hpx { namespace parcelset
                     this,
                     ::_1, ::_2, ::_3));
 
+            ++this->message_writes_;
             do_background_work_impl<ConnectionHandler>();
         }
 
+        template <typename ConnectionHandler_>
+        typename boost::enable_if<
+            typename connection_handler_traits<
+                ConnectionHandler_
+            >::send_streaming
+          , bool
+        >::type
+        send_streaming_parcels_impl(
+            boost::shared_ptr<connection> const& sender_connection,
+            std::vector<parcel>& parcels,
+            std::vector<write_handler_type>& handlers)
+        {
+            // the signature of the whole message has to be known before
+            // sending it if security is enabled
+            if (this->streaming_threshold() == 0 || this->enable_security() ||
+                get_parcels_size(parcels) < this->streaming_threshold())
+            {
+                return false;
+            }
+
+            boost::shared_ptr<util::frame_ring> frames =
+                boost::make_shared<util::frame_ring>(
+                    this->streaming_max_frames());
+            boost::shared_ptr<std::vector<parcel> > pv =
+                boost::make_shared<std::vector<parcel> >(std::move(parcels));
+
+            // The frames are produced by a new HPX thread. The encoding is
+            // suspended whenever the ring is full, which is possible on HPX
+            // threads only (the caller might be a plain OS thread), and the
+            // caller is not held up while the frames are being sent.
+            error_code ec(lightweight);
+            hpx::applier::register_thread_nullary(
+                HPX_STD_BIND(
+                    &parcelport_impl::encode_streaming_parcels,
+                    this, sender_connection, frames, pv),
+                "encode_streaming_parcels",
+                threads::pending, true, threads::thread_priority_critical,
+                std::size_t(-1), threads::thread_stacksize_default, ec);
+
+            if (ec)
+            {
+                // send the parcels as a single message instead
+                parcels = std::move(*pv);
+                return false;
+            }
+
+            // start sending, the frames are written as soon as they are
+            // available
+            sender_connection->async_write_streaming(frames,
+                hpx::parcelset::detail::call_for_each(std::move(handlers)),
+                boost::bind(&parcelport_impl::send_pending_parcels_trampoline,
+                    this,
+                    ::_1, ::_2, ::_3));
+
+            return true;
+        }
+
+        void encode_streaming_parcels(
+            boost::shared_ptr<connection> const& sender_connection,
+            boost::shared_ptr<util::frame_ring> const& frames,
+            boost::shared_ptr<std::vector<parcel> > const& parcels)
+        {
+            // this suspends the thread whenever the frames are produced
+            // faster than they can be sent
+            encode_parcels_streaming(*parcels, *frames,
+                sender_connection->buffer_->data_point_, archive_flags_,
+                this->streaming_frame_size());
+        }
+
+        template <typename ConnectionHandler_>
+        typename boost::disable_if<
+            typename connection_handler_traits<
+                ConnectionHandler_
+            >::send_streaming
+          , bool
+        >::type
+        send_streaming_parcels_impl(
+            boost::shared_ptr<connection> const&,
+            std::vector<parcel>&, std::vector<write_handler_type>&)
+        {
+            return false;
+        }
+
+        template <typename ConnectionHandler_>
+        typename boost::enable_if<
+            typename connection_handler_traits<
+                ConnectionHandler_
+            >::send_gathered
+          , bool
+        >::type
+        send_gathered_parcels_impl(
+            boost::shared_ptr<connection> const& sender_connection,
+            std::vector<parcel>& parcels,
+            std::vector<write_handler_type>& handlers)
+        {
+            // messages are signed one by one if security is enabled, which
+            // is not supported for gathered writes
+            std::size_t message_size = this->gather_message_size();
+            if (message_size == 0 || this->enable_security() ||
+                parcels.size() < 2)
+            {
+                return false;
+            }
+
+            // split the parcels into messages of roughly the configured size
+            std::vector<std::size_t> message_ends;
+            std::size_t size = 0;
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                size += traits::get_type_size(parcels[i]);
+                if (size >= message_size)
+                {
+                    message_ends.push_back(i + 1);
+                    size = 0;
+                }
+            }
+            if (message_ends.empty() || message_ends.back() != parcels.size())
+                message_ends.push_back(parcels.size());
+
+            if (message_ends.size() < 2)
+                return false;
+
+            // encode each of the messages into its own buffer
+            typedef typename connection::parcel_buffer_type parcel_buffer_type;
+            std::vector<boost::shared_ptr<parcel_buffer_type> > messages;
+            messages.reserve(message_ends.size());
+
+            std::size_t begin = 0;
+            BOOST_FOREACH(std::size_t end, message_ends)
+            {
+                std::vector<parcel> pv;
+                pv.reserve(end - begin);
+                std::move(parcels.begin() + begin, parcels.begin() + end,
+                    std::back_inserter(pv));
+
+                messages.push_back(encode_parcels(pv, *sender_connection,
+                    archive_flags_, false));
+
+                // the next message has to be encoded into a new buffer
+                sender_connection->buffer_.reset();
+                begin = end;
+            }
+
+            // send them asynchronously
+            this->message_writes_ += sender_connection->async_write_gathered(
+                std::move(messages), this->gather_max_size(),
+                this->gather_max_buffers(),
+                hpx::parcelset::detail::call_for_each(std::move(handlers)),
+                boost::bind(&parcelport_impl::send_pending_parcels_trampoline,
+                    this,
+                    ::_1, ::_2, ::_3));
+
+            return true;
+        }
+
+        template <typename ConnectionHandler_>
+        typename boost::disable_if<
+            typename connection_handler_traits<
+                ConnectionHandler_
+            >::send_gathered
+          , bool
+        >::type
+        send_gathered_parcels_impl(
+            boost::shared_ptr<connection> const&,
+            std::vector<parcel>&, std::vector<write_handler_type>&)
+        {
+            return false;
+        }
+
     protected:
         /// The pool of io_service objects used to perform asynchronous operations.
         util::io_service_pool io_service_pool_;
@@ -30,6 +30,8 @@ namespace hpx { namespace parcelset {
         typedef boost::mpl::false_  send_early_parcel;
         typedef boost::mpl::false_ do_background_work;
         typedef boost::mpl::false_ do_enable_parcel_handling;
+        typedef boost::mpl::false_ send_streaming;
+        typedef boost::mpl::false_ send_gathered;
 
         static const char * name()
         {
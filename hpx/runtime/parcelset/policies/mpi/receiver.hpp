@@ -55,7 +55,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
         void async_read(header const & h, connection_handler & parcelport)
         {
             header_ = h;
-            buffer_ = get_buffer();
+            buffer_ = get_buffer(parcel(), static_cast<std::size_t>(header_.size()));
             buffer_->clear();
             next_ = 0;
             recvd_chunks_ = 0;
@@ -94,8 +94,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
                 buffer_->data_point_.time_ = timer_.elapsed_nanoseconds() -
                     buffer_->data_point_.time_;
 
-                // decode the received parcels.
+                // decode the received parcels, the buffer is released once
+                // decoding has finished
                 decode_parcels(pp, shared_from_this(), buffer_);
+                buffer_.reset();
                 return true;
             }
             return false;
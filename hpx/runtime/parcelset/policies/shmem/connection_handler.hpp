@@ -0,0 +1,124 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_CONNECTION_HANDLER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_CONNECTION_HANDLER_HPP
+
+#include <hpx/config/warnings_prefix.hpp>
+
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/ring.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/sender.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+
+namespace hpx { namespace parcelset {
+    namespace policies { namespace shmem
+    {
+        class receiver;
+        class sender;
+        class HPX_EXPORT connection_handler;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shmem::connection_handler>
+    {
+        typedef policies::shmem::sender connection_type;
+        typedef boost::mpl::false_ send_early_parcel;
+        typedef boost::mpl::false_ do_background_work;
+        typedef boost::mpl::false_ do_enable_parcel_handling;
+        typedef boost::mpl::false_ send_streaming;
+        typedef boost::mpl::false_ send_gathered;
+
+        static const char * name()
+        {
+            return "shmem";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel_pool_shmem";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies { namespace shmem
+    {
+        // The shared memory parcelport connects localities running on the
+        // same node. Every sender creates a shared memory segment holding a
+        // ring of fixed size slots and an arena for messages too large to be
+        // stored in a slot. All incoming rings are polled by a single thread
+        // which sleeps on a futex while no data is available.
+        class HPX_EXPORT connection_handler
+          : public parcelport_impl<connection_handler>
+        {
+            typedef parcelport_impl<connection_handler> base_type;
+
+        public:
+            static std::vector<std::string> runtime_configuration();
+
+            connection_handler(util::runtime_configuration const& ini,
+                HPX_STD_FUNCTION<void(std::size_t, char const*)> const& on_start_thread,
+                HPX_STD_FUNCTION<void()> const& on_stop_thread);
+
+            ~connection_handler();
+
+            /// Start the handling of connections.
+            bool do_run();
+
+            /// Stop the handling of connections.
+            void do_stop();
+
+            /// Retrieve the type of the locality represented by this parcelport
+            connection_type get_type() const
+            {
+                return connection_shmem;
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const;
+
+            boost::shared_ptr<sender> create_connection(
+                naming::locality const& l, error_code& ec);
+
+        private:
+            // helper functions for receiving parcels
+            void receive_loop();
+            bool receive_parcels();
+            bool accept_connections();
+            bool has_data() const;
+
+            ring_parameters params_;
+            std::size_t spin_count_;
+            boost::atomic<std::size_t> connection_count_;
+
+            /// The listener used to accept incoming connections.
+            boost::scoped_ptr<segment_type> listener_segment_;
+            listener* listener_;
+
+            /// The thread polling all incoming rings.
+            boost::thread receive_thread_;
+            boost::atomic<bool> stopped_;
+
+            /// The list of accepted connections, used by the receive_thread_
+            /// only.
+            std::vector<boost::shared_ptr<receiver> > receivers_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
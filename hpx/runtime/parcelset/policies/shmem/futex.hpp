@@ -0,0 +1,77 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_SHMEM_FUTEX_OCT_17_2014_0930AM)
+#define HPX_PARCELSET_SHMEM_FUTEX_OCT_17_2014_0930AM
+
+#include <hpx/config.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
+#include <climits>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define HPX_PARCELSET_SHMEM_HAVE_FUTEX
+#else
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // The words used for waiting live in memory shared between processes, so
+    // they have to be lock free (and therefore address free).
+    typedef boost::atomic<boost::uint32_t> futex_word;
+
+    BOOST_STATIC_ASSERT(sizeof(futex_word) == sizeof(boost::uint32_t));
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Block the calling (OS-)thread as long as the given word holds the
+    // expected value, but not longer than the given number of milliseconds.
+    // Spurious wake ups are possible, the caller has to re-check its
+    // condition.
+    inline void futex_wait(futex_word& word, boost::uint32_t expected,
+        std::size_t timeout_ms)
+    {
+#if defined(HPX_PARCELSET_SHMEM_HAVE_FUTEX)
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(timeout_ms / 1000);
+        timeout.tv_nsec = static_cast<long>((timeout_ms % 1000) * 1000000);
+
+        // the word is shared between processes, FUTEX_PRIVATE_FLAG must not
+        // be used here
+        ::syscall(SYS_futex, reinterpret_cast<boost::uint32_t*>(&word),
+            FUTEX_WAIT, expected, &timeout, 0, 0);
+#else
+        // no futexes available, poll with a short delay instead
+        if (word.load() == expected)
+        {
+            boost::this_thread::sleep(boost::posix_time::microseconds(
+                (std::min)(timeout_ms * 1000, std::size_t(100))));
+        }
+#endif
+    }
+
+    // Wake up all threads (in all processes) waiting for the given word.
+    inline void futex_wake(futex_word& word)
+    {
+#if defined(HPX_PARCELSET_SHMEM_HAVE_FUTEX)
+        ::syscall(SYS_futex, reinterpret_cast<boost::uint32_t*>(&word),
+            FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#else
+        (void)word;
+#endif
+    }
+}}}}
+
+#endif
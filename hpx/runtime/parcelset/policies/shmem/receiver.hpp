@@ -0,0 +1,145 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/ring.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    class connection_handler;
+
+    // The receiving end of a ring. All receivers of a locality are polled by
+    // the same thread (see connection_handler::receive_loop).
+    class receiver
+      : public parcelport_connection<receiver, std::vector<char> >
+    {
+    public:
+        /// Open the ring created by the sending locality, this throws an
+        /// interprocess_exception if the segment does not exist anymore.
+        receiver(std::string const& name, connection_handler& parcelport)
+          : segment_(boost::interprocess::open_only, name.c_str()),
+            ring_(segment_.find<ring>("ring").first),
+            slots_(segment_.find<char>("slots").first),
+            parcelport_(parcelport)
+        {
+            if (0 == ring_ || 0 == slots_)
+            {
+                throw boost::interprocess::interprocess_exception(
+                    boost::interprocess::not_found_error);
+            }
+
+            // both sides have mapped the segment now, it will go away once
+            // both have unmapped it
+            ring_->attach();
+            boost::interprocess::shared_memory_object::remove(name.c_str());
+        }
+
+        /// Receive all messages currently available in the ring. Returns
+        /// whether anything was received.
+        bool poll()
+        {
+            bool received = false;
+            while (slot_header* slot = ring_->front(slots_))
+            {
+                if (!buffer_)
+                    start_message(*slot);
+
+                std::size_t size = static_cast<std::size_t>(slot->size_);
+                if (slot->handle_ == slot_header::inline_data)
+                {
+                    char const* data = reinterpret_cast<char const*>(slot + 1);
+                    buffer_->data_.insert(buffer_->data_.end(), data, data + size);
+                }
+                else
+                {
+                    char* data = static_cast<char*>(
+                        segment_.get_address_from_handle(
+                            static_cast<segment_type::handle_t>(slot->handle_)));
+                    buffer_->data_.insert(buffer_->data_.end(), data, data + size);
+                    segment_.deallocate(data);
+                }
+
+                // this wakes up the sender if it waits for a free slot or
+                // for space in the arena
+                ring_->pop();
+                received = true;
+
+                if (buffer_->data_.size() == buffer_->size_)
+                    finish_message();
+            }
+            return received;
+        }
+
+        /// Return whether data is waiting to be received.
+        bool has_data() const
+        {
+            return !ring_->empty();
+        }
+
+        /// Return whether the sender has gone away, after all of its data
+        /// was received.
+        bool closed() const
+        {
+            return ring_->closed() && ring_->empty();
+        }
+
+    private:
+        void start_message(slot_header const& slot)
+        {
+            std::size_t size = static_cast<std::size_t>(slot.message_size_);
+
+            buffer_.reset(new parcel_buffer_type(),
+                detail::parcel_buffer_deleter());
+            detail::acquire_buffer(buffer_->data_, size);
+            buffer_->size_ = size;
+            buffer_->data_size_ = slot.data_size_;
+
+            performance_counters::parcels::data_point& data =
+                buffer_->data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.bytes_ = size;
+            data.serialization_time_ = 0;
+            data.num_parcels_ = 0;
+        }
+
+        void finish_message()
+        {
+            // the buffer is handed over to the decoding, the next message
+            // is received into a new one
+            boost::shared_ptr<parcel_buffer_type> buffer;
+            buffer.swap(buffer_);
+
+            buffer->data_point_.time_ = timer_.elapsed_nanoseconds() -
+                buffer->data_point_.time_;
+
+            decode_parcels(parcelport_, shared_from_this(), buffer);
+        }
+
+        segment_type segment_;
+        ring* ring_;
+        char* slots_;
+
+        /// The handler used to process the incoming request.
+        connection_handler& parcelport_;
+
+        /// Counters and timers for parcels received.
+        util::high_resolution_timer timer_;
+    };
+}}}}
+
+#endif
@@ -0,0 +1,283 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_SHMEM_RING_OCT_17_2014_0945AM)
+#define HPX_PARCELSET_SHMEM_RING_OCT_17_2014_0945AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/futex.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstring>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    typedef boost::interprocess::managed_shared_memory segment_type;
+
+    std::size_t const cache_line_size = 64;
+    std::size_t const max_segment_name_length = 128;
+
+    // The name of the segment a locality listens on for new connections.
+    inline std::string get_listener_name(naming::locality const& l)
+    {
+        return "hpx.shmem." + l.get_address() + "." +
+            boost::lexical_cast<std::string>(l.get_port());
+    }
+
+    // The name of the segment holding the ring (and the arena) of a
+    // connection from one locality to another.
+    inline std::string get_connection_name(naming::locality const& here,
+        naming::locality const& there, std::size_t connection_count)
+    {
+        return get_listener_name(here) + "." +
+            boost::lexical_cast<std::string>(there.get_port()) + "." +
+            boost::lexical_cast<std::string>(connection_count);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every locality creates one listener. All senders to that locality use
+    // its doorbell to wake up the thread receiving the parcels, which allows
+    // it to sleep on a single futex regardless of the number of peers.
+    // New connections are announced by storing the name of their segment.
+    struct listener : boost::noncopyable
+    {
+        enum { max_pending_connections = 64 };
+
+        listener()
+          : doorbell_(0), sleeping_(0), num_pending_(0)
+        {}
+
+        // sender side: announce a new connection, returns false if too many
+        // connections are waiting to be accepted already
+        bool connect(std::string const& name)
+        {
+            HPX_ASSERT(name.size() < max_segment_name_length);
+            {
+                boost::interprocess::scoped_lock<
+                    boost::interprocess::interprocess_mutex> l(mtx_);
+                if (num_pending_ == max_pending_connections)
+                    return false;
+
+                char* pending = pending_[num_pending_.load()];
+                std::strncpy(pending, name.c_str(), max_segment_name_length - 1);
+                pending[max_segment_name_length - 1] = '\0';
+                ++num_pending_;
+            }
+            notify();
+            return true;
+        }
+
+        // receiver side: retrieve a connection waiting to be accepted
+        bool accept(std::string& name)
+        {
+            boost::interprocess::scoped_lock<
+                boost::interprocess::interprocess_mutex> l(mtx_);
+            if (num_pending_ == 0)
+                return false;
+
+            name = pending_[--num_pending_];
+            return true;
+        }
+
+        // Wake up the receiving thread, this is called after anything was
+        // made available to it.
+        void notify()
+        {
+            ++doorbell_;
+            if (sleeping_.load())
+                futex_wake(doorbell_);
+        }
+
+        // The receiving thread calls this before checking one last time for
+        // available data and going to sleep in wait() afterwards. Any
+        // notification issued after this will keep wait() from blocking.
+        boost::uint32_t prepare_wait()
+        {
+            boost::uint32_t seq = doorbell_.load();
+            sleeping_.store(1);
+            return seq;
+        }
+
+        void wait(boost::uint32_t seq, std::size_t timeout_ms)
+        {
+            futex_wait(doorbell_, seq, timeout_ms);
+            sleeping_.store(0);
+        }
+
+        void cancel_wait()
+        {
+            sleeping_.store(0);
+        }
+
+        bool has_pending_connections() const
+        {
+            return num_pending_.load() != 0;
+        }
+
+    private:
+        futex_word doorbell_;
+        futex_word sleeping_;
+
+        boost::interprocess::interprocess_mutex mtx_;
+        boost::atomic<boost::uint32_t> num_pending_;
+        char pending_[max_pending_connections][max_segment_name_length];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every slot of the ring starts with this header. Small messages are
+    // stored inline right after it, for larger messages the slot refers to
+    // the data stored in the arena (the remainder of the shared segment).
+    struct slot_header
+    {
+        enum { inline_data = -1 };
+
+        boost::uint64_t size_;          // number of bytes in this slot/chunk
+        boost::uint64_t data_size_;     // see parcel_buffer::data_size_
+        boost::uint64_t message_size_;  // overall size of the message
+        boost::int64_t handle_;         // arena handle or inline_data
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A single producer/single consumer ring of fixed size slots. The ring
+    // lives in the segment created by the sender, it is the only process
+    // writing to the ring, the receiving locality is the only one reading
+    // from it.
+    //
+    // The head and tail counters are placed on separate cache lines to
+    // avoid false sharing between the two processes.
+    class ring : boost::noncopyable
+    {
+    public:
+        ring(std::size_t num_slots, std::size_t slot_size)
+          : head_(0), tail_(0), space_seq_(0), producer_waiting_(0),
+            closed_(0), attached_(0),
+            num_slots_(static_cast<boost::uint32_t>(num_slots)),
+            slot_size_(static_cast<boost::uint32_t>(slot_size))
+        {}
+
+        std::size_t num_slots() const { return num_slots_; }
+        std::size_t slot_size() const { return slot_size_; }
+
+        // the number of bytes which can be stored inline in a slot
+        std::size_t inline_size() const
+        {
+            return slot_size_ - sizeof(slot_header);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // producer side: return the next free slot or zero if the ring is
+        // full
+        slot_header* try_reserve(char* slots) const
+        {
+            boost::uint64_t head = head_.load(boost::memory_order_relaxed);
+            if (head - tail_.load(boost::memory_order_acquire) >= num_slots_)
+                return 0;
+
+            return get_slot(slots, head);
+        }
+
+        // make the reserved slot visible to the consumer
+        void commit()
+        {
+            head_.store(head_.load(boost::memory_order_relaxed) + 1);
+        }
+
+        // Same protocol as listener::prepare_wait/wait, used by the
+        // producer to wait for a slot or for space in the arena.
+        boost::uint32_t prepare_wait()
+        {
+            boost::uint32_t seq = space_seq_.load();
+            producer_waiting_.store(1);
+            return seq;
+        }
+
+        void wait(boost::uint32_t seq, std::size_t timeout_ms)
+        {
+            futex_wait(space_seq_, seq, timeout_ms);
+            producer_waiting_.store(0);
+        }
+
+        void cancel_wait()
+        {
+            producer_waiting_.store(0);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // consumer side: return the oldest used slot or zero if the ring is
+        // empty
+        slot_header* front(char* slots) const
+        {
+            boost::uint64_t tail = tail_.load(boost::memory_order_relaxed);
+            if (tail == head_.load(boost::memory_order_acquire))
+                return 0;
+
+            return get_slot(slots, tail);
+        }
+
+        // release the oldest slot, wake up the producer if it is waiting
+        void pop()
+        {
+            tail_.store(tail_.load(boost::memory_order_relaxed) + 1);
+            notify_producer();
+        }
+
+        // this has to be called as well after the consumer has freed memory
+        // in the arena
+        void notify_producer()
+        {
+            ++space_seq_;
+            if (producer_waiting_.load())
+                futex_wake(space_seq_);
+        }
+
+        bool empty() const
+        {
+            return tail_.load() == head_.load();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // the sender marks the ring as closed before it goes away
+        void close() { closed_.store(1); }
+        bool closed() const { return closed_.load() != 0; }
+
+        // the receiver marks the ring as attached once it has opened it
+        void attach() { attached_.store(1); }
+        bool attached() const { return attached_.load() != 0; }
+
+    private:
+        slot_header* get_slot(char* slots, boost::uint64_t index) const
+        {
+            return reinterpret_cast<slot_header*>(
+                slots + (index % num_slots_) * slot_size_);
+        }
+
+        boost::atomic<boost::uint64_t> head_;
+        char pad0_[cache_line_size - sizeof(boost::atomic<boost::uint64_t>)];
+
+        boost::atomic<boost::uint64_t> tail_;
+        char pad1_[cache_line_size - sizeof(boost::atomic<boost::uint64_t>)];
+
+        futex_word space_seq_;
+        futex_word producer_waiting_;
+        futex_word closed_;
+        futex_word attached_;
+
+        boost::uint32_t const num_slots_;
+        boost::uint32_t const slot_size_;
+    };
+}}}}
+
+#endif
@@ -0,0 +1,289 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/ring.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // the configuration of the rings created by the senders
+    struct ring_parameters
+    {
+        std::size_t num_slots_;
+        std::size_t slot_size_;
+        std::size_t arena_size_;
+        std::size_t wait_timeout_;      // [ms]
+    };
+
+    class sender
+      : public parcelset::parcelport_connection<sender, std::vector<char> >
+    {
+    public:
+        sender(boost::asio::io_service& io_service,
+                naming::locality const& here, naming::locality const& there,
+                ring_parameters const& params,
+                boost::atomic<bool> const& stopped,
+                performance_counters::parcels::gatherer& parcels_sent,
+                std::size_t connection_count)
+          : io_service_(io_service), there_(there), params_(params),
+            name_(get_connection_name(here, there, connection_count)),
+            ring_(0), slots_(0), max_chunk_size_(0), listener_(0), written_(0),
+            stopped_(stopped), parcels_sent_(parcels_sent)
+        {}
+
+        ~sender()
+        {
+            if (0 != ring_)
+            {
+                ring_->close();
+                if (0 != listener_)
+                    listener_->notify();
+
+                // the receiver removes the name of the segment once it has
+                // opened it
+                if (!ring_->attached())
+                {
+                    boost::interprocess::shared_memory_object::remove(
+                        name_.c_str());
+                }
+            }
+        }
+
+        /// Create the ring and announce it to the receiving locality. This
+        /// throws an interprocess_exception if the receiving locality does
+        /// not listen for connections (yet).
+        void connect()
+        {
+            using namespace boost::interprocess;
+
+            if (!listener_)
+            {
+                std::string name(get_listener_name(there_));
+                listener_segment_.reset(
+                    new segment_type(open_only, name.c_str()));
+                listener_ = listener_segment_->find<listener>("listener").first;
+                if (!listener_)
+                {
+                    listener_segment_.reset();
+                    throw interprocess_exception(not_found_error);
+                }
+            }
+
+            if (!ring_)
+            {
+                shared_memory_object::remove(name_.c_str());
+                segment_.reset(new segment_type(create_only, name_.c_str(),
+                    params_.arena_size_ +
+                        params_.num_slots_ * params_.slot_size_ + 4096));
+
+                slots_ = segment_->construct<char>("slots")
+                    [params_.num_slots_ * params_.slot_size_](0);
+                ring_ = segment_->construct<ring>("ring")
+                    (params_.num_slots_, params_.slot_size_);
+
+                // don't let a single chunk of a message occupy the whole
+                // arena
+                max_chunk_size_ = (std::max)(params_.arena_size_ / 4,
+                    ring_->inline_size());
+            }
+
+            if (!listener_->connect(name_))
+                throw interprocess_exception(busy_error);
+        }
+
+        void verify(naming::locality const & parcel_locality_id)
+        {
+            HPX_ASSERT(parcel_locality_id == there_);
+        }
+
+        naming::locality const& destination() const
+        {
+            return there_;
+        }
+
+        /// Write the parcel buffer to the ring. The data is copied right
+        /// away if the ring (and the arena) has room for it, otherwise the
+        /// operation is finished by one of the threads of the io_service.
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler handler, ParcelPostprocess parcel_postprocess)
+        {
+            /// Increment sends and begin timer.
+            buffer_->data_point_.time_ = timer_.elapsed_nanoseconds();
+            buffer_->data_point_.bytes_ = buffer_->data_.size();
+            written_ = 0;
+
+            void (sender::*f)(boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::write_data<Handler, ParcelPostprocess>;
+            void (sender::*g)(boost::system::error_code const&,
+                    boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::handle_write<Handler, ParcelPostprocess>;
+
+            // completion handlers are never invoked from inside async_write
+            boost::tuple<Handler, ParcelPostprocess> handlers(
+                handler, parcel_postprocess);
+            if (try_write_data())
+            {
+                io_service_.post(boost::bind(g, shared_from_this(),
+                    boost::system::error_code(), handlers));
+            }
+            else
+            {
+                io_service_.post(boost::bind(f, shared_from_this(), handlers));
+            }
+        }
+
+    protected:
+        // Copy as much of the message as possible to the ring, returns true
+        // if all of the data was written.
+        bool try_write_data()
+        {
+            std::vector<char> const& data = buffer_->data_;
+            std::size_t const size = data.size();
+
+            do {
+                slot_header* slot = ring_->try_reserve(slots_);
+                if (0 == slot)
+                    return false;
+
+                std::size_t chunk_size = size - written_;
+                if (chunk_size <= ring_->inline_size())
+                {
+                    // small messages (and the tail of large ones) are
+                    // stored in the slot itself
+                    if (chunk_size != 0)
+                    {
+                        std::memcpy(reinterpret_cast<char*>(slot + 1),
+                            &data[written_], chunk_size);
+                    }
+                    slot->handle_ = slot_header::inline_data;
+                }
+                else
+                {
+                    chunk_size = (std::min)(chunk_size, max_chunk_size_);
+                    void* p = segment_->allocate(chunk_size, std::nothrow);
+                    if (0 == p)
+                        return false;       // the arena is full
+
+                    std::memcpy(p, &data[written_], chunk_size);
+                    slot->handle_ = segment_->get_handle_from_address(p);
+                }
+
+                slot->size_ = chunk_size;
+                slot->data_size_ = buffer_->data_size_;
+                slot->message_size_ = size;
+
+                ring_->commit();
+                listener_->notify();
+
+                written_ += chunk_size;
+
+            } while (written_ != size);
+
+            return true;
+        }
+
+        // Write the remainder of the message, block while the ring or the
+        // arena is full.
+        template <typename Handler, typename ParcelPostprocess>
+        void write_data(boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            boost::system::error_code ec;
+            while (!try_write_data())
+            {
+                if (stopped_.load())
+                {
+                    ec = boost::asio::error::operation_aborted;
+                    break;
+                }
+
+                boost::uint32_t seq = ring_->prepare_wait();
+                if (try_write_data())
+                {
+                    ring_->cancel_wait();
+                    break;
+                }
+                ring_->wait(seq, params_.wait_timeout_);
+            }
+
+            handle_write(ec, handler);
+        }
+
+        /// handle completed write operation
+        template <typename Handler, typename ParcelPostprocess>
+        void handle_write(boost::system::error_code const& e,
+            boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            // just call initial handler
+            boost::get<0>(handler)(e, written_);
+
+            // complete data point and push back onto gatherer
+            performance_counters::parcels::data_point& data =
+                buffer_->data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+            parcels_sent_.add_data(data);
+
+            data.bytes_ = 0;
+            data.time_ = 0;
+            data.serialization_time_ = 0;
+            data.num_parcels_ = 0;
+
+            // Call post-processing handler, which will send remaining pending
+            // parcels. Pass along the connection so it can be reused if more
+            // parcels have to be sent.
+            boost::get<1>(handler)(e, there_, shared_from_this());
+        }
+
+    private:
+        boost::asio::io_service& io_service_;
+
+        /// the other (receiving) end of this connection
+        naming::locality there_;
+
+        ring_parameters const params_;
+        std::string const name_;
+
+        // the segment holding the ring and the arena
+        boost::scoped_ptr<segment_type> segment_;
+        ring* ring_;
+        char* slots_;
+        std::size_t max_chunk_size_;
+
+        // the listener of the receiving locality
+        boost::scoped_ptr<segment_type> listener_segment_;
+        listener* listener_;
+
+        // number of bytes of the current message written so far
+        std::size_t written_;
+
+        boost::atomic<bool> const& stopped_;
+
+        /// Counters and their data containers.
+        util::high_resolution_timer timer_;
+        performance_counters::parcels::gatherer& parcels_sent_;
+    };
+}}}}
+
+#endif
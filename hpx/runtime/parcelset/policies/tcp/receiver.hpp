@@ -12,6 +12,8 @@
 #ifndef HPX_PARCELSET_POLICIES_TCP_RECEIVER_HPP
 #define HPX_PARCELSET_POLICIES_TCP_RECEIVER_HPP
 
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/frame_stream.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
@@ -28,10 +30,12 @@
 #include <boost/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/integer/endian.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 
+#include <cstring>
 #include <sstream>
 #include <vector>
 
@@ -40,12 +44,16 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
     class connection_handler;
 
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<
+            receiver, std::vector<char>, util::shared_chunk_buffer>
     {
     public:
         receiver(boost::asio::io_service& io_service, connection_handler& parcelport)
           : socket_(io_service)
           , max_inbound_size_(hpx::parcelset::get_max_inbound_size(parcelport))
+          , streaming_max_frames_(
+                hpx::parcelset::get_streaming_max_frames(parcelport))
+          , streamed_size_(0)
           , ack_(0)
           , parcelport_(parcelport)
         {}
@@ -126,6 +134,19 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 // Determine the length of the serialized data.
                 boost::uint64_t inbound_size = buffer_->size_;
 
+                if (inbound_size == streamed_message_size)
+                {
+                    // the parcels are de-serialized while the frames of the
+                    // message are received
+                    frames_ = boost::make_shared<util::frame_ring>(
+                        streaming_max_frames_);
+                    streamed_size_ = 0;
+
+                    decode_parcels_streaming(parcelport_, frames_, buffer_);
+                    read_frame_header(handler);
+                    return;
+                }
+
                 if (inbound_size > max_inbound_size_)
                 {
                     // report this problem back to the handler
@@ -136,6 +157,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
                 buffer_->data_point_.bytes_ = static_cast<std::size_t>(inbound_size);
 
+                // make sure the data buffer is large enough (this takes the
+                // buffer from the pool, if possible)
+                get_buffer(parcel(), static_cast<std::size_t>(inbound_size));
+
                 // receive buffers
                 std::vector<boost::asio::mutable_buffer> buffers;
 
@@ -206,7 +231,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 // receive buffers
                 std::vector<boost::asio::mutable_buffer> buffers;
 
-                // add appropriately sized chunk buffers for the zero-copy data
+                // Allocate a separate buffer for each of the zero-copy
+                // chunks. The data is received directly into these buffers
+                // and their ownership is handed over to the deserialized
+                // objects (see serialize_buffer), no data is copied.
                 std::size_t num_zero_copy_chunks =
                     static_cast<std::size_t>(
                         static_cast<boost::uint32_t>(buffer_->num_chunks_.first));
@@ -214,10 +242,15 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 buffer_->chunks_.resize(num_zero_copy_chunks);
                 for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
                 {
-                    std::size_t chunk_size = buffer_->transmission_chunks_[i].second;
-                    buffer_->chunks_[i].resize(chunk_size);
+                    std::size_t chunk_size = static_cast<std::size_t>(
+                        buffer_->transmission_chunks_[i].second);
+
+                    util::shared_chunk_buffer& c = buffer_->chunks_[i];
+                    c.data_.reset(new char[chunk_size]);
+                    c.size_ = chunk_size;
+
                     buffers.push_back(
-                        boost::asio::buffer(buffer_->chunks_[i].data(), chunk_size));
+                        boost::asio::buffer(c.data_.get(), chunk_size));
                 }
 
                 // Start an asynchronous call to receive the data.
@@ -257,8 +290,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                         boost::tuple<Handler>)
                     = &receiver::handle_write_ack<Handler>;
 
-                // decode the received parcels.
+                // decode the received parcels, the buffer is released once
+                // decoding has finished
                 decode_parcels(parcelport_, shared_from_this(), buffer_);
+                buffer_.reset();
 
                 ack_ = true;
                 boost::asio::async_write(socket_,
@@ -268,6 +303,146 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // receiving streamed messages
+        template <typename Handler>
+        void read_frame_header(boost::tuple<Handler> handler)
+        {
+            void (receiver::*f)(boost::system::error_code const&,
+                    boost::tuple<Handler>)
+                = &receiver::handle_read_frame_header<Handler>;
+
+            boost::asio::async_read(socket_,
+                boost::asio::buffer(&frame_header_, sizeof(frame_header_)),
+                boost::bind(f, shared_from_this(),
+                    boost::asio::placeholders::error, handler));
+        }
+
+        template <typename Handler>
+        void handle_read_frame_header(boost::system::error_code const& e,
+            boost::tuple<Handler> handler)
+        {
+            if (e) {
+                abort_stream(e, handler);
+                return;
+            }
+
+            boost::uint64_t size = frame_header_.size_;
+            if (size == 0)
+            {
+                // end of the message, complete the data point before the
+                // de-serialization gets to see the end of the stream
+                performance_counters::parcels::data_point& data =
+                    buffer_->data_point_;
+                data.bytes_ = static_cast<std::size_t>(streamed_size_);
+                data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+
+                frames_->close();
+                frames_.reset();
+                buffer_.reset();
+
+                // now send acknowledgment byte
+                void (receiver::*f)(boost::system::error_code const&,
+                        boost::tuple<Handler>)
+                    = &receiver::handle_write_ack<Handler>;
+
+                ack_ = true;
+                boost::asio::async_write(socket_,
+                    boost::asio::buffer(&ack_, sizeof(ack_)),
+                    boost::bind(f, shared_from_this(),
+                        boost::asio::placeholders::error, handler));
+                return;
+            }
+
+            streamed_size_ += size;
+            if (streamed_size_ > max_inbound_size_)
+            {
+                // report this problem back to the handler
+                abort_stream(boost::asio::error::make_error_code(
+                    boost::asio::error::operation_not_supported), handler);
+                return;
+            }
+
+            // the frame keeps its header, which describes its contents
+            std::size_t frame_size = static_cast<std::size_t>(size);
+            frame_ = get_parcel_buffer_pool().get_buffer(
+                util::frame_header_size + frame_size);
+            frame_.resize(util::frame_header_size + frame_size);
+            std::memcpy(&frame_[0], &frame_header_, util::frame_header_size);
+
+            void (receiver::*f)(boost::system::error_code const&,
+                    boost::tuple<Handler>)
+                = &receiver::handle_read_frame<Handler>;
+
+            boost::asio::async_read(socket_,
+                boost::asio::buffer(&frame_[util::frame_header_size],
+                    frame_size),
+                boost::bind(f, shared_from_this(),
+                    boost::asio::placeholders::error, handler));
+        }
+
+        template <typename Handler>
+        void handle_read_frame(boost::system::error_code const& e,
+            boost::tuple<Handler> handler)
+        {
+            if (e) {
+                abort_stream(e, handler);
+                return;
+            }
+
+            push_frame(handler);
+        }
+
+        // hand the received frame to the de-serialization, reading the next
+        // frame is suspended as long as too many frames are waiting
+        template <typename Handler>
+        void push_frame(boost::tuple<Handler> handler)
+        {
+            void (receiver::*resume)(boost::tuple<Handler>)
+                = &receiver::resume_push_frame<Handler>;
+
+            switch (frames_->try_push(frame_,
+                boost::bind(resume, shared_from_this(), handler)))
+            {
+            case util::frame_ring::succeeded:
+                read_frame_header(handler);
+                break;
+
+            case util::frame_ring::would_block:
+                break;          // resume_push_frame will be called
+
+            case util::frame_ring::stream_aborted:
+            default:
+                // the de-serialization has failed
+                abort_stream(boost::asio::error::make_error_code(
+                    boost::asio::error::operation_aborted), handler);
+                break;
+            }
+        }
+
+        template <typename Handler>
+        void resume_push_frame(boost::tuple<Handler> handler)
+        {
+            void (receiver::*f)(boost::tuple<Handler>)
+                = &receiver::push_frame<Handler>;
+
+            socket_.get_io_service().post(
+                boost::bind(f, shared_from_this(), handler));
+        }
+
+        template <typename Handler>
+        void abort_stream(boost::system::error_code const& e,
+            boost::tuple<Handler> handler)
+        {
+            get_parcel_buffer_pool().reclaim_buffer(frame_);
+
+            frames_->abort();
+            frames_.reset();
+            buffer_.reset();
+
+            boost::get<0>(handler)(e);
+        }
+
         template <typename Handler>
         void handle_write_ack(boost::system::error_code const& e,
             boost::tuple<Handler> handler)
@@ -286,6 +461,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         boost::uint64_t max_inbound_size_;
 
+        /// frames of the message currently being streamed
+        std::size_t streaming_max_frames_;
+        boost::shared_ptr<util::frame_ring> frames_;
+        util::frame_ring::frame_type frame_;
+        util::frame_header frame_header_;
+        boost::uint64_t streamed_size_;
+
         bool ack_;
 
         /// The handler used to process the incoming request.
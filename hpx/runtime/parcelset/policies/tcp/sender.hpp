@@ -13,6 +13,8 @@
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/frame_stream.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 
 #include <boost/asio/buffer.hpp>
@@ -46,8 +48,11 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             performance_counters::parcels::gatherer& parcels_sent)
           : socket_(io_service)
           , ack_(0)
+          , gathered_bytes_(0)
           , there_(locality_id), parcels_sent_(parcels_sent)
         {
+            end_of_stream_.size_ = 0;
+            end_of_stream_.raw_size_ = 0;
         }
 
         ~sender()
@@ -90,27 +95,138 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             // Write the serialized data to the socket. We use "gather-write"
             // to send both the header and the data in a single write operation.
             std::vector<boost::asio::const_buffer> buffers;
+            add_message_buffers(buffers, *buffer_);
+
+            // this additional wrapping of the handler into a bind object is
+            // needed to keep  this parcelport_connection object alive for the whole
+            // write operation
+            void (sender::*f)(boost::system::error_code const&, std::size_t,
+                    boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::handle_write<Handler, ParcelPostprocess>;
+
+            boost::asio::async_write(socket_, buffers,
+                boost::bind(f, shared_from_this(),
+                    boost::asio::placeholders::error, ::_2,
+                    boost::make_tuple(handler, parcel_postprocess)));
+        }
+
+        /// Send several messages using as few gathered write operations as
+        /// possible. Every write is limited to the given number of bytes and
+        /// buffers (but contains at least one message). The acknowledgments
+        /// of all messages are read once all of them have been written.
+        ///
+        /// Returns the number of write operations which will be used.
+        template <typename Handler, typename ParcelPostprocess>
+        std::size_t async_write_gathered(
+            std::vector<boost::shared_ptr<parcel_buffer_type> > && messages,
+            std::size_t max_size, std::size_t max_buffers,
+            Handler handler, ParcelPostprocess parcel_postprocess)
+        {
+            HPX_ASSERT(!messages.empty());
+
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_async_write;
+#endif
+            gathered_ = std::move(messages);
+            gathered_bytes_ = 0;
+
+            // determine the messages sent by each of the write operations
+            write_ends_.clear();
+            std::size_t size = 0, count = 0;
+            for (std::size_t i = 0; i != gathered_.size(); ++i)
+            {
+                std::size_t message_size = get_message_size(*gathered_[i]);
+                std::size_t message_buffers =
+                    get_message_buffer_count(*gathered_[i]);
+
+                if (i != 0 && (size + message_size > max_size ||
+                        count + message_buffers > max_buffers))
+                {
+                    write_ends_.push_back(i);
+                    size = 0;
+                    count = 0;
+                }
+                size += message_size;
+                count += message_buffers;
+            }
+            write_ends_.push_back(gathered_.size());
+
+            // this connection may be reused as soon as the last write has
+            // completed
+            std::size_t writes = write_ends_.size();
+            write_next_messages(0, boost::make_tuple(handler, parcel_postprocess));
+            return writes;
+        }
+
+        /// Send a message which is serialized while it is being sent (see
+        /// encode_parcels_streaming). The frames are written as soon as they
+        /// become available from the given ring, an empty frame header marks
+        /// the end of the message.
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write_streaming(
+            boost::shared_ptr<util::frame_ring> const& frames,
+            Handler handler, ParcelPostprocess parcel_postprocess)
+        {
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_async_write;
+#endif
+            buffer_ = get_buffer();
+            buffer_->clear();
+            buffer_->size_ = streamed_message_size;
+
+            /// Increment sends and begin timer.
+            buffer_->data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            frames_ = frames;
+
+            // the header announces a streamed message
+            std::vector<boost::asio::const_buffer> buffers;
             buffers.push_back(boost::asio::buffer(&buffer_->size_,
                 sizeof(buffer_->size_)));
             buffers.push_back(boost::asio::buffer(&buffer_->data_size_,
                 sizeof(buffer_->data_size_)));
-
-            // add chunk description
             buffers.push_back(boost::asio::buffer(&buffer_->num_chunks_,
                 sizeof(buffer_->num_chunks_)));
 
+            void (sender::*f)(boost::system::error_code const&, std::size_t,
+                    boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::handle_write_frame<Handler, ParcelPostprocess>;
+
+            boost::asio::async_write(socket_, buffers,
+                boost::bind(f, shared_from_this(),
+                    boost::asio::placeholders::error, ::_2,
+                    boost::make_tuple(handler, parcel_postprocess)));
+        }
+
+    private:
+        // The header of each message is followed by the description of the
+        // zero-copy chunks, the data serialized normally and the zero-copy
+        // chunks themselves.
+        static void add_message_buffers(
+            std::vector<boost::asio::const_buffer>& buffers,
+            parcel_buffer_type& buffer)
+        {
+            buffers.push_back(boost::asio::buffer(&buffer.size_,
+                sizeof(buffer.size_)));
+            buffers.push_back(boost::asio::buffer(&buffer.data_size_,
+                sizeof(buffer.data_size_)));
+
+            // add chunk description
+            buffers.push_back(boost::asio::buffer(&buffer.num_chunks_,
+                sizeof(buffer.num_chunks_)));
+
             std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
-                buffer_->transmission_chunks_;
+                buffer.transmission_chunks_;
             if (!chunks.empty()) {
                 buffers.push_back(
                     boost::asio::buffer(chunks.data(), chunks.size() *
                         sizeof(parcel_buffer_type::transmission_chunk_type)));
 
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_->data_));
+                buffers.push_back(boost::asio::buffer(buffer.data_));
 
                 // now add chunks themselves, those hold zero-copy serialized chunks
-                BOOST_FOREACH(util::serialization_chunk& c, buffer_->chunks_)
+                BOOST_FOREACH(util::serialization_chunk& c, buffer.chunks_)
                 {
                     if (c.type_ == util::chunk_type_pointer)
                         buffers.push_back(boost::asio::buffer(c.data_.cpos_, c.size_));
@@ -118,23 +234,234 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             }
             else {
                 // add main buffer holding data which was serialized normally
-                buffers.push_back(boost::asio::buffer(buffer_->data_));
+                buffers.push_back(boost::asio::buffer(buffer.data_));
+            }
+        }
+
+        // number of buffers added by add_message_buffers
+        static std::size_t get_message_buffer_count(
+            parcel_buffer_type const& buffer)
+        {
+            if (buffer.transmission_chunks_.empty())
+                return 4;
+
+            // the first element counts the zero-copy chunks
+            return 5 + static_cast<std::size_t>(buffer.num_chunks_.first);
+        }
+
+        // number of bytes written by add_message_buffers
+        static std::size_t get_message_size(parcel_buffer_type const& buffer)
+        {
+            std::size_t size = sizeof(buffer.size_) +
+                sizeof(buffer.data_size_) + sizeof(buffer.num_chunks_) +
+                buffer.data_.size();
+
+            if (!buffer.transmission_chunks_.empty()) {
+                size += buffer.transmission_chunks_.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type);
+
+                BOOST_FOREACH(util::serialization_chunk const& c, buffer.chunks_)
+                {
+                    if (c.type_ == util::chunk_type_pointer)
+                        size += c.size_;
+                }
+            }
+            return size;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // gathered writes of several messages
+        template <typename Handler, typename ParcelPostprocess>
+        void write_next_messages(std::size_t write,
+            boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            std::size_t begin = write ? write_ends_[write - 1] : 0;
+            std::size_t end = write_ends_[write];
+
+            boost::int64_t now = timer_.elapsed_nanoseconds();
+
+            std::vector<boost::asio::const_buffer> buffers;
+            for (std::size_t i = begin; i != end; ++i)
+            {
+                gathered_[i]->data_point_.time_ = now;
+                add_message_buffers(buffers, *gathered_[i]);
             }
 
-            // this additional wrapping of the handler into a bind object is
-            // needed to keep  this parcelport_connection object alive for the whole
-            // write operation
             void (sender::*f)(boost::system::error_code const&, std::size_t,
-                    boost::tuple<Handler, ParcelPostprocess>)
-                = &sender::handle_write<Handler, ParcelPostprocess>;
+                    std::size_t, boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::handle_write_messages<Handler, ParcelPostprocess>;
 
             boost::asio::async_write(socket_, buffers,
                 boost::bind(f, shared_from_this(),
-                    boost::asio::placeholders::error, ::_2,
-                    boost::make_tuple(handler, parcel_postprocess)));
+                    boost::asio::placeholders::error, ::_2, write, handler));
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void handle_write_messages(boost::system::error_code const& e,
+            std::size_t bytes, std::size_t write,
+            boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_handle_write;
+#endif
+            if (e)
+            {
+                gathered_.clear();
+
+                boost::get<0>(handler)(e, gathered_bytes_ + bytes);
+                boost::get<1>(handler)(e, there_, shared_from_this());
+                return;
+            }
+
+            gathered_bytes_ += bytes;
+
+            // complete data points and push back onto gatherer
+            std::size_t begin = write ? write_ends_[write - 1] : 0;
+            std::size_t end = write_ends_[write];
+
+            boost::int64_t now = timer_.elapsed_nanoseconds();
+            for (std::size_t i = begin; i != end; ++i)
+            {
+                performance_counters::parcels::data_point& data =
+                    gathered_[i]->data_point_;
+                data.time_ = now - data.time_;
+                parcels_sent_.add_data(data);
+            }
+
+            if (++write != write_ends_.size())
+            {
+                write_next_messages(write, handler);
+                return;
+            }
+
+            // all messages have been written
+            boost::get<0>(handler)(e, gathered_bytes_);
+
+            // now handle the acknowledgment bytes sent by the receiver, one
+            // for each of the messages
+#if defined(__linux) || defined(linux) || defined(__linux__)
+            boost::asio::detail::socket_option::boolean<
+                IPPROTO_TCP, TCP_QUICKACK> quickack(true);
+            socket_.set_option(quickack);
+#endif
+            acks_.resize(gathered_.size());
+
+            void (sender::*f)(boost::system::error_code const&,
+                      boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::handle_read_acks<Handler, ParcelPostprocess>;
+
+            boost::asio::async_read(socket_, boost::asio::buffer(acks_),
+                boost::bind(f, shared_from_this(), ::_1, handler));
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void handle_read_acks(boost::system::error_code const& e,
+            boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_handle_read_ack;
+#endif
+            // give the message data back to the pool
+            gathered_.clear();
+
+            boost::get<1>(handler)(e, there_, shared_from_this());
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Handler, typename ParcelPostprocess>
+        void handle_write_frame(boost::system::error_code const& e,
+            std::size_t /*bytes*/, boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            // give the memory of the frame back to the pool
+            get_parcel_buffer_pool().reclaim_buffer(frame_);
+
+            if (e)
+            {
+                // stop the serialization
+                frames_->abort();
+                frames_.reset();
+
+                boost::get<0>(handler)(e, 0);
+                boost::get<1>(handler)(e, there_, shared_from_this());
+                return;
+            }
+
+            write_next_frame(handler);
+        }
+
+        // continue writing frames on the io_service once the next frame is
+        // available
+        template <typename Handler, typename ParcelPostprocess>
+        void resume_write_frames(boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            void (sender::*f)(boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::write_next_frame<Handler, ParcelPostprocess>;
+
+            socket_.get_io_service().post(
+                boost::bind(f, shared_from_this(), handler));
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void write_next_frame(boost::tuple<Handler, ParcelPostprocess> handler)
+        {
+            void (sender::*resume)(boost::tuple<Handler, ParcelPostprocess>)
+                = &sender::resume_write_frames<Handler, ParcelPostprocess>;
+
+            switch (frames_->try_pop(frame_,
+                boost::bind(resume, shared_from_this(), handler)))
+            {
+            case util::frame_ring::succeeded:
+                {
+                    void (sender::*f)(boost::system::error_code const&,
+                            std::size_t, boost::tuple<Handler, ParcelPostprocess>)
+                        = &sender::handle_write_frame<Handler, ParcelPostprocess>;
+
+                    boost::asio::async_write(socket_,
+                        boost::asio::buffer(frame_),
+                        boost::bind(f, shared_from_this(),
+                            boost::asio::placeholders::error, ::_2, handler));
+                }
+                break;
+
+            case util::frame_ring::would_block:
+                break;          // resume_write_frames will be called
+
+            case util::frame_ring::end_of_stream:
+                {
+                    frames_.reset();
+
+                    // terminate the message, the acknowledgment is handled
+                    // as for all other messages
+                    void (sender::*f)(boost::system::error_code const&,
+                            std::size_t, boost::tuple<Handler, ParcelPostprocess>)
+                        = &sender::handle_write<Handler, ParcelPostprocess>;
+
+                    boost::asio::async_write(socket_,
+                        boost::asio::buffer(&end_of_stream_,
+                            sizeof(end_of_stream_)),
+                        boost::bind(f, shared_from_this(),
+                            boost::asio::placeholders::error, ::_2, handler));
+                }
+                break;
+
+            case util::frame_ring::stream_aborted:
+            default:
+                {
+                    // the serialization has failed, the connection can't be
+                    // reused as the message is incomplete
+                    frames_.reset();
+
+                    boost::system::error_code e =
+                        boost::asio::error::make_error_code(
+                            boost::asio::error::operation_aborted);
+
+                    boost::get<0>(handler)(e, 0);
+                    boost::get<1>(handler)(e, there_, shared_from_this());
+                }
+                break;
+            }
         }
 
-    private:
         /// handle completed write operation
         template <typename Handler, typename ParcelPostprocess>
         void handle_write(boost::system::error_code const& e, std::size_t bytes,
@@ -180,6 +507,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
 #endif
+            // give the message data back to the pool
+            buffer_.reset();
+
             // Call post-processing handler, which will send remaining pending
             // parcels. Pass along the connection so it can be reused if more
             // parcels have to be sent.
@@ -191,9 +521,21 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         bool ack_;
 
+        /// messages sent by the current gathered write operations and the
+        /// index of the message following the last one of each write
+        std::vector<boost::shared_ptr<parcel_buffer_type> > gathered_;
+        std::vector<std::size_t> write_ends_;
+        std::size_t gathered_bytes_;
+        std::vector<char> acks_;
+
         /// the other (receiving) end of this connection
         naming::locality there_;
 
+        /// frames of the message currently being streamed
+        boost::shared_ptr<util::frame_ring> frames_;
+        util::frame_ring::frame_type frame_;
+        util::frame_header end_of_stream_;
+
         /// Counters and their data containers.
         util::high_resolution_timer timer_;
         performance_counters::parcels::gatherer& parcels_sent_;
@@ -81,6 +81,107 @@ namespace hpx { namespace threads { namespace detail
             // Create a task description for the new thread.
             scheduler->create_thread(data, initial_state, false, ec, data.num_os_thread);
         }
+        if (ec) return;
+
+        // potentially wake up waiting thread
+        scheduler->do_some_work(data.num_os_thread);
+    }
+
+    // Create the given number of HPX-threads at once. All of them are
+    // expected to share the same initial state, priority and placement.
+    inline void create_work_bulk(policies::scheduler_base* scheduler,
+        thread_init_data* data, std::size_t count,
+        thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws)
+    {
+        // verify parameters
+        switch (initial_state) {
+        case pending:
+        case suspended:
+            break;
+
+        default:
+            {
+                hpx::util::osstream strm;
+                strm << "invalid initial state: "
+                     << get_thread_state_name(initial_state);
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "thread::detail::create_work_bulk",
+                    hpx::util::osstream_get_string(strm));
+                return;
+            }
+        }
+
+        if (0 == count)
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+#if HPX_THREAD_MAINTAIN_DESCRIPTION
+        if (0 == data[0].description)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread::detail::create_work_bulk", "description is NULL");
+            return;
+        }
+#endif
+
+        LTM_(info)
+            << "create_work_bulk: count(" << count
+            << "), initial_state("
+            << get_thread_state_name(initial_state) << "), thread_priority("
+            << get_thread_priority_name(data[0].priority)
+#if HPX_THREAD_MAINTAIN_DESCRIPTION
+            << "), description(" << data[0].description
+#endif
+            << ")";
+
+#if HPX_THREAD_MAINTAIN_PARENT_REFERENCE
+        thread_id_repr_type parent_id = 0;
+        std::size_t parent_phase = 0;
+        thread_self* self = get_self_ptr();
+        if (self)
+        {
+            parent_id = threads::get_self_id().get();
+            parent_phase = self->get_thread_phase();
+        }
+        boost::uint32_t parent_locality_id = get_locality_id();
+#endif
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+#if HPX_THREAD_MAINTAIN_PARENT_REFERENCE
+            if (0 == data[i].parent_id) {
+                data[i].parent_id = parent_id;
+                data[i].parent_phase = parent_phase;
+            }
+            if (0 == data[i].parent_locality_id)
+                data[i].parent_locality_id = parent_locality_id;
+#endif
+            if (0 == data[i].scheduler_base)
+                data[i].scheduler_base = scheduler;
+        }
+
+        // create the new threads
+        if (thread_priority_critical == data[0].priority) {
+            // For critical priority threads, create the threads immediately.
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                scheduler->create_thread(data[i], initial_state, true, ec,
+                    data[i].num_os_thread);
+                if (ec) return;
+            }
+        }
+        else {
+            // Create the task descriptions for all of the new threads at once.
+            scheduler->create_thread_bulk(data, count, initial_state, ec);
+        }
+        if (ec) return;
+
+        // potentially wake up enough waiting threads to run all of them
+        scheduler->do_some_work(data[0].num_os_thread, count);
     }
 }}}
 
@@ -163,16 +163,22 @@ namespace hpx { namespace threads { namespace detail
 #if HPX_THREAD_MAINTAIN_IDLE_RATE
     struct idle_collect_rate
     {
-        idle_collect_rate(boost::uint64_t& tfunc_time, boost::uint64_t& exec_time)
+        idle_collect_rate(boost::uint64_t& tfunc_time, boost::uint64_t& exec_time,
+                boost::uint64_t& park_time)
           : start_timestamp_(util::hardware::timestamp())
           , tfunc_time_(tfunc_time)
           , exec_time_(exec_time)
+          , park_time_(park_time)
         {}
 
         void collect_exec_time(boost::uint64_t timestamp)
         {
             exec_time_ += util::hardware::timestamp() - timestamp;
         }
+        void collect_park_time(boost::uint64_t timestamp)
+        {
+            park_time_ += util::hardware::timestamp() - timestamp;
+        }
         void take_snapshot()
         {
             tfunc_time_ = util::hardware::timestamp() - start_timestamp_;
@@ -182,6 +188,7 @@ namespace hpx { namespace threads { namespace detail
 
         boost::uint64_t& tfunc_time_;
         boost::uint64_t& exec_time_;
+        boost::uint64_t& park_time_;
     };
 
     struct exec_time_wrapper
@@ -199,6 +206,22 @@ namespace hpx { namespace threads { namespace detail
         idle_collect_rate& idle_rate_;
     };
 
+    struct park_time_wrapper
+    {
+        park_time_wrapper(idle_collect_rate& idle_rate)
+          : timestamp_(util::hardware::timestamp())
+          , idle_rate_(idle_rate)
+        {}
+
+        void collect()
+        {
+            idle_rate_.collect_park_time(timestamp_);
+        }
+
+        boost::uint64_t timestamp_;
+        idle_collect_rate& idle_rate_;
+    };
+
     struct tfunc_time_wrapper
     {
         tfunc_time_wrapper(idle_collect_rate& idle_rate)
@@ -215,7 +238,7 @@ namespace hpx { namespace threads { namespace detail
 #else
     struct idle_collect_rate
     {
-        idle_collect_rate(boost::uint64_t&, boost::uint64_t&) {}
+        idle_collect_rate(boost::uint64_t&, boost::uint64_t&, boost::uint64_t&) {}
     };
 
     struct exec_time_wrapper
@@ -223,6 +246,12 @@ namespace hpx { namespace threads { namespace detail
         exec_time_wrapper(idle_collect_rate&) {}
     };
 
+    struct park_time_wrapper
+    {
+        park_time_wrapper(idle_collect_rate&) {}
+        void collect() {}
+    };
+
     struct tfunc_time_wrapper
     {
         tfunc_time_wrapper(idle_collect_rate&) {}
@@ -234,7 +263,7 @@ namespace hpx { namespace threads { namespace detail
     void scheduling_loop(std::size_t num_thread, SchedulingPolicy& scheduler,
         boost::atomic<hpx::state>& global_state, boost::int64_t& executed_threads,
         boost::int64_t& executed_thread_phases, boost::uint64_t& tfunc_time,
-        boost::uint64_t& exec_time,
+        boost::uint64_t& exec_time, boost::uint64_t& park_time,
         util::function_nonser<void()> const& cb = util::function_nonser<void()>())
     {
         util::itt::stack_context ctx;        // helper for itt support
@@ -244,14 +273,19 @@ namespace hpx { namespace threads { namespace detail
 
         boost::int64_t idle_loop_count = 0;
         boost::int64_t busy_loop_count = 0;
+        boost::uint32_t idle_backoff = 0;
 
-        idle_collect_rate idle_rate(tfunc_time, exec_time);
+        idle_collect_rate idle_rate(tfunc_time, exec_time, park_time);
         tfunc_time_wrapper tfunc_time_collector(idle_rate);
 
         typedef typename SchedulingPolicy::has_periodic_maintenance pred;
         detail::start_periodic_maintenance(scheduler, global_state, pred());
 
         while (true) {
+            // Fire all expired timers, this makes the threads woken up by
+            // them eligible for being picked up below
+            scheduler.SchedulingPolicy::poll_timers();
+
             // Get the next HPX thread from the queue
             thread_data_base* thrd = NULL;
             if (scheduler.SchedulingPolicy::get_next_thread(num_thread,
@@ -260,6 +294,7 @@ namespace hpx { namespace threads { namespace detail
                 tfunc_time_wrapper tfunc_time_collector(idle_rate);
 
                 idle_loop_count = 0;
+                idle_backoff = 0;
                 ++busy_loop_count;
 
                 // Only pending HPX threads will be executed.
@@ -385,6 +420,15 @@ namespace hpx { namespace threads { namespace detail
                     // do background work in parcel layer
                     hpx::parcelset::do_background_work();
                 }
+
+                // back off or park this OS thread, depending on the idle
+                // policy of the scheduler
+                park_time_wrapper park_time_collector(idle_rate);
+                if (scheduler.SchedulingPolicy::idle_wait(num_thread,
+                        idle_loop_count, idle_backoff))
+                {
+                    park_time_collector.collect();
+                }
             }
 
             if (busy_loop_count > HPX_BUSY_LOOP_COUNT_MAX)
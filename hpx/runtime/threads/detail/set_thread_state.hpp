@@ -16,7 +16,8 @@
 #include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/coroutine/coroutine.hpp>
 
-#include <boost/asio/deadline_timer.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 namespace hpx { namespace threads { namespace detail
 {
@@ -240,98 +241,41 @@ namespace hpx { namespace threads { namespace detail
         error_code& ec = throws);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// This thread function is used by the at_timer thread below to trigger
-    /// the required action.
-    inline thread_state_enum wake_timer_thread(
-        thread_id_type const& thrd, thread_state_enum newstate,
-        thread_state_ex_enum newstate_ex, thread_priority priority,
-        thread_id_type const& timer_id,
-        boost::shared_ptr<boost::atomic<bool> > const& triggered)
+    /// This function is invoked by the timer wheel of the scheduler once a
+    /// timer set by one of the set_thread_state_timed functions below has
+    /// expired. It is invoked from inside the scheduling loop and must not
+    /// throw.
+    inline void wake_timer(thread_id_type const& thrd,
+        thread_state_enum newstate, thread_state_ex_enum newstate_ex,
+        thread_priority priority)
     {
-        if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "NULL thread id encountered (id)");
-            return terminated;
-        }
-        if (HPX_UNLIKELY(!timer_id)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "NULL thread id encountered (timer_id)");
-            return terminated;
-        }
-
-        bool oldvalue = false;
-        if (triggered->compare_exchange_strong(oldvalue, true)) //-V601
-        {
-            // timer has not been canceled yet, trigger the requested set_state
-            detail::set_thread_state(thrd, newstate, newstate_ex, priority);
-        }
-
-        // then re-activate the thread holding the deadline_timer
-        // REVIEW: Why do we ignore errors here?
         error_code ec(lightweight);    // do not throw
-        detail::set_thread_state(timer_id, pending, wait_timeout,
-            thread_priority_normal, std::size_t(-1), ec);
-        return terminated;
+        detail::set_thread_state(thrd, newstate, newstate_ex, priority,
+            std::size_t(-1), ec);
     }
 
-    /// This thread function initiates the required set_state action (on
-    /// behalf of one of the threads#detail#set_thread_state functions).
-    template <typename SchedulingPolicy, typename TimeType>
-    thread_state_enum at_timer(SchedulingPolicy& scheduler,
-        TimeType const& expire, thread_id_type const& thrd, thread_state_enum newstate,
+    /// Add a timer to the timer wheel of the given scheduler which will set
+    /// the state of the given \a thread to the given new value once the
+    /// given amount of nanoseconds has passed.
+    template <typename SchedulingPolicy>
+    void add_timer(SchedulingPolicy& scheduler, boost::int64_t delay,
+        thread_id_type const& thrd, thread_state_enum newstate,
         thread_state_ex_enum newstate_ex, thread_priority priority)
     {
-        if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::at_timer",
-                "NULL thread id encountered");
-            return terminated;
-        }
-
-        // create a new thread in suspended state, which will execute the
-        // requested set_state when timer fires and will re-awaken this thread,
-        // allowing the deadline_timer to go out of scope gracefully
-        thread_id_type self_id = get_self_id();
-
-        boost::shared_ptr<boost::atomic<bool> > triggered(
-            boost::make_shared<boost::atomic<bool> >(false));
-
-        thread_init_data data(
-            boost::bind(&wake_timer_thread,
-                thrd, newstate, newstate_ex, priority,
-                self_id, triggered),
-            "wake_timer", 0, priority);
-        thread_id_type wake_id = create_thread(&scheduler, data, suspended, true);
-
-        // create timer firing in correspondence with given time
-        boost::asio::deadline_timer t (
-            get_thread_pool("timer-pool")->get_io_service(), expire);
-
-        // let the timer invoke the set_state on the new (suspended) thread
-        t.async_wait(boost::bind(&detail::set_thread_state,
-            wake_id, pending, wait_timeout, priority,
-            std::size_t(-1), boost::ref(throws)));
-
-        // this waits for the thread to be reactivated when the timer fired
-        // if it returns signaled the timer has been canceled, otherwise
-        // the timer fired and the wake_timer_thread above has been executed
-        bool oldvalue = false;
-        thread_state_ex_enum statex = get_self().yield(suspended);
-
-        if (wait_timeout != statex &&
-            triggered->compare_exchange_strong(oldvalue, true)) //-V601
-        {
-            // wake_timer_thread has not been executed yet, cancel timer
-            t.cancel();
-        }
+        scheduler.get_timer_wheel().add_after(
+            delay > 0 ? boost::uint64_t(delay) : 0,
+            boost::bind(&wake_timer, thrd, newstate, newstate_ex, priority));
 
-        return terminated;
+        // make sure an idling worker thread recalculates its sleep period
+        scheduler.do_some_work(std::size_t(-1));
     }
 
     /// Set a timer to set the state of the given \a thread to the given
     /// new value after it expired (at the given time)
+    ///
+    /// The timer is handled by the timer wheel of the scheduler, no thread
+    /// is created for it. For this reason the returned thread id is always
+    /// invalid.
     template <typename SchedulingPolicy>
     thread_id_type set_thread_state_timed(SchedulingPolicy& scheduler,
         boost::posix_time::ptime const& expire_at, thread_id_type const& thrd,
@@ -345,16 +289,15 @@ namespace hpx { namespace threads { namespace detail
             return 0;
         }
 
-        // this creates a new thread which creates the timer and handles the
-        // requested actions
-        typedef boost::posix_time::ptime time_type;
-        thread_init_data data(
-            boost::bind(&at_timer<SchedulingPolicy, time_type>,
-                boost::ref(scheduler), expire_at, thrd, newstate, newstate_ex,
-                priority),
-            "at_timer (expire at)", 0, priority, thread_num);
+        boost::posix_time::time_duration from_now =
+            expire_at - boost::posix_time::microsec_clock::universal_time();
+        add_timer(scheduler, from_now.total_nanoseconds(), thrd, newstate,
+            newstate_ex, priority);
+
+        if (&ec != &throws)
+            ec = make_success_code();
 
-        return create_thread(&scheduler, data, pending, true, ec);
+        return thread_id_type();
     }
 
     template <typename SchedulingPolicy>
@@ -368,6 +311,10 @@ namespace hpx { namespace threads { namespace detail
 
     /// Set a timer to set the state of the given \a thread to the given
     /// new value after it expired (after the given duration)
+    ///
+    /// The timer is handled by the timer wheel of the scheduler, no thread
+    /// is created for it. For this reason the returned thread id is always
+    /// invalid.
     template <typename SchedulingPolicy>
     thread_id_type set_thread_state_timed(SchedulingPolicy& scheduler,
         boost::posix_time::time_duration const& from_now, thread_id_type const& thrd,
@@ -381,16 +328,13 @@ namespace hpx { namespace threads { namespace detail
             return 0;
         }
 
-        // this creates a new thread which creates the timer and handles the
-        // requested actions
-        typedef boost::posix_time::time_duration time_type;
-        thread_init_data data(
-            boost::bind(&at_timer<SchedulingPolicy, time_type>,
-                boost::ref(scheduler), from_now, thrd, newstate, newstate_ex,
-                priority),
-            "at_timer (from now)", 0, priority, thread_num);
+        add_timer(scheduler, from_now.total_nanoseconds(), thrd, newstate,
+            newstate_ex, priority);
+
+        if (&ec != &throws)
+            ec = make_success_code();
 
-        return create_thread(&scheduler, data, pending, true, ec);
+        return thread_id_type();
     }
 
     template <typename SchedulingPolicy>
@@ -0,0 +1,456 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_JAN_21_2014_1018AM)
+#define HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_JAN_21_2014_1018AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Hierarchical timer wheel (see "Hashed and Hierarchical Timing Wheels"
+    // by G. Varghese and T. Lauck), laid out like the one of the Linux
+    // kernel: the first level has 256 slots of one tick each, the four
+    // further levels have 64 slots each spanning all slots of the level
+    // below. Timers are kept in intrusive doubly linked lists, which makes
+    // adding and canceling a timer O(1). Whenever the first level wraps
+    // around the due slot of the next level is redistributed to the levels
+    // below (cascading).
+    //
+    // The wheel does not own a thread, it has to be driven by calling poll()
+    // regularly (the scheduling loop does this). Expired timers are invoked
+    // from inside poll(), never earlier than requested, but possibly up to
+    // one tick (plus the polling delay) later.
+    class timer_wheel : boost::noncopyable
+    {
+    private:
+        enum {
+            level0_bits = 8,
+            level_bits = 6,
+            level0_size = 1 << level0_bits,     // 256 slots
+            level_size = 1 << level_bits,       // 64 slots
+            num_levels = 4                      // number of levels above 0
+        };
+
+        struct list_node
+        {
+            list_node() : prev_(this), next_(this) {}
+
+            bool empty() const { return next_ == this; }
+
+            void link_before(list_node* pos)
+            {
+                next_ = pos;
+                prev_ = pos->prev_;
+                prev_->next_ = this;
+                pos->prev_ = this;
+            }
+
+            void unlink()
+            {
+                prev_->next_ = next_;
+                next_->prev_ = prev_;
+                prev_ = next_ = this;
+            }
+
+            list_node* prev_;
+            list_node* next_;
+        };
+
+    public:
+        typedef util::function_nonser<void()> callback_type;
+
+        class timer : private list_node, boost::noncopyable
+        {
+        public:
+            timer(boost::uint64_t expire, callback_type const& f)
+              : expire_(expire), f_(f), linked_(false), count_(0)
+            {}
+
+        private:
+            friend class timer_wheel;
+
+            friend void intrusive_ptr_add_ref(timer* t)
+            {
+                ++t->count_;
+            }
+
+            friend void intrusive_ptr_release(timer* t)
+            {
+                if (0 == --t->count_)
+                    delete t;
+            }
+
+            boost::uint64_t expire_;            // in ticks
+            callback_type f_;
+            bool linked_;                       // protected by wheel mutex
+            boost::atomic<long> count_;
+        };
+        typedef boost::intrusive_ptr<timer> timer_id;
+
+        // resolution is the length of one tick in nanoseconds
+        explicit timer_wheel(boost::uint64_t resolution = 100000)
+          : tick_(resolution ? resolution : 1),
+            start_(util::high_resolution_clock::now()),
+            current_(0),
+            next_due_(start_),
+            count_(0)
+        {
+            for (std::size_t i = 0; i != sizeof(occupied_)/sizeof(occupied_[0]); ++i)
+                occupied_[i] = 0;
+        }
+
+        ~timer_wheel()
+        {
+            clear();
+        }
+
+        boost::uint64_t resolution() const
+        {
+            return tick_;
+        }
+
+        // Add a timer which invokes the given function at the given point in
+        // time (as returned by util::high_resolution_clock::now()).
+        timer_id add(boost::uint64_t expire_at, callback_type const& f)
+        {
+            // never fire early, round up to the next tick
+            boost::uint64_t expire = 0;
+            if (expire_at > start_)
+                expire = (expire_at - start_ + tick_ - 1) / tick_;
+
+            timer_id t(new timer(expire, f));
+
+            boost::mutex::scoped_lock l(mtx_);
+            if (count_.load(boost::memory_order_relaxed) == 0)
+            {
+                // the wheel might not have been polled for a while, there is
+                // no need to catch up on the ticks missed
+                boost::uint64_t now = util::high_resolution_clock::now();
+                boost::uint64_t current = (now - start_) / tick_;
+                if (current > current_)
+                {
+                    current_ = current;
+                    next_due_.store(start_ + current_ * tick_,
+                        boost::memory_order_relaxed);
+                }
+            }
+
+            intrusive_ptr_add_ref(t.get());     // reference held by the wheel
+            add_locked(t.get());
+            ++count_;
+            return t;
+        }
+
+        timer_id add_after(boost::uint64_t delay, callback_type const& f)
+        {
+            return add(util::high_resolution_clock::now() + delay, f);
+        }
+
+        // Cancel the given timer, returns false if the timer has already
+        // fired (or is firing) or was canceled before.
+        bool cancel(timer_id const& t)
+        {
+            boost::mutex::scoped_lock l(mtx_);
+            if (!t || !t->linked_)
+                return false;
+
+            t->unlink();
+            t->linked_ = false;
+            --count_;
+
+            l.unlock();
+            intrusive_ptr_release(t.get());     // reference held by the wheel
+            return true;
+        }
+
+        // Invoke all timers which have expired, returns the number of invoked
+        // timers. Concurrent calls return immediately. This is called on every
+        // iteration of the scheduling loops, the clock is read only if any
+        // timer is pending.
+        std::size_t poll()
+        {
+            if (count_.load(boost::memory_order_relaxed) == 0)
+                return 0;
+            return poll(util::high_resolution_clock::now());
+        }
+
+        std::size_t poll(boost::uint64_t now)
+        {
+            if (count_.load(boost::memory_order_relaxed) == 0 ||
+                now < next_due_.load(boost::memory_order_relaxed))
+            {
+                return 0;
+            }
+
+            list_node expired;
+            {
+                boost::mutex::scoped_lock l(mtx_, boost::try_to_lock);
+                if (!l.owns_lock())
+                    return 0;
+
+                boost::uint64_t const current = (now - start_) / tick_;
+                while (current_ <= current)
+                {
+                    process_tick(expired);
+                    if (count_.load(boost::memory_order_relaxed) == 0)
+                    {
+                        current_ = current + 1;
+                        break;
+                    }
+                }
+                next_due_.store(start_ + current_ * tick_,
+                    boost::memory_order_relaxed);
+            }
+
+            // invoke the expired timers without holding the lock
+            std::size_t fired = 0;
+            while (!expired.empty())
+            {
+                timer* t = static_cast<timer*>(expired.next_);
+                t->unlink();
+
+                t->f_();
+                ++fired;
+
+                intrusive_ptr_release(t);       // reference held by the wheel
+            }
+            return fired;
+        }
+
+        // Return the time (in nanoseconds) until the next call to poll() may
+        // invoke a timer, returns boost::uint64_t(-1) if no timer is pending.
+        boost::uint64_t next_timeout(
+            boost::uint64_t now = util::high_resolution_clock::now()) const
+        {
+            if (count_.load(boost::memory_order_relaxed) == 0)
+                return boost::uint64_t(-1);
+
+            boost::mutex::scoped_lock l(mtx_, boost::try_to_lock);
+            if (!l.owns_lock())
+                return tick_;           // somebody is busy with the wheel
+
+            // look for the next occupied slot of the first level, otherwise
+            // the next cascade is due when the first level wraps around
+            boost::uint64_t due = (current_ | (level0_size - 1)) + 1;
+            for (boost::uint64_t tick = current_; tick != due; ++tick)
+            {
+                std::size_t index = std::size_t(tick & (level0_size - 1));
+                if (occupied_[index / 64] & (boost::uint64_t(1) << (index % 64)))
+                {
+                    due = tick;
+                    break;
+                }
+            }
+
+            boost::uint64_t due_time = start_ + due * tick_;
+            return due_time > now ? due_time - now : 0;
+        }
+
+        // Drop all pending timers without invoking them, returns the number
+        // of dropped timers.
+        std::size_t clear()
+        {
+            list_node dropped;
+            std::size_t count = 0;
+            {
+                boost::mutex::scoped_lock l(mtx_);
+
+                for (std::size_t i = 0; i != level0_size; ++i)
+                    count += move_all(level0_[i], dropped);
+
+                for (std::size_t l = 0; l != num_levels; ++l)
+                {
+                    for (std::size_t i = 0; i != level_size; ++i)
+                        count += move_all(levels_[l][i], dropped);
+                }
+
+                for (std::size_t i = 0; i != sizeof(occupied_)/sizeof(occupied_[0]); ++i)
+                    occupied_[i] = 0;
+                count_.store(0);
+            }
+
+            // release the timers without holding the lock
+            while (!dropped.empty())
+            {
+                timer* t = static_cast<timer*>(dropped.next_);
+                t->unlink();
+                intrusive_ptr_release(t);       // reference held by the wheel
+            }
+            return count;
+        }
+
+        // Return the number of pending timers.
+        std::size_t size() const
+        {
+            return std::size_t(count_.load(boost::memory_order_relaxed));
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+    private:
+        void add_locked(timer* t)
+        {
+            boost::uint64_t expire = t->expire_;
+            boost::uint64_t const delta = expire - current_;
+            list_node* slot = 0;
+
+            if (expire < current_)
+            {
+                // already expired, fire on the next tick
+                slot = level0_slot(current_);
+            }
+            else if (delta < level0_size)
+            {
+                slot = level0_slot(expire);
+            }
+            else if (delta < (boost::uint64_t(1) << (level0_bits + level_bits)))
+            {
+                slot = &levels_[0][(expire >> level0_bits) & (level_size - 1)];
+            }
+            else if (delta < (boost::uint64_t(1) << (level0_bits + 2*level_bits)))
+            {
+                slot = &levels_[1][
+                    (expire >> (level0_bits + level_bits)) & (level_size - 1)];
+            }
+            else if (delta < (boost::uint64_t(1) << (level0_bits + 3*level_bits)))
+            {
+                slot = &levels_[2][
+                    (expire >> (level0_bits + 2*level_bits)) & (level_size - 1)];
+            }
+            else
+            {
+                // timers beyond the range of the wheel are put into the last
+                // slot, they will be re-added whenever it gets cascaded
+                boost::uint64_t const max_delta =
+                    (boost::uint64_t(1) << (level0_bits + 4*level_bits)) - 1;
+                if (delta > max_delta)
+                    expire = current_ + max_delta;
+                slot = &levels_[3][
+                    (expire >> (level0_bits + 3*level_bits)) & (level_size - 1)];
+            }
+
+            t->link_before(slot);
+            t->linked_ = true;
+        }
+
+        list_node* level0_slot(boost::uint64_t tick)
+        {
+            std::size_t index = std::size_t(tick & (level0_size - 1));
+            occupied_[index / 64] |= boost::uint64_t(1) << (index % 64);
+            return &level0_[index];
+        }
+
+        // re-add all timers of the given slot, returns the slot index
+        std::size_t cascade(std::size_t level, std::size_t index)
+        {
+            list_node& slot = levels_[level][index];
+
+            list_node pending;
+            splice(slot, pending);
+            while (!pending.empty())
+            {
+                timer* t = static_cast<timer*>(pending.next_);
+                t->unlink();
+                add_locked(t);
+            }
+            return index;
+        }
+
+        // move all expired timers of the current tick to 'expired'
+        void process_tick(list_node& expired)
+        {
+            std::size_t const index = std::size_t(current_ & (level0_size - 1));
+            if (index == 0)
+            {
+                std::size_t const mask = level_size - 1;
+                if (cascade(0, (current_ >> level0_bits) & mask) == 0 &&
+                    cascade(1, (current_ >> (level0_bits + level_bits)) & mask) == 0 &&
+                    cascade(2, (current_ >> (level0_bits + 2*level_bits)) & mask) == 0)
+                {
+                    cascade(3, (current_ >> (level0_bits + 3*level_bits)) & mask);
+                }
+            }
+
+            list_node pending;
+            splice(level0_[index], pending);
+            occupied_[index / 64] &= ~(boost::uint64_t(1) << (index % 64));
+
+            while (!pending.empty())
+            {
+                timer* t = static_cast<timer*>(pending.next_);
+                t->unlink();
+                if (t->expire_ > current_)
+                {
+                    add_locked(t);      // not due yet (was beyond range)
+                    continue;
+                }
+
+                t->linked_ = false;
+                --count_;
+                t->link_before(&expired);
+            }
+
+            ++current_;
+        }
+
+        // move all entries of list 'from' to the (empty) list 'to'
+        static void splice(list_node& from, list_node& to)
+        {
+            if (from.empty())
+                return;
+
+            to.next_ = from.next_;
+            to.prev_ = from.prev_;
+            to.next_->prev_ = &to;
+            to.prev_->next_ = &to;
+            from.prev_ = from.next_ = &from;
+        }
+
+        // move all entries of list 'from' to the end of list 'to' while
+        // marking them as not being linked into the wheel anymore
+        static std::size_t move_all(list_node& from, list_node& to)
+        {
+            std::size_t count = 0;
+            while (!from.empty())
+            {
+                timer* t = static_cast<timer*>(from.next_);
+                t->unlink();
+                t->linked_ = false;
+                t->link_before(&to);
+                ++count;
+            }
+            return count;
+        }
+
+        boost::uint64_t const tick_;            // length of one tick [ns]
+        boost::uint64_t const start_;           // time of tick zero [ns]
+        boost::uint64_t current_;               // next tick to process
+        boost::atomic<boost::uint64_t> next_due_;   // time tick current_ is due
+        boost::atomic<boost::int64_t> count_;   // number of pending timers
+
+        list_node level0_[level0_size];
+        list_node levels_[num_levels][level_size];
+        boost::uint64_t occupied_[level0_size / 64];    // non-empty level0 slots
+
+        mutable boost::mutex mtx_;
+    };
+}}}
+
+#endif
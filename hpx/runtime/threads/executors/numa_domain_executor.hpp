@@ -0,0 +1,75 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_EXECUTORS_NUMA_DOMAIN_EXECUTOR_OCT_17_2014_0345PM)
+#define HPX_RUNTIME_THREADS_EXECUTORS_NUMA_DOMAIN_EXECUTOR_OCT_17_2014_0345PM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/threads/thread_executor.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/intrusive_ptr.hpp>
+
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace threads { namespace executors
+{
+    namespace detail
+    {
+        class HPX_EXPORT numa_domain_executor
+          : public threads::detail::executor_base
+        {
+        public:
+            explicit numa_domain_executor(std::size_t domain);
+
+            // Schedule the specified function for execution in this executor.
+            // Depending on the subclass implementation, this may block in some
+            // situations.
+            void add(HPX_STD_FUNCTION<void()> && f, char const* description,
+                threads::thread_state_enum initial_state, bool run_now,
+                threads::thread_stacksize stacksize, error_code& ec);
+
+            // Return an estimate of the number of waiting tasks.
+            std::size_t num_pending_closures(error_code& ec) const;
+
+        protected:
+            static void thread_function_nullary(
+                boost::intrusive_ptr<numa_domain_executor> const& exec,
+                HPX_STD_FUNCTION<void()> const& func);
+
+        private:
+            // the worker threads bound to the NUMA domain
+            std::vector<std::size_t> workers_;
+            boost::atomic<std::size_t> current_;
+
+            // closures submitted through this executor
+            boost::atomic<std::size_t> tasks_scheduled_;
+            boost::atomic<std::size_t> tasks_completed_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The numa_domain_executor places all HPX-threads scheduled through it
+    /// onto the worker threads bound to processing units of the given NUMA
+    /// domain (in a round robin fashion). This allows to keep work close to
+    /// the memory it operates on, for instance:
+    ///
+    ///     hpx::async(numa_domain_executor(1), f);
+    ///
+    /// If no worker thread is bound to the given NUMA domain the HPX-threads
+    /// are scheduled as if the default_executor was used.
+    struct numa_domain_executor : public executor
+    {
+        explicit numa_domain_executor(std::size_t domain)
+          : executor(new detail::numa_domain_executor(domain))
+        {}
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
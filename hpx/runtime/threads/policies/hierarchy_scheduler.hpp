@@ -111,7 +111,7 @@ namespace hpx { namespace threads { namespace policies
                 tree.push_back(
                     level_type(
                         1
-                      , new thread_queue_type(max_queue_thread_count)
+                      , new thread_queue_type(std::size_t(-1), max_queue_thread_count)
                     )
                 );
                 work_flag_tree.push_back(
@@ -134,7 +134,8 @@ namespace hpx { namespace threads { namespace policies
             task_flag_tree.push_back(level_flag_type(n));
             for(size_type i = 0; i < n; ++i)
             {
-                level.at(i) = new thread_queue_type(max_queue_thread_count);
+                level.at(i) = new thread_queue_type(
+                    std::size_t(-1), max_queue_thread_count);
                 work_flag_tree.back()[i] = false;
                 task_flag_tree.back()[i] = false;
             }
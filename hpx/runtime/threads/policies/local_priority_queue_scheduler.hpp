@@ -105,7 +105,7 @@ namespace hpx { namespace threads { namespace policies
             max_queue_thread_count_(init.max_queue_thread_count_),
             queues_(init.num_queues_),
             high_priority_queues_(init.num_high_priority_queues_),
-            low_priority_queue_(init.max_queue_thread_count_),
+            low_priority_queue_(std::size_t(-1), init.max_queue_thread_count_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_),
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
@@ -362,6 +362,42 @@ namespace hpx { namespace threads { namespace policies
                 run_now, ec);
         }
 
+        // Register the task descriptions for a number of HPX-threads at once.
+        // The tasks are distributed over the queues in contiguous chunks,
+        // each of the chunks is published to its queue at once.
+        void create_thread_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            if (0 == count)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            // all tasks are registered with the same priority and placement
+            if (data[0].priority == thread_priority_critical ||
+                data[0].priority == thread_priority_low ||
+                data[0].num_os_thread != std::size_t(-1))
+            {
+                scheduler_base::create_thread_bulk(data, count, initial_state,
+                    ec);
+                return;
+            }
+
+            std::size_t queue_size = queues_.size();
+            std::size_t chunk_size = (count + queue_size - 1) / queue_size;
+            std::size_t num_thread = ++curr_queue_;
+
+            for (std::size_t offset = 0; offset < count; offset += chunk_size)
+            {
+                std::size_t size = (std::min)(chunk_size, count - offset);
+                queues_[num_thread++ % queue_size]->create_thread_bulk(
+                    data + offset, size, initial_state, ec);
+                if (ec) return;
+            }
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread, bool running,
@@ -933,11 +969,11 @@ namespace hpx { namespace threads { namespace policies
         void on_start_thread(std::size_t num_thread)
         {
             queues_[num_thread] =
-                new thread_queue_type(max_queue_thread_count_);
+                new thread_queue_type(num_thread, max_queue_thread_count_);
 
             if (num_thread < high_priority_queues_.size())
                 high_priority_queues_[num_thread] =
-                    new thread_queue_type(max_queue_thread_count_);
+                    new thread_queue_type(num_thread, max_queue_thread_count_);
 
             // forward this call to all queues etc.
             if (num_thread < high_priority_queues_.size())
@@ -637,7 +637,7 @@ namespace hpx { namespace threads { namespace policies
         void on_start_thread(std::size_t num_thread)
         {
             queues_[num_thread] =
-                new thread_queue_type(max_queue_thread_count_);
+                new thread_queue_type(num_thread, max_queue_thread_count_);
 
             queues_[num_thread]->on_start_thread(num_thread);
 
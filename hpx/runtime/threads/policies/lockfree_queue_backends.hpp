@@ -9,11 +9,13 @@
 #define HPX_FB3518C8_4493_450E_A823_A9F8A3185B2D
 
 #include <hpx/config.hpp>
+#include <hpx/hpx_fwd.hpp>
 
 #include <boost/cstdint.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/stack.hpp>
 #include <hpx/util/lockfree/deque.hpp>
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 
 namespace hpx { namespace threads { namespace policies
 {
@@ -22,6 +24,7 @@ struct lockfree_fifo;
 struct lockfree_lifo;
 struct lockfree_abp_fifo;
 struct lockfree_abp_lifo;
+struct lockfree_chase_lev;
 
 template <typename T, typename Queuing>
 struct basic_lockfree_queue_backend
@@ -174,6 +177,81 @@ struct lockfree_abp_lifo
     };
 };
 
+// LIFO for the owning worker thread + FIFO stealing at the opposite end,
+// based on a Chase-Lev work-stealing deque.
+//
+// Only the worker thread the queue belongs to (as identified by num_thread)
+// may operate on the bottom of the deque, it does so without any CAS. Other
+// threads steal from the top of the deque. Items pushed by any thread other
+// than the owner (e.g. when a thread is re-scheduled by some other worker, or
+// for queues which have no owner at all) are put into a separate MPMC inbox
+// which is drained by everybody.
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef boost::lockfree::queue<T> inbox_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef boost::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0 
+      , size_type num_thread = size_type(-1)
+        )
+      : queue_(initial_size)
+      , inbox_(initial_size)
+      , num_thread_(num_thread)
+    {}
+
+    bool push(const_reference val)
+    {
+        if (is_owner())
+            return queue_.push_bottom(val);
+        return inbox_.push(val);
+    }
+ 
+    bool pop(reference val, bool steal = true)
+    {
+        if (is_owner())
+        {
+            if (queue_.pop_bottom(val))
+                return true;
+        }
+        else if (queue_.steal_top(val))
+        {
+            return true;
+        }
+        return inbox_.pop(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && inbox_.empty();
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return num_thread_ != size_type(-1) &&
+            num_thread_ == hpx::get_worker_thread_num();
+    }
+
+    container_type queue_;
+    inbox_type inbox_;
+    size_type const num_thread_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type; 
+    };
+};
+
 }}}
 
 #endif // HPX_FB3518C8_4493_450E_A823_A9F8A3185B2D
@@ -0,0 +1,845 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SCHEDULING_NUMA_HIERARCHY_OCT_17_2014_1120AM)
+#define HPX_THREADMANAGER_SCHEDULING_NUMA_HIERARCHY_OCT_17_2014_1120AM
+
+#include <vector>
+#include <map>
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/runtime/threads/policies/thread_queue.hpp>
+#include <hpx/runtime/threads/policies/affinity_data.hpp>
+#include <hpx/runtime/threads/policies/scheduler_base.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+#if HPX_THREAD_MINIMAL_DEADLOCK_DETECTION
+    ///////////////////////////////////////////////////////////////////////////
+    // We globally control whether to do minimal deadlock detection using this
+    // global bool variable. It will be set once by the runtime configuration
+    // startup code
+    extern bool minimal_deadlock_detection;
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The numa_hierarchy_scheduler maintains two tiers of queues: one queue
+    /// per OS thread (core) and, above those, one queue shared by all OS
+    /// threads bound to processing units of the same NUMA domain.
+    ///
+    /// HPX-threads created by a worker thread are placed into the queue of
+    /// this worker thread (unless another OS thread is explicitly requested).
+    /// HPX-threads created from outside of the thread manager are placed into
+    /// the shared queues of the NUMA domains in a round robin fashion, or,
+    /// if the address of the target object is known, into the shared queue
+    /// of the NUMA domain owning that memory.
+    ///
+    /// Idle worker threads look for work in their own queue first, then in
+    /// the shared queue of their NUMA domain, then in the queues of the other
+    /// cores of their NUMA domain, and only after that in the queues of the
+    /// other NUMA domains.
+    ///
+    /// This scheduler does not distinguish between thread priorities.
+    template <typename Mutex
+            , typename PendingQueuing
+            , typename StagedQueuing
+            , typename TerminatedQueuing
+             >
+    class numa_hierarchy_scheduler : public scheduler_base
+    {
+    protected:
+        // The maximum number of active threads this thread manager should
+        // create. This number will be a constraint only as long as the work
+        // items queue is not empty. Otherwise the number of active threads
+        // will be incremented in steps equal to the \a min_add_new_count
+        // specified above.
+        // FIXME: this is specified both here, and in thread_queue.
+        enum { max_thread_count = 1000 };
+
+        // per worker thread counts of HPX-threads taken from each steal tier
+        struct steal_counters
+        {
+            steal_counters()
+            {
+                for (std::size_t i = 0; i != num_tiers; ++i)
+                    counts_[i] = 0;
+            }
+
+            enum { num_tiers = 3 };
+            boost::atomic<boost::int64_t> counts_[num_tiers];
+        };
+
+    public:
+        typedef boost::mpl::false_ has_periodic_maintenance;
+
+        typedef thread_queue<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        > thread_queue_type;
+
+        // the scheduler type takes two initialization parameters:
+        //    the number of queues
+        //    the maxcount per queue
+        struct init_parameter
+        {
+            init_parameter()
+              : num_queues_(1),
+                max_queue_thread_count_(max_thread_count)
+            {}
+
+            init_parameter(std::size_t num_queues,
+                    std::size_t max_queue_thread_count = max_thread_count)
+              : num_queues_(num_queues),
+                max_queue_thread_count_(max_queue_thread_count)
+            {}
+
+            std::size_t num_queues_;
+            std::size_t max_queue_thread_count_;
+        };
+        typedef init_parameter init_parameter_type;
+
+        numa_hierarchy_scheduler(init_parameter_type const& init)
+          : scheduler_base(init.num_queues_),
+            max_queue_thread_count_(init.max_queue_thread_count_),
+            queues_(init.num_queues_),
+            domain_of_(init.num_queues_, 0),
+            curr_domain_(0),
+            steals_(new steal_counters[init.num_queues_])
+        {}
+
+        virtual ~numa_hierarchy_scheduler()
+        {
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                delete queues_[i];
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                delete domain_queues_[i];
+        }
+
+        bool numa_sensitive() const { return true; }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Group the worker threads by the NUMA domain of the processing unit
+        // they are bound to and create the shared queue for each of the
+        // domains. This is called by the thread manager before any of the
+        // worker threads is started.
+        std::size_t init(init_affinity_data const& data, topology const& topology)
+        {
+            std::size_t cores_used = scheduler_base::init(data, topology);
+
+            std::map<std::size_t, std::size_t> domains;
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+            {
+                error_code ec(lightweight);
+                std::size_t node =
+                    topology.get_numa_node_number(get_pu_num(i), ec);
+                if (ec)
+                    node = std::size_t(-1);
+
+                std::map<std::size_t, std::size_t>::iterator it =
+                    domains.find(node);
+                if (it == domains.end())
+                {
+                    it = domains.insert(std::make_pair(node,
+                        domain_queues_.size())).first;
+                    domain_queues_.push_back(new thread_queue_type(
+                        std::size_t(-1), max_queue_thread_count_));
+                    domain_workers_.push_back(std::vector<std::size_t>());
+                }
+
+                domain_of_[i] = it->second;
+                domain_workers_[it->second].push_back(i);
+            }
+
+            return cores_used;
+        }
+
+#if HPX_THREAD_MAINTAIN_CREATION_AND_CLEANUP_RATES
+        boost::uint64_t get_creation_time(bool reset)
+        {
+            boost::uint64_t time = 0;
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                time += domain_queues_[i]->get_creation_time(reset);
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                time += queues_[i]->get_creation_time(reset);
+
+            return time;
+        }
+
+        boost::uint64_t get_cleanup_time(bool reset)
+        {
+            boost::uint64_t time = 0;
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                time += domain_queues_[i]->get_cleanup_time(reset);
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                time += queues_[i]->get_cleanup_time(reset);
+
+            return time;
+        }
+#endif
+
+        std::size_t get_num_pending_misses(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_pending_misses = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_pending_misses += queues_[i]->
+                        get_num_pending_misses(reset);
+                return num_pending_misses;
+            }
+
+            return queues_[num_thread]->get_num_pending_misses(reset);
+        }
+
+        std::size_t get_num_pending_accesses(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_pending_accesses = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_pending_accesses += queues_[i]->
+                        get_num_pending_accesses(reset);
+                return num_pending_accesses;
+            }
+
+            return queues_[num_thread]->get_num_pending_accesses(reset);
+        }
+
+        std::size_t get_num_stolen_from_pending(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                    num_stolen_threads +=
+                        domain_queues_[i]->get_num_stolen_from_pending(reset);
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads +=
+                        queues_[i]->get_num_stolen_from_pending(reset);
+                return num_stolen_threads;
+            }
+
+            return queues_[num_thread]->get_num_stolen_from_pending(reset);
+        }
+
+        std::size_t get_num_stolen_to_pending(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads +=
+                        queues_[i]->get_num_stolen_to_pending(reset);
+                return num_stolen_threads;
+            }
+
+            return queues_[num_thread]->get_num_stolen_to_pending(reset);
+        }
+
+        std::size_t get_num_stolen_from_staged(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                    num_stolen_threads +=
+                        domain_queues_[i]->get_num_stolen_from_staged(reset);
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads +=
+                        queues_[i]->get_num_stolen_from_staged(reset);
+                return num_stolen_threads;
+            }
+
+            return queues_[num_thread]->get_num_stolen_from_staged(reset);
+        }
+
+        std::size_t get_num_stolen_to_staged(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads +=
+                        queues_[i]->get_num_stolen_to_staged(reset);
+                return num_stolen_threads;
+            }
+
+            return queues_[num_thread]->get_num_stolen_to_staged(reset);
+        }
+
+        std::size_t get_num_steals(steal_tier tier, std::size_t num_thread,
+            bool reset)
+        {
+            HPX_ASSERT(std::size_t(tier) < steal_counters::num_tiers);
+
+            if (num_thread == std::size_t(-1))
+            {
+                std::size_t num_steals = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                {
+                    num_steals += static_cast<std::size_t>(
+                        util::get_and_reset_value(steals_[i].counts_[tier], reset));
+                }
+                return num_steals;
+            }
+
+            HPX_ASSERT(num_thread < queues_.size());
+            return static_cast<std::size_t>(util::get_and_reset_value(
+                steals_[num_thread].counts_[tier], reset));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void abort_all_suspended_threads()
+        {
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                queues_[i]->abort_all_suspended_threads();
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                domain_queues_[i]->abort_all_suspended_threads();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        bool cleanup_terminated(bool delete_all = false)
+        {
+            bool empty = true;
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                empty = queues_[i]->cleanup_terminated(delete_all) && empty;
+            if (!delete_all)
+                return empty;
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                empty = domain_queues_[i]->cleanup_terminated(delete_all) && empty;
+            return empty;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // create a new thread and schedule it if the initial state is equal to
+        // pending
+        thread_id_type create_thread(thread_init_data& data,
+            thread_state_enum initial_state, bool run_now, error_code& ec,
+            std::size_t num_thread)
+        {
+            std::size_t queue_size = queues_.size();
+
+            if (std::size_t(-1) != num_thread)
+            {
+                // the HPX-thread was explicitly assigned to an OS thread
+                num_thread %= queue_size;
+                return queues_[num_thread]->create_thread(data, initial_state,
+                    run_now, ec);
+            }
+
+#if HPX_THREAD_MAINTAIN_TARGET_ADDRESS
+            // try to figure out the NUMA domain where the data lives
+            if (0 != data.lva)
+            {
+                mask_cref_type mask =
+                    topology_.get_thread_affinity_mask_from_lva(data.lva);
+                if (any(mask))
+                {
+                    for (std::size_t i = 0; i != queue_size; ++i)
+                    {
+                        if (test(mask, get_pu_num(i)))
+                        {
+                            return domain_queues_[domain_of_[i]]->create_thread(
+                                data, initial_state, run_now, ec);
+                        }
+                    }
+                }
+            }
+#endif
+
+            // HPX-threads created by a worker thread stay on its core
+            num_thread = threadmanager_base::get_worker_thread_num();
+            if (num_thread < queue_size)
+            {
+                return queues_[num_thread]->create_thread(data, initial_state,
+                    run_now, ec);
+            }
+
+            // distribute all other HPX-threads over the NUMA domains
+            HPX_ASSERT(!domain_queues_.empty());
+            std::size_t domain = ++curr_domain_ % domain_queues_.size();
+            return domain_queues_[domain]->create_thread(data, initial_state,
+                run_now, ec);
+        }
+
+        // Register the task descriptions for a number of HPX-threads at once.
+        // The tasks are distributed over the queues of all cores in contiguous
+        // chunks, each of the chunks is published to its queue at once.
+        void create_thread_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            if (0 == count)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            // all tasks are registered with the same placement
+            if (data[0].num_os_thread != std::size_t(-1))
+            {
+                scheduler_base::create_thread_bulk(data, count, initial_state,
+                    ec);
+                return;
+            }
+
+            // start with the queue of the calling worker thread
+            std::size_t queue_size = queues_.size();
+            std::size_t num_thread = threadmanager_base::get_worker_thread_num();
+            if (num_thread >= queue_size)
+                num_thread = 0;
+
+            std::size_t chunk_size = (count + queue_size - 1) / queue_size;
+            for (std::size_t offset = 0; offset < count; offset += chunk_size)
+            {
+                std::size_t size = (std::min)(chunk_size, count - offset);
+                queues_[num_thread++ % queue_size]->create_thread_bulk(
+                    data + offset, size, initial_state, ec);
+                if (ec) return;
+            }
+        }
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        virtual bool get_next_thread(std::size_t num_thread, bool running,
+            boost::int64_t& idle_loop_count, threads::thread_data_base*& thrd)
+        {
+            HPX_ASSERT(num_thread < queues_.size());
+
+            // first look into the queue of this core
+            {
+                thread_queue_type* q = queues_[num_thread];
+                bool result = q->get_next_thread(thrd);
+
+                q->increment_num_pending_accesses();
+                if (result)
+                    return true;
+                q->increment_num_pending_misses();
+
+                bool have_staged =
+                    q->get_staged_queue_length(boost::memory_order_relaxed) != 0;
+
+                // Give up, we should have work to convert.
+                if (have_staged)
+                    return false;
+            }
+
+            // then into the queue shared by this NUMA domain
+            std::size_t const domain = domain_of_[num_thread];
+            {
+                thread_queue_type* q = domain_queues_[domain];
+                if (q->get_next_thread(thrd, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    queues_[num_thread]->increment_num_stolen_to_pending();
+                    ++steals_[num_thread].counts_[steal_numa_domain];
+                    return true;
+                }
+            }
+
+            // then steal from the other cores in this NUMA domain
+            if (steal_from_domain(num_thread, domain, false, thrd))
+            {
+                ++steals_[num_thread].counts_[steal_core];
+                return true;
+            }
+
+            // finally try all other NUMA domains
+            std::size_t const num_domains = domain_queues_.size();
+            for (std::size_t i = 1; i < num_domains; ++i)
+            {
+                std::size_t const idx = (i + domain) % num_domains;
+
+                thread_queue_type* q = domain_queues_[idx];
+                if (q->get_next_thread(thrd, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    queues_[num_thread]->increment_num_stolen_to_pending();
+                    ++steals_[num_thread].counts_[steal_remote_numa_domain];
+                    return true;
+                }
+
+                if (steal_from_domain(num_thread, idx, true, thrd))
+                {
+                    ++steals_[num_thread].counts_[steal_remote_numa_domain];
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Schedule the passed thread
+        void schedule_thread(threads::thread_data_base* thrd, std::size_t num_thread,
+            thread_priority priority = thread_priority_normal)
+        {
+            std::size_t queue_size = queues_.size();
+
+            if (std::size_t(-1) == num_thread)
+            {
+                num_thread = threadmanager_base::get_worker_thread_num();
+                if (num_thread >= queue_size)
+                {
+                    std::size_t domain = ++curr_domain_ % domain_queues_.size();
+                    domain_queues_[domain]->schedule_thread(thrd);
+                    return;
+                }
+            }
+
+            queues_[num_thread % queue_size]->schedule_thread(thrd);
+        }
+
+        void schedule_thread_last(threads::thread_data_base* thrd, std::size_t num_thread,
+            thread_priority priority = thread_priority_normal)
+        {
+            numa_hierarchy_scheduler::schedule_thread(thrd, num_thread, priority);
+        }
+
+        /// Destroy the passed thread as it has been terminated
+        bool destroy_thread(threads::thread_data_base* thrd, boost::int64_t& busy_count)
+        {
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+            {
+                if (queues_[i]->destroy_thread(thrd, busy_count))
+                    return true;
+            }
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+            {
+                if (domain_queues_[i]->destroy_thread(thrd, busy_count))
+                    return true;
+            }
+
+            // the thread has to belong to one of the queues, always
+            HPX_ASSERT(false);
+
+            return false;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // This returns the current length of the queues (work items and new
+        // items). The shared queue of a NUMA domain is accounted for by the
+        // first worker thread of this domain.
+        boost::int64_t get_queue_length(std::size_t num_thread = std::size_t(-1)) const
+        {
+            boost::int64_t count = 0;
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < queues_.size());
+
+                std::size_t domain = domain_of_[num_thread];
+                if (!domain_workers_.empty() &&
+                    domain_workers_[domain].front() == num_thread)
+                {
+                    count = domain_queues_[domain]->get_queue_length();
+                }
+                return count + queues_[num_thread]->get_queue_length();
+            }
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                count += domain_queues_[i]->get_queue_length();
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                count += queues_[i]->get_queue_length();
+
+            return count;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Queries the current thread count of the queues.
+        boost::int64_t get_thread_count(thread_state_enum state = unknown,
+            thread_priority priority = thread_priority_default,
+            std::size_t num_thread = std::size_t(-1), bool reset = false) const
+        {
+            if (priority == thread_priority_unknown)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "numa_hierarchy_scheduler::get_thread_count",
+                    "unknown thread priority value (thread_priority_unknown)");
+                return 0;
+            }
+
+            boost::int64_t count = 0;
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < queues_.size());
+
+                std::size_t domain = domain_of_[num_thread];
+                if (!domain_workers_.empty() &&
+                    domain_workers_[domain].front() == num_thread)
+                {
+                    count = domain_queues_[domain]->get_thread_count(state);
+                }
+                return count + queues_[num_thread]->get_thread_count(state);
+            }
+
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+                count += domain_queues_[i]->get_thread_count(state);
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+                count += queues_[i]->get_thread_count(state);
+
+            return count;
+        }
+
+#if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
+        ///////////////////////////////////////////////////////////////////////
+        // Queries the current average thread wait time of the queues.
+        boost::int64_t get_average_thread_wait_time(
+            std::size_t num_thread = std::size_t(-1)) const
+        {
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < queues_.size());
+                return queues_[num_thread]->get_average_thread_wait_time();
+            }
+
+            boost::uint64_t wait_time = 0;
+            boost::uint64_t count = 0;
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+            {
+                wait_time += domain_queues_[i]->get_average_thread_wait_time();
+                ++count;
+            }
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+            {
+                wait_time += queues_[i]->get_average_thread_wait_time();
+                ++count;
+            }
+
+            return wait_time / (count + 1);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Queries the current average task wait time of the queues.
+        boost::int64_t get_average_task_wait_time(
+            std::size_t num_thread = std::size_t(-1)) const
+        {
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < queues_.size());
+                return queues_[num_thread]->get_average_task_wait_time();
+            }
+
+            boost::uint64_t wait_time = 0;
+            boost::uint64_t count = 0;
+            for (std::size_t i = 0; i != domain_queues_.size(); ++i)
+            {
+                wait_time += domain_queues_[i]->get_average_task_wait_time();
+                ++count;
+            }
+
+            for (std::size_t i = 0; i != queues_.size(); ++i)
+            {
+                wait_time += queues_[i]->get_average_task_wait_time();
+                ++count;
+            }
+
+            return wait_time / (count + 1);
+        }
+#endif
+
+        /// This is a function which gets called periodically by the thread
+        /// manager to allow for maintenance tasks to be executed in the
+        /// scheduler. Returns true if the OS thread calling this function
+        /// has to be terminated (i.e. no more work has to be done).
+        virtual bool wait_or_add_new(std::size_t num_thread, bool running,
+            boost::int64_t& idle_loop_count)
+        {
+            HPX_ASSERT(num_thread < queues_.size());
+
+            std::size_t added = 0;
+            bool result = true;
+
+            thread_queue_type* q = queues_[num_thread];
+            result = q->wait_or_add_new(running, idle_loop_count, added) && result;
+            if (0 != added) return result;
+
+            // convert the staged HPX-threads of the shared queue of this NUMA
+            // domain, those stay available to all cores of the domain
+            std::size_t const domain = domain_of_[num_thread];
+            result = domain_queues_[domain]->wait_or_add_new(running,
+                idle_loop_count, added) && result;
+            if (0 != added) return result;
+
+            // steal staged HPX-threads from the other cores of this NUMA domain
+            std::vector<std::size_t> const& workers = domain_workers_[domain];
+            for (std::size_t i = 1; i < workers.size(); ++i)
+            {
+                std::size_t const idx =
+                    workers[(i + num_thread) % workers.size()];
+                if (idx == num_thread)
+                    continue;
+
+                result = q->wait_or_add_new(running, idle_loop_count, added,
+                    queues_[idx], true) && result;
+                if (0 != added)
+                {
+                    queues_[idx]->increment_num_stolen_from_staged(added);
+                    q->increment_num_stolen_to_staged(added);
+                    steals_[num_thread].counts_[steal_core] += added;
+                    return result;
+                }
+            }
+
+            // then from all other NUMA domains
+            std::size_t const num_domains = domain_queues_.size();
+            for (std::size_t i = 1; i < num_domains; ++i)
+            {
+                std::size_t const d = (i + domain) % num_domains;
+
+                result = q->wait_or_add_new(running, idle_loop_count, added,
+                    domain_queues_[d], true) && result;
+                if (0 != added)
+                {
+                    domain_queues_[d]->increment_num_stolen_from_staged(added);
+                    q->increment_num_stolen_to_staged(added);
+                    steals_[num_thread].counts_[steal_remote_numa_domain] += added;
+                    return result;
+                }
+
+                std::vector<std::size_t> const& remote = domain_workers_[d];
+                for (std::size_t j = 0; j != remote.size(); ++j)
+                {
+                    std::size_t const idx = remote[j];
+                    result = q->wait_or_add_new(running, idle_loop_count,
+                        added, queues_[idx], true) && result;
+                    if (0 != added)
+                    {
+                        queues_[idx]->increment_num_stolen_from_staged(added);
+                        q->increment_num_stolen_to_staged(added);
+                        steals_[num_thread].counts_[steal_remote_numa_domain] +=
+                            added;
+                        return result;
+                    }
+                }
+            }
+
+#if HPX_THREAD_MINIMAL_DEADLOCK_DETECTION
+            // no new work is available, are we deadlocked?
+            if (HPX_UNLIKELY(minimal_deadlock_detection && LHPX_ENABLED(error)))
+            {
+                bool suspended_only = true;
+
+                for (std::size_t i = 0; suspended_only && i != queues_.size(); ++i) {
+                    suspended_only = queues_[i]->dump_suspended_threads(
+                        i, idle_loop_count, running);
+                }
+
+                if (HPX_UNLIKELY(suspended_only)) {
+                    if (running) {
+                        LTM_(error) //-V128
+                            << "queue(" << num_thread << "): "
+                            << "no new work available, are we deadlocked?";
+                    }
+                    else {
+                        LHPX_CONSOLE_(hpx::util::logging::level::error) << "  [TM] " //-V128
+                              << "queue(" << num_thread << "): "
+                              << "no new work available, are we deadlocked?\n";
+                    }
+                }
+            }
+#endif
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void on_start_thread(std::size_t num_thread)
+        {
+            // the queue is allocated by the OS thread using it, this places
+            // it into the memory of its NUMA domain
+            queues_[num_thread] =
+                new thread_queue_type(num_thread, max_queue_thread_count_);
+
+            std::size_t domain = domain_of_[num_thread];
+            if (domain_workers_[domain].front() == num_thread)
+                domain_queues_[domain]->on_start_thread(num_thread);
+
+            queues_[num_thread]->on_start_thread(num_thread);
+        }
+
+        void on_stop_thread(std::size_t num_thread)
+        {
+            std::size_t domain = domain_of_[num_thread];
+            if (domain_workers_[domain].front() == num_thread)
+                domain_queues_[domain]->on_stop_thread(num_thread);
+
+            queues_[num_thread]->on_stop_thread(num_thread);
+        }
+
+        void on_error(std::size_t num_thread, boost::exception_ptr const& e)
+        {
+            std::size_t domain = domain_of_[num_thread];
+            if (domain_workers_[domain].front() == num_thread)
+                domain_queues_[domain]->on_error(num_thread, e);
+
+            queues_[num_thread]->on_error(num_thread, e);
+        }
+
+    protected:
+        // Steal a pending HPX-thread from any of the cores of the given NUMA
+        // domain (except from the given worker thread itself).
+        bool steal_from_domain(std::size_t num_thread, std::size_t domain,
+            bool remote, threads::thread_data_base*& thrd)
+        {
+            std::vector<std::size_t> const& workers = domain_workers_[domain];
+            std::size_t const num_workers = workers.size();
+
+            // start looking at the neighbor of the current worker thread to
+            // spread the stealing over all cores of the domain
+            std::size_t const offset = remote ? num_thread : num_thread + 1;
+            for (std::size_t i = 0; i != num_workers; ++i)
+            {
+                std::size_t const idx = workers[(i + offset) % num_workers];
+                if (idx == num_thread)
+                    continue;
+
+                thread_queue_type* q = queues_[idx];
+                if (q->get_next_thread(thrd, true))
+                {
+                    q->increment_num_stolen_from_pending();
+                    queues_[num_thread]->increment_num_stolen_to_pending();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::size_t max_queue_thread_count_;
+
+        std::vector<thread_queue_type*> queues_;        // one per OS thread
+        std::vector<thread_queue_type*> domain_queues_; // one per NUMA domain
+
+        std::vector<std::size_t> domain_of_;            // OS thread -> domain
+        std::vector<std::vector<std::size_t> > domain_workers_;
+
+        boost::atomic<std::size_t> curr_domain_;
+        boost::scoped_array<steal_counters> steals_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
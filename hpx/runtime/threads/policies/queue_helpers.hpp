@@ -32,14 +32,14 @@ namespace detail
 {
     ///////////////////////////////////////////////////////////////////////////
     // debug helper function, logs all suspended threads
-    // this returns true if all threads in the map are currently suspended
-    template <typename Map>
+    // this returns true if all threads in the registry are currently suspended
+    template <typename Registry>
     bool dump_suspended_threads(std::size_t num_thread,
-        Map& tm, boost::int64_t& idle_loop_count, bool running) HPX_COLD;
+        Registry& tm, boost::int64_t& idle_loop_count, bool running) HPX_COLD;
 
-    template <typename Map>
+    template <typename Registry>
     bool dump_suspended_threads(std::size_t num_thread,
-        Map& tm, boost::int64_t& idle_loop_count, bool running)
+        Registry& tm, boost::int64_t& idle_loop_count, bool running)
     {
 #if !HPX_THREAD_MINIMAL_DEADLOCK_DETECTION
         HPX_UNUSED(tm);
@@ -59,10 +59,10 @@ namespace detail
         bool collect_suspended = true;
 
         bool logged_headline = false;
-        typename Map::const_iterator end = tm.end();
-        for (typename Map::const_iterator it = tm.begin(); it != end; ++it)
+        typename Registry::const_iterator end = tm.end();
+        for (typename Registry::const_iterator it = tm.begin(); it != end; ++it)
         {
-            threads::thread_data_base const* thrd = (*it).first;
+            threads::thread_data_base const* thrd = *it;
             threads::thread_state state = thrd->get_state();
             threads::thread_state marked_state = thrd->get_marked_state();
 
@@ -86,7 +86,7 @@ namespace detail
                     LTM_(error) << "queue(" << num_thread << "): " //-V128
                                 << get_thread_state_name(state)
                                 << "(" << std::hex << std::setw(8)
-                                    << std::setfill('0') << (*it).first
+                                    << std::setfill('0') << thrd
                                 << "." << std::hex << std::setw(2)
                                     << std::setfill('0') << thrd->get_thread_phase()
                                 << "/" << std::hex << std::setw(8)
@@ -104,7 +104,7 @@ namespace detail
                                 << "queue(" << num_thread << "): "
                                 << get_thread_state_name(state)
                                 << "(" << std::hex << std::setw(8)
-                                    << std::setfill('0') << (*it).first
+                                    << std::setfill('0') << thrd
                                 << "." << std::hex << std::setw(2)
                                     << std::setfill('0') << thrd->get_thread_phase()
                                 << "/" << std::hex << std::setw(8)
@@ -10,34 +10,83 @@
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads/policies/affinity_data.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/chrono/chrono.hpp>
+
+#include <algorithm>
 
 #include <hpx/config/warnings_prefix.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
-#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
+    ///////////////////////////////////////////////////////////////////////////
+    /// The idle policy defines what a worker thread does if it does not find
+    /// any work to execute.
+    enum idle_policy
+    {
+        idle_spin = 0,      ///< keep looking for work (lowest latency)
+        idle_backoff = 1,   ///< sleep for exponentially growing periods
+        idle_park = 2       ///< back off first, then park until woken up
+    };
+
+    struct idle_parameters
+    {
+        idle_parameters()
+          : policy_(idle_spin),
+            spin_count_(1000),
+            max_backoff_(1000),
+            park_timeout_(100)
+        {}
+
+        idle_parameters(idle_policy policy, boost::int64_t spin_count,
+                boost::uint32_t max_backoff, boost::uint32_t park_timeout)
+          : policy_(policy),
+            spin_count_(spin_count),
+            max_backoff_(max_backoff),
+            park_timeout_(park_timeout)
+        {}
+
+        idle_policy policy_;
+        boost::int64_t spin_count_;     // idle loops before backing off
+        boost::uint32_t max_backoff_;   // longest backoff period [us]
+        boost::uint32_t park_timeout_;  // longest time to stay parked [ms]
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The steal tier identifies where a worker thread found work which did
+    /// not come from its own queue. It is used by schedulers organizing their
+    /// queues along the NUMA topology of the machine.
+    enum steal_tier
+    {
+        steal_numa_domain = 0,  ///< the queue shared by the own NUMA domain
+        steal_core = 1,         ///< the queue of a core in the own NUMA domain
+        steal_remote_numa_domain = 2    ///< any queue of another NUMA domain
+    };
+
     namespace detail
     {
-        struct reset_on_exit
+        ///////////////////////////////////////////////////////////////////////
+        // Each worker thread owns a parking spot it waits on while idling.
+        struct parking_spot : boost::noncopyable
         {
-            reset_on_exit(boost::atomic<bool>& flag)
-              : flag_(flag)
-            {
-                flag_ = true;
-            }
-            ~reset_on_exit()
-            {
-                flag_ = false;
-            }
-            boost::atomic<bool>& flag_;
+            parking_spot()
+              : parked_(false), notified_(false), epoch_(0)
+            {}
+
+            boost::mutex mtx_;
+            boost::condition_variable cond_;
+            boost::atomic<bool> parked_;
+            boost::atomic<bool> notified_;
+            boost::uint64_t epoch_;         // accessed by owner only
         };
     }
-#endif
 
     ///////////////////////////////////////////////////////////////////////////
     /// The scheduler_base defines the interface to be implemented by all
@@ -47,10 +96,10 @@ namespace hpx { namespace threads { namespace policies
         scheduler_base(std::size_t num_threads)
           : topology_(get_topology())
           , affinity_data_(num_threads)
-#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
-          , wait_count_(0)
-          , waiting_(false)
-#endif
+          , num_spots_(num_threads ? num_threads : 1)
+          , spots_(new detail::parking_spot[num_spots_])
+          , parked_count_(0)
+          , wakeup_epoch_(0)
         {}
 
         virtual ~scheduler_base() {}
@@ -77,31 +126,120 @@ namespace hpx { namespace threads { namespace policies
             return affinity_data_.init(data, topology);
         }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        ///////////////////////////////////////////////////////////////////////
+        /// Return the timer wheel used to schedule timed thread state changes.
+        threads::detail::timer_wheel& get_timer_wheel()
         {
-#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            boost::chrono::milliseconds period(++wait_count_);
+            return timer_wheel_;
+        }
 
-            boost::mutex::scoped_lock l(mtx_);
-            policies::detail::reset_on_exit w(waiting_);
-            cond_.wait_for(l, period);
-#endif
+        /// This function gets called by the scheduling loops on each
+        /// iteration, it invokes all expired timers and returns their number.
+        std::size_t poll_timers()
+        {
+            return timer_wheel_.poll();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void set_idle_parameters(idle_parameters const& params)
+        {
+            idle_ = params;
+        }
+
+        idle_parameters const& get_idle_parameters() const
+        {
+            return idle_;
+        }
+
+        /// This function gets called by the scheduling loop whenever the given
+        /// worker thread did not find any work. Depending on the idle policy
+        /// it suspends the OS thread for exponentially growing periods
+        /// (\a backoff holds the current period and has to be reset to zero
+        /// by the caller once work was found) and eventually parks it until
+        /// new work is announced by do_some_work(). Worker thread zero never
+        /// parks for longer than the maximal backoff period as it has to
+        /// drive the background work of the parcel layer. Returns whether
+        /// the OS thread was suspended.
+        bool idle_wait(std::size_t num_thread, boost::int64_t idle_loop_count,
+            boost::uint32_t& backoff)
+        {
+            if (idle_.policy_ == idle_spin || idle_loop_count < idle_.spin_count_)
+                return false;
+
+            if (backoff < idle_.max_backoff_)
+            {
+                backoff = backoff ? (std::min)(2 * backoff, idle_.max_backoff_) : 1;
+                return park(num_thread, boost::chrono::microseconds(backoff));
+            }
+
+            if (idle_.policy_ == idle_park && num_thread != 0)
+            {
+                return park(num_thread,
+                    boost::chrono::milliseconds(idle_.park_timeout_));
+            }
+            return park(num_thread, boost::chrono::microseconds(backoff));
         }
 
         /// This function gets called by the thread-manager whenever new work
         /// has been added, allowing the scheduler to reactivate one or more of
-        /// possibly idling OS threads
-        void do_some_work(std::size_t /*num_thread*/)
+        /// possibly idling OS threads. If \a num_thread refers to a worker
+        /// thread which is currently parked only this thread is woken up,
+        /// otherwise any one of the parked threads is.
+        void do_some_work(std::size_t num_thread)
         {
-#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
-            wait_count_.store(0, boost::memory_order_release);
-            if (waiting_)
+            if (idle_.policy_ == idle_spin)
+                return;
+
+            if (num_thread != std::size_t(-1))
             {
-                cond_.notify_one();
+                detail::parking_spot& spot = spots_[num_thread % num_spots_];
+                spot.notified_.store(true);
+                if (spot.parked_.load())
+                {
+                    unpark(spot);
+                    return;
+                }
+            }
+
+            // make sure no thread goes to sleep without looking for the new
+            // work first
+            ++wakeup_epoch_;
+            if (parked_count_.load() == 0)
+                return;
+
+            for (std::size_t i = 0; i != num_spots_; ++i)
+            {
+                if (spots_[i].parked_.load())
+                {
+                    spots_[i].notified_.store(true);
+                    unpark(spots_[i]);
+                    return;
+                }
+            }
+        }
+
+        /// Announce \a count new work items at once, this wakes up as many
+        /// parked worker threads (but not more than there are).
+        void do_some_work(std::size_t num_thread, std::size_t count)
+        {
+            do_some_work(num_thread);
+            for (std::size_t i = 1; i < count && i < num_spots_; ++i)
+            {
+                if (parked_count_.load() == 0)
+                    return;
+                do_some_work(std::size_t(-1));
+            }
+        }
+
+        /// Wake up all parked worker threads (used on shutdown).
+        void unpark_all()
+        {
+            ++wakeup_epoch_;
+            for (std::size_t i = 0; i != num_spots_; ++i)
+            {
+                spots_[i].notified_.store(true);
+                unpark(spots_[i]);
             }
-#endif
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -126,6 +264,15 @@ namespace hpx { namespace threads { namespace policies
         virtual std::size_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
 
+        /// Return the number of HPX-threads the given worker thread (or all
+        /// worker threads) took from the given steal tier. Schedulers which
+        /// are not aware of the NUMA topology don't track this.
+        virtual std::size_t get_num_steals(steal_tier tier,
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
+
         virtual boost::int64_t get_queue_length(
             std::size_t num_thread = std::size_t(-1)) const = 0;
 
@@ -141,6 +288,20 @@ namespace hpx { namespace threads { namespace policies
             thread_state_enum initial_state, bool run_now, error_code& ec,
             std::size_t num_thread) = 0;
 
+        /// Register the task descriptions for the given number of HPX-threads
+        /// at once. Schedulers which can publish all of them to their queues
+        /// at once override this, the default registers them one by one.
+        virtual void create_thread_bulk(thread_init_data* data,
+            std::size_t count, thread_state_enum initial_state, error_code& ec)
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                create_thread(data[i], initial_state, false, ec,
+                    data[i].num_os_thread);
+                if (ec) return;
+            }
+        }
+
         virtual bool get_next_thread(std::size_t num_thread, bool running,
             boost::int64_t& idle_loop_count, threads::thread_data_base*& thrd) = 0;
 
@@ -168,17 +329,68 @@ namespace hpx { namespace threads { namespace policies
             std::size_t num_thread = std::size_t(-1)) const = 0;
 #endif
 
+    private:
+        template <typename Duration>
+        bool park(std::size_t num_thread, Duration const& period)
+        {
+            detail::parking_spot& spot = spots_[num_thread % num_spots_];
+
+            // don't go to sleep if new work was announced since this thread
+            // looked for work the last time
+            boost::uint64_t epoch = wakeup_epoch_.load();
+            if (spot.notified_.exchange(false) || epoch != spot.epoch_)
+            {
+                spot.epoch_ = epoch;
+                return false;
+            }
+
+            boost::mutex::scoped_lock l(spot.mtx_);
+
+            // publish that we are going to sleep before checking for
+            // notifications a last time, do_some_work() does the inverse
+            spot.parked_.store(true);
+            ++parked_count_;
+
+            if (!spot.notified_.load() && epoch == wakeup_epoch_.load())
+            {
+                // never sleep past the expiration of the next timer
+                boost::uint64_t next = timer_wheel_.next_timeout();
+                if (next < boost::uint64_t(
+                        boost::chrono::nanoseconds(period).count()))
+                {
+                    spot.cond_.wait_for(l, boost::chrono::nanoseconds(next));
+                }
+                else
+                {
+                    spot.cond_.wait_for(l, period);
+                }
+            }
+
+            --parked_count_;
+            spot.parked_.store(false);
+            spot.notified_.store(false);
+            return true;
+        }
+
+        void unpark(detail::parking_spot& spot)
+        {
+            boost::mutex::scoped_lock l(spot.mtx_);
+            spot.cond_.notify_one();
+        }
+
     protected:
         topology const& topology_;
         detail::affinity_data affinity_data_;
 
-#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
         // support for suspension on idle queues
-        boost::mutex mtx_;
-        boost::condition_variable cond_;
-        boost::atomic<boost::uint32_t> wait_count_;
-        boost::atomic<bool> waiting_;
-#endif
+        idle_parameters idle_;
+        std::size_t const num_spots_;
+        boost::scoped_array<detail::parking_spot> spots_;
+        boost::atomic<boost::int64_t> parked_count_;
+        boost::atomic<boost::uint64_t> wakeup_epoch_;
+
+        // pending timed thread state changes
+        threads::detail::timer_wheel timer_wheel_;
     };
 }}}
 
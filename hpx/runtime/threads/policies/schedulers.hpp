@@ -18,6 +18,9 @@
 #if defined(HPX_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 #endif
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_hierarchy_scheduler.hpp>
+#endif
 #if defined(HPX_PERIODIC_PRIORITY_SCHEDULER)
 #include <hpx/runtime/threads/policies/periodic_priority_queue_scheduler.hpp>
 #endif
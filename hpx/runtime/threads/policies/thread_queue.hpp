@@ -7,7 +7,6 @@
 #if !defined(HPX_THREADMANAGER_THREAD_QUEUE_AUG_25_2009_0132PM)
 #define HPX_THREADMANAGER_THREAD_QUEUE_AUG_25_2009_0132PM
 
-#include <map>
 #include <memory>
 
 #include <hpx/config.hpp>
@@ -18,6 +17,7 @@
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/thread_registry.hpp>
 
 #if HPX_THREAD_MAINTAIN_CREATION_AND_CLEANUP_RATES
 #   include <hpx/util/tick_counter.hpp>
@@ -77,10 +77,14 @@ namespace hpx { namespace threads { namespace policies
     //         typedef ... type;
     //     };
     // };
+    //
+    // The ThreadRegistry keeps track of all threads owned by the queue, see
+    // thread_registry.hpp for the required interface.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_lifo,
         typename StagedQueuing = lockfree_lifo,
-        typename TerminatedQueuing = lockfree_fifo>
+        typename TerminatedQueuing = lockfree_fifo,
+        typename ThreadRegistry = lockfree_thread_registry>
     class thread_queue
     {
     private:
@@ -95,10 +99,9 @@ namespace hpx { namespace threads { namespace policies
             max_delete_count = 1000
         };
 
-        // this is the type of a map holding all threads (except depleted ones)
-        typedef std::map<
-            thread_data_base*, thread_id_type, std::less<thread_data_base*>
-        > thread_map_type;
+        // this is the type of the registry holding all threads (except
+        // depleted ones)
+        typedef ThreadRegistry thread_map_type;
 
 #if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
         typedef
@@ -124,6 +127,31 @@ namespace hpx { namespace threads { namespace policies
         typedef typename TerminatedQueuing::template
             apply<thread_data_base*>::type terminated_items_type;
 
+        // A block of task descriptions registered at once (see
+        // create_thread_bulk). All task descriptions of a batch are allocated
+        // in one block and the batch is published with a single atomic
+        // operation.
+        struct task_batch
+        {
+            explicit task_batch(std::size_t capacity)
+              : next_(0), size_(0), consumed_(0),
+                tasks_(static_cast<task_description*>(
+                    ::operator new(capacity * sizeof(task_description))))
+            {}
+
+            ~task_batch()
+            {
+                for (std::size_t i = consumed_; i != size_; ++i)
+                    tasks_[i].~task_description();
+                ::operator delete(tasks_);
+            }
+
+            task_batch* next_;
+            std::size_t size_;          // number of constructed tasks
+            std::size_t consumed_;      // number of tasks turned into threads
+            task_description* tasks_;
+        };
+
     protected:
         template <typename Lock>
         void create_thread_object(threads::thread_id_type& thrd,
@@ -173,6 +201,179 @@ namespace hpx { namespace threads { namespace policies
             }
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // create a new thread from the given task description, returns
+        // whether it was scheduled
+        bool add_new_thread(threads::thread_init_data& data,
+            thread_state_enum state, typename mutex_type::scoped_try_lock &lk)
+        {
+            // measure thread creation time
+            util::block_profiler_wrapper<add_new_tag> bp(add_new_logger_);
+
+            threads::thread_id_type thrd;
+            create_thread_object(thrd, data, state, lk);
+
+            // add the new entry to the registry of all threads
+            if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                HPX_THROW_EXCEPTION(hpx::out_of_memory,
+                    "threadmanager::add_new",
+                    "Couldn't add new thread to the thread map");
+                return false;
+            }
+
+            // only insert the thread into the work-items queue if it is in
+            // pending state
+            bool scheduled = false;
+            if (state == pending) {
+                // pushing the new thread into the pending queue of the
+                // specified thread_queue
+                scheduled = true;
+                schedule_thread(thrd.get());
+            }
+
+            // this thread has to be in the registry now
+            HPX_ASSERT(thread_map_.contains(thrd.get()));
+            HPX_ASSERT(thrd->is_created_from(&memory_pool_));
+
+            return scheduled;
+        }
+
+        // Publish the given list of batches (linked through next_, from
+        // first to last) to this queue with a single atomic operation.
+        void publish_task_batches(task_batch* first, task_batch* last)
+        {
+            task_batch* head = new_task_batches_.load(boost::memory_order_relaxed);
+            do {
+                last->next_ = head;
+            } while (!new_task_batches_.compare_exchange_weak(head, first,
+                boost::memory_order_release, boost::memory_order_relaxed));
+        }
+
+        // Move the last n tasks of the given batch into a new batch.
+        static task_batch* split_task_batch(task_batch* batch, std::size_t n)
+        {
+            HPX_ASSERT(n < batch->size_ - batch->consumed_);
+
+            task_batch* part = new task_batch(n);
+            std::size_t const first = batch->size_ - n;
+            for (/**/; part->size_ != n; ++part->size_)
+            {
+                task_description& task = batch->tasks_[first + part->size_];
+                new (&part->tasks_[part->size_]) task_description(std::move(task));
+                task.~task_description();
+            }
+            batch->size_ = first;
+            return part;
+        }
+
+        // Take up to count tasks (all of them if count is negative) out of
+        // the batches published to the given queue, splitting a batch which
+        // holds more tasks than needed. The remaining batches are published
+        // again right away, this way tasks are never hidden from other queues
+        // trying to steal them until they are turned into threads.
+        static task_batch* take_task_batches(thread_queue* addfrom,
+            boost::int64_t count)
+        {
+            task_batch* batches = addfrom->new_task_batches_.exchange(0,
+                boost::memory_order_acquire);
+
+            task_batch* taken = 0;
+            while (0 != batches && 0 != count)
+            {
+                task_batch* batch = batches;
+                boost::int64_t const remaining =
+                    static_cast<boost::int64_t>(batch->size_ - batch->consumed_);
+
+                if (count > 0 && remaining > count)
+                {
+                    task_batch* part = split_task_batch(batch,
+                        static_cast<std::size_t>(count));
+                    part->next_ = taken;
+                    taken = part;
+                    break;
+                }
+
+                batches = batch->next_;
+                batch->next_ = taken;
+                taken = batch;
+
+                if (count > 0)
+                    count -= remaining;
+            }
+
+            if (0 != batches)
+            {
+                task_batch* last = batches;
+                while (0 != last->next_)
+                    last = last->next_;
+                addfrom->publish_task_batches(batches, last);
+            }
+            return taken;
+        }
+
+        // add new threads from the task batches published to the given queue
+        std::size_t add_new_from_batches(boost::int64_t& add_count,
+            thread_queue* addfrom, typename mutex_type::scoped_try_lock &lk,
+            bool steal)
+        {
+            boost::int64_t count = add_count;
+            if (steal || addfrom != this)
+            {
+                // leave at least half of the tasks to the queue they were
+                // registered with
+                boost::int64_t const half =
+                    addfrom->new_tasks_count_.load(boost::memory_order_relaxed) / 2;
+                if (count < 0 || count > half)
+                    count = (std::max)(half, boost::int64_t(1));
+            }
+
+            task_batch* batches = take_task_batches(addfrom, count);
+
+            std::size_t added = 0;
+            while (0 != batches)
+            {
+                task_batch* batch = batches;
+                while (batch->consumed_ != batch->size_)
+                {
+                    --add_count;
+
+                    // Take the task out of the batch before creating the
+                    // thread, as the lock might get released while doing so.
+                    task_description& task = batch->tasks_[batch->consumed_++];
+
+#if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
+                    if (maintain_queue_wait_times) {
+                        addfrom->new_tasks_wait_ +=
+                            util::high_resolution_clock::now() - HPX_STD_GET(2, task);
+                        ++addfrom->new_tasks_wait_count_;
+                    }
+#endif
+                    threads::thread_init_data data(std::move(HPX_STD_GET(0, task)));
+                    thread_state_enum state = HPX_STD_GET(1, task);
+                    task.~task_description();
+
+                    --addfrom->new_tasks_count_;
+
+                    try {
+                        if (add_new_thread(data, state, lk))
+                            ++added;
+                    }
+                    catch (...) {
+                        // hand the tasks not converted yet back to the queue
+                        task_batch* last = batches;
+                        while (0 != last->next_)
+                            last = last->next_;
+                        addfrom->publish_task_batches(batches, last);
+                        throw;
+                    }
+                }
+
+                batches = batch->next_;
+                delete batch;
+            }
+            return added;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // add new threads if there is some amount of work available
         std::size_t add_new(boost::int64_t add_count, thread_queue* addfrom,
@@ -181,7 +382,11 @@ namespace hpx { namespace threads { namespace policies
             if (HPX_UNLIKELY(0 == add_count))
                 return 0;
 
+            // tasks registered in bulk are converted first
             std::size_t added = 0;
+            if (0 != addfrom->new_task_batches_.load(boost::memory_order_relaxed))
+                added = add_new_from_batches(add_count, addfrom, lk, steal);
+
             task_description* task = 0;
             while (add_count-- && addfrom->new_tasks_.pop(task, steal))
             {
@@ -194,42 +399,13 @@ namespace hpx { namespace threads { namespace policies
 #endif
                 --addfrom->new_tasks_count_;
 
-                // measure thread creation time
-                util::block_profiler_wrapper<add_new_tag> bp(add_new_logger_);
-
                 // create the new thread
-                threads::thread_init_data& data = HPX_STD_GET(0, *task);
+                threads::thread_init_data data(std::move(HPX_STD_GET(0, *task)));
                 thread_state_enum state = HPX_STD_GET(1, *task);
-                threads::thread_id_type thrd;
-
-                create_thread_object(thrd, data, state, lk);
-
                 delete task;
 
-                // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thread_map_type::value_type(thrd.get(), thrd));
-
-                if (HPX_UNLIKELY(!p.second)) {
-                    HPX_THROW_EXCEPTION(hpx::out_of_memory,
-                        "threadmanager::add_new",
-                        "Couldn't add new thread to the thread map");
-                    return 0;
-                }
-                ++thread_map_count_;
-
-                // only insert the thread into the work-items queue if it is in
-                // pending state
-                if (state == pending) {
-                    // pushing the new thread into the pending queue of the
-                    // specified thread_queue
+                if (add_new_thread(data, state, lk))
                     ++added;
-                    schedule_thread(thrd.get());
-                }
-
-                // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                HPX_ASSERT(thrd->is_created_from(&memory_pool_));
             }
 
             if (added) {
@@ -255,7 +431,7 @@ namespace hpx { namespace threads { namespace policies
             // if the map doesn't hold max_count threads yet add some
             // FIXME: why do we have this test? can max_count_ ever be zero?
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count = static_cast<std::size_t>(thread_map_.size());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>((std::numeric_limits<boost::int64_t>::max)()));
@@ -290,7 +466,7 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count = static_cast<std::size_t>(thread_map_.size());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>((std::numeric_limits<boost::int64_t>::max)()));
@@ -369,14 +545,12 @@ namespace hpx { namespace threads { namespace policies
                 thread_data_base* todelete;
                 while (terminated_items_.pop(todelete))
                 {
-                    // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
-
                     --terminated_items_count_;
-                    bool deleted = thread_map_.erase(todelete) != 0;
-                    HPX_ASSERT(deleted);
-                    if (deleted)
-                        --thread_map_count_;
+
+                    // this thread has to be in this registry
+                    thread_id_type thrd = thread_map_.erase(todelete);
+                    HPX_ASSERT(thrd);
+                    HPX_UNUSED(thrd);
                 }
                 return false;
             }
@@ -390,16 +564,14 @@ namespace hpx { namespace threads { namespace policies
                 thread_data_base* todelete;
                 while (delete_count && terminated_items_.pop(todelete))
                 {
-                    thread_map_type::iterator it = thread_map_.find(todelete);
+                    thread_id_type thrd = thread_map_.erase(todelete);
 
-                    // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
+                    // this thread has to be in this registry
+                    HPX_ASSERT(thrd);
 
-                    recycle_thread((*it).second);
+                    recycle_thread(thrd);
 
-                    thread_map_.erase(it);
                     --terminated_items_count_;
-                    --thread_map_count_;
                     --delete_count;
                 }
                 return terminated_items_count_ != 0;
@@ -416,7 +588,7 @@ namespace hpx { namespace threads { namespace policies
         bool cleanup_terminated(bool delete_all = false)
         {
             if (terminated_items_count_ == 0)
-                return thread_map_count_ == 0;
+                return thread_map_.empty();
 
             if (delete_all) {
                 bool thread_map_is_empty = false;
@@ -446,8 +618,7 @@ namespace hpx { namespace threads { namespace policies
 
         thread_queue(std::size_t queue_num = std::size_t(-1),
                 std::size_t max_count = max_thread_count)
-          : thread_map_count_(0),
-            work_items_(128, queue_num),
+          : work_items_(128, queue_num),
             work_items_count_(0),
 #if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
             work_items_wait_(0),
@@ -458,8 +629,9 @@ namespace hpx { namespace threads { namespace policies
             max_count_((0 == max_count)
                       ? static_cast<std::size_t>(max_thread_count)
                       : max_count),
-            new_tasks_(128),
+            new_tasks_(128, queue_num),
             new_tasks_count_(0),
+            new_task_batches_(0),
 #if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
             new_tasks_wait_(0),
             new_tasks_wait_count_(0),
@@ -483,6 +655,17 @@ namespace hpx { namespace threads { namespace policies
             add_new_logger_("thread_queue::add_new")
         {}
 
+        ~thread_queue()
+        {
+            task_batch* batches = new_task_batches_.load();
+            while (batches)
+            {
+                task_batch* next = batches->next_;
+                delete batches;
+                batches = next;
+            }
+        }
+
         void set_max_count(std::size_t max_count = max_thread_count)
         {
             max_count_ = (0 == max_count) ? max_thread_count : max_count; //-V105
@@ -612,38 +795,35 @@ namespace hpx { namespace threads { namespace policies
 
                 // The mutex can not be locked while a new thread is getting
                 // created, as it might have that the current HPX thread gets
-                // suspended.
+                // suspended. The lock is needed only for accessing the heaps
+                // of recycled thread objects.
                 {
                     typename mutex_type::scoped_lock lk(mtx_);
-
                     create_thread_object(thrd, data, initial_state, lk);
+                }
 
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thread_map_type::value_type(thrd.get(), thrd));
-
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return invalid_thread_id;
-                    }
-                    ++thread_map_count_;
+                // add a new entry in the registry for this thread, this does
+                // not require to hold the lock
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                    HPX_THROWS_IF(ec, hpx::out_of_memory,
+                        "threadmanager::register_thread",
+                        "Couldn't add new thread to the map of threads");
+                    return invalid_thread_id;
+                }
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->is_created_from(&memory_pool_));
+                // this thread has to be in the registry now
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
+                HPX_ASSERT(thrd->is_created_from(&memory_pool_));
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
+                if (&ec != &throws)
+                    ec = make_success_code();
 
-                    // return the thread_id of the newly created thread
-                    return thrd;
-                }
+                // return the thread_id of the newly created thread
+                return thrd;
             }
 
             // do not execute the work, but register a task description for
@@ -665,6 +845,49 @@ namespace hpx { namespace threads { namespace policies
             return invalid_thread_id;     // thread has not been created yet
         }
 
+        // register task descriptions for the given number of threads to be
+        // created later, all of them are published at once
+        void create_thread_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            if (0 == count)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            task_batch* batch = new task_batch(count);
+
+#if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
+            boost::uint64_t now = util::high_resolution_clock::now();
+#endif
+            try {
+                for (/**/; batch->size_ != count; ++batch->size_)
+                {
+#if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
+                    new (&batch->tasks_[batch->size_]) task_description(
+                        std::move(data[batch->size_]), initial_state, now);
+#else
+                    new (&batch->tasks_[batch->size_]) task_description(
+                        std::move(data[batch->size_]), initial_state);
+#endif
+                }
+            }
+            catch (...) {
+                delete batch;
+                throw;
+            }
+
+            new_tasks_count_ += count;
+
+            // publish all task descriptions with a single atomic operation
+            publish_task_batches(batch, batch);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
         void move_work_items_from(thread_queue *src, boost::int64_t count)
         {
             thread_description* trd;
@@ -793,17 +1016,18 @@ namespace hpx { namespace threads { namespace policies
                 return new_tasks_count_;
 
             if (unknown == state)
-                return thread_map_count_ + new_tasks_count_;
+                return thread_map_.size() + new_tasks_count_;
 
-            // acquire lock only if absolutely necessary
+            // acquire lock only if absolutely necessary, this prevents
+            // threads from being removed from the registry concurrently
             typename mutex_type::scoped_lock lk(mtx_);
 
             boost::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
+            typename thread_map_type::const_iterator end = thread_map_.end();
+            for (typename thread_map_type::const_iterator it = thread_map_.begin();
                  it != end; ++it)
             {
-                if ((*it).second->get_state() == state)
+                if ((*it)->get_state() == state)
                     ++num_threads;
             }
             return num_threads;
@@ -813,15 +1037,16 @@ namespace hpx { namespace threads { namespace policies
         void abort_all_suspended_threads()
         {
             typename mutex_type::scoped_lock lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
+            typename thread_map_type::const_iterator end = thread_map_.end();
+            for (typename thread_map_type::const_iterator it = thread_map_.begin();
                  it != end; ++it)
             {
-                if ((*it).second->get_state() == suspended)
+                thread_data_base* thrd = *it;
+                if (thrd->get_state() == suspended)
                 {
-                    (*it).second->set_state_ex(wait_abort);
-                    (*it).second->set_state(pending);
-                    schedule_thread((*it).second.get());
+                    thrd->set_state_ex(wait_abort);
+                    thrd->set_state(pending);
+                    schedule_thread(thrd);
                 }
             }
         }
@@ -896,8 +1121,7 @@ namespace hpx { namespace threads { namespace policies
     private:
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
-        thread_map_type thread_map_;                ///< mapping of thread id's to HPX-threads
-        boost::atomic<boost::int64_t> thread_map_count_;       ///< overall count of work items
+        thread_map_type thread_map_;                ///< registry of all HPX-threads
 
         work_items_type work_items_;                ///< list of active work items
         boost::atomic<boost::int64_t> work_items_count_;       ///< count of active work items
@@ -913,6 +1137,8 @@ namespace hpx { namespace threads { namespace policies
         task_items_type new_tasks_;                 ///< list of new tasks to run
 
         boost::atomic<boost::int64_t> new_tasks_count_;        ///< count of new tasks to run
+
+        boost::atomic<task_batch*> new_task_batches_;   ///< batches of new tasks published
 #if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
         boost::atomic<boost::int64_t> new_tasks_wait_;         ///< overall wait time of new tasks
         boost::atomic<boost::int64_t> new_tasks_wait_count_;   ///< overall number tasks waited
@@ -0,0 +1,340 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_THREAD_REGISTRY_JAN_14_2014_0402PM)
+#define HPX_THREADMANAGER_THREAD_REGISTRY_JAN_14_2014_0402PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <iterator>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // // Thread registry interface:
+    //
+    // struct thread_registry
+    // {
+    //     typedef ... const_iterator;        // dereferences to thread_data_base*
+    //
+    //     bool insert(thread_id_type const& thrd);
+    //     thread_id_type erase(thread_data_base* thrd);
+    //     bool contains(thread_data_base* thrd) const;
+    //
+    //     boost::int64_t size() const;
+    //     bool empty() const;
+    //
+    //     const_iterator begin() const;
+    //     const_iterator end() const;
+    // };
+    //
+    // The registry holds a reference to every thread it contains. Iteration
+    // is not synchronized with erase(), callers which dereference the
+    // returned threads have to make sure that no concurrent erase() happens
+    // (the thread_queue does this by holding its mutex).
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Lock-free registry of all threads owned by a thread_queue.
+    //
+    // The threads are stored in a list of open addressing segments, segment
+    // k holding (segment_size << k) slots. A thread is hashed to a small
+    // probing window inside each segment, insert() claims the first free
+    // slot of that window using a single CAS. The global index of the slot
+    // is stored in the thread itself, which allows erase() and contains() to
+    // go straight to the slot instead of probing all segments. New segments
+    // are allocated (and never released before the registry is destroyed)
+    // whenever all windows a thread hashes to are occupied, insert() never
+    // allocates in the steady state.
+    class lockfree_thread_registry : private boost::noncopyable
+    {
+    private:
+        enum {
+            segment_size = 1024,        // number of slots of the first segment
+            window_size = 8,            // number of slots probed per segment
+            max_segments = 20           // up to 1G threads
+        };
+
+        static std::size_t const invalid_index = std::size_t(-1);
+
+        struct segment
+        {
+            explicit segment(std::size_t size)
+              : size_(size)
+              , slots_(new boost::atomic<thread_data_base*>[size])
+            {
+                for (std::size_t i = 0; i != size_; ++i)
+                    slots_[i].store(0, boost::memory_order_relaxed);
+            }
+
+            ~segment()
+            {
+                delete [] slots_;
+            }
+
+            std::size_t const size_;
+            boost::atomic<thread_data_base*>* const slots_;
+        };
+
+        // the index of the first slot of the given segment
+        static std::size_t segment_base(std::size_t k)
+        {
+            return segment_size * ((std::size_t(1) << k) - 1);
+        }
+
+        static std::size_t hash(thread_data_base const* thrd, std::size_t size)
+        {
+            // Fibonacci hashing, the lower bits of the address are always
+            // zero because of alignment.
+            boost::uint64_t h = reinterpret_cast<std::size_t>(thrd) >> 4;
+            h *= 0x9e3779b97f4a7c15ULL;
+            return static_cast<std::size_t>(h >> 20) & (size - window_size);
+        }
+
+        segment* get_segment(std::size_t k)
+        {
+            segment* s = segments_[k].load(boost::memory_order_acquire);
+            if (0 != s)
+                return s;
+
+            segment* new_segment = new segment(segment_size << k);
+            if (!segments_[k].compare_exchange_strong(s, new_segment,
+                    boost::memory_order_acq_rel))
+            {
+                // somebody else was faster, 's' now holds the segment
+                // allocated by the other thread
+                delete new_segment;
+                return s;
+            }
+            return new_segment;
+        }
+
+        // return the slot with the given global index, if it exists
+        boost::atomic<thread_data_base*>* get_slot(std::size_t index) const
+        {
+            if (index == invalid_index)
+                return 0;
+
+            // segment k starts at segment_size * (2^k - 1)
+            std::size_t k = 0;
+            for (std::size_t x = index / segment_size + 1; x > 1; x >>= 1)
+                ++k;
+
+            if (k >= max_segments)
+                return 0;
+
+            segment* s = segments_[k].load(boost::memory_order_acquire);
+            if (0 == s)
+                return 0;
+
+            return &s->slots_[index - segment_base(k)];
+        }
+
+    public:
+        class const_iterator
+          : public std::iterator<std::forward_iterator_tag, thread_data_base*>
+        {
+        public:
+            const_iterator()
+              : registry_(0), segment_(max_segments), index_(0)
+            {}
+
+            const_iterator(lockfree_thread_registry const* registry)
+              : registry_(registry), segment_(0), index_(0)
+            {
+                skip_empty();
+            }
+
+            thread_data_base* operator*() const
+            {
+                return registry_->segments_[segment_].load(
+                    boost::memory_order_relaxed)->slots_[index_].load(
+                        boost::memory_order_acquire);
+            }
+
+            const_iterator& operator++()
+            {
+                ++index_;
+                skip_empty();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return lhs.segment_ == rhs.segment_ && lhs.index_ == rhs.index_;
+            }
+
+            friend bool operator!=(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            void skip_empty()
+            {
+                while (segment_ != max_segments)
+                {
+                    segment const* s = registry_->segments_[segment_].load(
+                        boost::memory_order_acquire);
+                    if (0 == s)
+                        break;
+
+                    for (/**/; index_ != s->size_; ++index_)
+                    {
+                        if (s->slots_[index_].load(
+                                boost::memory_order_relaxed) != 0)
+                        {
+                            return;
+                        }
+                    }
+                    ++segment_;
+                    index_ = 0;
+                }
+                segment_ = max_segments;
+                index_ = 0;
+            }
+
+            lockfree_thread_registry const* registry_;
+            std::size_t segment_;
+            std::size_t index_;
+        };
+
+        lockfree_thread_registry()
+          : count_(0)
+        {
+            segments_[0].store(new segment(segment_size),
+                boost::memory_order_relaxed);
+            for (std::size_t k = 1; k != max_segments; ++k)
+                segments_[k].store(0, boost::memory_order_relaxed);
+        }
+
+        ~lockfree_thread_registry()
+        {
+            for (std::size_t k = 0; k != max_segments; ++k)
+            {
+                segment* s = segments_[k].load(boost::memory_order_relaxed);
+                if (0 == s)
+                    break;
+
+                for (std::size_t i = 0; i != s->size_; ++i)
+                {
+                    thread_data_base* thrd =
+                        s->slots_[i].load(boost::memory_order_relaxed);
+                    if (thrd != 0)
+                        intrusive_ptr_release(thrd);
+                }
+                delete s;
+            }
+        }
+
+        // Add the given thread to the registry, the registry takes a
+        // reference to the thread.
+        bool insert(thread_id_type const& thrd)
+        {
+            thread_data_base* p = thrd.get();
+            if (HPX_UNLIKELY(0 == p))
+                return false;
+
+            for (std::size_t k = 0; k != max_segments; ++k)
+            {
+                segment* s = get_segment(k);
+                std::size_t const start = hash(p, s->size_);
+
+                for (std::size_t i = start; i != start + window_size; ++i)
+                {
+                    if (s->slots_[i].load(boost::memory_order_relaxed) != 0)
+                        continue;
+
+                    // publish the index before the thread becomes visible
+                    p->set_registry_index(segment_base(k) + i);
+
+                    thread_data_base* expected = 0;
+                    if (s->slots_[i].compare_exchange_strong(expected, p,
+                            boost::memory_order_acq_rel))
+                    {
+                        intrusive_ptr_add_ref(p);
+                        ++count_;
+                        return true;
+                    }
+                }
+
+                // all slots in this window are taken, try the next segment
+            }
+
+            p->set_registry_index(invalid_index);
+            return false;
+        }
+
+        // Remove the given thread from the registry, returns the reference
+        // held by the registry (or an empty thread id if the thread was not
+        // registered).
+        thread_id_type erase(thread_data_base* thrd)
+        {
+            boost::atomic<thread_data_base*>* slot =
+                get_slot(thrd->get_registry_index());
+
+            thread_data_base* expected = thrd;
+            if (0 != slot && slot->load(boost::memory_order_relaxed) == thrd &&
+                slot->compare_exchange_strong(expected, 0,
+                    boost::memory_order_acq_rel))
+            {
+                thrd->set_registry_index(invalid_index);
+                --count_;
+                return thread_id_type(thrd, false);   // adopt reference
+            }
+            return thread_id_type();
+        }
+
+        bool contains(thread_data_base* thrd) const
+        {
+            // a thread is registered with at most one registry, if the slot
+            // it refers to holds a different thread it belongs to another one
+            boost::atomic<thread_data_base*>* slot =
+                get_slot(thrd->get_registry_index());
+            return 0 != slot &&
+                slot->load(boost::memory_order_acquire) == thrd;
+        }
+
+        boost::int64_t size() const
+        {
+            return count_.load(boost::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator();
+        }
+
+    private:
+        boost::atomic<segment*> segments_[max_segments];
+        boost::atomic<boost::int64_t> count_;
+    };
+}}}
+
+#endif
@@ -159,7 +159,8 @@ namespace hpx { namespace threads
             exit_funcs_(0),
             scheduler_base_(init_data.scheduler_base),
             count_(0),
-            stacksize_(init_data.stacksize)
+            stacksize_(init_data.stacksize),
+            registry_index_(std::size_t(-1))
         {
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
@@ -593,6 +594,17 @@ namespace hpx { namespace threads
             return stacksize_;
         }
 
+        // The index of the slot holding this thread in the registry of the
+        // thread_queue owning it (see lockfree_thread_registry).
+        std::size_t get_registry_index() const
+        {
+            return registry_index_.load(boost::memory_order_acquire);
+        }
+        void set_registry_index(std::size_t index)
+        {
+            registry_index_.store(index, boost::memory_order_release);
+        }
+
         virtual bool is_created_from(void* pool) const = 0;
         virtual thread_state_enum operator()() = 0;
         virtual thread_id_type get_thread_id() const = 0;
@@ -661,6 +673,8 @@ namespace hpx { namespace threads
         boost::detail::atomic_count count_;
 
         std::ptrdiff_t stacksize_;
+
+        boost::atomic<std::size_t> registry_index_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
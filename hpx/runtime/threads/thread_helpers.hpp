@@ -776,6 +776,30 @@ namespace hpx { namespace applier
         threads::thread_stacksize stacksize = threads::thread_stacksize_default,
         error_code& ec = throws);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create the given number of work items at once, each of them
+    ///        executing the given function.
+    ///
+    /// \param count      [in] The number of work items to create.
+    /// \param func       [in] The function to be executed by all of the
+    ///                   created threads. It is invoked with the index of the
+    ///                   work item (0 to \a count - 1).
+    ///
+    /// The task descriptions for all work items are allocated in one block
+    /// and are handed to the scheduler's queues at once, which makes this
+    /// considerably faster than calling \a register_work_nullary \a count
+    /// times.
+    ///
+    /// \note All other arguments are equivalent to those of the function
+    ///       \a threads#register_work_plain
+    ///
+    HPX_API_EXPORT void register_work_bulk(std::size_t count,
+        HPX_STD_FUNCTION<void(std::size_t)> && func, char const* description = 0,
+        threads::thread_state_enum initial_state = threads::pending,
+        threads::thread_priority priority = threads::thread_priority_normal,
+        threads::thread_stacksize stacksize = threads::thread_stacksize_default,
+        error_code& ec = throws);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Create a new work item using the given function as the
     ///        work to be executed.
@@ -842,6 +866,7 @@ namespace hpx { namespace threads
     using applier::register_work_plain;
     using applier::register_work;
     using applier::register_work_nullary;
+    using applier::register_work_bulk;
 }}
 
 #endif
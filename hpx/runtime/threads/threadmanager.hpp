@@ -253,6 +253,25 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             error_code& ec = throws) = 0;
 
+        /// The function \a register_work_bulk adds the given number of work
+        /// items to the thread manager at once. The task descriptions of all
+        /// of them are allocated in one block and are handed to the scheduler
+        /// at once, which is considerably cheaper than calling
+        /// \a register_work for each of them.
+        ///
+        /// \param data   [in] Points to the first of \a count consecutive
+        ///               \a thread_init_data instances. All of them must
+        ///               share the same priority and placement.
+        /// \param count  [in] The number of work items to add.
+        /// \param initial_state
+        ///               [in] The initial state of all of the newly created
+        ///               threads (thread_state#pending, or \a
+        ///               thread_state#suspended).
+        virtual void
+        register_work_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws) = 0;
+
         /// The function \a register_thread adds a new work item to the thread
         /// manager. It creates a new \a thread, adds it to the internal
         /// management data structures, and schedules the new thread, if
@@ -92,6 +92,24 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             error_code& ec = throws);
 
+        /// The function \a register_work_bulk adds the given number of work
+        /// items to the thread manager at once. The task descriptions of all
+        /// of them are allocated in one block and are handed to the scheduler
+        /// at once, which is considerably cheaper than calling
+        /// \a register_work for each of them.
+        ///
+        /// \param data   [in] Points to the first of \a count consecutive
+        ///               \a thread_init_data instances. All of them must
+        ///               share the same priority and placement.
+        /// \param count  [in] The number of work items to add.
+        /// \param initial_state
+        ///               [in] The initial state of all of the newly created
+        ///               threads (thread_state#pending, or \a
+        ///               thread_state#suspended).
+        void register_work_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws);
+
         /// The function \a register_thread adds a new work item to the thread
         /// manager. It creates a new \a thread, adds it to the internal
         /// management data structures, and schedules the new thread, if
@@ -347,7 +365,8 @@ namespace hpx { namespace threads
         /// \param priority   [in] The priority with which the thread will be
         ///                   executed if the parameter \a new_state is pending.
         ///
-        /// \returns
+        /// \returns         An invalid thread id, the timer is handled by the
+        ///                   timer wheel of the scheduler.
         thread_id_type set_state (time_type const& expire_at,
             thread_id_type const& id, thread_state_enum newstate = pending,
             thread_state_ex_enum newstate_ex = wait_timeout,
@@ -370,7 +389,8 @@ namespace hpx { namespace threads
         /// \param priority   [in] The priority with which the thread will be
         ///                   executed if the parameter \a new_state is pending.
         ///
-        /// \returns
+        /// \returns         An invalid thread id, the timer is handled by the
+        ///                   timer wheel of the scheduler.
         thread_id_type set_state (duration_type const& expire_from_now,
             thread_id_type const& id, thread_state_enum newstate = pending,
             thread_state_ex_enum newstate_ex = wait_timeout,
@@ -443,6 +463,12 @@ namespace hpx { namespace threads
         boost::int64_t avg_idle_rate(bool reset);
         boost::int64_t avg_idle_rate(std::size_t num_thread, bool reset);
 
+        /// Get percent of time the worker threads were parked (or spinning
+        /// while idle) in main thread-manager loop.
+        boost::int64_t avg_park_rate(bool parked, bool reset);
+        boost::int64_t avg_park_rate(std::size_t num_thread, bool parked,
+            bool reset);
+
 #if HPX_THREAD_MAINTAIN_CREATION_AND_CLEANUP_RATES
         boost::int64_t avg_creation_idle_rate(bool reset);
         boost::int64_t avg_cleanup_idle_rate(bool reset);
@@ -453,8 +479,6 @@ namespace hpx { namespace threads
         void tfunc(std::size_t num_thread, topology const& topology_);
         void tfunc_impl(std::size_t num_thread);
 
-        void idle_callback(std::size_t num_thread);
-
     public:
         /// this notifies the thread manager that there is some more work
         /// available
@@ -527,6 +551,9 @@ namespace hpx { namespace threads
             performance_counters::counter_info const& info, error_code& ec);
         naming::gid_type idle_rate_counter_creator(
             performance_counters::counter_info const& info, error_code& ec);
+        naming::gid_type park_rate_counter_creator(
+            performance_counters::counter_info const& info, error_code& ec,
+            bool parked);
 #if HPX_THREAD_MAINTAIN_QUEUE_WAITTIME
         naming::gid_type thread_wait_time_counter_creator(
             performance_counters::counter_info const& info, error_code& ec);
@@ -558,7 +585,7 @@ namespace hpx { namespace threads
         notification_policy_type& notifier_;
 
         // tfunc_impl timers
-        std::vector<boost::uint64_t> exec_times, tfunc_times;
+        std::vector<boost::uint64_t> exec_times, tfunc_times, park_times;
 
         // Stores the mask identifying all processing units used by this
         // thread manager.
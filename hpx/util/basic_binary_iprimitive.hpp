@@ -90,6 +90,19 @@ namespace hpx { namespace util
             size_ += count;
         }
 
+        bool load_shared_chunk(boost::shared_array<char>& data,
+            std::size_t count)
+        {
+            if (0 == count || (flags() & disable_data_chunking))
+                return false;
+
+            if (!buffer_->load_shared_chunk(data, count))
+                return false;
+
+            size_ += count;
+            return true;
+        }
+
 #ifndef BOOST_NO_MEMBER_TEMPLATE_FRIENDS
         friend class load_access;
     protected:
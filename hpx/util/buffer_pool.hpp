@@ -1,4 +1,5 @@
 //  Copyright (c)      2013 Thomas Heller
+//  Copyright (c) 2007-2014 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,86 +8,263 @@
 #define HPX_UTIL_BUFFER_POOL_HPP
 
 #include <hpx/hpx_fwd.hpp>
+#include <hpx/util/assert.hpp>
 
-#include <vector>
-#include <list>
-#include <map>
-
-#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/lockfree/stack.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
 
-namespace hpx { namespace util {
+#include <algorithm>
+#include <vector>
 
-    // This class holds shared_ptr of vector<T, Allocator> with a power of two
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The buffer_pool caches vector<T, Allocator> instances for reuse. All
+    // buffers are sorted into power of two size classes (from 2^min_size_class
+    // to 2^max_size_class elements), buffers outside of this range are never
+    // retained.
+    //
+    // The pool is thread-safe and lock-free. It is split into shards (one per
+    // core by default) to keep the threads from contending on the same
+    // memory locations. A thread first looks into its own shard and steals
+    // from the other shards only if its own shard has no matching buffer.
+    //
+    // The amount of retained memory is bounded both by the number of buffers
+    // per size class and shard and by the overall number of retained bytes.
     template <typename T, typename Allocator = std::allocator<T> >
-    struct buffer_pool
+    class buffer_pool : boost::noncopyable
     {
+    public:
         typedef std::vector<T, Allocator> buffer_type;
-        typedef boost::shared_ptr<buffer_type> shared_buffer_type;
         typedef typename buffer_type::size_type size_type;
-        typedef std::map<size_type, std::list<shared_buffer_type> > buffer_map_type;
 
-        shared_buffer_type get_buffer(size_type size)
+        enum
+        {
+            min_size_class = 10,        // 1K elements
+            max_size_class = 26,        // 64M elements
+            num_size_classes = max_size_class - min_size_class + 1
+        };
+
+    private:
+        typedef boost::lockfree::stack<buffer_type*> stack_type;
+
+        struct shard
         {
-            size_type capacity = next_power_of_two(size);
-            typename buffer_map_type::iterator it = buffers_.find(capacity);
-            shared_buffer_type res;
-            if(it == buffers_.end() || it->second.empty())
+            shard()
             {
-                res.reset(new buffer_type());
-                res->reserve(capacity);
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                    counts_[i].store(0);
             }
-            else
+
+            ~shard()
             {
-                res = it->second.front();
-                it->second.pop_front();
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    buffer_type* p = 0;
+                    while (buffers_[i].pop(p))
+                        delete p;
+                }
             }
-            return res;
+
+            stack_type buffers_[num_size_classes];
+            boost::atomic<std::size_t> counts_[num_size_classes];
+        };
+
+    public:
+        /// \param max_retained_bytes  the maximum overall size of all buffers
+        ///                            kept by the pool
+        /// \param max_buffers         the maximum number of buffers kept for
+        ///                            each size class in each shard
+        /// \param num_shards          the number of shards to use, defaults
+        ///                            to the number of cores
+        explicit buffer_pool(std::size_t max_retained_bytes = 64*1024*1024,
+                std::size_t max_buffers = 8, std::size_t num_shards = 0)
+          : num_shards_(num_shards ? num_shards :
+                (std::max)(1u, boost::thread::hardware_concurrency())),
+            shards_(new shard[num_shards_]),
+            max_retained_bytes_(max_retained_bytes),
+            max_buffers_(max_buffers),
+            retained_bytes_(0), hits_(0), misses_(0)
+        {}
+
+        ~buffer_pool()
+        {
+            buffer_type* p = 0;
+            while (shells_.pop(p))
+                delete p;
         }
 
-        void reclaim_buffer(shared_buffer_type buffer)
+        /// Return an empty buffer able to hold at least \a size elements
+        /// without reallocation.
+        buffer_type get_buffer(size_type size)
         {
-            size_type capacity = next_power_of_two(buffer->capacity());
-            buffer->clear();
-            if(capacity != buffer->capacity())
+            buffer_type result;
+
+            std::size_t size_class = get_size_class(size);
+            if (size_class < num_size_classes)
             {
-                buffer->reserve(capacity);
+                std::size_t const own = get_shard_num();
+                for (std::size_t i = 0; i != num_shards_; ++i)
+                {
+                    buffer_type* p = 0;
+                    shard& s = shards_[(own + i) % num_shards_];
+                    if (s.buffers_[size_class].pop(p))
+                    {
+                        --s.counts_[size_class];
+                        retained_bytes_ -= p->capacity() * sizeof(T);
+                        ++hits_;
+
+                        result.swap(*p);
+                        shells_.push(p);
+                        return result;
+                    }
+                }
+                size = size_type(1) << (size_class + min_size_class);
+            }
+
+            ++misses_;
+            result.reserve(size);
+            return result;
+        }
+
+        /// Hand a buffer back to the pool. The buffer is left empty. Its
+        /// memory is released if the pool already retains enough buffers of
+        /// the same size.
+        void reclaim_buffer(buffer_type& buffer)
+        {
+            buffer_type tmp;
+            tmp.swap(buffer);
+
+            size_type const capacity = tmp.capacity();
+            std::size_t size_class = get_reclaim_size_class(capacity);
+            if (size_class >= num_size_classes)
+                return;
+
+            std::size_t const bytes = capacity * sizeof(T);
+            if (retained_bytes_.fetch_add(bytes) + bytes > max_retained_bytes_)
+            {
+                retained_bytes_ -= bytes;
+                return;
             }
 
-            typename buffer_map_type::iterator it = buffers_.find(capacity);
-            if(it == buffers_.end())
+            shard& s = shards_[get_shard_num()];
+            if (s.counts_[size_class].fetch_add(1) >= max_buffers_)
             {
-                it = buffers_.insert(it, std::make_pair(capacity, std::list<shared_buffer_type>()));
+                --s.counts_[size_class];
+                retained_bytes_ -= bytes;
+                return;
             }
-            it->second.push_back(buffer);
+
+            buffer_type* p = 0;
+            if (!shells_.pop(p))
+                p = new buffer_type();
+
+            tmp.clear();
+            p->swap(tmp);
+            s.buffers_[size_class].push(p);
         }
 
+        /// Release all retained buffers. This function is not thread-safe.
         void clear()
         {
-            buffers_.clear();
+            for (std::size_t j = 0; j != num_shards_; ++j)
+            {
+                shard& s = shards_[j];
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    buffer_type* p = 0;
+                    while (s.buffers_[i].pop(p))
+                    {
+                        buffer_type().swap(*p);
+                        shells_.push(p);
+                    }
+                    s.counts_[i].store(0);
+                }
+            }
+            retained_bytes_.store(0);
+        }
+
+        // statistics
+        boost::int64_t get_hits(bool reset)
+        {
+            return reset ? hits_.exchange(0) : hits_.load();
+        }
+
+        boost::int64_t get_misses(bool reset)
+        {
+            return reset ? misses_.exchange(0) : misses_.load();
+        }
+
+        // the number of retained bytes can't be reset
+        boost::int64_t get_retained_bytes(bool /*reset*/ = false) const
+        {
+            return static_cast<boost::int64_t>(retained_bytes_.load());
         }
 
     private:
-        buffer_map_type buffers_;
+        std::size_t get_shard_num() const
+        {
+            // HPX worker threads use their own shard, all other threads (for
+            // instance the threads running the parcelport io_service
+            // objects) are spread across the shards based on their id.
+            std::size_t num = hpx::get_worker_thread_num();
+            if (num == std::size_t(-1))
+                num = boost::hash<boost::thread::id>()(boost::this_thread::get_id());
+            return num % num_shards_;
+        }
 
-        static size_type next_power_of_two(size_type size)
+        // Return the smallest size class holding buffers of at least the
+        // given size, this returns num_size_classes if the size is too large
+        // to be pooled.
+        static std::size_t get_size_class(size_type size)
         {
-            // Check if we already have a power of two
-            // http://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
-            if(size && !(size & (size - 1)))
-                return size;
-            size--;
-            size |= size >> 1;
-            size |= size >> 2;
-            size |= size >> 4;
-            size |= size >> 8;
-            size |= size >> 16;
-            if(sizeof(size_type) == 8)
+            std::size_t size_class = 0;
+            while (size > (size_type(1) << (size_class + min_size_class)))
             {
-                size |= size >> 32; //-V112
+                if (++size_class == num_size_classes)
+                    break;
             }
-            size++;
-            return size;
+            return size_class;
         }
+
+        // Return the largest size class the given capacity is sufficient for,
+        // returns num_size_classes if the buffer should not be pooled.
+        static std::size_t get_reclaim_size_class(size_type capacity)
+        {
+            if (capacity < (size_type(1) << min_size_class))
+                return num_size_classes;
+
+            std::size_t size_class = 0;
+            while (size_class + 1 != num_size_classes &&
+                capacity >= (size_type(1) << (size_class + 1 + min_size_class)))
+            {
+                ++size_class;
+            }
+
+            // don't keep buffers much larger than the largest size class
+            if (capacity >= (size_type(2) << max_size_class))
+                return num_size_classes;
+
+            return size_class;
+        }
+
+        std::size_t const num_shards_;
+        boost::scoped_array<shard> shards_;
+
+        // empty buffer objects, reused for storing reclaimed buffers
+        stack_type shells_;
+
+        std::size_t const max_retained_bytes_;
+        std::size_t const max_buffers_;
+
+        boost::atomic<std::size_t> retained_bytes_;
+        boost::atomic<boost::int64_t> hits_;
+        boost::atomic<boost::int64_t> misses_;
     };
 }}
 
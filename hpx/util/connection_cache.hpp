@@ -17,19 +17,24 @@
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/tuple.hpp>
 
+#include <deque>
 #include <map>
-#include <list>
 #include <stdexcept>
 #include <string>
 
-#include <boost/shared_ptr.hpp>
-#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util
@@ -37,34 +42,52 @@ namespace hpx { namespace util
     ///////////////////////////////////////////////////////////////////////////
     /// This class implements an LRU cache to hold connections. It includes
     /// entries checked out from the cache in its cache size.
-    // TODO: investigate usage of boost.cache.
-    template <typename Connection, typename Key>
-    class connection_cache
+    ///
+    /// The cache is split into stripes, each of which holds the entries for
+    /// a subset of the keys (selected by their hash value) and is protected
+    /// by its own lock. Getting and reclaiming connections for a key only
+    /// ever locks the stripe of that key, so threads sending to different
+    /// localities do not contend with each other. The eviction of entries
+    /// is approximately LRU: the least recently used entry of a stripe is
+    /// evicted first, stripes are visited round robin.
+    template <typename Connection, typename Key, typename Hash = boost::hash<Key> >
+    class connection_cache : boost::noncopyable
     {
     public:
-        typedef boost::recursive_mutex mutex_type;
+        typedef lcos::local::spinlock mutex_type;
 
         typedef boost::shared_ptr<Connection> connection_type;
         typedef std::deque<connection_type> value_type;
         typedef Key key_type;
-        typedef std::list<key_type> key_tracker_type;
         typedef util::tuple<
             value_type,                 // cached (available) connections
             std::size_t,                // number of existing connections
             std::size_t,                // max number of cached connections
-            typename key_tracker_type::iterator     // reference into LRU list
+            boost::uint64_t             // time of last use (LRU meta data)
         > cache_value_type;
         typedef std::map<key_type, cache_value_type> cache_type;
         typedef typename cache_type::size_type size_type;
 
+    private:
+        struct stripe
+        {
+            mutable mutex_type mtx_;
+            cache_type cache_;
+        };
+
+    public:
         connection_cache(
             size_type max_connections
           , size_type max_connections_per_locality
+          , std::size_t num_stripes = 64
         )
           : max_connections_(max_connections < 2 ? 2 : max_connections)
           , max_connections_per_locality_(
                 max_connections_per_locality < 2 ? 2 : max_connections_per_locality)
+          , num_stripes_(num_stripes ? num_stripes : 1)
+          , stripes_(new stripe[num_stripes_])
           , connections_(0)
+          , next_eviction_stripe_(0)
           , shutting_down_(false)
           , insertions_(0)
           , evictions_(0)
@@ -120,17 +143,28 @@ namespace hpx { namespace util
             return util::get<2>(entry);
         }
 
-        static typename key_tracker_type::iterator&
-        lru_reference(cache_value_type& entry)
+        static boost::uint64_t&
+        last_use(cache_value_type& entry)
         {
             return util::get<3>(entry);
         }
-        static typename key_tracker_type::iterator const&
-        lru_reference(cache_value_type const& entry)
+        static boost::uint64_t const&
+        last_use(cache_value_type const& entry)
         {
             return util::get<3>(entry);
         }
 
+        // Update LRU meta data.
+        static void touch(cache_value_type& entry)
+        {
+            last_use(entry) = util::high_resolution_clock::now();
+        }
+
+        stripe& get_stripe(key_type const& l) const
+        {
+            return stripes_[hash_(l) % num_stripes_];
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // Increase the per-locality and overall connection counts.
         void increment_connection_count(cache_value_type& e)
@@ -176,22 +210,17 @@ namespace hpx { namespace util
         ///          \a reclaim().
         connection_type get(key_type const& l)
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
-
-                // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                  , key_tracker_
-                  , lru_reference(it->second)
-                );
+                touch(it->second);
 
                 // If connections to the locality are available in the cache,
                 // remove the oldest one and return it.
@@ -202,14 +231,14 @@ namespace hpx { namespace util
                     connections.pop_front();
 
                     ++hits_;
-                    check_invariants();
+                    check_invariants(s);
                     return result;
                 }
             }
 
             // If we get here then the item is not in the cache.
             ++misses_;
-            check_invariants();
+            check_invariants(s);
             return connection_type();
         }
 
@@ -233,21 +262,16 @@ namespace hpx { namespace util
         bool get_or_reserve(key_type const& l, connection_type& conn,
             bool force_insert = false)
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
-            typename cache_type::iterator const it = cache_.find(l);
+            typename cache_type::iterator const it = s.cache_.find(l);
 
             // Check if this key already exists in the cache.
-            if (it != cache_.end())
+            if (it != s.cache_.end())
             {
                 // Key exists in cache.
-
-                // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                  , key_tracker_
-                  , lru_reference(it->second)
-                );
+                touch(it->second);
 
                 // If connections to the locality are available in the cache,
                 // remove the oldest one and return it.
@@ -261,7 +285,7 @@ namespace hpx { namespace util
                     conn->set_state(Connection::state_reinitialized);
 #endif
                     ++hits_;
-                    check_invariants();
+                    check_invariants(s);
                     return true;
                 }
 
@@ -279,13 +303,13 @@ namespace hpx { namespace util
                     // reduced in size next time some connection is handed back
                     // to the cache).
 
-                    if (!free_space() &&
+                    if (!free_space(s, l) &&
                         num_existing_connections(it->second) != 0 &&
                         !force_insert)
                     {
                         // If we can't find or make space, give up.
                         ++misses_;
-                        check_invariants();
+                        check_invariants(s);
                         return false;
                     }
 
@@ -298,7 +322,7 @@ namespace hpx { namespace util
 
                     // Statistics
                     ++insertions_;
-                    check_invariants();
+                    check_invariants(s);
                     return true;
                 }
 
@@ -306,7 +330,7 @@ namespace hpx { namespace util
                 // locality, and none of them are checked into the cache, so
                 // we have to give up.
                 ++misses_;
-                check_invariants();
+                check_invariants(s);
                 return false;
             }
 
@@ -320,15 +344,12 @@ namespace hpx { namespace util
             // fails we grow the cache size beyond its limit (hoping that it
             // will be reduced in size next time some connection is handed back
             // to the cache).
-            free_space();
+            free_space(s, l);
 
-            // Update LRU meta data.
-            typename key_tracker_type::iterator kt =
-                key_tracker_.insert(key_tracker_.end(), l);
-
-            cache_.insert(std::make_pair(
+            s.cache_.insert(std::make_pair(
                 l, util::make_tuple(
-                    value_type(), 1, max_connections_per_locality_, kt
+                    value_type(), 1, max_connections_per_locality_,
+                    util::high_resolution_clock::now()
                 ))
             );
 
@@ -339,7 +360,7 @@ namespace hpx { namespace util
             ++connections_;
 
             ++insertions_;
-            check_invariants();
+            check_invariants(s);
             return true;
         }
 
@@ -349,18 +370,14 @@ namespace hpx { namespace util
         ///       a prior call to \a get() or \a get_or_reserve().
         void reclaim(key_type const& l, connection_type const& conn)
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
             // Search for an entry for this key.
-            typename cache_type::iterator const ct = cache_.find(l);
+            typename cache_type::iterator const ct = s.cache_.find(l);
 
-            if (ct != cache_.end()) {
-                // Update LRU meta data.
-                key_tracker_.splice(
-                    key_tracker_.end()
-                    , key_tracker_
-                    , lru_reference(ct->second)
-                    );
+            if (ct != s.cache_.end()) {
+                touch(ct->second);
 
                 // Return the connection back to the cache only if the number
                 // of connections does not need to be shrunk.
@@ -391,7 +408,7 @@ namespace hpx { namespace util
 
                 // FIXME: Again, this should probably throw instead of asserting,
                 // as invariants could be invalidated here due to caller error.
-                check_invariants();
+                check_invariants(s);
             }
             else {
                 // Key should already exist in the cache. FIXME: This should
@@ -404,7 +421,6 @@ namespace hpx { namespace util
         /// than the maximum number of overall connections, and false otherwise.
         bool full() const
         {
-            mutex_type::scoped_lock lock(mtx_);
             return (connections_ >= max_connections_);
         }
 
@@ -412,13 +428,13 @@ namespace hpx { namespace util
         /// than the maximum connection count per locality, and false otherwise.
         bool full(key_type const& l) const
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
-            if (!cache_.count(l))
+            typename cache_type::const_iterator ct = s.cache_.find(l);
+            if (ct == s.cache_.end())
                 return false || (connections_ >= max_connections_);
 
-            typename cache_type::const_iterator ct = cache_.find(l);
-            HPX_ASSERT(ct != cache_.end());
             return (num_existing_connections(ct->second) >= max_num_connections(ct->second))
                 || (connections_ >= max_connections_);
         }
@@ -430,9 +446,12 @@ namespace hpx { namespace util
         ///       invariants.
         void clear()
         {
-            mutex_type::scoped_lock lock(mtx_);
-            key_tracker_.clear();
-            cache_.clear();
+            // lock all stripes, always in the same order
+            for (std::size_t i = 0; i != num_stripes_; ++i)
+                stripes_[i].mtx_.lock();
+
+            for (std::size_t i = 0; i != num_stripes_; ++i)
+                stripes_[i].cache_.clear();
             connections_ = 0;
 
             insertions_ = 0;
@@ -441,9 +460,8 @@ namespace hpx { namespace util
             misses_ = 0;
             reclaims_ = 0;
 
-            // FIXME: This should probably throw instead of asserting, as it
-            // can be triggered by caller error.
-            check_invariants();
+            for (std::size_t i = num_stripes_; i != 0; --i)
+                stripes_[i-1].mtx_.unlock();
         }
 
         /// Destroys all connections for the given locality in the cache, reset
@@ -454,26 +472,24 @@ namespace hpx { namespace util
         ///       invariants.
         void clear(key_type const& l)
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator const it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
-                // Remove from LRU meta data.
-                key_tracker_.erase(lru_reference(it->second));
-
                 // correct counter to avoid assertions later on
                 connections_ -= num_existing_connections(it->second);
                 evictions_ += num_existing_connections(it->second);
 
                 // Erase entry if key exists in the cache.
-                cache_.erase(it);
+                s.cache_.erase(it);
             }
 
             // FIXME: This should probably throw instead of asserting, as it
             // can be triggered by caller error.
-            check_invariants();
+            check_invariants(s);
         }
 
         /// Destroys all connections for the given locality in the cache, reset
@@ -484,11 +500,12 @@ namespace hpx { namespace util
         ///       invariants.
         void clear(key_type const& l, connection_type const& conn)
         {
-            mutex_type::scoped_lock lock(mtx_);
+            stripe& s = get_stripe(l);
+            mutex_type::scoped_lock lock(s.mtx_);
 
             // Check if this key already exists in the cache.
-            typename cache_type::iterator const it = cache_.find(l);
-            if (it != cache_.end())
+            typename cache_type::iterator const it = s.cache_.find(l);
+            if (it != s.cache_.end())
             {
                 // Adjust the number of existing connections for this key.
                 decrement_connection_count(it->second);
@@ -502,50 +519,45 @@ namespace hpx { namespace util
 #endif
             }
 
-            check_invariants();
+            check_invariants(s);
         }
 
         // access statistics
         boost::int64_t get_cache_insertions(bool reset)
         {
-            mutex_type::scoped_lock lock(mtx_);
             return util::get_and_reset_value(insertions_, reset);
         }
 
         boost::int64_t get_cache_evictions(bool reset)
         {
-            mutex_type::scoped_lock lock(mtx_);
             return util::get_and_reset_value(evictions_, reset);
         }
 
         boost::int64_t get_cache_hits(bool reset)
         {
-            mutex_type::scoped_lock lock(mtx_);
             return util::get_and_reset_value(hits_, reset);
         }
 
         boost::int64_t get_cache_misses(bool reset)
         {
-            mutex_type::scoped_lock lock(mtx_);
             return util::get_and_reset_value(misses_, reset);
         }
 
         boost::int64_t get_cache_reclaims(bool reset)
         {
-            mutex_type::scoped_lock lock(mtx_);
             return util::get_and_reset_value(reclaims_, reset);
         }
 
     private:
-        /// Verify class invariants
-        void check_invariants() const
+        /// Verify class invariants for the given (locked) stripe
+        void check_invariants(stripe const& s) const
         {
 #if defined(HPX_DEBUG)
             typedef typename cache_type::const_iterator const_iterator;
 
-            size_type in_cache_count = 0, total_count = 0;
-            const_iterator end = cache_.end();
-            for (const_iterator ct = cache_.begin(); ct != end; ++ct)
+            size_type in_cache_count = 0;
+            const_iterator end = s.cache_.end();
+            for (const_iterator ct = s.cache_.begin(); ct != end; ++ct)
             {
                 cache_value_type const& val = ct->second;
 
@@ -553,75 +565,94 @@ namespace hpx { namespace util
                 // existing elements, not only those in the cache entry.
                 HPX_ASSERT(cached_connections(val).size() <= num_existing_connections(val));
 
-                // Count all connections (both those in the cache and those
-                // checked out of the cache).
+                // Count all connections which are in the cache.
                 in_cache_count += cached_connections(val).size();
-                total_count += num_existing_connections(val);
             }
 
             // Overall connection count should be larger than or equal to the
             // number of entries in the cache.
             HPX_ASSERT(in_cache_count <= connections_);
-
-            // Overall connection count should be equal to the sum of connection
-            // counts for all localities.
-            HPX_ASSERT(total_count == connections_);
-
-            // The list of key trackers should have the same size as the cache.
-            HPX_ASSERT(key_tracker_.size() == cache_.size());
 #endif
         }
 
-        /// Evict the least recently used removable entry from the cache if the
-        /// cache is full.
+        /// Evict the least recently used removable entries from the cache if
+        /// the cache is full. The stripe \a own has to be locked by the
+        /// caller, the entry for \a l (which is in this stripe) is not removed.
         ///
         /// \returns Returns true if an entry was evicted or if the cache is not
         ///          full, and false if nothing could be evicted.
-        bool free_space()
+        bool free_space(stripe& own, key_type const& l)
         {
             // If the cache isn't full, just return true.
             if (connections_ < max_connections_)
                 return true;
 
-            // Find the least recently used key.
-            typename key_tracker_type::iterator kt = key_tracker_.begin();
+            // Visit all stripes, starting with a different one every time.
+            // Other stripes are skipped if they are currently locked, which
+            // also avoids any lock ordering problems.
+            std::size_t const start = next_eviction_stripe_++;
+            for (std::size_t i = 0; i != num_stripes_; ++i)
+            {
+                stripe& s = stripes_[(start + i) % num_stripes_];
+                if (&s == &own)
+                {
+                    if (evict_connections(s, &l))
+                        return true;
+                }
+                else
+                {
+                    mutex_type::scoped_try_lock lock(s.mtx_);
+                    if (lock && evict_connections(s, 0))
+                        return true;
+                }
+            }
+
+            return connections_ < max_connections_;
+        }
+
+        /// Evict cached connections from the given (locked) stripe, least
+        /// recently used entries first, until the cache is not full anymore.
+        /// Entries without any connections are removed, except the one for
+        /// \a keep.
+        bool evict_connections(stripe& s, key_type const* keep)
+        {
+            typedef typename cache_type::iterator iterator;
 
             while (connections_ >= max_connections_)
             {
-                // Find the least recently used keys data.
-                const typename cache_type::iterator ct = cache_.find(*kt);
-                HPX_ASSERT(ct != cache_.end());
-
-                // If the entry is empty, ignore it and try the next least
-                // recently used entry.
-                if (cached_connections(ct->second).empty())
+                // Find the least recently used entry holding a cached
+                // connection.
+                iterator lru = s.cache_.end();
+                for (iterator ct = s.cache_.begin(); ct != s.cache_.end(); /**/)
                 {
-                    // Remove the key if its connection count is zero.
-                    if (0 == num_existing_connections(ct->second)) {
-                        cache_.erase(ct);
-                        key_tracker_.erase(kt);
-                        kt = key_tracker_.begin();
+                    if (cached_connections(ct->second).empty())
+                    {
+                        // Remove the key if its connection count is zero.
+                        if (0 == num_existing_connections(ct->second) &&
+                            (keep == 0 || !(ct->first == *keep)))
+                        {
+                            s.cache_.erase(ct++);
+                            continue;
+                        }
                     }
-                    else {
-                        // REVIEW: Should we reorder key_tracker_ to speed up
-                        // the eviction?
-                        ++kt;
+                    else if (lru == s.cache_.end() ||
+                        last_use(ct->second) < last_use(lru->second))
+                    {
+                        lru = ct;
                     }
-
-                    // If we've gone through key_tracker_ and haven't found
-                    // anything evict-able, then all the entries must be
-                    // currently checked out.
-                    if (key_tracker_.end() == kt)
-                        return false;
-
-                    continue;
+                    ++ct;
                 }
 
+                // If we haven't found anything evict-able, then all the
+                // entries must be currently checked out.
+                if (lru == s.cache_.end())
+                    return false;
+
                 // Remove the oldest connection.
-                cached_connections(ct->second).pop_front();
+                cached_connections(lru->second).pop_front();
 
                 // Adjust the overall and per-locality connection count.
-                decrement_connection_count(ct->second);
+                decrement_connection_count(lru->second);
 
                 // Statistics
                 ++evictions_;
@@ -630,20 +661,23 @@ namespace hpx { namespace util
             return true;
         }
 
-        mutable mutex_type mtx_;
         size_type const max_connections_;
         size_type const max_connections_per_locality_;
-        key_tracker_type key_tracker_;
-        cache_type cache_;
-        size_type connections_;
+
+        std::size_t const num_stripes_;
+        boost::scoped_array<stripe> stripes_;
+        Hash hash_;
+
+        boost::atomic<size_type> connections_;
+        boost::atomic<std::size_t> next_eviction_stripe_;
         bool shutting_down_;
 
         // statistics support
-        boost::int64_t insertions_;
-        boost::int64_t evictions_;
-        boost::int64_t hits_;
-        boost::int64_t misses_;
-        boost::int64_t reclaims_;
+        boost::atomic<boost::int64_t> insertions_;
+        boost::atomic<boost::int64_t> evictions_;
+        boost::atomic<boost::int64_t> hits_;
+        boost::atomic<boost::int64_t> misses_;
+        boost::atomic<boost::int64_t> reclaims_;
     };
 }}
 
@@ -267,6 +267,19 @@ namespace hpx { namespace util { namespace coroutines
           return ++get_stack_recycle_counter();
       }
 
+      static boost::uint64_t get_stack_allocation_count(bool reset)
+      {
+          return posix::get_stack_allocation_count(reset);
+      }
+      static boost::uint64_t get_stack_reuse_count(bool reset)
+      {
+          return posix::get_stack_reuse_count(reset);
+      }
+      static boost::uint64_t get_stack_cache_bytes(bool reset)
+      {
+          return posix::get_stack_cache_bytes(reset);
+      }
+
       friend void swap_context(x86_linux_context_impl_base& from,
           x86_linux_context_impl const& to, default_hint);
 
@@ -284,6 +297,8 @@ namespace hpx { namespace util { namespace coroutines
 
       static void thread_shutdown()
       {
+          // release all stacks cached by this OS thread
+          posix::release_cached_stacks();
       }
 
     private:
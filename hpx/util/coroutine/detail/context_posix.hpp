@@ -237,7 +237,11 @@ namespace hpx { namespace util { namespace coroutines {
         // global functions to be called for each OS-thread after it started
         // running and before it exits
         static void thread_startup(char const* thread_type) {}
-        static void thread_shutdown() {}
+        static void thread_shutdown()
+        {
+            // release all stacks cached by this OS thread
+            posix::release_cached_stacks();
+        }
 
         void reset_stack() {}
         void rebind_stack()
@@ -267,6 +271,19 @@ namespace hpx { namespace util { namespace coroutines {
             return ++get_stack_recycle_counter();
         }
 
+        static boost::uint64_t get_stack_allocation_count(bool reset)
+        {
+            return posix::get_stack_allocation_count(reset);
+        }
+        static boost::uint64_t get_stack_reuse_count(bool reset)
+        {
+            return posix::get_stack_reuse_count(reset);
+        }
+        static boost::uint64_t get_stack_cache_bytes(bool reset)
+        {
+            return posix::get_stack_cache_bytes(reset);
+        }
+
     private:
         // declare m_stack_size first so we can use it to initialize m_stack
         std::ptrdiff_t m_stack_size;
@@ -46,6 +46,8 @@
 
 #include <new>
 #include <iostream>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/type_traits.hpp>
 
 #if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
@@ -65,12 +67,36 @@
 namespace hpx { namespace util { namespace coroutines { namespace detail { namespace posix {
 
 HPX_EXPORT extern bool use_guard_pages;
+HPX_EXPORT extern bool use_huge_pages;
+HPX_EXPORT extern std::size_t stack_cache_high_water_mark;
+
+/**
+ * Statistics about the stack allocations, exposed as performance counters.
+ */
+HPX_EXPORT boost::uint64_t get_stack_allocation_count(bool reset);
+HPX_EXPORT boost::uint64_t get_stack_reuse_count(bool reset);
+HPX_EXPORT boost::uint64_t get_stack_cache_bytes(bool reset);
+HPX_EXPORT void increment_stack_allocation_count();
+
+/**
+ * Each OS thread keeps a cache of the stacks freed on it (up to
+ * stack_cache_high_water_mark stacks per OS thread). Stacks are taken from
+ * the cache of the OS thread allocating a new stack, which keeps the stack
+ * memory on the NUMA domain which touched it first and avoids the page
+ * faults for freshly mapped stacks. get_cached_stack() returns zero if no
+ * stack of the given size is available, cache_stack() returns false if the
+ * stack was not added to the cache. release_cached_stacks() unmaps all
+ * stacks cached by the calling OS thread.
+ */
+HPX_EXPORT void* get_cached_stack(std::size_t size);
+HPX_EXPORT bool cache_stack(void* stack, std::size_t size);
+HPX_EXPORT void release_cached_stacks();
 
 #if defined(HPX_USE_MMAP) && defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
 
   inline
   void*
-  alloc_stack(std::size_t size) {
+  map_stack(std::size_t size) {
     void* real_stack = ::mmap(NULL,
                               size + EXEC_PAGESIZE,
                               PROT_EXEC|PROT_READ|PROT_WRITE,
@@ -89,6 +115,15 @@ HPX_EXPORT extern bool use_guard_pages;
         throw std::runtime_error("mmap() failed to allocate thread stack");
     }
 
+    increment_stack_allocation_count();
+
+#if defined(MADV_HUGEPAGE)
+    // Ask for transparent huge pages to back the stack. This is useful only
+    // for stacks spanning at least one huge page (i.e. huge stacks).
+    if (use_huge_pages)
+        ::madvise(real_stack, size + EXEC_PAGESIZE, MADV_HUGEPAGE);
+#endif
+
 #if HPX_THREAD_GUARD_PAGE
     if (use_guard_pages) {
         // Add a guard page.
@@ -112,6 +147,22 @@ HPX_EXPORT extern bool use_guard_pages;
     *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
   }
 
+  // Hand the given pages back to the system. MADV_FREE is not supported by
+  // kernels older than 4.5, once it failed we use MADV_DONTNEED instead.
+  inline
+  void release_stack_pages(void* addr, std::size_t size) {
+#if defined(MADV_FREE)
+    static boost::atomic<bool> use_madv_free(true);
+    if (use_madv_free.load(boost::memory_order_relaxed))
+    {
+      if (0 == ::madvise(addr, size, MADV_FREE) || EINVAL != errno)
+        return;
+      use_madv_free.store(false, boost::memory_order_relaxed);
+    }
+#endif
+    ::madvise(addr, size, MADV_DONTNEED);
+  }
+
   inline
   bool reset_stack(void* stack, std::size_t size) {
     void** watermark = static_cast<void**>(stack) + ((size - EXEC_PAGESIZE) / sizeof(void*));
@@ -121,8 +172,10 @@ HPX_EXPORT extern bool use_guard_pages;
     if((reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull)) != *watermark)
     {
       // We never free up the first page, as it's initialized only when the
-      // stack is created.
-      ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+      // stack is created. MADV_FREE releases the pages lazily, i.e. only if
+      // the system is under memory pressure, which avoids the page faults
+      // on re-use of the stack otherwise.
+      release_stack_pages(stack, size - EXEC_PAGESIZE);
       return true;
     }
 
@@ -130,7 +183,7 @@ HPX_EXPORT extern bool use_guard_pages;
   }
 
   inline
-  void free_stack(void* stack, std::size_t size) {
+  void unmap_stack(void* stack, std::size_t size) {
 #if HPX_THREAD_GUARD_PAGE
     if (use_guard_pages) {
         void** real_stack = static_cast<void**>(stack) - (EXEC_PAGESIZE / sizeof(void*));
@@ -144,6 +197,24 @@ HPX_EXPORT extern bool use_guard_pages;
 #endif
   }
 
+  inline
+  void* alloc_stack(std::size_t size) {
+    void* stack = get_cached_stack(size);
+    if (0 != stack)
+      return stack;
+    return map_stack(size);
+  }
+
+  inline
+  void free_stack(void* stack, std::size_t size) {
+    // Cached stacks keep their memory, but any pages touched beyond the
+    // first one are handed back lazily (see reset_stack).
+    if (0 != stack_cache_high_water_mark)
+      reset_stack(stack, size);
+    if (!cache_stack(stack, size))
+      unmap_stack(stack, size);
+  }
+
 #else  // non-mmap()
 
   //this should be a fine default.
@@ -164,6 +235,7 @@ HPX_EXPORT extern bool use_guard_pages;
    */
   inline
   void* alloc_stack(std::size_t size) {
+    increment_stack_allocation_count();
     return new stack_aligner[size/sizeof(stack_aligner)];
   }
 
@@ -35,6 +35,7 @@
 #include <hpx/util/function.hpp>
 
 #include <boost/noncopyable.hpp>
+#include <cstddef>
 #include <utility>
 
 namespace hpx { namespace util { namespace coroutines { namespace detail
@@ -191,6 +192,18 @@ namespace hpx { namespace util { namespace coroutines { namespace detail
 #endif
     }
 
+    // The self object is created right when the coroutine starts executing,
+    // thus it lives at the top of the coroutine's stack. The distance to a
+    // local variable approximates the stack space used so far (stacks grow
+    // downwards on all supported platforms).
+    std::ptrdiff_t get_available_stack_space() const
+    {
+      HPX_ASSERT(m_pimpl);
+      char marker = 0;
+      std::ptrdiff_t used = reinterpret_cast<char const*>(this) - &marker;
+      return m_pimpl->get_stacksize() - used;
+    }
+
     explicit coroutine_self(impl_type * pimpl, coroutine_self* next_self = 0)
       : m_pimpl(pimpl), next_self_(next_self)
     {}
@@ -33,6 +33,7 @@ namespace hpx { namespace util { namespace detail
         static void destruct(void ** /*f*/) {}
         static void clone(void *const* /*f*/, void ** /*dest*/) {}
         static void copy(void *const* /*f*/, void ** /*dest*/) {}
+        static void move(void ** /*f*/, void ** /*dest*/) {}
 
         // we can safely return an int here as those function will never
         // be called.
@@ -16,6 +16,7 @@
 #include <hpx/util/detail/vtable_ptr_base_fwd.hpp>
 #include <hpx/util/detail/vtable_ptr_fwd.hpp>
 #include <hpx/util/detail/serialization_registration.hpp>
+#include <hpx/util/detail/is_small_function.hpp>
 #include <hpx/util/safe_bool.hpp>
 #include <hpx/util/move.hpp>
 #include <hpx/util/serialize_empty_type.hpp>
@@ -220,7 +221,7 @@ namespace hpx { namespace util
                     >::create(function_name));
 
                 this->vptr = static_cast<vtable_ptr_type*>(p->get_ptr());
-                this->vptr->load_object(&this->object, ar, version);
+                this->vptr->load_object(this->object, ar, version);
             }
         }
 
@@ -234,7 +235,7 @@ namespace hpx { namespace util
                 std::string function_name = this->vptr->get_function_name();
                 ar.save(function_name);
 
-                this->vptr->save_object(&this->object, ar, version);
+                this->vptr->save_object(this->object, ar, version);
             }
         }
 
@@ -389,15 +390,11 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
 
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
 
         typedef R result_type;
@@ -426,7 +423,6 @@ namespace hpx { namespace util {
             >::type * /*dummy*/ = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
@@ -434,31 +430,29 @@ namespace hpx { namespace util {
                     typename util::decay<Functor>::type
                     functor_type;
 
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *))  // is_small
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
 
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
 
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
 
         function_base &assign(function_base const & other)
@@ -467,14 +461,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -495,19 +489,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *))  // is_small
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -515,13 +509,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *))  // is_small
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -545,10 +539,9 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
 
             return *this;
@@ -556,14 +549,22 @@ namespace hpx { namespace util {
 
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
 
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
 
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
@@ -580,9 +581,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
 
@@ -610,7 +610,7 @@ namespace hpx { namespace util {
 
         BOOST_FORCEINLINE R operator()(BOOST_PP_ENUM_BINARY_PARAMS(N, A, a)) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 BOOST_PP_COMMA_IF(N) HPX_ENUM_FORWARD_ARGS(N, A, a));
         }
 
@@ -630,10 +630,10 @@ namespace hpx { namespace util {
             if (vptr != f_vptr || empty())
                 return 0;
 
-            if (sizeof(functor_type) <= sizeof(void *))  // is_small
-                return reinterpret_cast<functor_type *>(&object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
 
-            return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
 
         template <typename T>
@@ -647,15 +647,15 @@ namespace hpx { namespace util {
             if (vptr != f_vptr || empty())
                 return 0;
 
-            if (sizeof(functor_type) <= sizeof(void *))  // is_small
-                return reinterpret_cast<functor_type const*>(&object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
 
-            return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
 
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 
@@ -9,6 +9,7 @@
 #define HPX_FUNCTION_DETAIL_GET_TABLE_HPP
 
 #include <hpx/config/forceinline.hpp>
+#include <hpx/util/detail/is_small_function.hpp>
 
 #include <boost/preprocessor/iteration/iterate.hpp>
 #include <boost/preprocessor/repetition/enum_params.hpp>
@@ -63,7 +64,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(BOOST_PP_ENUM_PARAMS(N, A))
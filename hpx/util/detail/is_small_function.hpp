@@ -0,0 +1,31 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_DETAIL_IS_SMALL_FUNCTION_HPP
+#define HPX_UTIL_DETAIL_IS_SMALL_FUNCTION_HPP
+
+#include <hpx/config.hpp>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace hpx { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A function object is stored in place (without allocating it on the
+    // heap) if it fits into the HPX_FUNCTION_STORAGE_SIZE pointers reserved
+    // for it by util::function and if it does not require a stricter
+    // alignment than a pointer.
+    template <typename Functor>
+    struct is_small_function
+      : boost::mpl::bool_<
+            sizeof(Functor) <= sizeof(void*) * HPX_FUNCTION_STORAGE_SIZE &&
+            boost::alignment_of<Functor>::value <=
+                boost::alignment_of<void*>::value
+        >
+    {};
+}}}
+
+#endif
@@ -23,14 +23,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -55,36 +51,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -92,14 +85,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -117,19 +110,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -137,13 +130,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -164,22 +157,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -193,9 +193,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -220,7 +219,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()() const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                  );
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -236,9 +235,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -249,13 +248,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -273,14 +272,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -305,36 +300,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -342,14 +334,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -367,19 +359,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -387,13 +379,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -414,22 +406,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -443,9 +442,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -470,7 +468,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -486,9 +484,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -499,13 +497,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -523,14 +521,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -555,36 +549,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -592,14 +583,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -617,19 +608,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -637,13 +628,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -664,22 +655,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -693,9 +691,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -720,7 +717,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -736,9 +733,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -749,13 +746,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -773,14 +770,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -805,36 +798,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -842,14 +832,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -867,19 +857,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -887,13 +877,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -914,22 +904,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -943,9 +940,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -970,7 +966,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -986,9 +982,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -999,13 +995,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -1023,14 +1019,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -1055,36 +1047,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -1092,14 +1081,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -1117,19 +1106,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -1137,13 +1126,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -1164,22 +1153,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -1193,9 +1189,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -1220,7 +1215,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -1236,9 +1231,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -1249,13 +1244,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -1273,14 +1268,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -1305,36 +1296,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -1342,14 +1330,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -1367,19 +1355,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -1387,13 +1375,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -1414,22 +1402,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -1443,9 +1438,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -1470,7 +1464,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -1486,9 +1480,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -1499,13 +1493,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -1523,14 +1517,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -1555,36 +1545,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -1592,14 +1579,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -1617,19 +1604,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -1637,13 +1624,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -1664,22 +1651,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -1693,9 +1687,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -1720,7 +1713,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -1736,9 +1729,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -1749,13 +1742,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -1773,14 +1766,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -1805,36 +1794,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -1842,14 +1828,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -1867,19 +1853,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -1887,13 +1873,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -1914,22 +1900,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -1943,9 +1936,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -1970,7 +1962,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -1986,9 +1978,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -1999,13 +1991,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -2023,14 +2015,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -2055,36 +2043,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -2092,14 +2077,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -2117,19 +2102,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -2137,13 +2122,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -2164,22 +2149,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -2193,9 +2185,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -2220,7 +2211,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -2236,9 +2227,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -2249,13 +2240,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -2273,14 +2264,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -2305,36 +2292,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -2342,14 +2326,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -2367,19 +2351,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -2387,13 +2371,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -2414,22 +2398,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -2443,9 +2434,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -2470,7 +2460,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7 , A8 a8) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ) , std::forward<A8>( a8 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -2486,9 +2476,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -2499,13 +2489,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -2523,14 +2513,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -2555,36 +2541,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -2592,14 +2575,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -2617,19 +2600,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -2637,13 +2620,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -2664,22 +2647,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -2693,9 +2683,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -2720,7 +2709,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7 , A8 a8 , A9 a9) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ) , std::forward<A8>( a8 ) , std::forward<A9>( a9 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -2736,9 +2725,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -2749,13 +2738,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -2773,14 +2762,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -2805,36 +2790,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -2842,14 +2824,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -2867,19 +2849,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -2887,13 +2869,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -2914,22 +2896,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -2943,9 +2932,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -2970,7 +2958,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7 , A8 a8 , A9 a9 , A10 a10) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ) , std::forward<A8>( a8 ) , std::forward<A9>( a9 ) , std::forward<A10>( a10 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -2986,9 +2974,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -2999,13 +2987,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -3023,14 +3011,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -3055,36 +3039,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -3092,14 +3073,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -3117,19 +3098,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -3137,13 +3118,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -3164,22 +3145,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -3193,9 +3181,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -3220,7 +3207,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7 , A8 a8 , A9 a9 , A10 a10 , A11 a11) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ) , std::forward<A8>( a8 ) , std::forward<A9>( a9 ) , std::forward<A10>( a10 ) , std::forward<A11>( a11 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -3236,9 +3223,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -3249,13 +3236,13 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
 namespace hpx { namespace util {
@@ -3273,14 +3260,10 @@ namespace hpx { namespace util {
     {
         function_base() BOOST_NOEXCEPT
             : vptr(get_empty_table_ptr())
-            , object(0)
         {}
         ~function_base()
         {
-            if(object)
-            {
-                vptr->static_delete(&object);
-            }
+            vptr->static_delete(object);
         }
         typedef R result_type;
         typedef
@@ -3305,36 +3288,33 @@ namespace hpx { namespace util {
             >::type * = 0
         )
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             if (!detail::is_empty_function(f))
             {
                 typedef
                     typename util::decay<Functor>::type
                     functor_type;
-                vptr = get_table_ptr<functor_type>();
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
+                vptr = get_table_ptr<functor_type>();
             }
         }
         function_base(function_base const & other)
             : vptr(get_empty_table_ptr())
-            , object(0)
         {
             assign(other);
         }
         function_base(function_base && other)
             : vptr(other.vptr)
-            , object(other.object)
         {
+            vptr->move(other.object, object);
             other.vptr = get_empty_table_ptr();
-            other.object = 0;
         }
         function_base &assign(function_base const & other)
         {
@@ -3342,14 +3322,14 @@ namespace hpx { namespace util {
             {
                 if(vptr == other.vptr && !empty())
                 {
-                    vptr->copy(&other.object, &object);
+                    vptr->copy(other.object, object);
                 }
                 else
                 {
                     reset();
                     if(!other.empty())
                     {
-                        other.vptr->clone(&other.object, &object);
+                        other.vptr->clone(other.object, object);
                         vptr = other.vptr;
                     }
                 }
@@ -3367,19 +3347,19 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if(vptr == f_vptr && !empty())
             {
-                if (sizeof(functor_type) <= sizeof(void *)) 
+                if (detail::is_small_function<functor_type>::value)
                 {
-                    vptr->destruct(&object);
-                    new (&object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object) functor_type(std::forward<Functor>(f));
                 }
-                else if (object)
+                else if (object[0])
                 {
-                    vptr->destruct(&object);
-                    new (object) functor_type(std::forward<Functor>(f));
+                    vptr->destruct(object);
+                    new (object[0]) functor_type(std::forward<Functor>(f));
                 }
                 else
                 {
-                    object = new functor_type(std::forward<Functor>(f));
+                    object[0] = new functor_type(std::forward<Functor>(f));
                 }
             }
             else
@@ -3387,13 +3367,13 @@ namespace hpx { namespace util {
                 reset();
                 if (!detail::is_empty_function(f))
                 {
-                    if (sizeof(functor_type) <= sizeof(void *)) 
+                    if (detail::is_small_function<functor_type>::value)
                     {
-                        new (&object) functor_type(std::forward<Functor>(f));
+                        new (object) functor_type(std::forward<Functor>(f));
                     }
                     else
                     {
-                        object = new functor_type(std::forward<Functor>(f));
+                        object[0] = new functor_type(std::forward<Functor>(f));
                     }
                     vptr = f_vptr;
                 }
@@ -3414,22 +3394,29 @@ namespace hpx { namespace util {
             if(this != &t)
             {
                 reset();
+                t.vptr->move(t.object, object);
                 vptr = t.vptr;
-                object = t.object;
                 t.vptr = get_empty_table_ptr();
-                t.object = 0;
             }
             return *this;
         }
         function_base &swap(function_base& f)
         {
-            std::swap(vptr, f.vptr);
-            std::swap(object, f.object);
+            if (this != &f)
+            {
+                void *tmp[HPX_FUNCTION_STORAGE_SIZE];
+                vtable_ptr_type *tmp_vptr = f.vptr;
+                f.vptr->move(f.object, tmp);
+                vptr->move(object, f.object);
+                f.vptr = vptr;
+                tmp_vptr->move(tmp, object);
+                vptr = tmp_vptr;
+            }
             return *this;
         }
         bool empty() const BOOST_NOEXCEPT
         {
-            return object == 0 && vptr->empty();
+            return vptr->empty();
         }
         operator typename util::safe_bool<function_base>::result_type() const BOOST_NOEXCEPT
         {
@@ -3443,9 +3430,8 @@ namespace hpx { namespace util {
         {
             if (!empty())
             {
-                vptr->static_delete(&object);
+                vptr->static_delete(object);
                 vptr = get_empty_table_ptr();
-                object = 0;
             }
         }
         static vtable_ptr_type* get_empty_table_ptr()
@@ -3470,7 +3456,7 @@ namespace hpx { namespace util {
         }
         BOOST_FORCEINLINE R operator()(A0 a0 , A1 a1 , A2 a2 , A3 a3 , A4 a4 , A5 a5 , A6 a6 , A7 a7 , A8 a8 , A9 a9 , A10 a10 , A11 a11 , A12 a12) const
         {
-            return vptr->invoke(&object
+            return vptr->invoke(object
                 , std::forward<A0>( a0 ) , std::forward<A1>( a1 ) , std::forward<A2>( a2 ) , std::forward<A3>( a3 ) , std::forward<A4>( a4 ) , std::forward<A5>( a5 ) , std::forward<A6>( a6 ) , std::forward<A7>( a7 ) , std::forward<A8>( a8 ) , std::forward<A9>( a9 ) , std::forward<A10>( a10 ) , std::forward<A11>( a11 ) , std::forward<A12>( a12 ));
         }
         std::type_info const& target_type() const BOOST_NOEXCEPT
@@ -3486,9 +3472,9 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type *>(&object);
-            return reinterpret_cast<functor_type *>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type *>(object);
+            return reinterpret_cast<functor_type *>(object[0]);
         }
         template <typename T>
         T const* target() const BOOST_NOEXCEPT
@@ -3499,12 +3485,12 @@ namespace hpx { namespace util {
             vtable_ptr_type* f_vptr = get_table_ptr<functor_type>();
             if (vptr != f_vptr || empty())
                 return 0;
-            if (sizeof(functor_type) <= sizeof(void *)) 
-                return reinterpret_cast<functor_type const*>(&object);
-            return reinterpret_cast<functor_type const*>(object);
+            if (detail::is_small_function<functor_type>::value)
+                return reinterpret_cast<functor_type const*>(object);
+            return reinterpret_cast<functor_type const*>(object[0]);
         }
     protected:
         vtable_ptr_type *vptr;
-        mutable void *object;
+        mutable void *object[HPX_FUNCTION_STORAGE_SIZE];
     };
 }}
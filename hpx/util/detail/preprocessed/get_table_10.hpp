@@ -23,7 +23,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R()
@@ -71,7 +71,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0)
@@ -119,7 +119,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1)
@@ -167,7 +167,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2)
@@ -215,7 +215,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3)
@@ -263,7 +263,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4)
@@ -311,7 +311,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5)
@@ -359,7 +359,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6)
@@ -407,7 +407,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7)
@@ -455,7 +455,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7 , A8)
@@ -503,7 +503,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7 , A8 , A9)
@@ -551,7 +551,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7 , A8 , A9 , A10)
@@ -599,7 +599,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7 , A8 , A9 , A10 , A11)
@@ -647,7 +647,7 @@ namespace hpx { namespace util { namespace detail {
         struct generate_vtable
         {
             typedef
-                typename vtable<sizeof(Functor) <= sizeof(void *)>::
+                typename vtable<is_small_function<Functor>::value>::
                     template type<
                         Functor
                       , R(A0 , A1 , A2 , A3 , A4 , A5 , A6 , A7 , A8 , A9 , A10 , A11 , A12)
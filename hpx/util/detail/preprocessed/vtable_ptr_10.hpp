@@ -48,6 +48,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -167,6 +168,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -225,6 +227,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -344,6 +347,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -402,6 +406,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -521,6 +526,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -579,6 +585,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -698,6 +705,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -756,6 +764,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -875,6 +884,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -933,6 +943,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1052,6 +1063,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1110,6 +1122,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1229,6 +1242,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1287,6 +1301,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1406,6 +1421,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1464,6 +1480,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1583,6 +1600,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1641,6 +1659,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1760,6 +1779,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1818,6 +1838,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -1937,6 +1958,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -1995,6 +2017,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -2114,6 +2137,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -2172,6 +2196,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -2291,6 +2316,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -2349,6 +2375,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
         ~vtable_ptr()
@@ -2468,6 +2495,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -28,6 +28,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             );
     };
@@ -49,6 +50,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             );
     };
@@ -86,6 +88,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 &&);
     };
@@ -107,6 +110,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 &&);
     };
@@ -144,6 +148,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 &&);
     };
@@ -165,6 +170,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 &&);
     };
@@ -202,6 +208,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 &&);
     };
@@ -223,6 +230,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 &&);
     };
@@ -260,6 +268,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 &&);
     };
@@ -281,6 +290,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 &&);
     };
@@ -318,6 +328,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 &&);
     };
@@ -339,6 +350,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 &&);
     };
@@ -376,6 +388,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 &&);
     };
@@ -397,6 +410,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 &&);
     };
@@ -434,6 +448,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 &&);
     };
@@ -455,6 +470,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 &&);
     };
@@ -492,6 +508,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 &&);
     };
@@ -513,6 +530,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 &&);
     };
@@ -550,6 +568,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 &&);
     };
@@ -571,6 +590,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 &&);
     };
@@ -608,6 +628,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 &&);
     };
@@ -629,6 +650,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 &&);
     };
@@ -666,6 +688,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 &&);
     };
@@ -687,6 +710,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 &&);
     };
@@ -724,6 +748,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 &&);
     };
@@ -745,6 +770,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 &&);
     };
@@ -782,6 +808,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 &&);
     };
@@ -803,6 +830,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 &&);
     };
@@ -840,6 +868,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 &&);
     };
@@ -861,6 +890,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 &&);
     };
@@ -898,6 +928,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 &&);
     };
@@ -919,6 +950,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 &&);
     };
@@ -956,6 +988,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 &&);
     };
@@ -977,6 +1010,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 &&);
     };
@@ -1014,6 +1048,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 &&);
     };
@@ -1035,6 +1070,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 &&);
     };
@@ -1072,6 +1108,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 &&);
     };
@@ -1093,6 +1130,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 &&);
     };
@@ -1130,6 +1168,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 &&);
     };
@@ -1151,6 +1190,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 &&);
     };
@@ -1188,6 +1228,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 &&);
     };
@@ -1209,6 +1250,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 &&);
     };
@@ -1246,6 +1288,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 &&);
     };
@@ -1267,6 +1310,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 &&);
     };
@@ -1304,6 +1348,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 && , A21 &&);
     };
@@ -1325,6 +1370,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 && , A21 &&);
     };
@@ -1362,6 +1408,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 && , A21 && , A22 &&);
     };
@@ -1383,6 +1430,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 && , A8 && , A9 && , A10 && , A11 && , A12 && , A13 && , A14 && , A15 && , A16 && , A17 && , A18 && , A19 && , A20 && , A21 && , A22 &&);
     };
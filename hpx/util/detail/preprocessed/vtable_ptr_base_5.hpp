@@ -28,6 +28,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             );
     };
@@ -49,6 +50,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             );
     };
@@ -86,6 +88,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 &&);
     };
@@ -107,6 +110,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 &&);
     };
@@ -144,6 +148,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 &&);
     };
@@ -165,6 +170,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 &&);
     };
@@ -202,6 +208,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 &&);
     };
@@ -223,6 +230,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 &&);
     };
@@ -260,6 +268,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 &&);
     };
@@ -281,6 +290,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 &&);
     };
@@ -318,6 +328,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 &&);
     };
@@ -339,6 +350,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 &&);
     };
@@ -376,6 +388,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 &&);
     };
@@ -397,6 +410,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 &&);
     };
@@ -434,6 +448,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 &&);
     };
@@ -455,6 +470,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 &&);
     };
@@ -492,6 +508,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void ** 
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 &&);
     };
@@ -513,6 +530,7 @@ namespace hpx { namespace util { namespace detail {
         void (*destruct)(void**);
         void (*clone)(void * const*, void **);
         void (*copy)(void * const*, void **);
+        void (*move)(void **, void **);
         R (*invoke)(void **
             , A0 && , A1 && , A2 && , A3 && , A4 && , A5 && , A6 && , A7 &&);
     };
@@ -72,6 +72,12 @@ namespace hpx { namespace util { namespace detail {
                 reinterpret_cast<Functor*>(dest)->~Functor();
                 new (dest) Functor(*reinterpret_cast<Functor const*>(f));
             }
+
+            static void move(void ** f, void ** dest)
+            {
+                new (dest) Functor(std::move(*reinterpret_cast<Functor*>(f)));
+                reinterpret_cast<Functor*>(f)->~Functor();
+            }
         };
 
         template <typename Functor, typename Sig, typename IArchive, typename OArchive>
@@ -159,6 +165,12 @@ namespace hpx { namespace util { namespace detail {
                 (*reinterpret_cast<Functor**>(dest))->~Functor();
                 *dest = new Functor(**reinterpret_cast<Functor *const*>(f));
             }
+
+            static void move(void ** f, void ** dest)
+            {
+                *dest = *f;
+                *f = 0;
+            }
         };
 
         template <typename Functor, typename Sig, typename IArchive, typename OArchive>
@@ -97,6 +97,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
 
@@ -227,6 +228,7 @@ namespace hpx { namespace util { namespace detail {
             base_type::destruct = Vtable::destruct;
             base_type::clone = Vtable::clone;
             base_type::copy = Vtable::copy;
+            base_type::move = Vtable::move;
             base_type::invoke = Vtable::invoke;
         }
     };
@@ -0,0 +1,216 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_FRAME_RING_OCT_17_2014_0412PM)
+#define HPX_UTIL_FRAME_RING_OCT_17_2014_0412PM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/scoped_unlock.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A bounded queue of data frames handed from one producer to one
+    // consumer. It is used to pipeline the serialization of large messages
+    // with their transmission.
+    //
+    // Either side may block (push, pop), which is allowed on HPX threads
+    // only, or may register a callback to be invoked as soon as the
+    // operation can proceed (try_push, try_pop), which is what the code
+    // running on the io_service threads does.
+    class frame_ring : boost::noncopyable
+    {
+    public:
+        typedef std::vector<char> frame_type;
+        typedef HPX_STD_FUNCTION<void()> callback_type;
+
+        enum state
+        {
+            succeeded,              // the frame was appended or retrieved
+            would_block,            // the callback will be invoked later
+            end_of_stream,          // the producer has closed the stream
+            stream_aborted          // one of the sides has aborted
+        };
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        explicit frame_ring(std::size_t max_frames)
+          : max_frames_(max_frames ? max_frames : 1),
+            closed_(false), aborted_(false)
+        {}
+
+        /// Append a frame, block while the queue is full. Returns false if
+        /// the stream has been aborted.
+        bool push(frame_type& f)
+        {
+            HPX_ASSERT(threads::get_self_ptr() != 0);
+
+            mutex_type::scoped_lock l(mtx_);
+            while (!aborted_ && frames_.size() >= max_frames_)
+                space_available_.wait(l);
+
+            if (aborted_)
+                return false;
+
+            do_push(l, f);
+            return true;
+        }
+
+        /// Append a frame if possible. Otherwise the frame is left alone
+        /// and the given function is called once there is space for it (or
+        /// the stream is aborted).
+        state try_push(frame_type& f, callback_type const& on_space)
+        {
+            mutex_type::scoped_lock l(mtx_);
+            if (aborted_)
+                return stream_aborted;
+
+            if (frames_.size() >= max_frames_)
+            {
+                HPX_ASSERT(!on_space_);
+                on_space_ = on_space;
+                return would_block;
+            }
+
+            do_push(l, f);
+            return succeeded;
+        }
+
+        /// Retrieve the next frame, block while the queue is empty. Returns
+        /// false at the end of the stream and throws if the stream was
+        /// aborted.
+        bool pop(frame_type& f)
+        {
+            HPX_ASSERT(threads::get_self_ptr() != 0);
+
+            mutex_type::scoped_lock l(mtx_);
+            while (!aborted_ && !closed_ && frames_.empty())
+                data_available_.wait(l);
+
+            if (aborted_)
+            {
+                HPX_THROW_EXCEPTION(network_error, "frame_ring::pop",
+                    "the stream of frames was aborted");
+                return false;
+            }
+
+            if (frames_.empty())
+                return false;           // end of stream
+
+            do_pop(l, f);
+            return true;
+        }
+
+        /// Retrieve the next frame if one is available. Otherwise the given
+        /// function is called once a frame becomes available (or the stream
+        /// is closed or aborted).
+        state try_pop(frame_type& f, callback_type const& on_data)
+        {
+            mutex_type::scoped_lock l(mtx_);
+            if (aborted_)
+                return stream_aborted;
+
+            if (frames_.empty())
+            {
+                if (closed_)
+                    return end_of_stream;
+
+                HPX_ASSERT(!on_data_);
+                on_data_ = on_data;
+                return would_block;
+            }
+
+            do_pop(l, f);
+            return succeeded;
+        }
+
+        /// Signal that no more frames will be produced.
+        void close()
+        {
+            mutex_type::scoped_lock l(mtx_);
+            closed_ = true;
+            notify_consumer(l);
+        }
+
+        /// Stop the stream, this wakes up both sides.
+        void abort()
+        {
+            mutex_type::scoped_lock l(mtx_);
+            aborted_ = true;
+            notify_producer(l);
+            notify_consumer(l);
+        }
+
+        bool aborted() const
+        {
+            mutex_type::scoped_lock l(mtx_);
+            return aborted_;
+        }
+
+    private:
+        void do_push(mutex_type::scoped_lock& l, frame_type& f)
+        {
+            frames_.push_back(frame_type());
+            frames_.back().swap(f);
+            notify_consumer(l);
+        }
+
+        void do_pop(mutex_type::scoped_lock& l, frame_type& f)
+        {
+            f.swap(frames_.front());
+            frames_.pop_front();
+            notify_producer(l);
+        }
+
+        // The callbacks are invoked without holding the lock as they may
+        // immediately access the queue again.
+        void notify_consumer(mutex_type::scoped_lock& l)
+        {
+            callback_type f;
+            f.swap(on_data_);
+            {
+                util::scoped_unlock<mutex_type::scoped_lock> ul(l);
+                data_available_.notify_all();
+                if (f) f();
+            }
+        }
+
+        void notify_producer(mutex_type::scoped_lock& l)
+        {
+            callback_type f;
+            f.swap(on_space_);
+            {
+                util::scoped_unlock<mutex_type::scoped_lock> ul(l);
+                space_available_.notify_all();
+                if (f) f();
+            }
+        }
+
+        mutable mutex_type mtx_;
+        std::deque<frame_type> frames_;
+        std::size_t const max_frames_;
+
+        lcos::local::condition_variable data_available_;
+        lcos::local::condition_variable space_available_;
+        callback_type on_data_;
+        callback_type on_space_;
+
+        bool closed_;
+        bool aborted_;
+    };
+}}
+
+#endif
@@ -0,0 +1,375 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_FRAME_STREAM_OCT_17_2014_0420PM)
+#define HPX_UTIL_FRAME_STREAM_OCT_17_2014_0420PM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/binary_filter.hpp>
+#include <hpx/util/buffer_pool.hpp>
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/ichunk_manager.hpp>
+#include <hpx/util/ochunk_manager.hpp>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/integer/endian.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Every frame starts with a header describing the data following it.
+    struct frame_header
+    {
+        boost::integer::ulittle64_t size_;      // number of bytes of data
+        boost::integer::ulittle64_t raw_size_;  // size after decompression
+    };
+
+    std::size_t const frame_header_size = sizeof(frame_header);
+
+    inline frame_header get_frame_header(char const* data)
+    {
+        frame_header h;
+        std::memcpy(&h, data, frame_header_size);
+        return h;
+    }
+
+    inline void set_frame_header(char* data, std::size_t size,
+        std::size_t raw_size)
+    {
+        frame_header h;
+        h.size_ = size;
+        h.raw_size_ = raw_size;
+        std::memcpy(data, &h, frame_header_size);
+    }
+
+    // creates a new instance of the filter to apply to each of the frames
+    typedef HPX_STD_FUNCTION<binary_filter*()> frame_filter_factory;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The oframe_stream is used as the container for serializing data into
+    // a sequence of frames of (at most) the given size. Every full frame is
+    // handed to the frame_ring, which blocks the serialization if too many
+    // frames are waiting to be sent.
+    //
+    // If a filter factory is given, each frame is compressed separately,
+    // which allows for the frames to be decompressed as soon as they are
+    // received.
+    class oframe_stream : boost::noncopyable
+    {
+    public:
+        typedef frame_ring::frame_type frame_type;
+
+        oframe_stream(frame_ring& frames, buffer_pool<char>& pool,
+                std::size_t frame_size,
+                frame_filter_factory const& create_filter = frame_filter_factory())
+          : frames_(frames), pool_(pool),
+            frame_size_(frame_size ? frame_size : 1),
+            create_filter_(create_filter),
+            bytes_written_(0), bytes_sent_(0)
+        {}
+
+        ~oframe_stream()
+        {
+            pool_.reclaim_buffer(frame_);
+        }
+
+        void write(void const* address, std::size_t count)
+        {
+            char const* data = static_cast<char const*>(address);
+            bytes_written_ += count;
+
+            while (count != 0)
+            {
+                if (frame_.empty())
+                {
+                    frame_ = pool_.get_buffer(frame_header_size + frame_size_);
+                    frame_.resize(frame_header_size);
+                }
+
+                std::size_t n = (std::min)(count,
+                    frame_header_size + frame_size_ - frame_.size());
+                frame_.insert(frame_.end(), data, data + n);
+                data += n;
+                count -= n;
+
+                if (frame_.size() == frame_header_size + frame_size_)
+                    push_frame();
+            }
+        }
+
+        // hand the partially filled last frame to the ring
+        void flush()
+        {
+            if (frame_.size() > frame_header_size)
+                push_frame();
+        }
+
+        // number of bytes before compression
+        std::size_t bytes_written() const
+        {
+            return bytes_written_;
+        }
+
+        // number of bytes handed to the ring, including the frame headers
+        std::size_t bytes_sent() const
+        {
+            return bytes_sent_;
+        }
+
+    private:
+        void compress_frame()
+        {
+            boost::scoped_ptr<binary_filter> filter(create_filter_());
+
+            std::size_t raw_size = frame_.size() - frame_header_size;
+            filter->set_max_length(raw_size);
+            filter->save(&frame_[frame_header_size], raw_size);
+
+            frame_type compressed(pool_.get_buffer(frame_.size()));
+            compressed.resize(frame_.size());
+
+            std::size_t current = frame_header_size;
+            std::size_t written = 0;
+            do {
+                bool flushed = filter->flush(&compressed[current],
+                    compressed.size()-current, written);
+
+                current += written;
+                if (flushed)
+                    break;
+
+                // resize container
+                compressed.resize(compressed.size()*2);
+
+            } while (true);
+
+            compressed.resize(current);         // truncate container
+
+            pool_.reclaim_buffer(frame_);
+            frame_.swap(compressed);
+            set_frame_header(&frame_[0], frame_.size() - frame_header_size,
+                raw_size);
+        }
+
+        void push_frame()
+        {
+            if (create_filter_)
+            {
+                compress_frame();
+            }
+            else
+            {
+                std::size_t size = frame_.size() - frame_header_size;
+                set_frame_header(&frame_[0], size, size);
+            }
+
+            bytes_sent_ += frame_.size();
+            if (!frames_.push(frame_))
+            {
+                HPX_THROW_EXCEPTION(network_error, "oframe_stream::push_frame",
+                    "the stream of frames was aborted");
+            }
+            HPX_ASSERT(frame_.empty());
+        }
+
+        frame_ring& frames_;
+        buffer_pool<char>& pool_;
+        std::size_t const frame_size_;
+        frame_filter_factory create_filter_;
+
+        frame_type frame_;
+        std::size_t bytes_written_;
+        std::size_t bytes_sent_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The iframe_stream is used as the container for de-serializing data
+    // from a sequence of frames. The archive refers to its container through
+    // a const reference, that's why the state of the de-serialization is
+    // kept by the corresponding icontainer_type.
+    class iframe_stream : boost::noncopyable
+    {
+    public:
+        typedef frame_ring::frame_type frame_type;
+
+        iframe_stream(frame_ring& frames, buffer_pool<char>& pool,
+                frame_filter_factory const& create_filter = frame_filter_factory())
+          : frames_(frames), pool_(pool), create_filter_(create_filter)
+        {}
+
+        // Retrieve the next frame (blocking) and return the offset of its
+        // data. Returns false at the end of the stream.
+        bool next_frame(frame_type& frame, std::size_t& begin) const
+        {
+            pool_.reclaim_buffer(frame);
+            if (!frames_.pop(frame))
+                return false;
+
+            if (frame.size() < frame_header_size)
+            {
+                BOOST_THROW_EXCEPTION(
+                    boost::archive::archive_exception(
+                        boost::archive::archive_exception::input_stream_error,
+                        "archive data bstream frame is too short"));
+                return false;
+            }
+
+            frame_header h = get_frame_header(frame.data());
+            std::size_t size = static_cast<std::size_t>(h.size_);
+            std::size_t raw_size = static_cast<std::size_t>(h.raw_size_);
+
+            if (frame.size() - frame_header_size != size)
+            {
+                BOOST_THROW_EXCEPTION(
+                    boost::archive::archive_exception(
+                        boost::archive::archive_exception::input_stream_error,
+                        "archive data bstream frame size mismatch"));
+                return false;
+            }
+
+            if (!create_filter_)
+            {
+                begin = frame_header_size;
+                return true;
+            }
+
+            // decompress the frame
+            boost::scoped_ptr<binary_filter> filter(create_filter_());
+            filter->init_data(&frame[frame_header_size], size, raw_size);
+
+            frame_type decompressed(pool_.get_buffer(raw_size));
+            decompressed.resize(raw_size);
+            if (raw_size != 0)
+                filter->load(decompressed.data(), raw_size);
+
+            pool_.reclaim_buffer(frame);
+            frame.swap(decompressed);
+            begin = 0;
+            return true;
+        }
+
+        void release_frame(frame_type& frame) const
+        {
+            pool_.reclaim_buffer(frame);
+        }
+
+    private:
+        frame_ring& frames_;
+        buffer_pool<char>& pool_;
+        frame_filter_factory create_filter_;
+    };
+}}
+
+namespace hpx { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Zero-copy chunks are not supported for streamed data, all data is
+    // copied into the frames. Compression is applied by the streams on a
+    // frame by frame basis, the archives must not be given a filter.
+    template <>
+    struct ocontainer_type<oframe_stream> : erase_ocontainer_type
+    {
+        ocontainer_type(oframe_stream& stream)
+          : stream_(stream)
+        {}
+
+        ocontainer_type(oframe_stream& stream,
+                std::vector<serialization_chunk>* /*chunks*/)
+          : stream_(stream)
+        {}
+
+        void set_filter(binary_filter* filter)
+        {
+            HPX_ASSERT(0 == filter);
+        }
+
+        void save_binary(void const* address, std::size_t count)
+        {
+            stream_.write(address, count);
+        }
+
+        void save_binary_chunk(void const* address, std::size_t count)
+        {
+            stream_.write(address, count);
+        }
+
+        oframe_stream& stream_;
+    };
+
+    template <>
+    struct icontainer_type<iframe_stream> : erase_icontainer_type
+    {
+        typedef iframe_stream::frame_type frame_type;
+
+        icontainer_type(iframe_stream const& stream,
+                std::size_t /*inbound_data_size*/)
+          : stream_(stream), current_(0)
+        {}
+
+        icontainer_type(iframe_stream const& stream,
+                std::vector<serialization_chunk> const* /*chunks*/,
+                std::size_t /*inbound_data_size*/)
+          : stream_(stream), current_(0)
+        {}
+
+        ~icontainer_type()
+        {
+            stream_.release_frame(frame_);
+        }
+
+        void set_filter(binary_filter* filter)
+        {
+            HPX_ASSERT(0 == filter);
+            delete filter;
+        }
+
+        void load_binary(void* address, std::size_t count)
+        {
+            char* data = static_cast<char*>(address);
+            while (count != 0)
+            {
+                if (current_ == frame_.size() &&
+                    !stream_.next_frame(frame_, current_))
+                {
+                    BOOST_THROW_EXCEPTION(
+                        boost::archive::archive_exception(
+                            boost::archive::archive_exception::input_stream_error,
+                            "archive data bstream is too short"));
+                    return;
+                }
+
+                std::size_t n = (std::min)(count, frame_.size() - current_);
+                std::memcpy(data, &frame_[current_], n);
+                current_ += n;
+                data += n;
+                count -= n;
+            }
+        }
+
+        void load_binary_chunk(void* address, std::size_t count)
+        {
+            load_binary(address, count);
+        }
+
+        bool load_shared_chunk(boost::shared_array<char>& /*data*/,
+            std::size_t /*count*/)
+        {
+            return false;
+        }
+
+        iframe_stream const& stream_;
+        frame_type frame_;
+        std::size_t current_;
+    };
+}}}
+
+#endif
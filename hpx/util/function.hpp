@@ -17,6 +17,7 @@
 #include <hpx/util/detail/vtable.hpp>
 #include <hpx/util/detail/get_empty_table.hpp>
 #include <hpx/util/detail/empty_vtable.hpp>
+#include <hpx/util/detail/is_small_function.hpp>
 #include <hpx/util/decay.hpp>
 
 #include <boost/preprocessor/cat.hpp>
@@ -42,8 +43,8 @@
                 Sig                                                           \
               , portable_binary_iarchive                                      \
               , portable_binary_oarchive                                      \
-              , vtable<sizeof(util::decay<Functor>::type) <=                  \
-                       sizeof(void *)>::type<                                 \
+              , vtable<is_small_function<                                     \
+                    util::decay<Functor>::type>::value>::type<                \
                     util::decay<Functor>::type                                \
                   , Sig                                                       \
                   , portable_binary_iarchive                                  \
@@ -25,6 +25,11 @@ namespace hpx { namespace util
 {
     /// The unique_id_ranges class is a type responsible for generating
     /// unique ids for components, parcels, threads etc.
+    ///
+    /// Ids are carved from a range reserved from the primary namespace
+    /// instance of this locality. Every worker thread hands out small
+    /// requests from its own sub-range, which keeps concurrent component
+    /// creation from serializing on a single lock.
     class HPX_EXPORT unique_id_ranges
     {
         typedef hpx::util::spinlock mutex_type;
@@ -33,7 +38,30 @@ namespace hpx { namespace util
 
         /// size of the id range returned by command_getidrange
         /// FIXME: is this a policy?
-        enum { range_delta = 0x100000 };
+        enum { range_delta = 0x1000000 };
+
+        /// size of the id ranges handed to the worker threads, requests for
+        /// more than local_range_limit ids are served from the shared range
+        enum
+        {
+            local_range_delta = 0x100000,
+            local_range_limit = 0x10000,
+            num_local_ranges = 64
+        };
+
+        struct local_range
+        {
+            local_range()
+              : lower_(0), upper_(0)
+            {}
+
+            mutex_type mtx_;
+            naming::gid_type lower_;
+            naming::gid_type upper_;
+
+            // keep the ranges of different threads on separate cache lines
+            char pad_[64 - sizeof(mutex_type) - 2 * sizeof(naming::gid_type)];
+        };
 
     public:
         unique_id_ranges()
@@ -54,9 +82,13 @@ namespace hpx { namespace util
         }
 
     private:
+        naming::gid_type get_shared_id(std::size_t count);
+
         /// The range of available ids for components
         naming::gid_type lower_;
         naming::gid_type upper_;
+
+        local_range local_ranges_[num_local_ranges];
     };
 }}
 
@@ -7,6 +7,9 @@
 #define HPX_UTIL_ICHUNK_MANAGER_JUL_31_2013_0723PM
 
 #include <hpx/util/binary_filter.hpp>
+#include <hpx/util/portable_binary_archive.hpp>
+
+#include <boost/shared_array.hpp>
 
 #include <cstddef> // for size_t
 #include <cstring> // for memcpy
@@ -21,6 +24,8 @@ namespace hpx { namespace util { namespace detail
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void* address, std::size_t count) = 0;
         virtual void load_binary_chunk(void* address, std::size_t count) = 0;
+        virtual bool load_shared_chunk(boost::shared_array<char>& data,
+            std::size_t count) = 0;
     };
 
     template <typename Container>
@@ -42,6 +47,16 @@ namespace hpx { namespace util { namespace detail
             return (*chunks_)[chunk].data_;
         }
 
+        void const* get_chunk_address(std::size_t chunk) const
+        {
+            if (get_chunk_type(chunk) == chunk_type_shared)
+            {
+                return static_cast<shared_chunk_buffer const*>(
+                    get_chunk_data(chunk).cpos_)->data_.get();
+            }
+            return get_chunk_data(chunk).cpos_;
+        }
+
         std::size_t get_num_chunks() const
         {
             return chunks_->size();
@@ -140,7 +155,8 @@ namespace hpx { namespace util { namespace detail
             }
             else {
                 HPX_ASSERT(current_chunk_ != std::size_t(-1));
-                HPX_ASSERT(get_chunk_type(current_chunk_) == chunk_type_pointer);
+                HPX_ASSERT(get_chunk_type(current_chunk_) == chunk_type_pointer ||
+                    get_chunk_type(current_chunk_) == chunk_type_shared);
 
                 if (get_chunk_size(current_chunk_) != count)
                 {
@@ -151,13 +167,41 @@ namespace hpx { namespace util { namespace detail
                     return;
                 }
 
-                // unfortunately we can't implement a zero copy policy on the receiving end
-                // as the memory was already allocated by the serialization code
-                std::memcpy(address, get_chunk_data(current_chunk_).pos_, count);
+                // the memory was already allocated by the serialization code,
+                // see load_shared_chunk for the zero copy alternative
+                std::memcpy(address, get_chunk_address(current_chunk_), count);
                 ++current_chunk_;
             }
         }
 
+        // Hand out the data of the current chunk if it was received into a
+        // buffer of its own, returns false if the data has to be copied using
+        // load_binary_chunk instead.
+        bool load_shared_chunk(boost::shared_array<char>& data,
+            std::size_t count)
+        {
+            if (filter_.get() || chunks_ == 0 || count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+                return false;
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            if (get_chunk_type(current_chunk_) != chunk_type_shared)
+                return false;
+
+            if (get_chunk_size(current_chunk_) != count)
+            {
+                BOOST_THROW_EXCEPTION(
+                    boost::archive::archive_exception(
+                        boost::archive::archive_exception::input_stream_error,
+                        "archive data bstream data chunk size mismatch"));
+                return false;
+            }
+
+            data = static_cast<shared_chunk_buffer const*>(
+                get_chunk_data(current_chunk_).cpos_)->data_;
+            ++current_chunk_;
+            return true;
+        }
+
         Container const& cont_;
         std::size_t current_;
         HPX_STD_UNIQUE_PTR<binary_filter> filter_;
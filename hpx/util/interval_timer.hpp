@@ -51,6 +51,12 @@ namespace hpx { namespace util
             return microsecs_;
         }
 
+        void change_interval(boost::int64_t new_interval)
+        {
+            mutex_type::scoped_lock l(mtx_);
+            microsecs_ = new_interval;
+        }
+
         void slow_down(boost::int64_t max_interval)
         {
             mutex_type::scoped_lock l(mtx_);
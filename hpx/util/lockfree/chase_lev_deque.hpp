@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithm from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: http://dl.acm.org/citation.cfm?id=1073974
+//
+//  Memory orderings follow "Correct and Efficient Work-Stealing for Weak
+//  Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//
+//  Copyright (C) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  The deque has exactly one owner which pushes and pops items at the bottom
+//  end without executing any atomic read-modify-write operation (except when
+//  competing for the very last item). Any number of thieves may concurrently
+//  steal items from the top end, each steal costs one CAS.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JAN_16_2014_1112AM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JAN_16_2014_1112AM
+
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost { namespace lockfree
+{
+
+template <typename T>
+struct chase_lev_deque : private boost::noncopyable
+{
+  private:
+    // Circular array holding the items of the deque. Arrays which have been
+    // replaced by a larger one during grow() are kept alive (linked through
+    // 'previous') until the deque is destroyed as concurrent thieves might
+    // still be reading from them.
+    struct array
+    {
+        array(boost::int64_t log_size, array* previous = 0)
+          : log_size_(log_size)
+          , mask_((boost::int64_t(1) << log_size) - 1)
+          , items_(new boost::atomic<T>[std::size_t(1) << log_size])
+          , previous_(previous)
+        {}
+
+        ~array()
+        {
+            delete [] items_;
+        }
+
+        boost::int64_t size() const
+        {
+            return mask_ + 1;
+        }
+
+        T get(boost::int64_t i) const
+        {
+            return items_[i & mask_].load(boost::memory_order_relaxed);
+        }
+
+        void put(boost::int64_t i, T const& val)
+        {
+            items_[i & mask_].store(val, boost::memory_order_relaxed);
+        }
+
+        array* grow(boost::int64_t bottom, boost::int64_t top)
+        {
+            array* a = new array(log_size_ + 1, this);
+            for (boost::int64_t i = top; i != bottom; ++i)
+                a->put(i, get(i));
+            return a;
+        }
+
+        boost::int64_t const log_size_;
+        boost::int64_t const mask_;
+        boost::atomic<T>* const items_;
+        array* const previous_;
+    };
+
+    static boost::int64_t log2_size(boost::uint64_t initial_size)
+    {
+        boost::int64_t log_size = 4;        // at least 16 items
+        while ((boost::uint64_t(1) << log_size) < initial_size)
+            ++log_size;
+        return log_size;
+    }
+
+  public:
+    typedef T value_type;
+    typedef boost::uint64_t size_type;
+
+    chase_lev_deque(size_type initial_size = 0)
+      : top_(0)
+      , bottom_(0)
+      , array_(new array(log2_size(initial_size)))
+    {}
+
+    ~chase_lev_deque()
+    {
+        array* a = array_.load(boost::memory_order_relaxed);
+        while (a != 0)
+        {
+            array* previous = a->previous_;
+            delete a;
+            a = previous;
+        }
+    }
+
+    // Called by the owner only.
+    bool push_bottom(T const& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        array* a = array_.load(boost::memory_order_relaxed);
+
+        if (b - t > a->size() - 1)
+        {
+            // the deque is full, grow it
+            a = a->grow(b, t);
+            array_.store(a, boost::memory_order_release);
+        }
+
+        a->put(b, val);
+        boost::atomic_thread_fence(boost::memory_order_release);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return true;
+    }
+
+    // Called by the owner only.
+    bool pop_bottom(T& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed) - 1;
+        array* a = array_.load(boost::memory_order_relaxed);
+        bottom_.store(b, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // the deque was empty
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->get(b);
+        if (t == b)
+        {
+            // this is the last item, compete with thieves
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return result;
+        }
+        return true;
+    }
+
+    // May be called by any thread.
+    bool steal_top(T& val)
+    {
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t b = bottom_.load(boost::memory_order_acquire);
+
+        if (t >= b)
+            return false;       // the deque is empty
+
+        array* a = array_.load(boost::memory_order_acquire);
+        T tmp = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed))
+        {
+            return false;       // lost the race against another thief or owner
+        }
+
+        val = tmp;
+        return true;
+    }
+
+    bool empty() const
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b <= t;
+    }
+
+  private:
+    // top_ and bottom_ are written by different threads, keep them on
+    // separate cache lines
+    boost::atomic<boost::int64_t> top_;
+    char pad0_[64 - sizeof(boost::atomic<boost::int64_t>)];
+    boost::atomic<boost::int64_t> bottom_;
+    char pad1_[64 - sizeof(boost::atomic<boost::int64_t>)];
+    boost::atomic<array*> array_;
+};
+
+}}
+
+#endif
+
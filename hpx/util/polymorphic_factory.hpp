@@ -11,11 +11,16 @@
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/util/static.hpp>
+#include <boost/atomic.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/scoped_array.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -48,6 +53,18 @@ namespace hpx { namespace util
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    // Besides looking up the registered types by name, the factory supports
+    // dense numeric ids for them. The id table is created by the root
+    // locality and is distributed to all other localities while they connect
+    // (see big_boot_barrier). This allows to send a 32 bit id instead of the
+    // (mangled) type name with every parcel. Types registered after the table
+    // has been created (for instance by a component loaded later on) get the
+    // id the table has reserved for them, if any. Otherwise they have no id
+    // and are still looked up by name.
+    //
+    // The id table is never modified once it has been published (through
+    // ids_available_), which allows to look up ids without locking. The map
+    // of registered types may still grow at runtime and is protected by mtx_.
     template <typename Base>
     class HPX_EXPORT polymorphic_factory
     {
@@ -57,18 +74,63 @@ namespace hpx { namespace util
             boost::uint32_t, std::pair<std::string, ctor_type>
         > ctor_map;
 
+        // maps the hash of a type name to the id of that name
+        typedef std::multimap<boost::uint32_t, boost::uint32_t> id_map;
+
+        enum { invalid_id = ~0u };
+
         static boost::shared_ptr<Base> create(std::string const & name);
+        static boost::shared_ptr<Base> create(boost::uint32_t id);
+
+        // Return the id assigned to the type with the given name, returns
+        // invalid_id if no id has been assigned (yet).
+        static boost::uint32_t get_id(std::string const& name);
+
+        // Return whether ids have been assigned to the registered types.
+        static bool has_ids();
+
+        // Assign ids to all currently registered types (unless ids have been
+        // assigned already).
+        static void assign_ids();
+
+        // Return the names of all types which have an id assigned, ordered by
+        // their id.
+        static std::vector<std::string> get_names();
+
+        // Assign the ids as created by another locality (the id of a type is
+        // its index in the given list). Names unknown to this locality are
+        // skipped.
+        static void set_ids(std::vector<std::string> const& names);
+
+        polymorphic_factory()
+          : num_ids_(0), ids_available_(false)
+        {}
 
     protected:
         typename ctor_map::const_iterator locate(boost::uint32_t hash,
             std::string const& name) const;
 
+        // Return the id of the given name, requires the id table to be
+        // available.
+        boost::uint32_t locate_id(boost::uint32_t hash,
+            std::string const& name) const;
+
     private:
         void add_factory_function(std::string const & name, ctor_type ctor);
         static polymorphic_factory& get_instance();
 
         ctor_map ctor_map_;
 
+        // the id table: the ctors of all types which have an id assigned
+        // (indexed by id, the entries of types not registered yet are filled
+        // in later), their names and the lookup of the ids by name
+        boost::scoped_array<boost::atomic<ctor_type> > ctors_;
+        std::size_t num_ids_;
+        std::vector<std::string> names_;
+        id_map ids_;
+        boost::atomic<bool> ids_available_;
+        boost::mutex mtx_;
+
         template <typename Action>
         friend struct actions::detail::action_registration;
 
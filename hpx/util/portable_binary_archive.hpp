@@ -17,6 +17,7 @@
 #include <boost/static_assert.hpp>
 #include <boost/archive/basic_archive.hpp>
 #include <boost/detail/endian.hpp>
+#include <boost/shared_array.hpp>
 
 #include <algorithm>
 #include <climits>
@@ -58,7 +59,8 @@ namespace hpx { namespace util
     enum chunk_type
     {
         chunk_type_index = 0,
-        chunk_type_pointer = 1
+        chunk_type_pointer = 1,
+        chunk_type_shared = 2       // pointer to a shared_chunk_buffer
     };
 
     struct serialization_chunk
@@ -68,6 +70,19 @@ namespace hpx { namespace util
         boost::uint8_t type_;   // chunk_type
     };
 
+    // A received zero-copy chunk. The ownership of its data can be handed
+    // over to the deserialized object (see serialize_buffer) instead of
+    // copying the data.
+    struct shared_chunk_buffer
+    {
+        shared_chunk_buffer()
+          : size_(0)
+        {}
+
+        boost::shared_array<char> data_;
+        std::size_t size_;
+    };
+
     ///////////////////////////////////////////////////////////////////////
     inline serialization_chunk create_index_chunk(std::size_t index, std::size_t size)
     {
@@ -86,6 +101,15 @@ namespace hpx { namespace util
         retval.data_.cpos_ = pos;
         return retval;
     }
+
+    inline serialization_chunk create_shared_chunk(shared_chunk_buffer const& buffer)
+    {
+        serialization_chunk retval = {
+            { 0 }, buffer.size_, static_cast<boost::uint8_t>(chunk_type_shared)
+        };
+        retval.data_.cpos_ = &buffer;
+        return retval;
+    }
 }}
 
 #endif // PORTABLE_BINARY_ARCHIVE_HPP
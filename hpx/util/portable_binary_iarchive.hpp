@@ -304,6 +304,24 @@ public:
         }
     }
 
+    // Take over the ownership of the data of the next zero-copy chunk
+    // instead of loading it into memory allocated by the caller. This
+    // returns false if the data has to be loaded using load_array.
+    template <typename T>
+    bool load_shared_chunk(boost::shared_array<char>& data, std::size_t count)
+    {
+        // we can't hand out the data if bytes might have to be flipped
+#ifdef BOOST_BIG_ENDIAN
+        if (this->flags() & (endian_little | disable_array_optimization))
+            return false;
+#else
+        if (this->flags() & (endian_big | disable_array_optimization))
+            return false;
+#endif
+        return this->primitive_base_t::load_shared_chunk(data,
+            count * sizeof(T));
+    }
+
     void load_array(boost::serialization::array<float>& a, unsigned int)
     {
         this->primitive_base_t::load_array(a);
@@ -74,6 +74,7 @@ namespace hpx { namespace util
         bool get_agas_range_caching_mode() const;
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
+        std::size_t get_agas_refcnt_flush_interval() const;
 
         // Get whether the AGAS server is running as a dedicated runtime.
         // This decides whether the AGAS actions are executed with normal
@@ -132,6 +133,8 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         bool init_use_stack_guard_pages() const;
+        bool init_use_stack_huge_pages() const;
+        std::size_t init_stack_cache_high_water_mark() const;
 #endif
 
         void pre_initialize_ini();
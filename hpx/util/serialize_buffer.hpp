@@ -14,6 +14,7 @@
 #include <boost/serialization/split_member.hpp>
 #include <boost/shared_array.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <hpx/util/serialize_allocator.hpp>
 
@@ -21,9 +22,48 @@
 
 namespace hpx { namespace util
 {
+    class portable_binary_iarchive;
+
     namespace detail
     {
         struct serialize_buffer_no_allocator {};
+
+        // Keeps the received chunk alive which is referenced by the data of
+        // a serialize_buffer.
+        struct serialize_buffer_chunk_holder
+        {
+            explicit serialize_buffer_chunk_holder(
+                    boost::shared_array<char> const& chunk)
+              : chunk_(chunk)
+            {}
+
+            template <typename T>
+            void operator()(T*) const {}
+
+            boost::shared_array<char> chunk_;
+        };
+
+        // Take over the ownership of a received zero-copy chunk, this is
+        // supported by the portable_binary_iarchive only.
+        template <typename Archive, typename T>
+        bool load_shared_chunk(Archive&, boost::shared_array<T>&, std::size_t,
+            boost::mpl::false_)
+        {
+            return false;
+        }
+
+        template <typename Archive, typename T>
+        bool load_shared_chunk(Archive& ar, boost::shared_array<T>& data,
+            std::size_t size, boost::mpl::true_)
+        {
+            boost::shared_array<char> chunk;
+            if (!ar.template load_shared_chunk<T>(chunk, size))
+                return false;
+
+            data = boost::shared_array<T>(reinterpret_cast<T*>(chunk.get()),
+                serialize_buffer_chunk_holder(chunk));
+            return true;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -229,7 +269,6 @@ namespace hpx { namespace util
         void load(Archive& ar, const unsigned int version)
         {
             ar >> size_;
-            data_.reset(new T[size_]);
 
             typedef typename
                 boost::serialization::use_array_optimization<Archive>::template apply<
@@ -242,6 +281,8 @@ namespace hpx { namespace util
         template <typename Archive>
         void load_optimized(Archive& ar, const unsigned int version, boost::mpl::false_)
         {
+            data_.reset(new T[size_]);
+
             std::size_t c = size_;
             T* t = data_.get();
             while(c-- > 0)
@@ -251,6 +292,19 @@ namespace hpx { namespace util
         template <typename Archive>
         void load_optimized(Archive& ar, const unsigned int version, boost::mpl::true_)
         {
+            // directly use the received data, if possible
+            typedef boost::mpl::bool_<
+                boost::is_same<Archive, portable_binary_iarchive>::value
+            > is_portable_binary_iarchive;
+
+            if (detail::load_shared_chunk(ar, data_, size_,
+                    is_portable_binary_iarchive()))
+            {
+                return;
+            }
+
+            data_.reset(new T[size_]);
+
             boost::serialization::array<T> arr(data_.get(), size_);
             ar.load_array(arr, version);
         }
@@ -0,0 +1,180 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_THRESHOLD_FILTER_OCT_18_2014_1104AM)
+#define HPX_UTIL_THRESHOLD_FILTER_OCT_18_2014_1104AM
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/config/forceinline.hpp>
+#include <hpx/traits/action_serialization_filter.hpp>
+#include <hpx/runtime/actions/guid_initialization.hpp>
+#include <hpx/util/binary_filter.hpp>
+#include <hpx/util/detail/serialization_registration.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/export.hpp>
+
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The statistics collected by the \a threshold_binary_filter for all
+    /// messages of one action. These are exposed as the performance counters
+    /// /compression/ratio, /compression/time/compress,
+    /// /compression/count/compressed, and /compression/count/uncompressed.
+    struct HPX_EXPORT compression_statistics : boost::noncopyable
+    {
+        compression_statistics()
+          : raw_bytes_(0), sent_bytes_(0), time_(0), compressed_(0),
+            uncompressed_(0)
+        {}
+
+        void add_data(std::size_t raw_bytes, std::size_t sent_bytes,
+            boost::int64_t time, bool compressed);
+
+        // uncompressed size of the data in percent of the size of the data
+        // actually sent
+        boost::int64_t get_compression_ratio(bool reset);
+
+        // overall time spent compressing the data [ns]
+        boost::int64_t get_compression_time(bool reset);
+
+        // number of messages sent compressed/uncompressed
+        boost::int64_t get_compressed_count(bool reset);
+        boost::int64_t get_uncompressed_count(bool reset);
+
+    private:
+        boost::atomic<boost::int64_t> raw_bytes_;
+        boost::atomic<boost::int64_t> sent_bytes_;
+        boost::atomic<boost::int64_t> time_;
+        boost::atomic<boost::int64_t> compressed_;
+        boost::atomic<boost::int64_t> uncompressed_;
+    };
+
+    /// Return the statistics collected for the action with the given name.
+    HPX_EXPORT compression_statistics& get_compression_statistics(
+        std::string const& action_name);
+
+    /// Install the performance counters exposing the compression statistics.
+    HPX_EXPORT void register_compression_counter_types();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The threshold_binary_filter wraps another binary filter, which is used
+    /// only if the serialized data is at least \a threshold bytes large and
+    /// if it reduces the size of the data to at most \a max_ratio percent.
+    /// Otherwise the data is sent as is. A single leading byte tells the
+    /// receiving end whether the data has to be decompressed.
+    ///
+    /// The defaults for both values are taken from the configuration
+    /// settings hpx.parcel.compression_threshold and
+    /// hpx.parcel.compression_max_ratio.
+    class HPX_EXPORT threshold_binary_filter : public binary_filter
+    {
+    public:
+        threshold_binary_filter(binary_filter* next_filter = 0,
+            compression_statistics* stats = 0,
+            std::size_t threshold = std::size_t(-1),
+            std::size_t max_ratio = std::size_t(-1));
+        ~threshold_binary_filter();
+
+        // compression API
+        void set_max_length(std::size_t size);
+        void save(void const* src, std::size_t src_count);
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
+
+        // decompression API
+        std::size_t init_data(char const* buffer, std::size_t size,
+            std::size_t buffer_size);
+        void load(void* dst, std::size_t dst_count);
+
+        /// serialization support
+        static void register_base();
+
+    private:
+        enum data_mode
+        {
+            data_uncompressed = 0,
+            data_compressed = 1
+        };
+
+        void compress_data();
+
+        // serialization support
+        friend class boost::serialization::access;
+
+        // only the wrapped filter is sent, the decision whether the data
+        // was compressed is made after the filter has been serialized
+        template <typename Archive>
+        BOOST_FORCEINLINE void serialize(Archive& ar, const unsigned int)
+        {
+            binary_filter* next_filter = next_filter_.get();
+            ar & next_filter;
+            if (next_filter != next_filter_.get())
+                next_filter_.reset(next_filter);
+        }
+
+        boost::scoped_ptr<binary_filter> next_filter_;
+        compression_statistics* stats_;
+        std::size_t threshold_;
+        std::size_t max_ratio_;
+
+        // sending side: the raw and the compressed data
+        std::vector<char> buffer_;
+        std::vector<char> compressed_;
+        bool prepared_;
+
+        // receiving side: the data, if it was sent uncompressed
+        data_mode mode_;
+        char const* data_;
+        std::size_t size_;
+        std::size_t current_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+HPX_SERIALIZATION_REGISTER_TYPE_DECLARATION(hpx::util::threshold_binary_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+// Use the given binary filter (e.g. "lz4_serialization_filter") for the
+// parcels of an action only if it pays off, i.e. for messages larger than
+// the configured threshold and only if the compression ratio is good enough.
+// Small (latency sensitive) messages are sent uncompressed.
+#define HPX_ACTION_USES_THRESHOLD_COMPRESSION(action, filter_type)            \
+    HPX_ACTION_USES_THRESHOLD_COMPRESSION_2(action, filter_type,              \
+        std::size_t(-1))                                                      \
+/**/
+
+#define HPX_ACTION_USES_THRESHOLD_COMPRESSION_2(action, filter_type,          \
+        threshold)                                                            \
+    namespace hpx { namespace traits                                          \
+    {                                                                         \
+        template <>                                                           \
+        struct action_serialization_filter<action>                            \
+        {                                                                     \
+            /* Note that the caller is responsible for deleting the filter */ \
+            /* instance returned from this function */                        \
+            static util::binary_filter* call(parcelset::parcel const& p)      \
+            {                                                                 \
+                static util::compression_statistics& stats =                  \
+                    util::get_compression_statistics(                         \
+                        p.get_action()->get_action_name());                   \
+                return new util::threshold_binary_filter(                     \
+                    hpx::create_binary_filter(filter_type, true),             \
+                    &stats, threshold);                                       \
+            }                                                                 \
+        };                                                                    \
+    }}                                                                        \
+/**/
+
+#endif
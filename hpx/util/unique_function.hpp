@@ -0,0 +1,267 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_UTIL_UNIQUE_FUNCTION_HPP
+#define HPX_UTIL_UNIQUE_FUNCTION_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/move.hpp>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/ref.hpp>
+#include <boost/type_traits/is_class.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <typeinfo>
+
+namespace hpx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Function objects held by a unique_function are wrapped into the type
+        // below. It selects the vtables defined further down, which have no
+        // copy entries, so that the function object is never required to be
+        // copyable. The wrapper owns the function object, but is otherwise
+        // treated like a reference_wrapper (see the specializations of
+        // is_reference_wrapper and unwrap_reference at the end of this file),
+        // which makes util::invoke call the wrapped function object directly.
+        template <typename F>
+        struct unique_function_object
+        {
+            typedef F type;
+
+            explicit unique_function_object(F && f)
+              : f_(std::move(f))
+            {}
+
+            unique_function_object(unique_function_object && other)
+              : f_(std::move(other.f_))
+            {}
+
+            F& get() { return f_; }
+            F const& get() const { return f_; }
+
+        private:
+            // unique_function_object is not copyable
+            unique_function_object(unique_function_object const&);
+            unique_function_object& operator=(unique_function_object const&);
+
+            F f_;
+        };
+
+        // the vtables report the type of the wrapped function object
+        template <typename F>
+        struct unique_vtable_base
+        {
+            enum { empty = false };
+
+            static std::type_info const& get_type()
+            {
+                return typeid(F);
+            }
+
+            // a unique_function is never copied, the copy entries stay empty
+            static void (* const clone)(void *const*, void **);
+            static void (* const copy)(void *const*, void **);
+        };
+
+        template <typename F>
+        void (* const unique_vtable_base<F>::clone)(void *const*, void **) = 0;
+
+        template <typename F>
+        void (* const unique_vtable_base<F>::copy)(void *const*, void **) = 0;
+
+        // function objects stored in place
+        template <typename F>
+        struct vtable<true>::type_base<unique_function_object<F> >
+          : unique_vtable_base<F>
+        {
+            typedef unique_function_object<F> functor_type;
+
+            static void static_delete(void ** f)
+            {
+                reinterpret_cast<functor_type*>(f)->~functor_type();
+            }
+
+            static void destruct(void ** f)
+            {
+                reinterpret_cast<functor_type*>(f)->~functor_type();
+            }
+
+            static void move(void ** f, void ** dest)
+            {
+                new (dest) functor_type(
+                    std::move(*reinterpret_cast<functor_type*>(f)));
+                reinterpret_cast<functor_type*>(f)->~functor_type();
+            }
+        };
+
+        // function objects allocated on the heap
+        template <typename F>
+        struct vtable<false>::type_base<unique_function_object<F> >
+          : unique_vtable_base<F>
+        {
+            typedef unique_function_object<F> functor_type;
+
+            static void static_delete(void ** f)
+            {
+                delete (*reinterpret_cast<functor_type **>(f));
+            }
+
+            static void destruct(void ** f)
+            {
+                (*reinterpret_cast<functor_type**>(f))->~functor_type();
+            }
+
+            static void move(void ** f, void ** dest)
+            {
+                *dest = *f;
+                *f = 0;
+            }
+        };
+
+        // function pointers and reference wrappers are copyable anyways
+        template <typename F>
+        struct needs_unique_function_object
+          : boost::mpl::bool_<
+                boost::is_class<F>::value &&
+               !boost::is_reference_wrapper<F>::value
+            >
+        {};
+
+        // the type stored for a function object of type F
+        template <typename F, typename Enable = void>
+        struct unique_function_storage
+        {
+            typedef F type;
+
+            static F* target(F* f) { return f; }
+            static F const* target(F const* f) { return f; }
+        };
+
+        template <typename F>
+        struct unique_function_storage<F
+          , typename boost::enable_if<needs_unique_function_object<F> >::type>
+        {
+            typedef unique_function_object<F> type;
+
+            static F* target(type* f) { return f ? &f->get() : 0; }
+            static F const* target(type const* f) { return f ? &f->get() : 0; }
+        };
+
+        template <typename F>
+        typename boost::enable_if<
+            needs_unique_function_object<typename util::decay<F>::type>
+          , unique_function_object<typename util::decay<F>::type>
+        >::type
+        make_unique_function_object(F && f)
+        {
+            typedef typename util::decay<F>::type functor_type;
+            return unique_function_object<functor_type>(
+                functor_type(std::forward<F>(f)));
+        }
+
+        template <typename F>
+        typename boost::disable_if<
+            needs_unique_function_object<typename util::decay<F>::type>
+          , typename util::decay<F>::type
+        >::type
+        make_unique_function_object(F && f)
+        {
+            return std::forward<F>(f);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A move-only, non-serializable function wrapper. In contrast to
+    /// function_nonser it can hold function objects which are not copyable
+    /// (for instance, ones owning a unique_future or a std::unique_ptr).
+    /// It should be preferred for callbacks which are invoked (at most)
+    /// once, as it is never copied.
+    template <typename Sig>
+    struct unique_function : function_base<Sig, void, void>
+    {
+        typedef function_base<Sig, void, void> base_type;
+        typedef typename base_type::result_type result_type;
+
+        using base_type::reset;
+
+        unique_function() BOOST_NOEXCEPT
+          : base_type()
+        {}
+
+        template <typename Functor>
+        unique_function(
+            Functor && f
+          , typename ::boost::disable_if<
+                typename boost::is_same<
+                    unique_function
+                  , typename util::decay<Functor>::type
+                >::type
+            >::type * = 0
+        )
+          : base_type(detail::make_unique_function_object(
+                std::forward<Functor>(f)))
+        {}
+
+        unique_function(unique_function && other)
+          : base_type(std::move(static_cast<base_type &&>(other)))
+        {}
+
+        unique_function& operator=(unique_function && t)
+        {
+            this->base_type::operator=(std::move(static_cast<base_type &&>(t)));
+            return *this;
+        }
+
+        void clear() { reset(); }
+
+        // The stored function object is wrapped (see above), the wrapper is
+        // not visible to the user.
+        template <typename T>
+        T* target() BOOST_NOEXCEPT
+        {
+            typedef detail::unique_function_storage<
+                typename util::decay<T>::type> storage;
+            return storage::target(
+                this->base_type::template target<typename storage::type>());
+        }
+
+        template <typename T>
+        T const* target() const BOOST_NOEXCEPT
+        {
+            typedef detail::unique_function_storage<
+                typename util::decay<T>::type> storage;
+            return storage::target(
+                this->base_type::template target<typename storage::type>());
+        }
+
+    private:
+        // unique_function is not copyable
+        unique_function(unique_function const &);
+        unique_function& operator=(unique_function const &);
+    };
+}}
+
+namespace boost
+{
+    // util::invoke and util::result_of see through the wrapper
+    template <typename F>
+    struct is_reference_wrapper<hpx::util::detail::unique_function_object<F> >
+      : boost::mpl::true_
+    {};
+
+    template <typename F>
+    struct unwrap_reference<hpx::util::detail::unique_function_object<F> >
+    {
+        typedef F type;
+    };
+}
+
+#endif
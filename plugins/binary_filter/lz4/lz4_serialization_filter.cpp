@@ -0,0 +1,200 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+#include <hpx/runtime/actions/guid_initialization.hpp>
+#include <hpx/traits/plugin_config_data.hpp>
+#include <hpx/util/void_cast.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <climits>
+#include <cstring>
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.plugins.lz4_serialization_filter]
+    //      ...
+    //      high_compression_level = 0
+    //
+    template <>
+    struct plugin_config_data<hpx::plugins::compression::lz4_serialization_filter>
+    {
+        static char const* call()
+        {
+            return "high_compression_level = 0";
+        }
+    };
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_SERIALIZATION_REGISTER_TYPE_DEFINITION(
+    hpx::plugins::compression::lz4_serialization_filter);
+HPX_REGISTER_BASE_HELPER(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    namespace detail
+    {
+        // zero selects the default (fast) LZ4 compression
+        int get_high_compression_level()
+        {
+            static int level = boost::lexical_cast<int>(hpx::get_config_entry(
+                "hpx.plugins.lz4_serialization_filter.high_compression_level",
+                "0"));
+            return level;
+        }
+    }
+
+    lz4_serialization_filter::~lz4_serialization_filter()
+    {
+        hpx::actions::detail::guid_initialization<lz4_serialization_filter>();
+    }
+
+    void lz4_serialization_filter::register_base()
+    {
+        util::void_cast_register_nonvirt<
+            lz4_serialization_filter, util::binary_filter>();
+    }
+
+    void lz4_serialization_filter::set_max_length(std::size_t size)
+    {
+        buffer_.reserve(size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t lz4_serialization_filter::init_data(
+        char const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        if (size > INT_MAX || buffer_size > INT_MAX)
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is too large to be decompressed"));
+            return 0;
+        }
+
+        buffer_.resize(buffer_size);
+        int decompressed = 0;
+        if (size != 0)
+        {
+            decompressed = LZ4_decompress_safe(buffer, buffer_.data(),
+                static_cast<int>(size), static_cast<int>(buffer_size));
+        }
+
+        if (decompressed < 0)
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is corrupted"));
+            return 0;
+        }
+
+        buffer_.resize(static_cast<std::size_t>(decompressed));
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_+dst_count > buffer_.size())
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is too short"));
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::save(void const* src,
+        std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        buffer_.insert(buffer_.end(), src_begin, src_begin+src_count);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool lz4_serialization_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        if (buffer_.size() > LZ4_MAX_INPUT_SIZE)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::flush",
+                "compression failure, too much data to compress");
+            return false;
+        }
+
+        // make sure we have enough memory
+        int size = static_cast<int>(buffer_.size());
+        std::size_t needed = static_cast<std::size_t>(LZ4_compressBound(size));
+        if (needed > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        if (size == 0)
+        {
+            written = 0;
+            return true;
+        }
+
+        // compress everything in one go
+        char* dst_begin = static_cast<char*>(dst);
+        int level = detail::get_high_compression_level();
+        int compressed_length = 0;
+        if (level != 0)
+        {
+            compressed_length = LZ4_compress_HC(buffer_.data(), dst_begin,
+                size, static_cast<int>(needed), level);
+        }
+        else
+        {
+            compressed_length = LZ4_compress_default(buffer_.data(), dst_begin,
+                size, static_cast<int>(needed));
+        }
+
+        if (compressed_length <= 0)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::flush",
+                "compression failure, flushing did not reach end of data");
+            return false;
+        }
+
+        written = static_cast<std::size_t>(compressed_length);
+        return true;
+    }
+}}}
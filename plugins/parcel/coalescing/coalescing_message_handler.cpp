@@ -1,4 +1,4 @@
-//  Copyright (c) 2007-2013 Hartmut Kaiser
+//  Copyright (c) 2007-2014 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,11 +7,24 @@
 
 #if defined(HPX_HAVE_PARCEL_COALESCING)
 #include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/interval_timer.hpp>
+#include <hpx/util/static.hpp>
 
 #include <hpx/plugins/message_handler_factory.hpp>
 #include <hpx/plugins/parcel/coalescing_message_handler.hpp>
+#include <hpx/plugins/parcel/message_buffer.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <map>
 
 namespace hpx { namespace traits
 {
@@ -23,6 +36,8 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      adaptive = 0
+    //      combine_actions = $[hpx.plugins.coalescing_message_handler.adaptive]
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -30,7 +45,10 @@ namespace hpx { namespace traits
         static char const* call()
         {
             return "num_messages = 50\n"
-                   "interval = 100";
+                   "interval = 100\n"
+                   "adaptive = 0\n"
+                   "combine_actions = "
+                        "$[hpx.plugins.coalescing_message_handler.adaptive]";
         }
     };
 }}
@@ -63,90 +81,400 @@ namespace hpx { namespace plugins { namespace parcel
             return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
                 "hpx.plugins.coalescing_message_handler.interval", 100));
         }
-    }
 
-    coalescing_message_handler::coalescing_message_handler(
-            char const* action_name, parcelset::parcelport* pp, std::size_t num,
-            std::size_t interval)
-      : buffer_(detail::get_num_messages(num)), pp_(pp),
-        timer_(boost::bind(&coalescing_message_handler::timer_flush, this_()),
-            boost::bind(&coalescing_message_handler::flush, this_(), true),
-            detail::get_interval(interval), std::string(action_name) + "_timer",
-            true),
-        stopped_(false)
-    {}
+        bool get_adaptive()
+        {
+            return boost::lexical_cast<int>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0")) != 0;
+        }
+
+        bool get_combine_actions()
+        {
+            return boost::lexical_cast<int>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.combine_actions",
+                "0")) != 0;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // statistics collected over all coalescing buffers
+        struct coalescing_statistics
+        {
+            coalescing_statistics()
+              : parcels_(0), messages_(0), latency_parcels_(0),
+                added_latency_(0)
+            {}
+
+            // average number of parcels sent per message
+            boost::int64_t get_average_batch_size(bool reset)
+            {
+                boost::int64_t messages = util::get_and_reset_value(messages_, reset);
+                boost::int64_t parcels = util::get_and_reset_value(parcels_, reset);
+                return messages ? parcels / messages : 0;
+            }
+
+            // average time a parcel was held back [ns]
+            boost::int64_t get_average_added_latency(bool reset)
+            {
+                boost::int64_t parcels = util::get_and_reset_value(
+                    latency_parcels_, reset);
+                boost::int64_t latency = util::get_and_reset_value(
+                    added_latency_, reset);
+                return parcels ? latency / parcels : 0;
+            }
+
+            void add_message(std::size_t parcels, boost::int64_t added_latency)
+            {
+                parcels_ += parcels;
+                ++messages_;
+                latency_parcels_ += parcels;
+                added_latency_ += added_latency;
+            }
+
+            boost::atomic<boost::int64_t> parcels_;
+            boost::atomic<boost::int64_t> messages_;
+            boost::atomic<boost::int64_t> latency_parcels_;
+            boost::atomic<boost::int64_t> added_latency_;
+        };
+
+        struct coalescing_statistics_tag {};
+
+        coalescing_statistics& get_statistics()
+        {
+            util::static_<coalescing_statistics, coalescing_statistics_tag> s;
+            return s.get();
+        }
+
+        void register_counter_types()
+        {
+            static boost::atomic<bool> registered(false);
+            if (registered.exchange(true))
+                return;
+
+            coalescing_statistics& s = get_statistics();
+
+            error_code ec(lightweight);
+            performance_counters::install_counter_type(
+                "/coalescing/count/average-parcels-per-message",
+                boost::bind(&coalescing_statistics::get_average_batch_size,
+                    &s, ::_1),
+                "returns the average number of parcels sent in one message "
+                    "by the coalescing message handlers",
+                "", ec);
+            performance_counters::install_counter_type(
+                "/coalescing/time/average-added-latency",
+                boost::bind(&coalescing_statistics::get_average_added_latency,
+                    &s, ::_1),
+                "returns the average time parcels were held back by the "
+                    "coalescing message handlers",
+                "ns", ec);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // A coalescing_buffer collects the parcels for one destination (and
+        // action, unless actions are combined).
+        class coalescing_buffer : boost::noncopyable
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef parcelset::policies::message_handler::write_handler_type
+                write_handler_type;
+
+            coalescing_buffer* this_() { return this; }
+
+        public:
+            coalescing_buffer(std::string const& name,
+                    parcelset::parcelport* pp, std::size_t num_messages,
+                    std::size_t interval, bool adaptive)
+              : pp_(pp),
+                buffer_(num_messages),
+                timer_(boost::bind(&coalescing_buffer::timer_flush, this_()),
+                    boost::bind(&coalescing_buffer::flush, this_(), true),
+                    interval, name + "_timer", true),
+                stopped_(false),
+                adaptive_(adaptive),
+                max_messages_(num_messages),
+                max_latency_(boost::int64_t(interval) * 1000),
+                last_arrival_(0),
+                avg_interarrival_(0),
+                arrival_sum_(0)
+            {}
+
+            void put_parcel(parcelset::parcel& p, write_handler_type const& f);
+            void flush(bool stop_buffering);
+
+        private:
+            bool timer_flush();
+            void flush(mutex_type::scoped_lock& l, bool stop_buffering);
+            std::size_t get_batch_size(boost::uint64_t now);
+
+            mutable mutex_type mtx_;
+            parcelset::parcelport* pp_;
+            detail::message_buffer buffer_;
+            util::interval_timer timer_;
+            bool stopped_;
+
+            // data for the adaptive mode
+            bool adaptive_;
+            std::size_t max_messages_;
+            boost::int64_t max_latency_;        // [ns]
+            boost::uint64_t last_arrival_;      // [ns]
+            double avg_interarrival_;           // [ns]
+
+            // sum of the arrival times of the buffered parcels
+            boost::uint64_t arrival_sum_;       // [ns]
+        };
+
+        // Estimate how many parcels will arrive during the maximal allowed
+        // latency, based on the (exponentially weighted) average time between
+        // the arrivals of parcels.
+        std::size_t coalescing_buffer::get_batch_size(boost::uint64_t now)
+        {
+            if (last_arrival_ != 0)
+            {
+                double interarrival = double(now - last_arrival_);
+                if (avg_interarrival_ == 0)
+                    avg_interarrival_ = interarrival;
+                else
+                    avg_interarrival_ = 0.875 * avg_interarrival_ +
+                        0.125 * interarrival;
+            }
+            last_arrival_ = now;
+
+            // no estimate available yet
+            if (avg_interarrival_ == 0)
+                return 1;
+
+            double batch_size = double(max_latency_) / avg_interarrival_;
+            if (batch_size >= double(max_messages_))
+                return max_messages_;
+            return batch_size < 1 ? 1 : std::size_t(batch_size);
+        }
+
+        void coalescing_buffer::put_parcel(parcelset::parcel& p,
+            write_handler_type const& f)
+        {
+            mutex_type::scoped_lock l(mtx_);
+            if (stopped_) {
+                l.unlock();
+
+                // this instance should not buffer parcels anymore
+                pp_->put_parcel(p, f);
+                return;
+            }
+
+            boost::uint64_t now = util::high_resolution_clock::now();
+            if (adaptive_)
+            {
+                std::size_t batch_size = get_batch_size(now);
+
+                if (buffer_.empty())
+                {
+                    // Parcels are too rare to be combined without exceeding
+                    // the maximal allowed latency, send this one right away.
+                    if (batch_size <= 1)
+                    {
+                        l.unlock();
+                        get_statistics().add_message(1, 0);
+                        pp_->put_parcel(p, f);
+                        return;
+                    }
+
+                    // start a new batch, the deadline is the expected time to
+                    // fill the batch (which never exceeds the maximal latency)
+                    detail::message_buffer(batch_size).swap(buffer_);
+
+                    boost::int64_t deadline = boost::int64_t(
+                        double(batch_size) * avg_interarrival_) / 1000;
+                    timer_.change_interval((std::max)(boost::int64_t(1),
+                        (std::min)(deadline, max_latency_ / 1000)));
+                }
+            }
+            arrival_sum_ += now;
+
+            detail::message_buffer::message_buffer_append_state s =
+                buffer_.append(p, f);
+
+            switch(s) {
+            case detail::message_buffer::first_message:
+                timer_.start(false);        // start deadline timer to flush buffer
+                break;
+
+            case detail::message_buffer::normal:
+                // in adaptive mode the deadline is not extended, as this
+                // would increase the latency of the already buffered parcels
+                if (!adaptive_)
+                    timer_.restart(false);  // restart timer
+                break;
+
+            case detail::message_buffer::buffer_now_full:
+                flush(l, false);
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "coalescing_message_handler::put_parcel",
+                    "unexpected return value from message_buffer::append");
+                return;
+            }
+        }
+
+        bool coalescing_buffer::timer_flush()
+        {
+            // adjust timer if needed
+            mutex_type::scoped_lock l(mtx_);
+            if (!buffer_.empty())
+                flush(l, false);
+
+            // do not restart timer for now, will be restarted on next parcel
+            return false;
+        }
+
+        void coalescing_buffer::flush(bool stop_buffering)
+        {
+            mutex_type::scoped_lock l(mtx_);
+            flush(l, stop_buffering);
+        }
+
+        void coalescing_buffer::flush(mutex_type::scoped_lock& l,
+            bool stop_buffering)
+        {
+            if (!stopped_ && stop_buffering) {
+                stopped_ = true;
+                timer_.stop();              // interrupt timer
+            }
+
+            if (buffer_.empty())
+                return;
+
+            detail::message_buffer buff (buffer_.capacity());
+            std::swap(buff, buffer_);
+
+            // the added latency is the sum of the times all parcels have
+            // spent in the buffer
+            boost::uint64_t now = util::high_resolution_clock::now();
+            boost::int64_t added_latency =
+                boost::int64_t(now * buff.size() - arrival_sum_);
+            arrival_sum_ = 0;
 
-    void coalescing_message_handler::put_parcel(parcelset::parcel& p,
-        write_handler_type const& f)
-    {
-        mutex_type::scoped_lock l(mtx_);
-        if (stopped_) {
             l.unlock();
 
-            // this instance should not buffer parcels anymore
-            pp_->put_parcel(p, f);
-            return;
+            get_statistics().add_message(buff.size(), added_latency);
+
+            HPX_ASSERT(NULL != pp_);
+            buff(pp_);                   // 'invoke' the buffer
         }
 
-        detail::message_buffer::message_buffer_append_state s =
-            buffer_.append(p, f);
+        ///////////////////////////////////////////////////////////////////////
+        // All actions sent to the same destination share one buffer if
+        // actions are combined.
+        class combined_buffers
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef std::map<
+                naming::locality, boost::weak_ptr<coalescing_buffer>
+            > buffers_type;
+
+        public:
+            boost::shared_ptr<coalescing_buffer> get(
+                naming::locality const& dest, parcelset::parcelport* pp,
+                std::size_t num_messages, std::size_t interval)
+            {
+                mutex_type::scoped_lock l(mtx_);
+
+                boost::shared_ptr<coalescing_buffer> buffer =
+                    buffers_[dest].lock();
+                if (!buffer)
+                {
+                    buffer = boost::make_shared<coalescing_buffer>(
+                        "coalescing_" + boost::lexical_cast<std::string>(dest),
+                        pp, num_messages, interval, true);
+                    buffers_[dest] = buffer;
+                }
+                return buffer;
+            }
 
-        switch(s) {
-        case detail::message_buffer::first_message:
-            timer_.start(false);        // start deadline timer to flush buffer
-            break;
+            // remove the entries of the buffers which are not used by any
+            // message handler anymore
+            void prune()
+            {
+                mutex_type::scoped_lock l(mtx_);
 
-        case detail::message_buffer::normal:
-            timer_.restart(false);      // restart timer
-            break;
+                buffers_type::iterator it = buffers_.begin();
+                while (it != buffers_.end())
+                {
+                    if (it->second.expired())
+                        buffers_.erase(it++);
+                    else
+                        ++it;
+                }
+            }
 
-        case detail::message_buffer::buffer_now_full:
-            flush(l, false);
-            break;
+        private:
+            mutex_type mtx_;
+            buffers_type buffers_;
+        };
 
-        default:
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_message_handler::put_parcel",
-                "unexpected return value from message_buffer::append");
-            return;
+        struct combined_buffers_tag {};
+
+        combined_buffers& get_combined_buffers()
+        {
+            util::static_<combined_buffers, combined_buffers_tag> buffers;
+            return buffers.get();
         }
     }
 
-    bool coalescing_message_handler::timer_flush()
+    ///////////////////////////////////////////////////////////////////////////
+    coalescing_message_handler::coalescing_message_handler(
+            char const* action_name, parcelset::parcelport* pp, std::size_t num,
+            std::size_t interval)
+      : action_name_(action_name), pp_(pp),
+        num_messages_(detail::get_num_messages(num)),
+        interval_(detail::get_interval(interval)),
+        adaptive_(detail::get_adaptive()),
+        combine_actions_(adaptive_ && detail::get_combine_actions())
     {
-        // adjust timer if needed
-        mutex_type::scoped_lock l(mtx_);
-        if (!buffer_.empty())
-            flush(l, false);
+        detail::register_counter_types();
 
-        // do not restart timer for now, will be restarted on next parcel
-        return false;
+        if (!combine_actions_)
+        {
+            buffer_ = boost::make_shared<detail::coalescing_buffer>(
+                action_name_, pp_, num_messages_, interval_, adaptive_);
+        }
     }
 
-    void coalescing_message_handler::flush(bool stop_buffering)
+    // The destination is known only once the first parcel is sent, that's
+    // when the buffer shared by all actions is attached.
+    boost::shared_ptr<detail::coalescing_buffer>
+    coalescing_message_handler::get_buffer(parcelset::parcel const& p)
     {
         mutex_type::scoped_lock l(mtx_);
-        flush(l, stop_buffering);
+        if (!buffer_)
+        {
+            buffer_ = detail::get_combined_buffers().get(
+                p.get_destination_locality(), pp_, num_messages_, interval_);
+        }
+        return buffer_;
     }
 
-    void coalescing_message_handler::flush(mutex_type::scoped_lock& l,
-        bool stop_buffering)
+    void coalescing_message_handler::put_parcel(parcelset::parcel& p,
+        write_handler_type const& f)
     {
-        if (!stopped_ && stop_buffering) {
-            stopped_ = true;
-            timer_.stop();              // interrupt timer
-        }
+        get_buffer(p)->put_parcel(p, f);
+    }
 
-        if (buffer_.empty())
-            return;
+    void coalescing_message_handler::flush(bool stop_buffering)
+    {
+        boost::shared_ptr<detail::coalescing_buffer> buffer;
 
-        detail::message_buffer buff (buffer_.capacity());
-        std::swap(buff, buffer_);
+        {
+            mutex_type::scoped_lock l(mtx_);
+            buffer = buffer_;
+        }
 
-        l.unlock();
+        if (buffer)
+            buffer->flush(stop_buffering);
 
-        HPX_ASSERT(NULL != pp_);
-        buff(pp_);                   // 'invoke' the buffer
+        if (combine_actions_)
+            detail::get_combined_buffers().prune();
     }
 }}}
 
@@ -438,8 +438,8 @@ namespace hpx
             if (vm.count("hpx:high-priority-threads")) {
                 throw std::logic_error("Invalid command line option "
                     "--hpx:high-priority-threads, valid for "
-                    "--hpx:queuing=priority_local and --hpx:queuing=priority_abp "
-                    "only");
+                    "--hpx:queuing=priority_local, --hpx:queuing=priority_abp, "
+                    "and --hpx:queuing=priority_chase_lev only");
             }
         }
 
@@ -449,8 +449,9 @@ namespace hpx
             if (vm.count("hpx:numa-sensitive")) {
                 throw std::logic_error("Invalid command line option "
                     "--hpx:numa-sensitive, valid for "
-                    "--hpx:queuing=local, --hpx:queuing=priority_local, or "
-                    "--hpx:queuing=priority_abp only");
+                    "--hpx:queuing=local, --hpx:queuing=priority_local, "
+                    "--hpx:queuing=priority_abp, or "
+                    "--hpx:queuing=priority_chase_lev only");
             }
         }
 
@@ -544,6 +545,7 @@ namespace hpx
 #if defined(HPX_LOCAL_SCHEDULER)
         ///////////////////////////////////////////////////////////////////////
         // local scheduler (one queue for each OS threads)
+        template <typename LocalQueuePolicy>
         int run_local(startup_function_type const& startup,
             shutdown_function_type const& shutdown,
             util::command_line_handling& cfg, bool blocking)
@@ -616,9 +618,8 @@ namespace hpx
 #endif
 
             // scheduling policy
-            typedef hpx::threads::policies::local_queue_scheduler<>
-                local_queue_policy;
-            local_queue_policy::init_parameter_type init(
+            typedef LocalQueuePolicy local_queue_policy;
+            typename local_queue_policy::init_parameter_type init(
                 cfg.num_threads_, 1000, numa_sensitive);
             threads::policies::init_affinity_data affinity_init(
                 pu_offset, pu_step, affinity_domain, affinity_desc);
@@ -746,6 +747,7 @@ namespace hpx
         ///////////////////////////////////////////////////////////////////////
         // local scheduler with priority queue (one queue for each OS threads
         // plus one separate queue for high priority HPX-threads)
+        template <typename LocalQueuePolicy>
         int run_priority_local(startup_function_type const& startup,
             shutdown_function_type const& shutdown,
             util::command_line_handling& cfg, bool blocking)
@@ -822,9 +824,8 @@ namespace hpx
             }
 #endif
             // scheduling policy
-            typedef hpx::threads::policies::local_priority_queue_scheduler<>
-                local_queue_policy;
-            local_queue_policy::init_parameter_type init(
+            typedef LocalQueuePolicy local_queue_policy;
+            typename local_queue_policy::init_parameter_type init(
                 cfg.num_threads_, num_high_priority_queues, 1000,
                 numa_sensitive);
             threads::policies::init_affinity_data affinity_init(
@@ -930,6 +931,103 @@ namespace hpx
         }
 #endif
 
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+        ///////////////////////////////////////////////////////////////////////
+        // NUMA aware hierarchical scheduler: one shared queue for each NUMA
+        // domain and one queue for each OS thread, stealing prefers queues
+        // of the own NUMA domain
+        int run_numa_hierarchy(startup_function_type const& startup,
+            shutdown_function_type const& shutdown,
+            util::command_line_handling& cfg, bool blocking)
+        {
+            ensure_high_priority_compatibility(cfg.vm_);
+            ensure_numa_sensitivity_compatibility(cfg.vm_);
+            ensure_hierarchy_arity_compatibility(cfg.vm_);
+
+            std::size_t pu_offset = std::size_t(-1);
+            std::size_t pu_step = 1;
+            std::string affinity_domain("pu");
+            std::string affinity_desc;
+
+#if defined(HPX_HAVE_HWLOC) || defined(BOOST_WINDOWS)
+            if (cfg.vm_.count("hpx:pu-offset")) {
+                pu_offset = cfg.vm_["hpx:pu-offset"].as<std::size_t>();
+                if (pu_offset >= hpx::threads::hardware_concurrency()) {
+                    throw std::logic_error("Invalid command line option "
+                        "--hpx:pu-offset, value must be smaller than number of "
+                        "available processing units.");
+                }
+            }
+
+            if (cfg.vm_.count("hpx:pu-step")) {
+                pu_step = cfg.vm_["hpx:pu-step"].as<std::size_t>();
+                if (pu_step == 0 || pu_step >= hpx::threads::hardware_concurrency()) {
+                    throw std::logic_error("Invalid command line option "
+                        "--hpx:pu-step, value must be non-zero smaller than number of "
+                        "available processing units.");
+                }
+            }
+#endif
+#if defined(HPX_HAVE_HWLOC)
+            if (cfg.vm_.count("hpx:affinity")) {
+                affinity_domain = cfg.vm_["hpx:affinity"].as<std::string>();
+                if (0 != std::string("pu").find(affinity_domain) &&
+                    0 != std::string("core").find(affinity_domain) &&
+                    0 != std::string("numa").find(affinity_domain) &&
+                    0 != std::string("machine").find(affinity_domain))
+                {
+                    throw std::logic_error("Invalid command line option "
+                        "--hpx:affinity, value must be one of: pu, core, numa, "
+                        "or machine.");
+                }
+            }
+            if (cfg.vm_.count("hpx:bind")) {
+                if (cfg.vm_.count("hpx:pu-offset") ||
+                    cfg.vm_.count("hpx:pu-step") ||
+                    cfg.vm_.count("hpx:affinity"))
+                {
+                    throw std::logic_error("Command line option --hpx:bind "
+                        "should not be used with --hpx:pu-step, --hpx:pu-offset, "
+                        "or --hpx:affinity.");
+                }
+
+                std::vector<std::string> bind_affinity =
+                    cfg.vm_["hpx:bind"].as<std::vector<std::string> >();
+                BOOST_FOREACH(std::string const& s, bind_affinity)
+                {
+                    if (!affinity_desc.empty())
+                        affinity_desc += ";";
+                    affinity_desc += s;
+                }
+            }
+#endif
+
+            // scheduling policy
+            typedef hpx::threads::policies::numa_hierarchy_scheduler<>
+                queue_policy;
+            queue_policy::init_parameter_type init(cfg.num_threads_, 1000);
+            threads::policies::init_affinity_data affinity_init(
+                pu_offset, pu_step, affinity_domain, affinity_desc);
+
+            // Build and configure this runtime instance.
+            typedef hpx::runtime_impl<queue_policy> runtime_type;
+            HPX_STD_UNIQUE_PTR<hpx::runtime> rt(
+                new runtime_type(cfg.rtcfg_, cfg.mode_, cfg.num_threads_, init,
+                    affinity_init));
+
+            if (blocking) {
+                return run(*rt, cfg.hpx_main_f_, cfg.vm_, cfg.mode_, startup,
+                    shutdown);
+            }
+
+            // non-blocking version
+            start(*rt, cfg.hpx_main_f_, cfg.vm_, cfg.mode_, startup, shutdown);
+
+            rt.release();          // pointer to runtime is stored in TLS
+            return 0;
+        }
+#endif
+
 #if defined(HPX_PERIODIC_PRIORITY_SCHEDULER)
         ///////////////////////////////////////////////////////////////////////
         // hierarchical scheduler: The thread queues are built up hierarchically
@@ -1022,11 +1120,25 @@ namespace hpx
             // Initialize and start the HPX runtime.
             if (0 == std::string("local").find(cfg.queuing_)) {
 #if defined(HPX_LOCAL_SCHEDULER)
-                result = detail::run_local(startup, shutdown, cfg, blocking);
+                result = detail::run_local<
+                        hpx::threads::policies::local_queue_scheduler<>
+                    >(startup, shutdown, cfg, blocking);
 #else
                 throw std::logic_error("Command line option --hpx:queuing=local "
                     "is not configured in this build. Please rebuild with "
                     "'cmake -DHPX_LOCAL_SCHEDULER=ON'.");
+#endif
+            }
+            else if (0 == std::string("local_chase_lev").find(cfg.queuing_)) {
+#if defined(HPX_LOCAL_SCHEDULER)
+                // local scheduler using Chase-Lev work-stealing deques
+                result = detail::run_local<
+                        hpx::threads::policies::chase_lev_local_queue_scheduler
+                    >(startup, shutdown, cfg, blocking);
+#else
+                throw std::logic_error("Command line option "
+                    "--hpx:queuing=local_chase_lev is not configured in this "
+                    "build. Please rebuild with 'cmake -DHPX_LOCAL_SCHEDULER=ON'.");
 #endif
             }
             else if (0 == std::string("static").find(cfg.queuing_)) {
@@ -1041,7 +1153,9 @@ namespace hpx
             else if (0 == std::string("priority_local").find(cfg.queuing_)) {
                 // local scheduler with priority queue (one queue for each OS threads
                 // plus separate deques for low/high priority HPX-threads)
-                result = detail::run_priority_local(startup, shutdown, cfg, blocking);
+                result = detail::run_priority_local<
+                        hpx::threads::policies::local_priority_queue_scheduler<>
+                    >(startup, shutdown, cfg, blocking);
             }
             else if (0 == std::string("priority_abp").find(cfg.queuing_)) {
                 // local scheduler with priority deque (one deque for each OS threads
@@ -1049,6 +1163,15 @@ namespace hpx
                 // abp-style stealing
                 result = detail::run_priority_abp(startup, shutdown, cfg, blocking);
             }
+            else if (0 == std::string("priority_chase_lev").find(cfg.queuing_)) {
+                // local scheduler with priority queue (one Chase-Lev deque for
+                // each OS thread plus separate deques for low/high priority
+                // HPX-threads), the owning OS thread does not need any CAS
+                // operations to access its deque
+                result = detail::run_priority_local<
+                        hpx::threads::policies::chase_lev_priority_queue_scheduler
+                    >(startup, shutdown, cfg, blocking);
+            }
             else if (0 == std::string("hierarchy").find(cfg.queuing_)) {
 #if defined(HPX_HIERARCHY_SCHEDULER)
                 // hierarchy scheduler: tree of queues, with work
@@ -1058,6 +1181,19 @@ namespace hpx
                 throw std::logic_error("Command line option --hpx:queuing=hierarchy "
                     "is not configured in this build. Please rebuild with "
                     "'cmake -DHPX_HIERARCHY_SCHEDULER=ON'.");
+#endif
+            }
+            else if (0 == std::string("numa_hierarchy").find(cfg.queuing_)) {
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+                // NUMA aware scheduler: one queue per NUMA domain on top of
+                // one queue for each OS thread, stealing is topology aware
+                result = detail::run_numa_hierarchy(startup, shutdown, cfg,
+                    blocking);
+#else
+                throw std::logic_error("Command line option "
+                    "--hpx:queuing=numa_hierarchy is not configured in this "
+                    "build. Please rebuild with "
+                    "'cmake -DHPX_NUMA_HIERARCHY_SCHEDULER=ON'.");
 #endif
             }
             else if (0 == std::string("periodic").find(cfg.queuing_)) {
@@ -0,0 +1,269 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/lcos/detail/full_empty_cell.hpp>
+#include <hpx/lcos/detail/full_empty_entry.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct full_empty_cell_base::waiter
+    {
+        explicit waiter(threads::thread_id_type const& id)
+          : next_(0), id_(id), notified_(false)
+        {}
+
+        waiter* next_;
+        threads::thread_id_type id_;
+        boost::atomic<bool> notified_;
+    };
+
+    struct full_empty_cell_base::detach_on_exit
+    {
+        detach_on_exit(full_empty_cell_base& cell, waiter& self)
+          : cell_(cell), self_(self)
+        {}
+
+        ~detach_on_exit()
+        {
+            // detach may suspend, which must not throw while unwinding
+            this_thread::disable_interruption di;
+            cell_.detach(self_);
+        }
+
+        full_empty_cell_base& cell_;
+        waiter& self_;
+    };
+
+    namespace
+    {
+        inline std::size_t list_of(std::size_t word)
+        {
+            return word & ~std::size_t(3);
+        }
+
+        inline std::size_t state_of(full_empty_state state)
+        {
+            return state == full ? 1 : 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    full_empty_cell_base::~full_empty_cell_base()
+    {
+        std::size_t list = list_of(word_.exchange(0));
+        if (list != 0)
+        {
+            LERR_(info) << "~full_empty_cell: aborting pending threads";
+            resume_waiters(list, 0, threads::wait_abort);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool full_empty_cell_base::acquire(full_empty_state wait_for,
+        char const* description, error_code& ec)
+    {
+        // the two lowest bits of the pointers to the waiters are used to
+        // store the state of the cell
+        BOOST_STATIC_ASSERT(boost::alignment_of<waiter>::value > 3);
+
+        std::size_t const state = state_of(wait_for);
+
+        std::size_t k = 0;
+        std::size_t w = word_.load(boost::memory_order_acquire);
+        while (true)
+        {
+            if (w & state_busy)
+            {
+                // somebody else is accessing the data, this won't take long
+                lcos::local::spinlock::yield(k++);
+                w = word_.load(boost::memory_order_acquire);
+                continue;
+            }
+
+            if ((w & state_full) == state)
+            {
+                if (word_.compare_exchange_weak(w, w | state_busy,
+                        boost::memory_order_acquire))
+                {
+                    return true;
+                }
+                continue;
+            }
+
+            // the cell is in the opposite state, enqueue this thread
+            threads::thread_self* self = threads::get_self_ptr_checked(ec);
+            if (0 == self || ec) return false;
+
+            waiter f(threads::get_self_id());
+            f.next_ = reinterpret_cast<waiter*>(list_of(w));
+            if (!word_.compare_exchange_weak(w,
+                    reinterpret_cast<std::size_t>(&f) | (w & state_mask),
+                    boost::memory_order_release))
+            {
+                continue;
+            }
+
+            if (wait_for == full)
+                ++full_empty_counter_data_.read_enqueued_;
+
+            // yield this thread, the waiter is taken off the list before
+            // it goes out of scope, even if the thread was interrupted or
+            // aborted
+            {
+                detach_on_exit d(*this, f);
+                this_thread::suspend(threads::suspended, description, ec);
+            }
+            if (ec) return false;
+
+            if (wait_for == full)
+                ++full_empty_counter_data_.read_dequeued_;
+
+            k = 0;
+            w = word_.load(boost::memory_order_acquire);
+        }
+        return false;
+    }
+
+    bool full_empty_cell_base::try_acquire(full_empty_state state)
+    {
+        std::size_t const s = state_of(state);
+
+        std::size_t k = 0;
+        std::size_t w = word_.load(boost::memory_order_acquire);
+        while (true)
+        {
+            if (w & state_busy)
+            {
+                lcos::local::spinlock::yield(k++);
+                w = word_.load(boost::memory_order_acquire);
+                continue;
+            }
+
+            if ((w & state_full) != s)
+                return false;
+
+            if (word_.compare_exchange_weak(w, w | state_busy,
+                    boost::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void full_empty_cell_base::acquire_any()
+    {
+        std::size_t k = 0;
+        std::size_t w = word_.load(boost::memory_order_acquire);
+        while (true)
+        {
+            if (w & state_busy)
+            {
+                lcos::local::spinlock::yield(k++);
+                w = word_.load(boost::memory_order_acquire);
+                continue;
+            }
+
+            if (word_.compare_exchange_weak(w, w | state_busy,
+                    boost::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+
+    void full_empty_cell_base::release(full_empty_state state)
+    {
+        std::size_t const s = state_of(state);
+
+        std::size_t w = word_.load(boost::memory_order_relaxed);
+        HPX_ASSERT(w & state_busy);
+
+        // the state did not change, all waiting threads keep waiting
+        while ((w & state_full) == s)
+        {
+            if (word_.compare_exchange_weak(w, w & ~std::size_t(state_busy),
+                    boost::memory_order_release))
+            {
+                return;
+            }
+        }
+
+        // the state changed, detach the list of waiting threads
+        w = word_.exchange(s, boost::memory_order_acq_rel);
+
+        std::size_t list = list_of(w);
+        if (list != 0)
+        {
+            if (state == full)
+                ++full_empty_counter_data_.set_full_;
+
+            resume_waiters(list, 0, threads::wait_signaled);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void full_empty_cell_base::detach(waiter& self)
+    {
+        std::size_t k = 0;
+        while (!self.notified_.load(boost::memory_order_acquire))
+        {
+            // This thread was resumed without having been taken off the list
+            // of waiting threads (for instance, because it was aborted). Take
+            // the whole list and resume all other threads in it, those will
+            // simply enqueue themselves again.
+            std::size_t w = word_.load(boost::memory_order_acquire);
+            std::size_t list = list_of(w);
+            if (list == 0)
+            {
+                // somebody else is about to notify this thread
+                lcos::local::spinlock::yield(k++);
+                continue;
+            }
+
+            if (word_.compare_exchange_weak(w, w & state_mask,
+                    boost::memory_order_acq_rel))
+            {
+                resume_waiters(list, &self, threads::wait_signaled);
+            }
+        }
+    }
+
+    void full_empty_cell_base::resume_waiters(std::size_t list, waiter* self,
+        threads::thread_state_ex_enum state_ex)
+    {
+        waiter* w = reinterpret_cast<waiter*>(list);
+        while (w != 0)
+        {
+            // the waiter may go away as soon as it has been notified
+            waiter* next = w->next_;
+            threads::thread_id_type id = w->id_;
+
+            w->notified_.store(true, boost::memory_order_release);
+
+            if (w != self)
+            {
+                error_code ec(lightweight);
+                threads::set_thread_state(id, threads::pending, state_ex,
+                    threads::thread_priority_default, ec);
+                if (ec) {
+                    LERR_(error) << "full_empty_cell: could not resume thread("
+                        << id.get() << "): " << ec.get_message();
+                }
+            }
+
+            w = next;
+        }
+    }
+}}}
@@ -0,0 +1,61 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/lcos/detail/inline_continuation.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/thread/tss.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    namespace
+    {
+        // Only continuations executed on OS-threads which do not run an
+        // HPX-thread are counted. HPX-threads may suspend while executing a
+        // continuation and resume on a different OS-thread, which would
+        // corrupt any per OS-thread count.
+        boost::thread_specific_ptr<std::size_t> inline_depth_;
+
+        std::size_t& inline_depth()
+        {
+            std::size_t* depth = inline_depth_.get();
+            if (0 == depth)
+            {
+                depth = new std::size_t(0);
+                inline_depth_.reset(depth);
+            }
+            return *depth;
+        }
+    }
+
+    bool can_run_inline()
+    {
+        if (0 != threads::get_self_ptr())
+        {
+            return threads::get_available_stack_space() >=
+                HPX_CONTINUATION_MIN_STACK_SPACE;
+        }
+        return inline_depth() < HPX_CONTINUATION_MAX_INLINE_DEPTH;
+    }
+
+    inline_continuation_scope::inline_continuation_scope()
+      : counted_(0 == threads::get_self_ptr())
+    {
+        if (counted_)
+            ++inline_depth();
+    }
+
+    inline_continuation_scope::~inline_continuation_scope()
+    {
+        if (counted_)
+        {
+            HPX_ASSERT(inline_depth() != 0);
+            --inline_depth();
+        }
+    }
+}}}
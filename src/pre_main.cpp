@@ -49,15 +49,18 @@ create_barrier(std::size_t num_localities, char const* symname)
 inline lcos::barrier
 find_barrier(char const* symname)
 {
+    // the symbol namespace tells us as soon as the barrier is registered, we
+    // don't wait longer than the retry budget allows
+    lcos::unique_future<naming::id_type> f = agas::when_registered(symname);
+
     naming::id_type barrier_id;
-    for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+    if (f.wait_for(boost::posix_time::milliseconds(
+            HPX_MAX_NETWORK_RETRIES * HPX_NETWORK_RETRIES_SLEEP)) ==
+        lcos::future_status::ready)
     {
-        if (agas::resolve_name_sync(symname, barrier_id))
-            break;
-
-        boost::this_thread::sleep(boost::get_system_time() +
-            boost::posix_time::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+        barrier_id = f.get();
     }
+
     if (HPX_UNLIKELY(!barrier_id))
     {
         HPX_THROW_EXCEPTION(network_error, "pre_main::find_barrier",
@@ -252,6 +255,9 @@ bool pre_main(runtime_mode mode)
     // connected localities
     agas_client.adjust_local_cache_size();
 
+    // from now on, send the buffered decrefs to AGAS periodically
+    agas_client.start_refcnt_flush_timer();
+
     return true;
 }
 
@@ -24,10 +24,12 @@
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #if !defined(HPX_GCC_VERSION) || (HPX_GCC_VERSION > 40400)
 #include <hpx/lcos/broadcast.hpp>
 #endif
 
+#include <boost/foreach.hpp>
 #include <boost/format.hpp>
 #include <boost/icl/closed_interval.hpp>
 #include <boost/lexical_cast.hpp>
@@ -113,90 +115,6 @@ struct addressing_service::hosted_data_type
     server::symbol_namespace symbol_ns_server_;
 }; // }}}
 
-struct addressing_service::gva_cache_key
-{ // {{{ gva_cache_key implementation
-  private:
-    typedef boost::icl::closed_interval<naming::gid_type, std::less>
-        key_type;
-
-    key_type key_;
-
-  public:
-    gva_cache_key()
-      : key_()
-    {}
-
-    explicit gva_cache_key(
-        naming::gid_type const& id_
-      , boost::uint64_t count_ = 1
-        )
-      : key_(naming::detail::get_stripped_gid(id_)
-           , naming::detail::get_stripped_gid(id_) + (count_ - 1))
-    {
-        HPX_ASSERT(count_);
-    }
-
-    naming::gid_type get_gid() const
-    {
-        return boost::icl::lower(key_);
-    }
-
-    boost::uint64_t get_count() const
-    {
-        naming::gid_type const size = boost::icl::length(key_);
-        HPX_ASSERT(size.get_msb() == 0);
-        return size.get_lsb();
-    }
-
-    friend bool operator<(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        return boost::icl::exclusive_less(lhs.key_, rhs.key_);
-    }
-
-    friend bool operator==(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        // Is lhs in rhs?
-        if (1 == lhs.get_count() && 1 != rhs.get_count())
-            return boost::icl::contains(rhs.key_, lhs.key_);
-
-        // Is rhs in lhs?
-        else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            return boost::icl::contains(lhs.key_, rhs.key_);
-
-        // Direct hit
-        return lhs.key_ == rhs.key_;
-    }
-}; // }}}
-
-struct addressing_service::gva_erase_policy
-{ // {{{ gva_erase_policy implementation
-    gva_erase_policy(
-        naming::gid_type const& id
-      , boost::uint64_t count
-        )
-      : entry(id, count)
-    {}
-
-    typedef std::pair<
-        gva_cache_key, boost::cache::entries::lfu_entry<gva>
-    > entry_type;
-
-    bool operator()(
-        entry_type const& p
-        ) const
-    {
-        return p.first == entry;
-    }
-
-    gva_cache_key entry;
-}; // }}}
-
 addressing_service::addressing_service(
     parcelset::parcelport& pp
   , util::runtime_configuration const& ini_
@@ -208,6 +126,12 @@ addressing_service::addressing_service(
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
   , refcnt_requests_(new refcnt_requests_type)
+  , refcnt_flush_timer_(
+        boost::bind(&addressing_service::flush_refcnt_requests, this)
+      , boost::int64_t(ini_.get_agas_refcnt_flush_interval()) * 1000
+      , "addressing_service::flush_refcnt_requests", true)
+  , enable_refcnt_flush_timer_(false)
+  , flushed_credits_(0)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
@@ -219,6 +143,7 @@ addressing_service::addressing_service(
   , mem_lva_(0)
   , state_(starting)
   , locality_()
+  , symbol_cache_epoch_(0)
 { // {{{
     create_big_boot_barrier(pp, ini_);
 
@@ -429,6 +354,43 @@ void addressing_service::adjust_local_cache_size()
     }
 } // }}}
 
+void addressing_service::start_refcnt_flush_timer()
+{
+    if (0 == refcnt_flush_timer_.get_interval())
+        return;
+
+    // the timer terminates itself during pre-shutdown, start_shutdown()
+    // sends the decrements collected afterwards
+    mutex_type::scoped_lock l(refcnt_requests_mtx_);
+    enable_refcnt_flush_timer_ = true;
+
+    // the first start registers the pre-shutdown termination, the timer
+    // stops again right away if nothing has been buffered so far
+    refcnt_flush_timer_.start(false);
+}
+
+bool addressing_service::flush_refcnt_requests()
+{
+    error_code ec(lightweight);
+
+    mutex_type::scoped_lock l(refcnt_requests_mtx_);
+    send_refcnt_requests_non_blocking(l, ec);
+
+    if (ec)
+    {
+        LAGAS_(error) << (boost::format(
+            "addressing_service::flush_refcnt_requests, "
+            "failed to send pending decrements: %1%")
+            % ec.get_message());
+    }
+
+    // The buffer has been flushed, stop the timer. It is started again by
+    // send_refcnt_requests once the next decrement is buffered (the timer is
+    // not marked as running while this function executes), which avoids
+    // waking up idle worker threads when there is nothing to send.
+    return false;
+}
+
 void addressing_service::set_local_locality(naming::gid_type const& g)
 {
     locality_ = g;
@@ -1119,11 +1081,8 @@ bool addressing_service::unbind_range_local(
         if (ec || (success != rep.get_status()))
             return false;
 
-        // I'm afraid that this will break the first form of paged caching,
-        // so it's commented out for now.
-        //cache_mutex_type::scoped_lock lock(hosted->gva_cache_mtx_);
-        //gva_erase_policy ep(lower_id, count);
-        //hosted->gva_cache_->erase(ep);
+        // I'm afraid that erasing the range from the cache will break the
+        // first form of paged caching, so we don't do it for now.
 
         gva const& gaddr = rep.get_gva();
         addr.locality_ = gaddr.endpoint;
@@ -1355,19 +1314,16 @@ bool addressing_service::resolve_cached(
     }
 
     // first look up the requested item in the cache
-    gva_cache_key k(id);
-    gva_cache_key idbase;
-    gva_cache_type::entry_type e;
-
-    cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
+    naming::gid_type idbase;
+    gva g;
 
     // Check if the entry is currently in the cache
-    if (gva_cache_->get_entry(k, idbase, e))
+    if (gva_cache_->get_entry(id, idbase, g))
     {
         const boost::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(id.get_msb());
 
-        if (HPX_UNLIKELY(id_msb != idbase.get_gid().get_msb()))
+        if (HPX_UNLIKELY(id_msb != idbase.get_msb()))
         {
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::resolve_cached"
@@ -1375,13 +1331,9 @@ bool addressing_service::resolve_cached(
             return false;
         }
 
-        gva const& g = e.get();
-
         addr.locality_ = g.endpoint;
         addr.type_ = g.type;
-        addr.address_ = g.lva(id, idbase.get_gid());
-
-        lock.unlock();
+        addr.address_ = g.lva(id, idbase);
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -1393,7 +1345,7 @@ bool addressing_service::resolve_cached(
                 "cache hit for address %1%, lva %2% (base %3%, lva %4%)")
             % id
             % reinterpret_cast<void*>(addr.address_)
-            % idbase.get_gid()
+            % idbase
             % reinterpret_cast<void*>(g.lva()));
 */
 
@@ -1715,6 +1667,13 @@ void addressing_service::route(
 
             // send to the main AGAS instance for routing
             hpx::applier::get_applier().get_parcel_handler().put_parcel(route_p, f);
+
+            // The main AGAS instance knows the addresses of all service
+            // instances. Once the address of the target instance is cached,
+            // requests are sent to that instance directly instead of going
+            // through the main AGAS instance every time.
+            if (caching_)
+                resolve_service_instance_async(target.get_gid());
             return;
         }
     }
@@ -1724,6 +1683,43 @@ void addressing_service::route(
       , f, req);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void addressing_service::resolve_service_instance_async(
+    naming::gid_type const& id
+    )
+{
+    // don't ask more than once for the same service instance
+    boost::uint32_t const locality_id = naming::get_locality_id_from_gid(id);
+    {
+        cache_mutex_type::scoped_lock l(resolving_instances_mtx_);
+        if (!resolving_instances_.insert(locality_id).second)
+            return;
+    }
+
+    request req(primary_ns_resolve_gid, id);
+    naming::id_type const target(
+        bootstrap_primary_namespace_gid(), naming::id_type::unmanaged);
+
+    using util::placeholders::_1;
+    stubs::primary_namespace::service_async<response>(target, req).then(
+        util::bind(&addressing_service::resolve_service_instance_postproc,
+            this, _1, id));
+}
+
+void addressing_service::resolve_service_instance_postproc(
+    unique_future<response> f
+  , naming::gid_type const& id
+    )
+{
+    {
+        cache_mutex_type::scoped_lock l(resolving_instances_mtx_);
+        resolving_instances_.erase(naming::get_locality_id_from_gid(id));
+    }
+
+    // this puts the address of the service instance into the cache
+    resolve_full_postproc(std::move(f), id);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // The parameter 'compensated_credit' holds the amount of credits to be added
 // to the acknowledged number of credits. The compensated credits are non-zero
@@ -1986,6 +1982,7 @@ bool addressing_service::unregister_name(
 
         if (!ec && (success == rep.get_status()))
         {
+            erase_symbol_cache_entry(name);
             id = rep.get_gid();
             return true;
         }
@@ -2002,6 +1999,8 @@ lcos::unique_future<naming::id_type> addressing_service::unregister_name_async(
     std::string const& name
     )
 { // {{{
+    erase_symbol_cache_entry(name);
+
     request req(symbol_ns_unbind, name);
 
     return stubs::symbol_namespace::service_async<naming::id_type>(
@@ -2039,14 +2038,213 @@ bool addressing_service::resolve_name(
     }
 } // }}}
 
+namespace detail
+{
+    naming::id_type get_first_id(
+        lcos::unique_future<std::vector<naming::id_type> > f
+        )
+    {
+        return f.get().front();
+    }
+}
+
 lcos::unique_future<naming::id_type> addressing_service::resolve_name_async(
     std::string const& name
     )
 { // {{{
-    request req(symbol_ns_resolve, name);
+    if (!caching_)
+    {
+        request req(symbol_ns_resolve, name);
 
-    return stubs::symbol_namespace::service_async<naming::id_type>(
-        name, req, action_priority_);
+        return stubs::symbol_namespace::service_async<naming::id_type>(
+            name, req, action_priority_);
+    }
+
+    {
+        cache_mutex_type::scoped_lock l(symbol_cache_mtx_);
+
+        std::map<std::string, naming::id_type>::iterator it =
+            symbol_cache_.find(name);
+        if (it != symbol_cache_.end())
+            return make_ready_future(it->second);
+    }
+
+    using HPX_STD_PLACEHOLDERS::_1;
+    return resolve_names_async(std::vector<std::string>(1, name)).then(
+        HPX_STD_BIND(&detail::get_first_id, _1));
+} // }}}
+
+lcos::unique_future<std::vector<naming::id_type> >
+addressing_service::resolve_names_async(
+    std::vector<std::string> const& names
+    )
+{ // {{{
+    std::vector<naming::id_type> ids(names.size());
+    std::vector<std::size_t> missing;
+    boost::uint64_t epoch = 0;
+
+    if (caching_)
+    {
+        cache_mutex_type::scoped_lock l(symbol_cache_mtx_);
+
+        epoch = symbol_cache_epoch_;
+        for (std::size_t i = 0; i != names.size(); ++i)
+        {
+            std::map<std::string, naming::id_type>::iterator it =
+                symbol_cache_.find(names[i]);
+            if (it != symbol_cache_.end())
+                ids[i] = it->second;
+            else
+                missing.push_back(i);
+        }
+    }
+    else
+    {
+        missing.reserve(names.size());
+        for (std::size_t i = 0; i != names.size(); ++i)
+            missing.push_back(i);
+    }
+
+    if (missing.empty())
+        return make_ready_future(std::move(ids));
+
+    // send one request to each symbol namespace instance responsible for
+    // any of the missing names
+    typedef std::map<naming::gid_type, std::vector<std::size_t> > targets_type;
+
+    targets_type targets;
+    BOOST_FOREACH(std::size_t i, missing)
+    {
+        naming::id_type const target =
+            stubs::symbol_namespace::symbol_namespace_locality(names[i]);
+        targets[target.get_gid()].push_back(i);
+    }
+
+    // ask to be told about unregistered names only if we cache them
+    boost::uint32_t const watcher = caching_ ?
+        naming::get_locality_id_from_gid(get_local_locality()) :
+        naming::invalid_locality_id;
+
+    std::vector<lcos::unique_future<std::vector<response> > > requests;
+    std::vector<std::vector<std::size_t> > indices;
+    requests.reserve(targets.size());
+    indices.reserve(targets.size());
+
+    BOOST_FOREACH(targets_type::value_type const& t, targets)
+    {
+        std::vector<std::string> target_names;
+        target_names.reserve(t.second.size());
+        BOOST_FOREACH(std::size_t i, t.second)
+            target_names.push_back(names[i]);
+
+        requests.push_back(stubs::symbol_namespace::resolve_names_async(
+            naming::id_type(t.first, naming::id_type::unmanaged)
+          , target_names, watcher, action_priority_));
+        indices.push_back(t.second);
+    }
+
+    using HPX_STD_PLACEHOLDERS::_1;
+    return hpx::when_all(requests).then(
+        HPX_STD_BIND(&addressing_service::resolve_names_postproc, this, _1,
+            std::move(ids), std::move(indices), names, epoch));
+} // }}}
+
+std::vector<naming::id_type> addressing_service::resolve_names_postproc(
+    lcos::unique_future<
+        std::vector<lcos::unique_future<std::vector<response> > >
+    > f
+  , std::vector<naming::id_type> ids
+  , std::vector<std::vector<std::size_t> > const& indices
+  , std::vector<std::string> const& names
+  , boost::uint64_t epoch
+    )
+{ // {{{
+    std::vector<lcos::unique_future<std::vector<response> > > replies = f.get();
+    HPX_ASSERT(replies.size() == indices.size());
+
+    for (std::size_t i = 0; i != replies.size(); ++i)
+    {
+        std::vector<response> reps = replies[i].get();
+        HPX_ASSERT(reps.size() == indices[i].size());
+
+        for (std::size_t j = 0; j != reps.size(); ++j)
+        {
+            if (success == reps[j].get_status())
+            {
+                ids[indices[i][j]] = traits::get_remote_result<
+                    naming::id_type, response>::call(reps[j]);
+            }
+        }
+    }
+
+    if (caching_)
+    {
+        cache_mutex_type::scoped_lock l(symbol_cache_mtx_);
+
+        // a name might have been unregistered while the request was on its
+        // way, its reply could then hold an id which is stale already
+        if (epoch == symbol_cache_epoch_)
+        {
+            BOOST_FOREACH(std::vector<std::size_t> const& idx, indices)
+            {
+                BOOST_FOREACH(std::size_t i, idx)
+                {
+                    if (ids[i])
+                        symbol_cache_.insert(std::make_pair(names[i], ids[i]));
+                }
+            }
+        }
+    }
+
+    return ids;
+} // }}}
+
+lcos::unique_future<naming::id_type>
+addressing_service::on_symbol_namespace_event(
+    std::string const& name
+    )
+{ // {{{
+    lcos::promise<naming::id_type> p;
+    stubs::symbol_namespace::on_event_non_blocking(
+        stubs::symbol_namespace::symbol_namespace_locality(name)
+      , name, p.get_gid(), action_priority_);
+    return p.get_future();
+} // }}}
+
+void addressing_service::invalidate_symbol_cache_entry(
+    std::string const& name
+    )
+{ // {{{
+    LAGAS_(info) << (boost::format(
+        "addressing_service::invalidate_symbol_cache_entry, key(%1%)")
+        % name);
+
+    erase_symbol_cache_entry(name);
+} // }}}
+
+void addressing_service::erase_symbol_cache_entry(
+    std::string const& name
+    )
+{ // {{{
+    if (!caching_)
+        return;
+
+    // releasing the id might have to talk to AGAS, don't hold the spinlock
+    naming::id_type id;
+
+    {
+        cache_mutex_type::scoped_lock l(symbol_cache_mtx_);
+
+        ++symbol_cache_epoch_;
+
+        std::map<std::string, naming::id_type>::iterator it =
+            symbol_cache_.find(name);
+        if (it != symbol_cache_.end())
+        {
+            id = it->second;
+            symbol_cache_.erase(it);
+        }
+    }
 } // }}}
 
 }}
@@ -2134,31 +2332,18 @@ void addressing_service::insert_cache_entry(
             "addressing_service::insert_cache_entry, gid(%1%), count(%2%)")
             % gid % count);
 
-        cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
+        // Figure out who we collided with, if any.
+        naming::gid_type idbase;
+        boost::uint64_t idbase_count = 0;
 
-        const gva_cache_key key(gid, count);
-
-        if (!gva_cache_->insert(key, g))
+        if (!gva_cache_->insert(gid, count, g, idbase, idbase_count))
         {
-            // Figure out who we collided with.
-            gva_cache_key idbase;
-            gva_cache_type::entry_type e;
-
-            if (!gva_cache_->get_entry(key, idbase, e))
-            {
-                // This is impossible under sane conditions.
-                HPX_THROWS_IF(ec, invalid_data
-                  , "addressing_service::insert_cache_entry"
-                  , "data corruption or lock error occurred in cache");
-                return;
-            }
-
             LAGAS_(warning) <<
                 ( boost::format(
                     "addressing_service::insert_cache_entry, "
                     "aborting insert due to key collision in cache, "
                     "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
-                ) % gid % count % idbase.get_gid() % idbase.get_count());
+                ) % gid % count % idbase % idbase_count);
         }
 
         if (&ec != &throws)
@@ -2169,15 +2354,6 @@ void addressing_service::insert_cache_entry(
     }
 } // }}}
 
-bool check_for_collisions(
-    addressing_service::gva_cache_key const& new_key
-  , addressing_service::gva_cache_key const& old_key
-    )
-{
-    return (new_key.get_gid() == old_key.get_gid())
-        && (new_key.get_count() == old_key.get_count());
-}
-
 void addressing_service::update_cache_entry(
     naming::gid_type const& gid
   , gva const& g
@@ -2207,40 +2383,18 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid(%1%), count(%2%)"
             ) % gid % count);
 
-        cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-
-        // update cache only if it's currently not locked
-//         cache_mutex_type::scoped_try_lock lock(gva_cache_mtx_);
-//         if (!lock)
-//         {
-//             if (&ec != &throws)
-//                 ec = make_success_code();
-//             return;
-//         }
+        // Figure out who we collided with, if any.
+        naming::gid_type idbase;
+        boost::uint64_t idbase_count = 0;
 
-        const gva_cache_key key(gid, count);
-
-        if (!gva_cache_->update_if(key, g, check_for_collisions))
+        if (!gva_cache_->update(gid, count, g, idbase, idbase_count))
         {
-            // Figure out who we collided with.
-            gva_cache_key idbase;
-            gva_cache_type::entry_type e;
-
-            if (!gva_cache_->get_entry(key, idbase, e))
-            {
-                // This is impossible under sane conditions.
-                HPX_THROWS_IF(ec, invalid_data
-                  , "addressing_service::update_cache_entry"
-                  , "data corruption or lock error occurred in cache");
-                return;
-            }
-
             LAGAS_(warning) <<
                 ( boost::format(
                     "addressing_service::update_cache_entry, "
                     "aborting update due to key collision in cache, "
                     "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)"
-                ) % gid % count % idbase.get_gid() % idbase.get_count());
+                ) % gid % count % idbase % idbase_count);
         }
 
         if (&ec != &throws)
@@ -2264,8 +2418,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -2283,6 +2435,17 @@ void addressing_service::start_shutdown(error_code& ec)
     if (!caching_)
         return;
 
+    // drop the cached names first, this releases the credits they hold
+    {
+        std::map<std::string, naming::id_type> symbol_cache;
+
+        {
+            cache_mutex_type::scoped_lock l(symbol_cache_mtx_);
+            ++symbol_cache_epoch_;
+            symbol_cache.swap(symbol_cache_);
+        }
+    }
+
     mutex_type::scoped_lock l(refcnt_requests_mtx_);
     enable_refcnt_caching_ = false;
     send_refcnt_requests_sync(l, ec);
@@ -2443,29 +2606,44 @@ bool addressing_service::retrieve_statistics_counter(
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+// Helper functions to access the reference counting statistics
+boost::int64_t addressing_service::get_pending_credits(bool)
+{
+    boost::int64_t credits = 0;
+
+    mutex_type::scoped_lock l(refcnt_requests_mtx_);
+    BOOST_FOREACH(refcnt_requests_type::const_reference e, *refcnt_requests_)
+    {
+        if (e.data() < 0)
+            credits -= e.data();
+    }
+    return credits;
+}
+
+boost::int64_t addressing_service::get_flushed_credits(bool reset)
+{
+    return reset ? flushed_credits_.exchange(0) : flushed_credits_.load();
+}
+
 // Helper functions to access the current cache statistics
 std::size_t addressing_service::get_cache_hits(bool reset)
 {
-    cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return gva_cache_->hits(reset);
 }
 
 std::size_t addressing_service::get_cache_misses(bool reset)
 {
-    cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    return gva_cache_->misses(reset);
 }
 
 std::size_t addressing_service::get_cache_evictions(bool reset)
 {
-    cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return gva_cache_->evictions(reset);
 }
 
 std::size_t addressing_service::get_cache_insertions(bool reset)
 {
-    cache_mutex_type::scoped_lock lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return gva_cache_->insertions(reset);
 }
 
 /// Install performance counter types exposing properties from the local cache.
@@ -2480,6 +2658,10 @@ void addressing_service::register_counter_types()
         boost::bind(&addressing_service::get_cache_evictions, this, ::_1));
     HPX_STD_FUNCTION<boost::int64_t(bool)> cache_insertions(
         boost::bind(&addressing_service::get_cache_insertions, this, ::_1));
+    HPX_STD_FUNCTION<boost::int64_t(bool)> pending_credits(
+        boost::bind(&addressing_service::get_pending_credits, this, ::_1));
+    HPX_STD_FUNCTION<boost::int64_t(bool)> flushed_credits(
+        boost::bind(&addressing_service::get_flushed_credits, this, ::_1));
 
     performance_counters::generic_counter_type_data const counter_types[] =
     {
@@ -2514,6 +2696,23 @@ void addressing_service::register_counter_types()
               _1, cache_insertions, _2),
           &performance_counters::locality_counter_discoverer,
           ""
+        },
+        { "/agas/count/pending-credits", performance_counters::counter_raw,
+          "returns the number of credits buffered by this locality which "
+          "have not been sent to AGAS yet",
+          HPX_PERFORMANCE_COUNTER_V1,
+          boost::bind(&performance_counters::locality_raw_counter_creator,
+              _1, pending_credits, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/flushed-credits", performance_counters::counter_raw,
+          "returns the number of credits sent to AGAS by this locality",
+          HPX_PERFORMANCE_COUNTER_V1,
+          boost::bind(&performance_counters::locality_raw_counter_creator,
+              _1, flushed_credits, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
         }
     };
     performance_counters::install_counter_types(
@@ -2567,9 +2766,17 @@ void addressing_service::send_refcnt_requests(
     }
 
     if (!enable_refcnt_caching_ || max_refcnt_requests_ == ++refcnt_requests_count_)
+    {
         send_refcnt_requests_non_blocking(l, ec);
+        return;
+    }
 
-    else if (&ec != &throws)
+    // make sure the buffered decrement is sent eventually, this is a no-op
+    // if the timer is running already
+    if (enable_refcnt_flush_timer_)
+        refcnt_flush_timer_.start(false);
+
+    if (&ec != &throws)
         ec = make_success_code();
 }
 
@@ -2612,6 +2819,39 @@ void addressing_service::send_refcnt_requests(
     }
 #endif
 
+namespace detail
+{
+    typedef std::map<naming::id_type, credit_deltas> credit_deltas_map;
+
+    // Encode the decrements for each primary namespace instance. The
+    // requests are sorted, which keeps the deltas of every instance sorted
+    // as well. Returns the overall number of credits.
+    boost::int64_t collect_credit_deltas(
+        addressing_service::refcnt_requests_type const& requests
+      , credit_deltas_map& deltas
+        )
+    {
+        boost::int64_t credits = 0;
+
+        BOOST_FOREACH(
+            addressing_service::refcnt_requests_type::const_reference e,
+            requests)
+        {
+            HPX_ASSERT(e.data() < 0);
+
+            naming::gid_type lower(boost::icl::lower(e.key()));
+            naming::id_type target(
+                stubs::primary_namespace::get_service_instance(lower)
+              , naming::id_type::unmanaged);
+
+            deltas[target].add(lower, boost::icl::upper(e.key()), -e.data());
+            credits -= e.data();
+        }
+
+        return credits;
+    }
+}
+
 void addressing_service::send_refcnt_requests_non_blocking(
     addressing_service::mutex_type::scoped_lock& l
   , error_code& ec
@@ -2642,30 +2882,16 @@ void addressing_service::send_refcnt_requests_non_blocking(
                 "addressing_service::send_refcnt_requests_non_blocking");
 #endif
 
-        // collect all requests for each locality
-        typedef std::map<naming::id_type, std::vector<request> > requests_type;
-        requests_type requests;
-
-        BOOST_FOREACH(refcnt_requests_type::const_reference e, *p)
-        {
-            HPX_ASSERT(e.data() < 0);
-
-            naming::gid_type lower(boost::icl::lower(e.key()));
-            request const req(primary_ns_decrement_credit
-              , lower, boost::icl::upper(e.key()), e.data());
-
-            naming::id_type target(
-                stubs::primary_namespace::get_service_instance(lower)
-              , naming::id_type::unmanaged);
-
-            requests[target].push_back(req);
-        }
+        // collect all decrements for each locality
+        detail::credit_deltas_map deltas;
+        flushed_credits_ += detail::collect_credit_deltas(*p, deltas);
 
-        // send requests to all locality
-        requests_type::const_iterator end = requests.end();
-        for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
+        // send one message to each locality
+        detail::credit_deltas_map::const_iterator end = deltas.end();
+        for (detail::credit_deltas_map::const_iterator it = deltas.begin();
+             it != end; ++it)
         {
-            stubs::primary_namespace::bulk_service_non_blocking(
+            stubs::primary_namespace::decrement_credits_non_blocking(
                 (*it).first, (*it).second, action_priority_);
         }
 
@@ -2678,7 +2904,7 @@ void addressing_service::send_refcnt_requests_non_blocking(
     }
 }
 
-std::vector<hpx::unique_future<std::vector<response> > >
+std::vector<hpx::unique_future<void> >
 addressing_service::send_refcnt_requests_async(
     addressing_service::mutex_type::scoped_lock& l
     )
@@ -2686,7 +2912,7 @@ addressing_service::send_refcnt_requests_async(
     if (refcnt_requests_->empty())
     {
         l.unlock();
-        return std::vector<hpx::unique_future<std::vector<response> > >();
+        return std::vector<hpx::unique_future<void> >();
     }
 
     boost::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
@@ -2707,34 +2933,20 @@ addressing_service::send_refcnt_requests_async(
             "addressing_service::send_refcnt_requests_sync");
 #endif
 
-    // collect all requests for each locality
-    typedef std::map<naming::id_type, std::vector<request> > requests_type;
-    requests_type requests;
-
-    std::vector<hpx::unique_future<std::vector<response> > > lazy_results;
-    BOOST_FOREACH(refcnt_requests_type::const_reference e, *p)
-    {
-        HPX_ASSERT(e.data() < 0);
-
-        naming::gid_type lower(boost::icl::lower(e.key()));
-        request const req(primary_ns_decrement_credit
-                        , lower
-                        , boost::icl::upper(e.key())
-                        , e.data());
+    // collect all decrements for each locality
+    detail::credit_deltas_map deltas;
+    flushed_credits_ += detail::collect_credit_deltas(*p, deltas);
 
-        naming::id_type target(
-            stubs::primary_namespace::get_service_instance(lower)
-          , naming::id_type::unmanaged);
-
-        requests[target].push_back(req);
-    }
+    // send one message to each locality
+    std::vector<hpx::unique_future<void> > lazy_results;
+    lazy_results.reserve(deltas.size());
 
-    // send requests to all locality
-    requests_type::const_iterator end = requests.end();
-    for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
+    detail::credit_deltas_map::const_iterator end = deltas.end();
+    for (detail::credit_deltas_map::const_iterator it = deltas.begin();
+         it != end; ++it)
     {
         lazy_results.push_back(
-            stubs::primary_namespace::bulk_service_async(
+            stubs::primary_namespace::decrement_credits_async(
                 (*it).first, (*it).second, action_priority_));
     }
 
@@ -2746,24 +2958,15 @@ void addressing_service::send_refcnt_requests_sync(
   , error_code& ec
     )
 {
-    std::vector<hpx::unique_future<std::vector<response> > > lazy_results =
+    std::vector<hpx::unique_future<void> > lazy_results =
         send_refcnt_requests_async(l);
 
     wait_all(lazy_results);
 
-    BOOST_FOREACH(hpx::unique_future<std::vector<response> > & f, lazy_results)
+    BOOST_FOREACH(hpx::unique_future<void> & f, lazy_results)
     {
-        std::vector<response> const& reps = f.get();
-        BOOST_FOREACH(response const& rep, reps)
-        {
-            if (success != rep.get_status())
-            {
-                HPX_THROWS_IF(ec, rep.get_status(),
-                    "addressing_service::send_refcnt_requests_sync",
-                    "could not decrement reference count");
-                return;
-            }
-        }
+        f.get(ec);
+        if (ec) return;
     }
 
     if (&ec != &throws)
@@ -14,6 +14,7 @@
 #include <hpx/runtime/components/plain_component_factory.hpp>
 #include <hpx/runtime/components/server/managed_component_base.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/polymorphic_factory.hpp>
 #include <hpx/util/portable_binary_iarchive.hpp>
 #include <hpx/util/stringstream.hpp>
 #include <hpx/util/reinitializable_static.hpp>
@@ -41,6 +42,8 @@
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 
 namespace hpx { namespace detail
 {
@@ -175,6 +178,10 @@ struct notification_header
     boost::uint32_t num_localities;
     boost::uint32_t used_cores;
 
+    // the tables mapping the (dense) action and continuation ids to names
+    std::vector<std::string> action_names;
+    std::vector<std::string> continuation_names;
+
 #if defined(HPX_HAVE_SECURITY)
     components::security::signed_certificate root_certificate;
 #endif
@@ -189,6 +196,8 @@ struct notification_header
         ar & symbol_ns_address;
         ar & num_localities;
         ar & used_cores;
+        ar & action_names;
+        ar & continuation_names;
 #if defined(HPX_HAVE_SECURITY)
         ar & root_certificate;
 #endif
@@ -394,6 +403,15 @@ void register_worker(registration_header const& header)
       , component_addr, symbol_addr, rt.get_config().get_num_localities()
       , first_core);
 
+    // all localities use the action ids assigned by the root
+    util::polymorphic_factory<actions::base_action>::assign_ids();
+    util::polymorphic_factory<actions::continuation>::assign_ids();
+
+    hdr.action_names =
+        util::polymorphic_factory<actions::base_action>::get_names();
+    hdr.continuation_names =
+        util::polymorphic_factory<actions::continuation>::get_names();
+
 #if defined(HPX_HAVE_SECURITY)
     // wait for the root certificate to be available
     bool got_root_certificate = false;
@@ -529,10 +547,12 @@ void notify_worker(notification_header const& header)
         agas_client.get_hosted_symbol_ns_ptr());
     agas_client.bind_local(symbol_gid, symbol_addr);
 
-    // Assign the initial parcel gid range to the parcelport. Note that we can't
-    // get the parcelport through the parcelhandler because it isn't up yet.
+    // Assign the initial gid range to the id pool of the runtime. Note that
+    // we can't get the parcelport through the parcelhandler because it isn't
+    // up yet.
     naming::gid_type parcel_lower, parcel_upper;
-    agas_client.get_id_range(here, 1000, parcel_lower, parcel_upper);
+    agas_client.get_id_range(here, HPX_INITIAL_GID_RANGE, parcel_lower,
+        parcel_upper);
 
     rt.get_id_pool().set_range(parcel_lower, parcel_upper);
 
@@ -556,6 +576,12 @@ void notify_worker(notification_header const& header)
     //  , p->get_address()
     //  , response_heap_type::block_type::heap_size);
 
+    // use the same action ids as all other localities
+    util::polymorphic_factory<actions::base_action>::set_ids(
+        header.action_names);
+    util::polymorphic_factory<actions::continuation>::set_ids(
+        header.continuation_names);
+
     // store number of initial localities
     rt.get_config().set_num_localities(header.num_localities);
 
@@ -744,6 +770,10 @@ void big_boot_barrier::wait_bootstrap()
 { // {{{
     HPX_ASSERT(service_mode_bootstrap == service_type);
 
+    // create the action id tables which will be sent to all localities
+    util::polymorphic_factory<actions::base_action>::assign_ids();
+    util::polymorphic_factory<actions::continuation>::assign_ids();
+
     // the root just waits until all localities have connected
     spin();
 } // }}}
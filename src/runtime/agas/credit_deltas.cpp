@@ -0,0 +1,114 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/agas/credit_deltas.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/integer_traits.hpp>
+
+namespace hpx { namespace agas
+{
+    namespace
+    {
+        inline void encode_varint(std::vector<boost::uint8_t>& data,
+            boost::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                data.push_back(static_cast<boost::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            data.push_back(static_cast<boost::uint8_t>(value));
+        }
+
+        inline boost::uint64_t decode_varint(
+            std::vector<boost::uint8_t> const& data, std::size_t& pos)
+        {
+            boost::uint64_t value = 0;
+            for (unsigned shift = 0; pos != data.size() && shift < 64; shift += 7)
+            {
+                boost::uint8_t const byte = data[pos++];
+                value |= boost::uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+
+            HPX_THROW_EXCEPTION(invalid_data
+              , "credit_deltas::decode"
+              , "encountered a truncated or malformed credit decrement");
+            return 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void credit_deltas::add(naming::gid_type const& lower,
+        naming::gid_type const& upper, boost::int64_t credits)
+    {
+        HPX_ASSERT(credits > 0);
+        HPX_ASSERT(lower <= upper);
+
+        // merged ranges may cross the boundary of an msb, store one range
+        // for each msb they touch
+        naming::gid_type first = lower;
+        while (first.get_msb() != upper.get_msb())
+        {
+            append(first,
+                boost::integer_traits<boost::uint64_t>::const_max - first.get_lsb(),
+                credits);
+            first = naming::gid_type(first.get_msb() + 1, 0);
+        }
+        append(first, upper.get_lsb() - first.get_lsb(), credits);
+    }
+
+    void credit_deltas::append(naming::gid_type const& lower,
+        boost::uint64_t length, boost::int64_t credits)
+    {
+        HPX_ASSERT(last_ <= lower);
+
+        boost::uint64_t const msb_delta = lower.get_msb() - last_.get_msb();
+        encode_varint(data_, msb_delta);
+        encode_varint(data_,
+            msb_delta ? lower.get_lsb() : lower.get_lsb() - last_.get_lsb());
+        encode_varint(data_, length);
+        encode_varint(data_, static_cast<boost::uint64_t>(credits));
+
+        last_ = lower;
+        ++size_;
+    }
+
+    void credit_deltas::decode(std::vector<entry>& entries) const
+    {
+        entries.reserve(entries.size() + size_);
+
+        naming::gid_type last;
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i != size_; ++i)
+        {
+            boost::uint64_t const msb_delta = decode_varint(data_, pos);
+            boost::uint64_t const lsb = decode_varint(data_, pos);
+            boost::uint64_t const length = decode_varint(data_, pos);
+            boost::uint64_t const credits = decode_varint(data_, pos);
+
+            if (msb_delta)
+                last = naming::gid_type(last.get_msb() + msb_delta, lsb);
+            else
+                last = naming::gid_type(last.get_msb(), last.get_lsb() + lsb);
+
+            entry e;
+            e.lower_ = last;
+            e.upper_ = naming::gid_type(last.get_msb(), last.get_lsb() + length);
+            e.credits_ = static_cast<boost::int64_t>(credits);
+            entries.push_back(e);
+        }
+
+        if (pos != data_.size())
+        {
+            HPX_THROW_EXCEPTION(invalid_data
+              , "credit_deltas::decode"
+              , "encountered trailing data after the last credit decrement");
+        }
+    }
+}}
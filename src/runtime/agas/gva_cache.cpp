@@ -0,0 +1,524 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/scoped_array.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace hpx { namespace agas
+{
+    namespace
+    {
+        // finalizer of MurmurHash3
+        inline boost::uint64_t mix(boost::uint64_t k)
+        {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return k;
+        }
+
+        inline boost::uint64_t hash_id(boost::uint64_t msb, boost::uint64_t lsb)
+        {
+            return mix(msb ^ mix(lsb));
+        }
+
+        inline boost::uint64_t hash_block(boost::uint64_t msb,
+            boost::uint64_t block)
+        {
+            return mix(~msb ^ mix(block));
+        }
+
+        template <typename T>
+        inline bool same_set(T const& lhs, T const& rhs)
+        {
+            return lhs.first == rhs.first;
+        }
+
+        inline std::size_t get_num_sets(std::size_t capacity)
+        {
+            std::size_t const sets = (capacity + gva_cache::ways - 1) /
+                gva_cache::ways;
+
+            std::size_t num_sets = 1;
+            while (num_sets < sets)
+                num_sets <<= 1;
+            return num_sets;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A copy of the contents of a slot
+    struct gva_cache::entry
+    {
+        entry()
+          : msb_(0), lsb_(0), count_(0), type_(0), endpoint_(0),
+            gva_count_(0), lva_(0), offset_(0)
+        {}
+
+        bool contains(boost::uint64_t msb, boost::uint64_t lsb) const
+        {
+            return 0 != count_ && msb == msb_ && lsb >= lsb_ &&
+                lsb - lsb_ < count_;
+        }
+
+        bool overlaps(entry const& e) const
+        {
+            return 0 != count_ && e.msb_ == msb_ &&
+                e.lsb_ <= lsb_ + (count_ - 1) &&
+                lsb_ <= e.lsb_ + (e.count_ - 1);
+        }
+
+        boost::uint64_t msb_;
+        boost::uint64_t lsb_;
+        boost::uint64_t count_;         // 0 if the slot is empty
+        boost::uint64_t type_;
+        boost::uint64_t endpoint_;      // points into gva_cache::endpoints_
+        boost::uint64_t gva_count_;
+        boost::uint64_t lva_;
+        boost::uint64_t offset_;
+    };
+
+    // Every slot is protected by a sequence number which is odd while the
+    // slot is being modified. Readers don't lock, they treat a slot which
+    // was modified while being read as a miss.
+    struct gva_cache::slot
+    {
+        slot()
+          : seq_(0), msb_(0), lsb_(0), count_(0), type_(0), endpoint_(0),
+            gva_count_(0), lva_(0), offset_(0), referenced_(false)
+        {}
+
+        bool load(entry& e) const
+        {
+            boost::uint32_t const seq = seq_.load(boost::memory_order_acquire);
+            if (seq & 1)
+                return false;
+
+            read(e);
+
+            boost::atomic_thread_fence(boost::memory_order_acquire);
+            return seq == seq_.load(boost::memory_order_relaxed);
+        }
+
+        // the lock of the set has to be held by the caller
+        void read(entry& e) const
+        {
+            e.msb_ = msb_.load(boost::memory_order_relaxed);
+            e.lsb_ = lsb_.load(boost::memory_order_relaxed);
+            e.count_ = count_.load(boost::memory_order_relaxed);
+            e.type_ = type_.load(boost::memory_order_relaxed);
+            e.endpoint_ = endpoint_.load(boost::memory_order_relaxed);
+            e.gva_count_ = gva_count_.load(boost::memory_order_relaxed);
+            e.lva_ = lva_.load(boost::memory_order_relaxed);
+            e.offset_ = offset_.load(boost::memory_order_relaxed);
+        }
+
+        // the lock of the set has to be held by the caller
+        void store(entry const& e)
+        {
+            boost::uint32_t const seq = seq_.load(boost::memory_order_relaxed);
+            seq_.store(seq + 1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_release);
+
+            msb_.store(e.msb_, boost::memory_order_relaxed);
+            lsb_.store(e.lsb_, boost::memory_order_relaxed);
+            count_.store(e.count_, boost::memory_order_relaxed);
+            type_.store(e.type_, boost::memory_order_relaxed);
+            endpoint_.store(e.endpoint_, boost::memory_order_relaxed);
+            gva_count_.store(e.gva_count_, boost::memory_order_relaxed);
+            lva_.store(e.lva_, boost::memory_order_relaxed);
+            offset_.store(e.offset_, boost::memory_order_relaxed);
+
+            seq_.store(seq + 2, boost::memory_order_release);
+        }
+
+        boost::atomic<boost::uint32_t> seq_;
+        boost::atomic<boost::uint64_t> msb_;
+        boost::atomic<boost::uint64_t> lsb_;
+        boost::atomic<boost::uint64_t> count_;
+        boost::atomic<boost::uint64_t> type_;
+        boost::atomic<boost::uint64_t> endpoint_;
+        boost::atomic<boost::uint64_t> gva_count_;
+        boost::atomic<boost::uint64_t> lva_;
+        boost::atomic<boost::uint64_t> offset_;
+
+        // reference bit used by the CLOCK eviction
+        mutable boost::atomic<bool> referenced_;
+    };
+
+    struct gva_cache::set
+    {
+        set()
+          : hand_(0)
+        {}
+
+        bool find(boost::uint64_t msb, boost::uint64_t lsb, entry& e) const
+        {
+            for (std::size_t i = 0; i != ways; ++i)
+            {
+                slot const& s = slots_[i];
+                if (s.load(e) && e.contains(msb, lsb))
+                {
+                    // avoid writing to the slot if the bit is set already
+                    if (!s.referenced_.load(boost::memory_order_relaxed))
+                        s.referenced_.store(true, boost::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Returns false and the conflicting entry if the new entry overlaps
+        // with a different range. The lock of the set has to be held by the
+        // caller.
+        bool check(entry const& e, entry& other) const
+        {
+            for (std::size_t i = 0; i != ways; ++i)
+            {
+                slots_[i].read(other);
+                if (other.overlaps(e) &&
+                    (other.lsb_ != e.lsb_ || other.count_ != e.count_))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // The lock of the set has to be held by the caller, and check() has
+        // to have succeeded for the new entry.
+        void store(entry const& e, bool overwrite, statistics& stats)
+        {
+            entry other;
+            slot* free_slot = 0;
+            for (std::size_t i = 0; i != ways; ++i)
+            {
+                slot& s = slots_[i];
+                s.read(other);
+
+                if (0 == other.count_)
+                {
+                    if (0 == free_slot)
+                        free_slot = &s;
+                    continue;
+                }
+
+                if (!other.overlaps(e))
+                    continue;
+
+                HPX_ASSERT(other.lsb_ == e.lsb_ && other.count_ == e.count_);
+                if (overwrite)
+                    s.store(e);
+                return;
+            }
+
+            if (0 == free_slot)
+            {
+                free_slot = &get_victim();
+                ++stats.evictions_;
+            }
+
+            free_slot->store(e);
+            free_slot->referenced_.store(true, boost::memory_order_relaxed);
+            ++stats.insertions_;
+        }
+
+        mutex_type& get_mutex()
+        {
+            return mtx_;
+        }
+
+        void clear()
+        {
+            mutex_type::scoped_lock l(mtx_);
+
+            entry const empty;
+            for (std::size_t i = 0; i != ways; ++i)
+            {
+                slot& s = slots_[i];
+                if (0 != s.count_.load(boost::memory_order_relaxed))
+                {
+                    s.store(empty);
+                    s.referenced_.store(false, boost::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        // CLOCK: evict the first slot which was not referenced since the hand
+        // passed it the last time
+        slot& get_victim()
+        {
+            for (;;)
+            {
+                slot& s = slots_[hand_];
+                hand_ = (hand_ + 1) % ways;
+
+                if (!s.referenced_.exchange(false, boost::memory_order_relaxed))
+                    return s;
+            }
+        }
+
+        slot slots_[ways];
+        mutex_type mtx_;
+        std::size_t hand_;
+    };
+
+    struct gva_cache::table
+    {
+        explicit table(std::size_t num_sets)
+          : mask_(num_sets - 1), sets_(new set[num_sets])
+        {
+            HPX_ASSERT(0 == (num_sets & mask_));
+        }
+
+        set& get_set(boost::uint64_t hash) const
+        {
+            return sets_[static_cast<std::size_t>(hash) & mask_];
+        }
+
+        std::size_t capacity() const
+        {
+            return (mask_ + 1) * ways;
+        }
+
+        std::size_t const mask_;
+        boost::scoped_array<set> sets_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache(std::size_t capacity)
+      : table_(new table(get_num_sets(capacity)))
+    {}
+
+    gva_cache::~gva_cache()
+    {
+        delete table_.load();
+        for (std::size_t i = 0; i != retired_.size(); ++i)
+            delete retired_[i];
+    }
+
+    std::size_t gva_cache::capacity() const
+    {
+        return table_.load(boost::memory_order_acquire)->capacity();
+    }
+
+    void gva_cache::reserve(std::size_t capacity)
+    {
+        mutex_type::scoped_lock l(mtx_);
+
+        table* t = table_.load(boost::memory_order_relaxed);
+        if (t->capacity() >= capacity)
+            return;
+
+        // readers might still access the old table, it is kept alive until
+        // the cache is destroyed
+        table_.store(new table(get_num_sets(capacity)),
+            boost::memory_order_release);
+        retired_.push_back(t);
+    }
+
+    bool gva_cache::get_entry(naming::gid_type const& id,
+        naming::gid_type& base, gva& g) const
+    {
+        naming::gid_type const key = naming::detail::get_stripped_gid(id);
+        boost::uint64_t const msb = key.get_msb();
+        boost::uint64_t const lsb = key.get_lsb();
+
+        table const* t = table_.load(boost::memory_order_acquire);
+
+        // look for the id itself first, then for a range covering it
+        boost::uint64_t const hash = hash_id(msb, lsb);
+
+        entry e;
+        if (!t->get_set(hash).find(msb, lsb, e) &&
+            !t->get_set(hash_block(msb, lsb >> block_bits)).find(msb, lsb, e))
+        {
+            ++get_statistics(hash).misses_;
+            return false;
+        }
+
+        ++get_statistics(hash).hits_;
+
+        base = naming::gid_type(e.msb_, e.lsb_);
+
+        naming::locality const* endpoint =
+            reinterpret_cast<naming::locality const*>(
+                static_cast<std::size_t>(e.endpoint_));
+
+        g = gva(*endpoint,
+            static_cast<boost::int32_t>(static_cast<boost::uint32_t>(e.type_)),
+            e.gva_count_, e.lva_, e.offset_);
+
+        return true;
+    }
+
+    bool gva_cache::insert(naming::gid_type const& id, boost::uint64_t count,
+        gva const& g, naming::gid_type& other_id, boost::uint64_t& other_count)
+    {
+        return store(id, count, g, false, other_id, other_count);
+    }
+
+    bool gva_cache::update(naming::gid_type const& id, boost::uint64_t count,
+        gva const& g, naming::gid_type& other_id, boost::uint64_t& other_count)
+    {
+        return store(id, count, g, true, other_id, other_count);
+    }
+
+    bool gva_cache::store(naming::gid_type const& id, boost::uint64_t count,
+        gva const& g, bool overwrite, naming::gid_type& other_id,
+        boost::uint64_t& other_count)
+    {
+        HPX_ASSERT(0 != count);
+
+        naming::gid_type const key = naming::detail::get_stripped_gid(id);
+
+        entry e;
+        e.msb_ = key.get_msb();
+        e.lsb_ = key.get_lsb();
+        e.count_ = count;
+        e.type_ = static_cast<boost::uint32_t>(g.type);
+        e.endpoint_ = static_cast<boost::uint64_t>(
+            reinterpret_cast<std::size_t>(get_endpoint(g.endpoint)));
+        e.gva_count_ = g.count;
+        e.lva_ = g.lva();
+        e.offset_ = g.offset;
+
+        table* t = table_.load(boost::memory_order_acquire);
+
+        // Single ids are stored in the set selected by their hash, ranges in
+        // the sets of the blocks they cover.
+        typedef std::pair<set*, boost::uint64_t> set_hash;
+
+        set_hash sets[max_span];
+        std::size_t num_sets = 0;
+
+        if (1 == count)
+        {
+            boost::uint64_t const hash = hash_id(e.msb_, e.lsb_);
+            sets[num_sets++] = set_hash(&t->get_set(hash), hash);
+        }
+        else
+        {
+            boost::uint64_t const first = e.lsb_ >> block_bits;
+            boost::uint64_t last = (e.lsb_ + (count - 1)) >> block_bits;
+            if (last - first >= max_span)
+                last = first + max_span - 1;
+
+            for (boost::uint64_t block = first; block <= last; ++block)
+            {
+                boost::uint64_t const hash = hash_block(e.msb_, block);
+                sets[num_sets++] = set_hash(&t->get_set(hash), hash);
+            }
+
+            // several blocks might map to the same set, the sets are locked
+            // in the order of their addresses to avoid deadlocks
+            std::sort(sets, sets + num_sets);
+            num_sets = static_cast<std::size_t>(std::unique(
+                sets, sets + num_sets, &same_set<set_hash>) - sets);
+        }
+
+        // A range is stored either in all of its sets or in none of them, so
+        // all sets are locked and checked for conflicts before writing.
+        struct lock_sets
+        {
+            lock_sets(set_hash* sets, std::size_t num_sets)
+              : sets_(sets), num_sets_(num_sets)
+            {
+                for (std::size_t i = 0; i != num_sets_; ++i)
+                    sets_[i].first->get_mutex().lock();
+            }
+
+            ~lock_sets()
+            {
+                for (std::size_t i = num_sets_; i != 0; --i)
+                    sets_[i - 1].first->get_mutex().unlock();
+            }
+
+            set_hash* sets_;
+            std::size_t num_sets_;
+        } l(sets, num_sets);
+
+        entry other;
+        std::size_t i = 0;
+        while (i != num_sets && sets[i].first->check(e, other))
+            ++i;
+
+        if (i == num_sets)
+        {
+            for (i = 0; i != num_sets; ++i)
+            {
+                sets[i].first->store(e, overwrite,
+                    get_statistics(sets[i].second));
+            }
+            return true;
+        }
+
+        other_id = naming::gid_type(other.msb_, other.lsb_);
+        other_count = other.count_;
+        return false;
+    }
+
+    void gva_cache::clear()
+    {
+        table* t = table_.load(boost::memory_order_acquire);
+        for (std::size_t i = 0; i <= t->mask_; ++i)
+            t->sets_[i].clear();
+    }
+
+    // The endpoints are never removed, entries refer to them while they are
+    // read without holding a lock.
+    naming::locality const* gva_cache::get_endpoint(naming::locality const& l)
+    {
+        mutex_type::scoped_lock lk(mtx_);
+        return &*endpoints_.insert(l).first;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::statistics& gva_cache::get_statistics(std::size_t set_index) const
+    {
+        return statistics_[set_index % num_statistics];
+    }
+
+    std::size_t gva_cache::accumulate(
+        boost::atomic<std::size_t> statistics::* counter, bool reset)
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i != num_statistics; ++i)
+        {
+            boost::atomic<std::size_t>& value = statistics_[i].*counter;
+            result += reset ? value.exchange(0) : value.load();
+        }
+        return result;
+    }
+
+    std::size_t gva_cache::hits(bool reset)
+    {
+        return accumulate(&statistics::hits_, reset);
+    }
+
+    std::size_t gva_cache::misses(bool reset)
+    {
+        return accumulate(&statistics::misses_, reset);
+    }
+
+    std::size_t gva_cache::insertions(bool reset)
+    {
+        return accumulate(&statistics::insertions_, reset);
+    }
+
+    std::size_t gva_cache::evictions(bool reset)
+    {
+        return accumulate(&statistics::evictions_, reset);
+    }
+}}
@@ -141,6 +141,31 @@ naming::id_type resolve_name_sync(
     return agas_.resolve_name(name, ec);
 }
 
+std::vector<naming::id_type> resolve_names_sync(
+    std::vector<std::string> const& names
+  , error_code& ec
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_names(names, ec);
+}
+
+lcos::unique_future<std::vector<naming::id_type> > resolve_names(
+    std::vector<std::string> const& names
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_names_async(names);
+}
+
+lcos::unique_future<naming::id_type> when_registered(
+    std::string const& name
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.on_symbol_namespace_event(name);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // lcos::unique_future<std::vector<naming::id_type> > get_localities(
 //     components::component_type type
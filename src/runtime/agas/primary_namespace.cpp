@@ -36,3 +36,7 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     primary_namespace::bulk_service_action,
     primary_namespace_bulk_service_action)
+
+HPX_REGISTER_ACTION(
+    primary_namespace::decrement_credits_action,
+    primary_namespace_decrement_credits_action)
@@ -10,6 +10,7 @@
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/agas/server/locality_namespace.hpp>
 #include <hpx/runtime/agas/server/primary_namespace.hpp>
+#include <hpx/runtime/agas/stubs/symbol_namespace.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/components/server/runtime_support.hpp>
 #include <hpx/runtime/components/stubs/runtime_support.hpp>
@@ -17,6 +18,7 @@
 #include <hpx/util/get_and_reset_value.hpp>
 
 #include <list>
+#include <vector>
 
 #include <boost/foreach.hpp>
 #include <boost/fusion/include/at_c.hpp>
@@ -504,6 +506,26 @@ response locality_namespace::free(
             if (ec) return resp;
         }
 
+        // the symbol namespace instances of the remaining localities have
+        // to forget about the names cached by and the LCOs waiting on the
+        // locality which has left
+        boost::uint32_t const locality_id =
+            naming::get_locality_id_from_gid(locality);
+        std::vector<boost::uint32_t> remaining(
+            prefixes_.begin(), prefixes_.end());
+
+        l.unlock();
+
+        BOOST_FOREACH(boost::uint32_t id, remaining)
+        {
+            naming::id_type const target(
+                stubs::symbol_namespace::get_service_instance(id)
+              , naming::id_type::unmanaged);
+
+            stubs::symbol_namespace::remove_locality_non_blocking(
+                target, locality_id);
+        }
+
         LAGAS_(info) << (boost::format(
             "locality_namespace::free, ep(%1%)")
             % ep);
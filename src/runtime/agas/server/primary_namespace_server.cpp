@@ -338,7 +338,7 @@ response primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    mutex_type::scoped_lock l(mutex_);
+    mutex_type::scoped_lock l(gva_mutex_);
 
     gva_table_type::iterator it = gvas_.lower_bound(id)
                            , begin = gvas_.begin()
@@ -510,7 +510,7 @@ response primary_namespace::resolve_gid(
     boost::fusion::vector3<naming::gid_type, gva, boost::uint32_t> r;
 
     {
-        mutex_type::scoped_lock l(mutex_);
+        mutex_type::scoped_lock l(gva_mutex_);
         r = resolve_gid_locked(id, ec);
     }
 
@@ -547,7 +547,7 @@ response primary_namespace::unbind_gid(
     naming::gid_type id = req.get_gid();
     naming::detail::strip_internal_bits_from_gid(id);
 
-    mutex_type::scoped_lock l(mutex_);
+    mutex_type::scoped_lock l(gva_mutex_);
 
     gva_table_type::iterator it = gvas_.find(id)
                            , end = gvas_.end();
@@ -659,6 +659,72 @@ response primary_namespace::decrement_credit(
     return response(primary_ns_decrement_credit, credits);
 }
 
+void primary_namespace::decrement_credits(
+    credit_deltas const& deltas
+  , error_code& ec
+    )
+{ // {{{ decrement_credits implementation
+    update_time_on_exit update(
+        counter_data_
+      , counter_data_.decrement_credit_.time_
+    );
+    counter_data_.increment_decrement_credit_count();
+
+    std::vector<credit_deltas::entry> entries;
+    deltas.decode(entries);
+
+    if (entries.empty())
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+        return;
+    }
+
+    LAGAS_(info) << (boost::format(
+        "primary_namespace::decrement_credits, entries(%1%), bytes(%2%)")
+        % entries.size() % deltas.encoded_size());
+
+    // Validate the whole batch before anything is changed.
+    BOOST_FOREACH(credit_deltas::entry const& e, entries)
+    {
+        if (HPX_UNLIKELY(e.credits_ <= 0))
+        {
+            HPX_THROWS_IF(ec, bad_parameter
+              , "primary_namespace::decrement_credits"
+              , boost::str(boost::format("invalid credit count of %1%")
+                    % e.credits_));
+            return;
+        }
+    }
+
+    // Apply all decrements while holding the lock only once, the dead
+    // objects are freed together afterwards. The objects collected before
+    // a decrement failed are freed as well, as their entries are gone.
+    std::list<free_entry> free_list;
+    error_code sweep_ec(lightweight);
+    {
+        mutex_type::scoped_lock l(refcnt_mutex_);
+
+        BOOST_FOREACH(credit_deltas::entry const& e, entries)
+        {
+            decrement_sweep_locked(l, free_list, e.lower_, e.upper_,
+                e.credits_, sweep_ec);
+            if (sweep_ec) break;
+        }
+    } // Unlock the mutex.
+
+    free_components_sync(free_list, entries.front().lower_,
+        entries.back().upper_, ec);
+    if (ec) return;
+
+    if (sweep_ec)
+    {
+        HPX_THROWS_IF(ec, static_cast<hpx::error>(sweep_ec.value())
+          , "primary_namespace::decrement_credits"
+          , sweep_ec.get_message());
+    }
+} // }}}
+
 response primary_namespace::allocate(
     request const& req
   , error_code& ec
@@ -667,6 +733,10 @@ response primary_namespace::allocate(
     boost::uint64_t const count = req.get_count();
     boost::uint64_t const real_count = (count) ? (count - 1) : (0);
 
+    // several threads of this locality may refill their id ranges at the
+    // same time
+    mutex_type::scoped_lock l(next_id_mutex_);
+
     // Just return the prefix
     // REVIEW: Should this be an error?
     if (0 == count)
@@ -793,7 +863,7 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    mutex_type::scoped_lock l(mutex_);
+    mutex_type::scoped_lock l(refcnt_mutex_);
 
 #if defined(HPX_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
@@ -882,9 +952,12 @@ void primary_namespace::resolve_free_list(
         {
             naming::gid_type query = boost::icl::lower(super);
 
-            // Resolve the query GID.
-            boost::fusion::vector3<naming::gid_type, gva, boost::uint32_t>
+            // Resolve the query GID, the caller holds refcnt_mutex_ already.
+            boost::fusion::vector3<naming::gid_type, gva, boost::uint32_t> r;
+            {
+                mutex_type::scoped_lock gl(gva_mutex_);
                 r = resolve_gid_locked(query, ec);
+            }
 
             if (ec)
                 return;
@@ -993,92 +1066,105 @@ void primary_namespace::decrement_sweep(
     free_entry_list.clear();
 
     {
-        mutex_type::scoped_lock l(mutex_);
+        mutex_type::scoped_lock l(refcnt_mutex_);
+        decrement_sweep_locked(l, free_entry_list, lower, upper, credits, ec);
+        if (ec) return;
+    } // Unlock the mutex.
+
+    if (&ec != &throws)
+        ec = make_success_code();
+} // }}}
+
+void primary_namespace::decrement_sweep_locked(
+    mutex_type::scoped_lock& l
+  , std::list<free_entry>& free_entry_list
+  , naming::gid_type const& lower
+  , naming::gid_type const& upper
+  , boost::int64_t credits
+  , error_code& ec
+    )
+{ // {{{ decrement_sweep_locked implementation
+    HPX_ASSERT(l.owns_lock());
 
 #if defined(HPX_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
+    if (LAGAS_ENABLED(debug))
+    {
+        typedef refcnt_table_type::iterator iterator;
 
-            // Find the mappings that we just added or modified.
-            std::pair<iterator, iterator> match = refcnts_.find(lower, upper);
+        // Find the mappings that we just added or modified.
+        std::pair<iterator, iterator> match = refcnts_.find(lower, upper);
 
-            dump_refcnt_matches(match, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+        dump_refcnt_matches(match, lower, upper, l,
+            "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
-        using util::placeholders::_1;
-        refcnts_.apply(
-            lower, upper
-          , util::decrementer<boost::int64_t>(credits)
-          , default_global_credit);
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
+    using util::placeholders::_1;
+    refcnts_.apply(
+        lower, upper
+      , util::decrementer<boost::int64_t>(credits)
+      , default_global_credit);
 
-        ///////////////////////////////////////////////////////////////////////
-        // Search for dead objects.
+    ///////////////////////////////////////////////////////////////////////////
+    // Search for dead objects.
 
-        typedef refcnt_table_type::iterator iterator;
+    typedef refcnt_table_type::iterator iterator;
 
-        // Find the mappings that we just added or modified.
-        std::pair<iterator, iterator> match = refcnts_.find(lower, upper);
+    // Find the mappings that we just added or modified.
+    std::pair<iterator, iterator> match = refcnts_.find(lower, upper);
 
-        // This search should always succeed.
-        if (match.first == refcnts_.end() && match.second == refcnts_.end())
+    // This search should always succeed.
+    if (match.first == refcnts_.end() && match.second == refcnts_.end())
+    {
+        l.unlock();
+
+        HPX_THROWS_IF(ec, lock_error
+          , "primary_namespace::decrement_sweep"
+          , boost::str(boost::format(
+                "reference count table insertion failed due to a locking "
+                "error or memory corruption, lower(%1%), upper(%2%)")
+                % lower % upper));
+        return;
+    }
+
+    // Ranges containing dead objects.
+    std::list<iterator> free_list;
+
+    for (/**/; match.first != match.second; ++match.first)
+    {
+        // Sanity check.
+        if (match.first->data_ < 0)
         {
             l.unlock();
 
-            HPX_THROWS_IF(ec, lock_error
+            HPX_THROWS_IF(ec, invalid_data
               , "primary_namespace::decrement_sweep"
               , boost::str(boost::format(
-                    "reference count table insertion failed due to a locking "
-                    "error or memory corruption, lower(%1%), upper(%2%)")
-                    % lower % upper));
+                    "negative entry in reference count table, lower(%1%), "
+                    "upper(%2%), count(%3%)")
+                    % boost::icl::lower(match.first->key_)
+                    % boost::icl::upper(match.first->key_)
+                    % match.first->data_));
             return;
         }
 
-        // Ranges containing dead objects.
-        std::list<iterator> free_list;
-
-        for (/**/; match.first != match.second; ++match.first)
-        {
-            // Sanity check.
-            if (match.first->data_ < 0)
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, invalid_data
-                  , "primary_namespace::decrement_sweep"
-                  , boost::str(boost::format(
-                        "negative entry in reference count table, lower(%1%), "
-                        "upper(%2%), count(%3%)")
-                        % boost::icl::lower(match.first->key_)
-                        % boost::icl::upper(match.first->key_)
-                        % match.first->data_));
-                return;
-            }
-
-            // Any object with a reference count of 0 is dead.
-            if (match.first->data_ == 0)
-                free_list.push_back(match.first);
-        }
-
-        ///////////////////////////////////////////////////////////////////////
-        // Resolve the dead objects.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
-
-    } // Unlock the mutex.
+        // Any object with a reference count of 0 is dead.
+        if (match.first->data_ == 0)
+            free_list.push_back(match.first);
+    }
 
-    if (&ec != &throws)
-        ec = make_success_code();
-}
+    ///////////////////////////////////////////////////////////////////////////
+    // Resolve the dead objects.
+    resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
+} // }}}
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::free_components_sync(
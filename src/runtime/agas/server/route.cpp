@@ -33,7 +33,7 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            mutex_type::scoped_lock l(mutex_);
+            mutex_type::scoped_lock l(gva_mutex_);
 
             if (!locality_)
                 locality_ = get_runtime().here();
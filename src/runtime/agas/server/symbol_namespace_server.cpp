@@ -11,6 +11,8 @@
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/agas/server/symbol_namespace.hpp>
+#include <hpx/runtime/agas/stubs/symbol_namespace.hpp>
+#include <hpx/runtime/applier/apply.hpp>
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 
@@ -216,6 +218,7 @@ void symbol_namespace::unregister_server_instance(
     )
 {
     agas::unregister_name_sync(instance_name_, ec);
+    release_waiting_lcos();
     this->base_type::finalize();
 }
 
@@ -226,6 +229,19 @@ void symbol_namespace::finalize()
         error_code ec(lightweight);
         agas::unregister_name_sync(instance_name_, ec);
     }
+    release_waiting_lcos();
+}
+
+void symbol_namespace::release_waiting_lcos()
+{
+    // the names will not be registered anymore, the ids are released
+    // outside of the lock as this might send credits back to AGAS
+    on_event_data_type on_event_data;
+
+    {
+        mutex_type::scoped_lock l(mutex_);
+        on_event_data.swap(on_event_data_);
+    }
 }
 
 // TODO: do/undo semantics (e.g. transactions)
@@ -246,6 +262,165 @@ std::vector<response> symbol_namespace::bulk_service(
     return r;
 }
 
+namespace detail
+{
+    // wrap a gid handed out by the symbol table into an id_type
+    inline naming::id_type make_symbol_id(naming::gid_type const& gid)
+    {
+        if (naming::detail::has_credits(gid))
+            return naming::id_type(gid, naming::id_type::managed);
+        return naming::id_type(gid, naming::id_type::unmanaged);
+    }
+}
+
+std::vector<response> symbol_namespace::resolve_names(
+    std::vector<std::string> const& names
+  , boost::uint32_t watcher
+  , error_code& ec
+    )
+{ // {{{ resolve_names implementation
+    std::vector<response> r;
+    r.reserve(names.size());
+
+    {
+        mutex_type::scoped_lock l(mutex_);
+
+        BOOST_FOREACH(std::string const& key, names)
+        {
+            gid_table_type::iterator it = gids_.find(key);
+            if (it == gids_.end())
+            {
+                r.push_back(response(symbol_ns_resolve
+                                   , naming::invalid_gid
+                                   , no_success));
+                continue;
+            }
+
+            if (watcher != naming::invalid_locality_id)
+                watchers_[key].insert(watcher);
+
+            r.push_back(response(symbol_ns_resolve
+                               , naming::detail::split_gid_if_needed(it->second)));
+        }
+    }
+
+    LAGAS_(info) << (boost::format(
+        "symbol_namespace::resolve_names, count(%1%), watcher(%2%)")
+        % names.size() % watcher);
+
+    counter_data_.increment_resolve_count();
+
+    if (&ec != &throws)
+        ec = make_success_code();
+
+    return r;
+} // }}}
+
+void symbol_namespace::on_event(
+    std::string const& name
+  , naming::id_type const& lco
+  , error_code& ec
+    )
+{ // {{{ on_event implementation
+    naming::gid_type gid;
+
+    {
+        mutex_type::scoped_lock l(mutex_);
+
+        gid_table_type::iterator it = gids_.find(name);
+        if (it == gids_.end())
+        {
+            // the LCO will be triggered once the name is registered
+            on_event_data_.insert(on_event_data_type::value_type(name, lco));
+
+            LAGAS_(info) << (boost::format(
+                "symbol_namespace::on_event, key(%1%), response(deferred)")
+                % name);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
+        gid = naming::detail::split_gid_if_needed(it->second);
+    }
+
+    LAGAS_(info) << (boost::format(
+        "symbol_namespace::on_event, key(%1%), gid(%2%)")
+        % name % gid);
+
+    hpx::set_lco_value(lco, detail::make_symbol_id(gid));
+
+    if (&ec != &throws)
+        ec = make_success_code();
+} // }}}
+
+void symbol_namespace::remote_invalidate(
+    std::string const& name
+    )
+{
+    naming::get_agas_client().invalidate_symbol_cache_entry(name);
+}
+
+void symbol_namespace::remove_locality(
+    boost::uint32_t locality_id
+    )
+{ // {{{ remove_locality implementation
+    // the ids are released outside of the lock as this might send credits
+    // back to AGAS
+    std::vector<naming::id_type> abandoned;
+
+    {
+        mutex_type::scoped_lock l(mutex_);
+
+        // the locality does not cache any names anymore
+        watchers_type::iterator wit = watchers_.begin();
+        while (wit != watchers_.end())
+        {
+            wit->second.erase(locality_id);
+            if (wit->second.empty())
+                watchers_.erase(wit++);
+            else
+                ++wit;
+        }
+
+        // the LCOs living on that locality are gone as well
+        on_event_data_type::iterator oit = on_event_data_.begin();
+        while (oit != on_event_data_.end())
+        {
+            if (naming::get_locality_id_from_gid(oit->second.get_gid()) ==
+                    locality_id)
+            {
+                abandoned.push_back(oit->second);
+                on_event_data_.erase(oit++);
+            }
+            else
+            {
+                ++oit;
+            }
+        }
+    }
+
+    LAGAS_(info) << (boost::format(
+        "symbol_namespace::remove_locality, locality(%1%), abandoned(%2%)")
+        % locality_id % abandoned.size());
+} // }}}
+
+void symbol_namespace::invalidate_watchers(
+    std::string const& name
+  , std::set<boost::uint32_t> const& watchers
+    )
+{
+    BOOST_FOREACH(boost::uint32_t locality_id, watchers)
+    {
+        naming::id_type const target(
+            stubs::symbol_namespace::get_service_instance(locality_id)
+          , naming::id_type::unmanaged);
+
+        stubs::symbol_namespace::invalidate_non_blocking(target, name);
+    }
+}
+
 response symbol_namespace::bind(
     request const& req
   , error_code& ec
@@ -313,9 +488,33 @@ response symbol_namespace::bind(
         return response();
     }
 
+    // hand out a copy of the new id to everybody waiting for this name
+    std::vector<std::pair<naming::id_type, naming::gid_type> > waiting;
+
+    std::pair<on_event_data_type::iterator, on_event_data_type::iterator> p =
+        on_event_data_.equal_range(key);
+    if (p.first != p.second)
+    {
+        gid_table_type::iterator it = gids_.find(key);
+        for (on_event_data_type::iterator wit = p.first; wit != p.second; ++wit)
+        {
+            waiting.push_back(std::make_pair(wit->second
+              , naming::detail::split_gid_if_needed(it->second)));
+        }
+        on_event_data_.erase(p.first, p.second);
+    }
+
+    l.unlock();
+
     LAGAS_(info) << (boost::format(
-        "symbol_namespace::bind, key(%1%), gid(%2%)")
-        % key % gid);
+        "symbol_namespace::bind, key(%1%), gid(%2%), waiting(%3%)")
+        % key % gid % waiting.size());
+
+    typedef std::pair<naming::id_type, naming::gid_type> waiting_type;
+    BOOST_FOREACH(waiting_type const& w, waiting)
+    {
+        hpx::set_lco_value(w.first, detail::make_symbol_id(w.second));
+    }
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -391,6 +590,19 @@ response symbol_namespace::unbind(
 
     gids_.erase(it);
 
+    // the localities caching this name have to drop it
+    std::set<boost::uint32_t> watchers;
+    watchers_type::iterator wit = watchers_.find(key);
+    if (wit != watchers_.end())
+    {
+        watchers.swap(wit->second);
+        watchers_.erase(wit);
+    }
+
+    l.unlock();
+
+    invalidate_watchers(key, watchers);
+
     LAGAS_(info) << (boost::format(
         "symbol_namespace::unbind, key(%1%), gid(%2%)")
         % key % gid);
@@ -100,5 +100,29 @@ void primary_namespace::bulk_service_non_blocking(
     hpx::apply_p<action_type>(gid, priority, reqs);
 }
 
+lcos::unique_future<void>
+    primary_namespace::decrement_credits_async(
+        naming::id_type const& gid
+      , credit_deltas const& deltas
+      , threads::thread_priority priority
+        )
+{
+    typedef server_type::decrement_credits_action action_type;
+
+    lcos::packaged_action<action_type> p;
+    p.apply_p(launch::async, gid, priority, deltas);
+    return p.get_future();
+}
+
+void primary_namespace::decrement_credits_non_blocking(
+   naming::id_type const& gid
+  , credit_deltas const& deltas
+  , threads::thread_priority priority
+    )
+{
+    typedef server_type::decrement_credits_action action_type;
+    hpx::apply_p<action_type>(gid, priority, deltas);
+}
+
 }}}
 
@@ -78,5 +78,50 @@ void symbol_namespace::bulk_service_non_blocking(
     hpx::apply_p<action_type>(gid, priority, reqs);
 }
 
+lcos::unique_future<std::vector<response> > symbol_namespace::resolve_names_async(
+    naming::id_type const& gid
+  , std::vector<std::string> const& names
+  , boost::uint32_t watcher
+  , threads::thread_priority priority
+    )
+{
+    typedef server_type::resolve_names_action action_type;
+
+    lcos::packaged_action<action_type> p;
+    p.apply_p(launch::async, gid, priority, names, watcher);
+    return p.get_future();
+}
+
+void symbol_namespace::on_event_non_blocking(
+    naming::id_type const& gid
+  , std::string const& name
+  , naming::id_type const& lco
+  , threads::thread_priority priority
+    )
+{
+    typedef server_type::on_event_action action_type;
+    hpx::apply_p<action_type>(gid, priority, name, lco);
+}
+
+void symbol_namespace::invalidate_non_blocking(
+    naming::id_type const& gid
+  , std::string const& name
+  , threads::thread_priority priority
+    )
+{
+    typedef server_type::invalidate_action action_type;
+    hpx::apply_p<action_type>(gid, priority, name);
+}
+
+void symbol_namespace::remove_locality_non_blocking(
+    naming::id_type const& gid
+  , boost::uint32_t locality_id
+  , threads::thread_priority priority
+    )
+{
+    typedef server_type::remove_locality_action action_type;
+    hpx::apply_p<action_type>(gid, priority, locality_id);
+}
+
 }}}
 
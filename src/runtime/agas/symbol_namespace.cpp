@@ -37,3 +37,19 @@ HPX_REGISTER_ACTION(
     symbol_namespace::bulk_service_action,
     symbol_namespace_bulk_service_action)
 
+HPX_REGISTER_ACTION(
+    symbol_namespace::resolve_names_action,
+    symbol_namespace_resolve_names_action)
+
+HPX_REGISTER_ACTION(
+    symbol_namespace::on_event_action,
+    symbol_namespace_on_event_action)
+
+HPX_REGISTER_ACTION(
+    symbol_namespace::invalidate_action,
+    symbol_namespace_invalidate_action)
+
+HPX_REGISTER_ACTION(
+    symbol_namespace::remove_locality_action,
+    symbol_namespace_remove_locality_action)
+
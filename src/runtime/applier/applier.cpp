@@ -17,6 +17,12 @@
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/include/async.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
 #if defined(HPX_HAVE_SECURITY)
 #include <hpx/components/security/capability.hpp>
 #include <hpx/components/security/certificate.hpp>
@@ -55,6 +61,21 @@ namespace hpx { namespace applier
         return threads::terminated;
     }
 
+    static inline threads::thread_state_enum thread_function_indexed(
+        boost::shared_ptr<HPX_STD_FUNCTION<void(std::size_t)> > const& func,
+        std::size_t index)
+    {
+        // execute the actual thread function
+        (*func)(index);
+
+        // Verify that there are no more registered locks for this
+        // OS-thread. This will throw if there are still any locks
+        // held.
+        util::force_error_on_lock();
+
+        return threads::terminated;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     threads::thread_id_type register_thread_nullary(
         HPX_STD_FUNCTION<void()> && func, char const* desc,
@@ -187,6 +208,41 @@ namespace hpx { namespace applier
         app->get_thread_manager().register_work(data, state, ec);
     }
 
+    void register_work_bulk(std::size_t count,
+        HPX_STD_FUNCTION<void(std::size_t)> && func, char const* desc,
+        threads::thread_state_enum state, threads::thread_priority priority,
+        threads::thread_stacksize stacksize, error_code& ec)
+    {
+        hpx::applier::applier* app = hpx::applier::get_applier_ptr();
+        if (NULL == app)
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "hpx::applier::register_work_bulk",
+                "global applier object is not accessible");
+            return;
+        }
+
+        // all threads share the same function object
+        boost::shared_ptr<HPX_STD_FUNCTION<void(std::size_t)> > f(
+            boost::make_shared<HPX_STD_FUNCTION<void(std::size_t)> >(
+                std::move(func)));
+
+        std::ptrdiff_t stack_size = threads::get_stack_size(stacksize);
+
+        std::vector<threads::thread_init_data> data;
+        data.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            data.push_back(threads::thread_init_data(
+                HPX_STD_BIND(&thread_function_indexed, f, i),
+                desc ? desc : "<unknown>", 0, priority, std::size_t(-1),
+                stack_size));
+        }
+
+        app->get_thread_manager().register_work_bulk(
+            data.empty() ? 0 : &data[0], count, state, ec);
+    }
+
     void register_work(
         HPX_STD_FUNCTION<void(threads::thread_state_ex_enum)> && func,
         char const* desc, threads::thread_state_enum state,
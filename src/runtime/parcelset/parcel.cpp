@@ -10,6 +10,9 @@
 #include <hpx/util/portable_binary_iarchive.hpp>
 #include <hpx/util/portable_binary_oarchive.hpp>
 #include <hpx/util/serialize_intrusive_ptr.hpp>
+#include <hpx/util/static.hpp>
+
+#include <boost/atomic.hpp>
 
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/version.hpp>
@@ -39,6 +42,153 @@ namespace hpx { namespace parcelset
 
     namespace detail
     {
+        ///////////////////////////////////////////////////////////////////////////
+        // All localities use the action and continuation id tables created by
+        // the root locality (see polymorphic_factory). A type is sent as its
+        // id only if the destination is known to have received the id tables
+        // already, otherwise one of the markers below is sent, followed by
+        // the type name. The marker tells the receiver whether the sender has
+        // the id tables, which allows to send ids in the opposite direction.
+        boost::uint32_t const sender_without_ids = ~0U;
+        boost::uint32_t const sender_with_ids = ~0U - 1;
+
+        // The peers having the id tables are stored in a bitmap which is
+        // checked for every parcel sent, it does not need any locking. The
+        // bitmap is split into chunks which are allocated on first use. Peers
+        // with locality ids beyond the last chunk are always sent names.
+        class id_table_peers
+        {
+            typedef boost::atomic<boost::uint64_t> word_type;
+
+            enum
+            {
+                bits_per_word = 64,
+                words_per_chunk = 64,
+                bits_per_chunk = bits_per_word * words_per_chunk,
+                max_chunks = 1024
+            };
+
+        public:
+            id_table_peers()
+            {
+                for (std::size_t i = 0; i != max_chunks; ++i)
+                    chunks_[i].store(0, boost::memory_order_relaxed);
+            }
+
+            ~id_table_peers()
+            {
+                for (std::size_t i = 0; i != max_chunks; ++i)
+                    delete [] chunks_[i].load(boost::memory_order_relaxed);
+            }
+
+            bool has_ids(boost::uint32_t locality_id) const
+            {
+                std::size_t chunk = locality_id / bits_per_chunk;
+                if (chunk >= max_chunks)
+                    return false;
+
+                word_type const* words =
+                    chunks_[chunk].load(boost::memory_order_acquire);
+                if (0 == words)
+                    return false;
+
+                std::size_t bit = locality_id % bits_per_chunk;
+                return (words[bit / bits_per_word].load(
+                    boost::memory_order_relaxed) & mask_of(bit)) != 0;
+            }
+
+            void add(boost::uint32_t locality_id)
+            {
+                std::size_t chunk = locality_id / bits_per_chunk;
+                if (chunk >= max_chunks)
+                    return;
+
+                word_type* words =
+                    chunks_[chunk].load(boost::memory_order_acquire);
+                if (0 == words)
+                {
+                    word_type* new_words = new word_type[words_per_chunk];
+                    for (std::size_t i = 0; i != words_per_chunk; ++i)
+                        new_words[i].store(0, boost::memory_order_relaxed);
+
+                    if (chunks_[chunk].compare_exchange_strong(words,
+                            new_words, boost::memory_order_acq_rel))
+                    {
+                        words = new_words;
+                    }
+                    else
+                    {
+                        delete [] new_words;    // somebody else was faster
+                    }
+                }
+
+                std::size_t bit = locality_id % bits_per_chunk;
+                words[bit / bits_per_word].fetch_or(mask_of(bit),
+                    boost::memory_order_relaxed);
+            }
+
+        private:
+            static boost::uint64_t mask_of(std::size_t bit)
+            {
+                return boost::uint64_t(1) << (bit % bits_per_word);
+            }
+
+            boost::atomic<word_type*> chunks_[max_chunks];
+        };
+
+        id_table_peers& get_id_table_peers()
+        {
+            util::static_<id_table_peers> peers;
+            return peers.get();
+        }
+
+        template <typename Base>
+        void save_type_name(util::portable_binary_oarchive& ar,
+            std::string const& name, bool use_ids)
+        {
+            typedef util::polymorphic_factory<Base> factory_type;
+
+            if (use_ids)
+            {
+                boost::uint32_t id = factory_type::get_id(name);
+                if (id != boost::uint32_t(factory_type::invalid_id))
+                {
+                    ar << id;
+                    return;
+                }
+            }
+
+            boost::uint32_t marker = factory_type::has_ids() ?
+                sender_with_ids : sender_without_ids;
+            ar << marker;
+            ar.save(name);
+        }
+
+        template <typename Base>
+        boost::shared_ptr<Base> load_type(util::portable_binary_iarchive& ar,
+            boost::uint32_t source_locality_id)
+        {
+            typedef util::polymorphic_factory<Base> factory_type;
+
+            boost::uint32_t id = 0;
+            ar >> id;
+
+            if (id < sender_with_ids)
+                return factory_type::create(id);
+
+            // the sender has the same id tables as we do, from now on we can
+            // send ids to it as well
+            if (id == sender_with_ids && factory_type::has_ids() &&
+                source_locality_id != naming::invalid_locality_id)
+            {
+                get_id_table_peers().add(source_locality_id);
+            }
+
+            std::string name;
+            ar.load(name);
+            return factory_type::create(name);
+        }
+
         ///////////////////////////////////////////////////////////////////////////
         void parcel_data::save(util::portable_binary_oarchive& ar, bool has_source_id, bool has_continuation) const
         {
@@ -46,40 +196,37 @@ namespace hpx { namespace parcelset
             if (has_source_id)
                 ar << source_id_;
 
-            std::string action_name = action_->get_action_name();
-            ar.save(action_name);
+            bool use_ids =
+                get_id_table_peers().has_ids(ar.get_dest_locality_id());
+
+            save_type_name<actions::base_action>(ar,
+                action_->get_action_name(), use_ids);
 
             action_->save(ar);
 
             // If we have a continuation, serialize it.
             if (has_continuation) {
-                std::string continuation_name = continuation_->get_continuation_name();
-                ar.save(continuation_name);
+                save_type_name<actions::continuation>(ar,
+                    continuation_->get_continuation_name(), use_ids);
 
                 continuation_->save(ar);
             }
         }
 
-        void parcel_data::load(util::portable_binary_iarchive& ar, bool has_source_id, bool has_continuation)
+        void parcel_data::load(util::portable_binary_iarchive& ar, bool has_source_id,
+            bool has_continuation, boost::uint32_t source_locality_id)
         {
             // Check for a source id.
             if (has_source_id)
                 ar >> source_id_;
 
-            std::string action_name;
-            ar.load(action_name);
-
-            action_ = util::polymorphic_factory<
-                actions::base_action>::create(action_name);
+            action_ = load_type<actions::base_action>(ar, source_locality_id);
             action_->load(ar);
 
             // handle continuation.
             if (has_continuation) {
-                std::string continuation_name;
-                ar.load(continuation_name);
-
-                continuation_ = util::polymorphic_factory<
-                    actions::continuation>::create(continuation_name);
+                continuation_ = load_type<actions::continuation>(ar,
+                    source_locality_id);
                 continuation_->load(ar);
             }
         }
@@ -126,7 +273,8 @@ namespace hpx { namespace parcelset
             ar >> dest_ >> addr_;
 
             this->parcel_data::load(ar, data_.has_source_id_ != 0,
-                data_.has_continuation_ != 0);
+                data_.has_continuation_ != 0,
+                naming::get_locality_id_from_gid(data_.parcel_id_));
         }
 
         void single_destination_parcel_data::load_normal(util::portable_binary_iarchive & ar)
@@ -139,7 +287,8 @@ namespace hpx { namespace parcelset
             ar >> dest_ >> addr_;
 
             this->parcel_data::load(ar, data_.has_source_id_ != 0,
-                data_.has_continuation_ != 0);
+                data_.has_continuation_ != 0,
+                naming::get_locality_id_from_gid(data_.parcel_id_));
         }
 
         void single_destination_parcel_data::load(util::portable_binary_iarchive& ar)
@@ -192,7 +341,8 @@ namespace hpx { namespace parcelset
             ar >> dests_ >> addrs_;
 
             this->parcel_data::load(ar, data_.has_source_id_ != 0,
-                data_.has_continuation_ != 0);
+                data_.has_continuation_ != 0,
+                naming::get_locality_id_from_gid(data_.parcel_id_));
         }
 
         void multi_destination_parcel_data::load_normal(util::portable_binary_iarchive& ar)
@@ -204,7 +354,8 @@ namespace hpx { namespace parcelset
             ar >> dests_ >> addrs_;
 
             this->parcel_data::load(ar, data_.has_source_id_ != 0,
-                data_.has_continuation_ != 0);
+                data_.has_continuation_ != 0,
+                naming::get_locality_id_from_gid(data_.parcel_id_));
         }
 
         void multi_destination_parcel_data::load(util::portable_binary_iarchive& ar)
@@ -7,10 +7,12 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime.hpp>
 #include <hpx/state.hpp>
 #include <hpx/exception.hpp>
 #include <hpx/util/portable_binary_iarchive.hpp>
 #include <hpx/util/io_service_pool.hpp>
+#include <hpx/util/threshold_filter.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
@@ -61,6 +63,9 @@ namespace hpx { namespace parcelset
         case connection_mpi:
             return "mpi";
 
+        case connection_shmem:
+            return "shmem";
+
         default:
             break;
         }
@@ -84,6 +89,9 @@ namespace hpx { namespace parcelset
         if (!std::strcmp(t.c_str(), "mpi"))
             return connection_mpi;
 
+        if (!std::strcmp(t.c_str(), "shmem"))
+            return connection_shmem;
+
         return connection_unknown;
     }
 
@@ -155,7 +163,8 @@ namespace hpx { namespace parcelset
         parcels_(policy),
         use_alternative_parcelports_(false),
         enable_parcel_handling_(true),
-        count_routed_(0)
+        count_routed_(0),
+        count_local_(0)
     {}
 
     std::vector<std::string> parcelhandler::load_runtime_configuration()
@@ -176,6 +185,24 @@ namespace hpx { namespace parcelset
                 BOOST_PP_STRINGIZE(HPX_PARCEL_MAX_CONNECTIONS_PER_LOCALITY) "}",
             "max_message_size = ${HPX_PARCEL_MAX_MESSAGE_SIZE:"
                 BOOST_PP_STRINGIZE(HPX_PARCEL_MAX_MESSAGE_SIZE) "}",
+            "max_buffer_pool_size = ${HPX_PARCEL_MAX_BUFFER_POOL_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_MAX_BUFFER_POOL_SIZE) "}",
+            "streaming_threshold = ${HPX_PARCEL_STREAMING_THRESHOLD:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_STREAMING_THRESHOLD) "}",
+            "streaming_frame_size = ${HPX_PARCEL_STREAMING_FRAME_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_STREAMING_FRAME_SIZE) "}",
+            "streaming_max_frames = ${HPX_PARCEL_STREAMING_MAX_FRAMES:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_STREAMING_MAX_FRAMES) "}",
+            "gather_message_size = ${HPX_PARCEL_GATHER_MESSAGE_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_GATHER_MESSAGE_SIZE) "}",
+            "gather_max_size = ${HPX_PARCEL_GATHER_MAX_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_GATHER_MAX_SIZE) "}",
+            "gather_max_buffers = ${HPX_PARCEL_GATHER_MAX_BUFFERS:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_GATHER_MAX_BUFFERS) "}",
+            "compression_threshold = ${HPX_PARCEL_COMPRESSION_THRESHOLD:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_COMPRESSION_THRESHOLD) "}",
+            "compression_max_ratio = ${HPX_PARCEL_COMPRESSION_MAX_RATIO:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_COMPRESSION_MAX_RATIO) "}",
 #ifdef BOOST_BIG_ENDIAN
             "endian_out = ${HPX_PARCEL_ENDIAN_OUT:big}",
 #else
@@ -260,6 +287,17 @@ namespace hpx { namespace parcelset
         HPX_ASSERT(0 != pool);
 
 
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+        std::string enable_shmem =
+            get_config_entry("hpx.parcel.shmem.enable", "0");
+
+        if (boost::lexical_cast<int>(enable_shmem))
+        {
+            attach_parcelport(parcelport::create(
+                connection_shmem, hpx::get_config(),
+                pool->get_on_start_thread(), pool->get_on_stop_thread()));
+        }
+#endif
 #if defined(HPX_HAVE_PARCELPORT_IPC)
         std::string enable_ipc =
             get_config_entry("hpx.parcel.ipc.enable", "0");
@@ -419,6 +457,22 @@ namespace hpx { namespace parcelset
     connection_type parcelhandler::find_appropriate_connection_type(
         naming::locality const& dest)
     {
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+        if (dest.get_type() == connection_tcp) {
+            std::string enable_shmem =
+                get_config_entry("hpx.parcel.shmem.enable", "0");
+
+            // if destination is on the same network node, use the shared
+            // memory rings, this is preferred over the ipc parcelport
+            if (use_alternative_parcelports_ &&
+                dest.get_address() == here().get_address() &&
+                boost::lexical_cast<int>(enable_shmem))
+            {
+                if (pports_[connection_shmem])
+                    return connection_shmem;
+            }
+        }
+#endif
 #if defined(HPX_HAVE_PARCELPORT_IPC)
         if (dest.get_type() == connection_tcp) {
             std::string enable_ipc =
@@ -521,6 +575,21 @@ namespace hpx { namespace parcelset
         {
             f(ec, size);    // invoke the original handler
         }
+
+        // Return whether all destinations of the given parcel live on this
+        // locality.
+        inline bool is_local_parcel(parcel const& p,
+            naming::locality const& here)
+        {
+            std::size_t size = p.size();
+            naming::address const* addrs = p.get_destination_addrs();
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                if (addrs[i].locality_ != here)
+                    return false;
+            }
+            return true;
+        }
     }
 
     void parcelhandler::put_parcel(parcel& p, write_handler_type const& f)
@@ -560,6 +629,16 @@ namespace hpx { namespace parcelset
         if (!p.get_parcel_id())
             p.set_parcel_id(parcel::generate_unique_id());
 
+        // If all destinations are on this locality the threads are created
+        // directly from the action stored in the parcel, this avoids
+        // serializing the parcel and sending it to ourselves.
+        if (resolved_locally && detail::is_local_parcel(p, here())) {
+            ++count_local_;
+            get_runtime().get_applier().schedule_action(p);
+            f(boost::system::error_code(), 0);
+            return;
+        }
+
         // If we were able to resolve the address(es) locally we send the
         // parcel directly to the destination.
         if (resolved_locally) {
@@ -729,6 +808,12 @@ namespace hpx { namespace parcelset
         return util::get_and_reset_value(count_routed_, reset);
     }
 
+    // number of parcels delivered locally
+    boost::int64_t parcelhandler::get_parcel_local_count(bool reset)
+    {
+        return util::get_and_reset_value(count_local_, reset);
+    }
+
     // number of messages sent
     std::size_t parcelhandler::get_message_send_count(
         connection_type pp_type, bool reset) const
@@ -738,6 +823,15 @@ namespace hpx { namespace parcelset
         return pp ? pp->get_message_send_count(reset) : 0;
     }
 
+    // number of write operations used to send messages
+    boost::int64_t parcelhandler::get_message_write_count(
+        connection_type pp_type, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_message_write_count(reset) : 0;
+    }
+
     // number of parcels received
     std::size_t parcelhandler::get_parcel_receive_count(
         connection_type pp_type, bool reset) const
@@ -887,6 +981,9 @@ namespace hpx { namespace parcelset
 #if defined(HPX_HAVE_PARCELPORT_IPC)
         register_counter_types(connection_ipc);
 #endif
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+        register_counter_types(connection_shmem);
+#endif
 #if defined(HPX_HAVE_PARCELPORT_IBVERBS)
         register_counter_types(connection_ibverbs);
 #endif
@@ -901,6 +998,16 @@ namespace hpx { namespace parcelset
             boost::bind(&parcelhandler::get_outgoing_queue_length, this, ::_1));
         HPX_STD_FUNCTION<boost::int64_t(bool)> outgoing_routed_count(
             boost::bind(&parcelhandler::get_parcel_routed_count, this, ::_1));
+        HPX_STD_FUNCTION<boost::int64_t(bool)> outgoing_local_count(
+            boost::bind(&parcelhandler::get_parcel_local_count, this, ::_1));
+
+        util::buffer_pool<char>& pool = get_parcel_buffer_pool();
+        HPX_STD_FUNCTION<boost::int64_t(bool)> buffer_pool_hits(
+            boost::bind(&util::buffer_pool<char>::get_hits, &pool, ::_1));
+        HPX_STD_FUNCTION<boost::int64_t(bool)> buffer_pool_misses(
+            boost::bind(&util::buffer_pool<char>::get_misses, &pool, ::_1));
+        HPX_STD_FUNCTION<boost::int64_t(bool)> buffer_pool_retained(
+            boost::bind(&util::buffer_pool<char>::get_retained_bytes, &pool, ::_1));
 
         performance_counters::generic_counter_type_data const counter_types[] =
         {
@@ -931,10 +1038,53 @@ namespace hpx { namespace parcelset
                   _1, outgoing_routed_count, _2),
               &performance_counters::locality_counter_discoverer,
               ""
+            },
+            { "/parcels/count/local",
+              performance_counters::counter_raw,
+              "returns the number of parcels which were delivered to this "
+                  "locality directly, without being serialized",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, outgoing_local_count, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/parcels/count/buffer-pool-hits",
+              performance_counters::counter_raw,
+              "returns the number of parcel buffers which were taken from the "
+                  "pool of parcel buffers",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, buffer_pool_hits, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/parcels/count/buffer-pool-misses",
+              performance_counters::counter_raw,
+              "returns the number of parcel buffers which had to be allocated "
+                  "as no matching buffer was found in the pool of parcel buffers",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, buffer_pool_misses, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/parcels/count/buffer-pool-retained",
+              performance_counters::counter_raw,
+              "returns the number of bytes currently retained by the pool of "
+                  "parcel buffers",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, buffer_pool_retained, _2),
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
             }
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+
+        // register the counters of the actions using threshold compression
+        util::register_compression_counter_types();
     }
 
     void parcelhandler::register_counter_types(connection_type pp_type)
@@ -946,6 +1096,8 @@ namespace hpx { namespace parcelset
 
         HPX_STD_FUNCTION<boost::int64_t(bool)> num_message_sends(
             boost::bind(&parcelhandler::get_message_send_count, this, pp_type, ::_1));
+        HPX_STD_FUNCTION<boost::int64_t(bool)> num_message_writes(
+            boost::bind(&parcelhandler::get_message_write_count, this, pp_type, ::_1));
         HPX_STD_FUNCTION<boost::int64_t(bool)> num_message_receives(
             boost::bind(&parcelhandler::get_message_receive_count, this, pp_type, ::_1));
 
@@ -1023,6 +1175,17 @@ namespace hpx { namespace parcelset
               &performance_counters::locality_counter_discoverer,
               ""
             },
+            { boost::str(boost::format("/messages/count/%s/writes") % connection_type_name),
+              performance_counters::counter_raw,
+              boost::str(boost::format("returns the number of write operations used "
+                  "to send the messages using the %s connection type for the "
+                  "referenced locality") % connection_type_name),
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, num_message_writes, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
 
             { boost::str(boost::format("/data/time/%s/sent") % connection_type_name),
               performance_counters::counter_raw,
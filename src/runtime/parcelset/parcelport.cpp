@@ -22,6 +22,11 @@
 #include <hpx/runtime/parcelset/policies/ipc/receiver.hpp>
 #include <hpx/runtime/parcelset/policies/ipc/sender.hpp>
 #endif
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/runtime/parcelset/policies/shmem/connection_handler.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/receiver.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/sender.hpp>
+#endif
 #if defined(HPX_HAVE_PARCELPORT_IBVERBS)
 #include <hpx/runtime/parcelset/policies/ibverbs/connection_handler.hpp>
 #include <hpx/runtime/parcelset/policies/ibverbs/receiver.hpp>
@@ -36,8 +41,10 @@
 #include <hpx/runtime/parcelset/parcelport_impl.hpp>
 #include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/static.hpp>
 #include <hpx/exception.hpp>
 
+#include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
@@ -94,6 +101,14 @@ namespace hpx { namespace parcelset
 #endif
 
             break;
+
+        case connection_shmem:
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+            return return_type(
+                policies::shmem::connection_handler::runtime_configuration()
+              , true);
+#endif
+            break;
         default:
             break;
         }
@@ -187,6 +202,25 @@ namespace hpx { namespace parcelset
                 "unsupported connection type 'connection_mpi'");
             break;
 
+        case connection_shmem:
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+            {
+                // Create shared memory based parcelport only if allowed by
+                // the configuration info.
+                std::string enable_shmem =
+                    cfg.get_entry("hpx.parcel.shmem.enable", "0");
+
+                if (boost::lexical_cast<int>(enable_shmem))
+                {
+                    return boost::make_shared<policies::shmem::connection_handler>(
+                        cfg, on_start_thread, on_stop_thread);
+                }
+            }
+#endif
+            HPX_THROW_EXCEPTION(bad_parameter, "parcelport::create",
+                "unsupported connection type 'connection_shmem'");
+            break;
+
         default:
             HPX_THROW_EXCEPTION(bad_parameter, "parcelport::create",
                 "unknown connection type");
@@ -206,6 +240,13 @@ namespace hpx { namespace parcelset
         allow_zero_copy_optimizations_(true),
         enable_security_(false),
         async_serialization_(false),
+        streaming_threshold_(HPX_PARCEL_STREAMING_THRESHOLD),
+        streaming_frame_size_(HPX_PARCEL_STREAMING_FRAME_SIZE),
+        streaming_max_frames_(HPX_PARCEL_STREAMING_MAX_FRAMES),
+        gather_message_size_(HPX_PARCEL_GATHER_MESSAGE_SIZE),
+        gather_max_size_(HPX_PARCEL_GATHER_MAX_SIZE),
+        gather_max_buffers_(HPX_PARCEL_GATHER_MAX_BUFFERS),
+        message_writes_(0),
         enable_parcel_handling_(true)
     {
         std::string key("hpx.parcel.");
@@ -238,6 +279,26 @@ namespace hpx { namespace parcelset
         {
             async_serialization_ = true;
         }
+
+        streaming_threshold_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.streaming_threshold",
+                HPX_PARCEL_STREAMING_THRESHOLD));
+        streaming_frame_size_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.streaming_frame_size",
+                HPX_PARCEL_STREAMING_FRAME_SIZE));
+        streaming_max_frames_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.streaming_max_frames",
+                HPX_PARCEL_STREAMING_MAX_FRAMES));
+
+        gather_message_size_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.gather_message_size",
+                HPX_PARCEL_GATHER_MESSAGE_SIZE));
+        gather_max_size_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.gather_max_size",
+                HPX_PARCEL_GATHER_MAX_SIZE));
+        gather_max_buffers_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.gather_max_buffers",
+                HPX_PARCEL_GATHER_MAX_BUFFERS));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -245,5 +306,33 @@ namespace hpx { namespace parcelset
     {
         return pp.get_max_message_size();
     }
+
+    std::size_t get_streaming_max_frames(parcelport& pp)
+    {
+        return pp.streaming_max_frames();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct parcel_buffer_pool : util::buffer_pool<char>
+        {
+            parcel_buffer_pool()
+              : util::buffer_pool<char>(boost::lexical_cast<std::size_t>(
+                    get_config_entry("hpx.parcel.max_buffer_pool_size",
+                        HPX_PARCEL_MAX_BUFFER_POOL_SIZE)))
+            {}
+        };
+
+        struct parcel_buffer_pool_tag {};
+    }
+
+    util::buffer_pool<char>& get_parcel_buffer_pool()
+    {
+        util::static_<
+            detail::parcel_buffer_pool, detail::parcel_buffer_pool_tag
+        > pool;
+        return pool.get();
+    }
 }}
 
@@ -0,0 +1,299 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config/defines.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/connection_handler.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/sender.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/receiver.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+
+#include <boost/assign/std/vector.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // the time a thread sleeps before re-checking for a peer which went away
+    std::size_t const wait_timeout = 100;       // [ms]
+
+    std::vector<std::string> connection_handler::runtime_configuration()
+    {
+        std::vector<std::string> lines;
+
+        using namespace boost::assign;
+        lines +=
+            "max_connections_per_locality = "
+                "${HPX_PARCEL_SHMEM_MAX_CONNECTIONS_PER_LOCALITY:1}",
+            "num_slots = ${HPX_PARCEL_SHMEM_NUM_SLOTS:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_SHMEM_NUM_SLOTS) "}",
+            "inline_size = ${HPX_PARCEL_SHMEM_INLINE_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_SHMEM_INLINE_SIZE) "}",
+            "arena_size = ${HPX_PARCEL_SHMEM_ARENA_SIZE:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_SHMEM_ARENA_SIZE) "}",
+            "spin_count = ${HPX_PARCEL_SHMEM_SPIN_COUNT:"
+                BOOST_PP_STRINGIZE(HPX_PARCEL_SHMEM_SPIN_COUNT) "}"
+            ;
+
+        return lines;
+    }
+
+    connection_handler::connection_handler(util::runtime_configuration const& ini,
+            HPX_STD_FUNCTION<void(std::size_t, char const*)> const& on_start_thread,
+            HPX_STD_FUNCTION<void()> const& on_stop_thread)
+      : base_type(ini, on_start_thread, on_stop_thread)
+      , spin_count_(0)
+      , connection_count_(0)
+      , listener_(0)
+      , stopped_(true)
+    {
+        // we never do zero copy optimization for this parcelport, the data
+        // is copied into the shared memory in one go
+        allow_zero_copy_optimizations_ = false;
+
+        std::size_t inline_size = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.shmem.inline_size",
+                HPX_PARCEL_SHMEM_INLINE_SIZE));
+
+        // every slot starts on its own cache line
+        std::size_t slot_size = inline_size + sizeof(slot_header);
+        slot_size = ((slot_size + cache_line_size - 1) / cache_line_size) *
+            cache_line_size;
+
+        params_.num_slots_ = (std::max)(std::size_t(1),
+            boost::lexical_cast<std::size_t>(
+                ini.get_entry("hpx.parcel.shmem.num_slots",
+                    HPX_PARCEL_SHMEM_NUM_SLOTS)));
+        params_.slot_size_ = slot_size;
+        params_.arena_size_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.shmem.arena_size",
+                HPX_PARCEL_SHMEM_ARENA_SIZE));
+        params_.wait_timeout_ = wait_timeout;
+
+        spin_count_ = boost::lexical_cast<std::size_t>(
+            ini.get_entry("hpx.parcel.shmem.spin_count",
+                HPX_PARCEL_SHMEM_SPIN_COUNT));
+    }
+
+    connection_handler::~connection_handler()
+    {
+        do_stop();
+    }
+
+    bool connection_handler::do_run()
+    {
+        using namespace boost::interprocess;
+
+        std::string name(get_listener_name(here_));
+        try {
+            shared_memory_object::remove(name.c_str());
+            listener_segment_.reset(new segment_type(create_only, name.c_str(),
+                sizeof(listener) + 4096));
+            listener_ = listener_segment_->construct<listener>("listener")();
+        }
+        catch (interprocess_exception const& e) {
+            listener_segment_.reset();
+            listener_ = 0;
+            HPX_THROW_EXCEPTION(network_error,
+                "shmem::connection_handler::run", e.what());
+            return false;
+        }
+
+        stopped_.store(false);
+        receive_thread_ = boost::thread(
+            &connection_handler::receive_loop, this);
+
+        return true;
+    }
+
+    void connection_handler::do_stop()
+    {
+        if (receive_thread_.joinable())
+        {
+            stopped_.store(true);
+            listener_->notify();
+            receive_thread_.join();
+        }
+
+        receivers_.clear();
+
+        if (listener_segment_)
+        {
+            listener_segment_.reset();
+            listener_ = 0;
+
+            boost::interprocess::shared_memory_object::remove(
+                get_listener_name(here_).c_str());
+        }
+    }
+
+    std::string connection_handler::get_locality_name() const
+    {
+        return "shmem";
+    }
+
+    boost::shared_ptr<sender> connection_handler::create_connection(
+        naming::locality const& l, error_code& ec)
+    {
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+        boost::shared_ptr<sender> sender_connection(new sender(io_service,
+            here_, l, params_, stopped_, parcels_sent_, ++connection_count_));
+
+        // Connect to the target locality, retry if needed
+        std::string error;
+        for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+        {
+            try {
+                sender_connection->connect();
+                error.clear();
+                break;
+            }
+            catch (boost::interprocess::interprocess_exception const& e) {
+                error = e.what();
+            }
+
+            // wait for a really short amount of time
+            this_thread::suspend(hpx::threads::pending,
+                "connection_handler(shmem)::create_connection");
+        }
+
+        if (!error.empty()) {
+            sender_connection.reset();
+
+            hpx::util::osstream strm;
+            strm << error << " (while trying to connect to: " << l << ")";
+            HPX_THROWS_IF(ec, network_error,
+                "shmem::parcelport::get_connection",
+                hpx::util::osstream_get_string(strm));
+            return sender_connection;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return sender_connection;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All incoming rings are polled by this thread. It spins for a while
+    // after the last message was received and sleeps on the doorbell of the
+    // listener afterwards.
+    void connection_handler::receive_loop()
+    {
+        HPX_STD_FUNCTION<void(std::size_t, char const*)> on_start_thread =
+            io_service_pool_.get_on_start_thread();
+        if (on_start_thread)
+            on_start_thread(0, "-shmem-receive");
+
+        std::size_t idle = 0;
+        while (!stopped_.load())
+        {
+            if (receive_parcels())
+            {
+                idle = 0;
+                continue;
+            }
+
+            if (++idle < spin_count_)
+            {
+#if defined(BOOST_SMT_PAUSE)
+                BOOST_SMT_PAUSE
+#endif
+                continue;
+            }
+
+            // Announce that we are about to sleep, then check once more to
+            // not miss any data written concurrently.
+            idle = 0;
+            boost::uint32_t seq = listener_->prepare_wait();
+            if (stopped_.load() || has_data())
+            {
+                listener_->cancel_wait();
+                continue;
+            }
+            listener_->wait(seq, wait_timeout);
+        }
+
+        // receive everything which was written to the rings before the
+        // parcelport was stopped, the rings go away afterwards
+        while (receive_parcels())
+            /**/;
+
+        HPX_STD_FUNCTION<void()> on_stop_thread =
+            io_service_pool_.get_on_stop_thread();
+        if (on_stop_thread)
+            on_stop_thread();
+    }
+
+    bool connection_handler::receive_parcels()
+    {
+        bool received = accept_connections();
+
+        typedef std::vector<boost::shared_ptr<receiver> >::iterator iterator;
+        for (iterator it = receivers_.begin(); it != receivers_.end(); /**/)
+        {
+            if ((*it)->poll())
+                received = true;
+
+            // forget about connections the sender has closed
+            if ((*it)->closed())
+                it = receivers_.erase(it);
+            else
+                ++it;
+        }
+        return received;
+    }
+
+    // open the rings of all newly connected senders
+    bool connection_handler::accept_connections()
+    {
+        bool accepted = false;
+
+        std::string name;
+        while (listener_->accept(name))
+        {
+            try {
+                receivers_.push_back(
+                    boost::shared_ptr<receiver>(new receiver(name, *this)));
+                accepted = true;
+            }
+            catch (boost::interprocess::interprocess_exception const& e) {
+                // the sender has gone away already
+                LPT_(error)
+                    << "shmem::connection_handler::accept_connections: "
+                    << "could not open connection " << name << ": "
+                    << e.what();
+            }
+        }
+        return accepted;
+    }
+
+    bool connection_handler::has_data() const
+    {
+        if (listener_->has_pending_connections())
+            return true;
+
+        typedef std::vector<boost::shared_ptr<receiver> >::const_iterator
+            iterator;
+        for (iterator it = receivers_.begin(); it != receivers_.end(); ++it)
+        {
+            if ((*it)->has_data())
+                return true;
+        }
+        return false;
+    }
+}}}}
+
+#endif
@@ -0,0 +1,85 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/threads/executors/numa_domain_executor.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/bind.hpp>
+
+namespace hpx { namespace threads { namespace executors { namespace detail
+{
+    numa_domain_executor::numa_domain_executor(std::size_t domain)
+      : current_(0), tasks_scheduled_(0), tasks_completed_(0)
+    {
+        threadmanager_base& tm = get_thread_manager();
+        topology const& topo = get_topology();
+
+        std::size_t num_threads = get_os_thread_count();
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            error_code ec(lightweight);
+            std::size_t node = topo.get_numa_node_number(tm.get_pu_num(i), ec);
+            if (!ec && node == domain)
+                workers_.push_back(i);
+        }
+    }
+
+    void numa_domain_executor::thread_function_nullary(
+        boost::intrusive_ptr<numa_domain_executor> const& exec,
+        HPX_STD_FUNCTION<void()> const& func)
+    {
+        // update statistics even if the closure throws
+        struct on_exit
+        {
+            explicit on_exit(numa_domain_executor& exec) : exec_(exec) {}
+            ~on_exit() { ++exec_.tasks_completed_; }
+
+            numa_domain_executor& exec_;
+        } update_statistics(*exec);
+
+        func();
+    }
+
+    // Schedule the specified function for execution in this executor.
+    // Depending on the subclass implementation, this may block in some
+    // situations.
+    void numa_domain_executor::add(HPX_STD_FUNCTION<void()> && f,
+        char const* desc, threads::thread_state_enum initial_state,
+        bool run_now, threads::thread_stacksize stacksize, error_code& ec)
+    {
+        std::size_t os_thread = std::size_t(-1);
+        if (!workers_.empty())
+            os_thread = workers_[current_++ % workers_.size()];
+
+        // update statistics
+        ++tasks_scheduled_;
+
+        // the closure keeps the executor alive until it has been run
+        register_thread_nullary(
+            util::bind(&numa_domain_executor::thread_function_nullary,
+                boost::intrusive_ptr<numa_domain_executor>(this), std::move(f)),
+            desc, initial_state, run_now, threads::thread_priority_normal,
+            os_thread, stacksize, ec);
+        if (ec) {
+            --tasks_scheduled_;
+            return;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    // Return an estimate of the number of waiting tasks.
+    std::size_t numa_domain_executor::num_pending_closures(error_code& ec) const
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        // only the closures submitted through this executor are counted
+        return tasks_scheduled_ - tasks_completed_;
+    }
+}}}}
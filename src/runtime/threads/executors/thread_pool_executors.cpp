@@ -120,6 +120,9 @@ namespace hpx { namespace threads { namespace executors { namespace detail
         // detach this executor from resource manager
         rm.detach(cookie_);     // this releases proxy (manage_thread_pool_executor)
 
+        // drop all timers which did not expire anymore
+        scheduler_.get_timer_wheel().clear();
+
 #if defined(HPX_DEBUG)
         // all resources should have been stopped at this point
         for (std::size_t i = 0; i != states_.size(); ++i)
@@ -308,10 +311,11 @@ namespace hpx { namespace threads { namespace executors { namespace detail
             on_run_exit on_exit(current_concurrency_, shutdown_sem_);
 
             boost::int64_t executed_threads = 0, executed_thread_phases = 0;
-            boost::uint64_t overall_times = 0, thread_times = 0;
+            boost::uint64_t overall_times = 0, thread_times = 0, park_times = 0;
             threads::detail::scheduling_loop(virt_core, scheduler_,
                 states_[virt_core], executed_threads, executed_thread_phases,
-                overall_times, thread_times, &suspend_back_into_calling_context);
+                overall_times, thread_times, park_times,
+                &suspend_back_into_calling_context);
 
 #if HPX_DEBUG != 0
             // the scheduling_loop is allowed to exit only if no more HPX
@@ -13,6 +13,8 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/coroutine/detail/coroutine_impl_impl.hpp>
 
+#include <limits>
+
 // #if HPX_DEBUG
 // #  define HPX_DEBUG_THREAD_POOL 1
 // #endif
@@ -190,6 +192,15 @@ namespace hpx { namespace threads
         return p;
     }
 
+    std::ptrdiff_t get_available_stack_space()
+    {
+        thread_self* self = get_self_ptr();
+        if (0 == self)
+            return (std::numeric_limits<std::ptrdiff_t>::max)();
+
+        return self->get_available_stack_space();
+    }
+
     thread_id_type get_self_id()
     {
         thread_self* self = get_self_ptr();
@@ -33,6 +33,7 @@
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include <numeric>
 
@@ -92,6 +93,55 @@ namespace hpx { namespace threads
         return strings::thread_priority_names[priority];
     }
 
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        T get_idle_entry(char const* key, T dflt)
+        {
+            std::string value = get_config_entry(key, "");
+            if (value.empty())
+                return dflt;
+
+            try {
+                return boost::lexical_cast<T>(value);
+            }
+            catch (boost::bad_lexical_cast const&) {
+                HPX_THROW_EXCEPTION(bad_parameter, "get_idle_parameters",
+                    boost::str(boost::format(
+                        "invalid value for configuration entry %1%: %2%") %
+                            key % value));
+            }
+            return dflt;
+        }
+
+        // read the idle policy settings from the [hpx.idle] section
+        policies::idle_parameters get_idle_parameters()
+        {
+            policies::idle_parameters params;
+
+            std::string policy = get_config_entry("hpx.idle.policy", "");
+            if (policy == "backoff")
+                params.policy_ = policies::idle_backoff;
+            else if (policy == "park")
+                params.policy_ = policies::idle_park;
+            else if (!policy.empty() && policy != "spin") {
+                HPX_THROW_EXCEPTION(bad_parameter, "get_idle_parameters",
+                    "invalid idle policy (hpx.idle.policy): " + policy +
+                    ", expected one of: spin, backoff, park");
+            }
+
+            params.spin_count_ = get_idle_entry(
+                "hpx.idle.spin_count", params.spin_count_);
+            params.max_backoff_ = get_idle_entry(
+                "hpx.idle.max_backoff", params.max_backoff_);
+            params.park_timeout_ = get_idle_entry(
+                "hpx.idle.park_timeout", params.park_timeout_);
+
+            return params;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename SchedulingPolicy, typename NotificationPolicy>
     threadmanager_impl<SchedulingPolicy, NotificationPolicy>::threadmanager_impl(
@@ -213,6 +263,26 @@ namespace hpx { namespace threads
         detail::create_work(&scheduler_, data, initial_state, ec);
     }
 
+    template <typename SchedulingPolicy, typename NotificationPolicy>
+    void threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
+        register_work_bulk(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+    {
+        util::block_profiler_wrapper<register_work_tag> bp(work_logger_);
+
+        // verify state
+        if ((thread_count_ == 0 && state_ != running))
+        {
+            // thread-manager is not currently running
+            HPX_THROWS_IF(ec, invalid_status,
+                "threadmanager_impl::register_work_bulk",
+                "invalid state: thread manager is not running");
+            return;
+        }
+
+        detail::create_work_bulk(&scheduler_, data, count, initial_state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// The set_state function is part of the thread related API and allows
     /// to change the state of one of the threads managed by this threadmanager_impl
@@ -984,6 +1054,63 @@ namespace hpx { namespace threads
         return naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // parked and spinning rate counter creation function
+    template <typename SchedulingPolicy, typename NotificationPolicy>
+    naming::gid_type threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
+        park_rate_counter_creator(
+            performance_counters::counter_info const& info, error_code& ec,
+            bool parked)
+    {
+        // verify the validity of the counter instance name
+        performance_counters::counter_path_elements paths;
+        performance_counters::get_counter_path_elements(info.fullname_, paths, ec);
+        if (ec) return naming::invalid_gid;
+
+        // /threads{locality#%d/total}/parked-rate
+        // /threads{locality#%d/worker-thread%d}/parked-rate
+        // /threads{locality#%d/total}/spinning-rate
+        // /threads{locality#%d/worker-thread%d}/spinning-rate
+        if (paths.parentinstance_is_basename_) {
+            HPX_THROWS_IF(ec, bad_parameter, "park_rate_counter_creator",
+                "invalid counter instance parent name: " +
+                    paths.parentinstancename_);
+            return naming::invalid_gid;
+        }
+
+        typedef threadmanager_impl ti;
+
+        using HPX_STD_PLACEHOLDERS::_1;
+        using performance_counters::detail::create_raw_counter;
+        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        {
+            // overall counter
+            boost::int64_t (threadmanager_impl::*avg_park_rate_ptr)(
+                bool, bool
+            ) = &ti::avg_park_rate;
+            HPX_STD_FUNCTION<boost::int64_t(bool)> f =
+                 HPX_STD_BIND(avg_park_rate_ptr, this, parked, _1);
+            return create_raw_counter(info, f, ec);
+        }
+        else if (paths.instancename_ == "worker-thread" &&
+            paths.instanceindex_ >= 0 &&
+            std::size_t(paths.instanceindex_) < threads_.size())
+        {
+            // specific counter
+            boost::int64_t (threadmanager_impl::*avg_park_rate_ptr)(
+                std::size_t, bool, bool
+            ) = &ti::avg_park_rate;
+            HPX_STD_FUNCTION<boost::int64_t(bool)> f =
+                HPX_STD_BIND(avg_park_rate_ptr, this,
+                    static_cast<std::size_t>(paths.instanceindex_), parked, _1);
+            return create_raw_counter(info, f, ec);
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter, "park_rate_counter_creator",
+            "invalid counter instance name: " + paths.instancename_);
+        return naming::invalid_gid;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     naming::gid_type
     counter_creator(performance_counters::counter_info const& info,
@@ -1154,6 +1281,21 @@ namespace hpx { namespace threads
               HPX_STD_BIND(&coroutine_type::impl_type::get_stack_unbind_count, _1),
               HPX_STD_FUNCTION<boost::uint64_t(bool)>(), "", 0
             },
+            // /threads{locality#%d/total}/count/stack-allocations
+            { "count/stack-allocations",
+              HPX_STD_BIND(&coroutine_type::impl_type::get_stack_allocation_count, _1),
+              HPX_STD_FUNCTION<boost::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-reuses
+            { "count/stack-reuses",
+              HPX_STD_BIND(&coroutine_type::impl_type::get_stack_reuse_count, _1),
+              HPX_STD_FUNCTION<boost::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-cache-bytes
+            { "count/stack-cache-bytes",
+              HPX_STD_BIND(&coroutine_type::impl_type::get_stack_cache_bytes, _1),
+              HPX_STD_FUNCTION<boost::uint64_t(bool)>(), "", 0
+            },
 #endif
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
@@ -1217,6 +1359,36 @@ namespace hpx { namespace threads
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
             },
+            // /threads{locality#%d/total}/count/stolen-from-numa-domain
+            // /threads{locality#%d/worker-thread%d}/count/stolen-from-numa-domain
+            { "count/stolen-from-numa-domain",
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_numa_domain, std::size_t(-1), _1),
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_numa_domain,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-from-core
+            // /threads{locality#%d/worker-thread%d}/count/stolen-from-core
+            { "count/stolen-from-core",
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_core, std::size_t(-1), _1),
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_core,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-from-remote-numa-domain
+            // /threads{locality#%d/worker-thread%d}/count/stolen-from-remote-numa-domain
+            { "count/stolen-from-remote-numa-domain",
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_remote_numa_domain, std::size_t(-1), _1),
+              HPX_STD_BIND(&spt::get_num_steals, &scheduler_,
+                  policies::steal_remote_numa_domain,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
         };
         std::size_t const data_size = sizeof(data)/sizeof(data[0]);
 
@@ -1281,6 +1453,20 @@ namespace hpx { namespace threads
               &performance_counters::locality_thread_counter_discoverer,
               "0.01%"
             },
+            { "/threads/parked-rate", performance_counters::counter_raw,
+              "returns the % of time the referenced object spent parked or "
+              "backing off while idle", HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&ti::park_rate_counter_creator, this, _1, _2, true),
+              &performance_counters::locality_thread_counter_discoverer,
+              "0.01%"
+            },
+            { "/threads/spinning-rate", performance_counters::counter_raw,
+              "returns the % of time the referenced object spent spinning "
+              "while idle", HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&ti::park_rate_counter_creator, this, _1, _2, false),
+              &performance_counters::locality_thread_counter_discoverer,
+              "0.01%"
+            },
 #if HPX_THREAD_MAINTAIN_CREATION_AND_CLEANUP_RATES
             { "/threads/creation-idle-rate", performance_counters::counter_raw,
               "returns the % of idle-rate spent creating HPX-threads for the "
@@ -1358,6 +1544,27 @@ namespace hpx { namespace threads
               counts_creator, &performance_counters::locality_counter_discoverer,
               ""
             },
+            { "/threads/count/stack-allocations", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks newly allocated "
+              "from the operating system for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-reuses", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks taken from the "
+              "per OS-thread stack caches for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-cache-bytes", performance_counters::counter_raw,
+              "returns the current number of bytes held by HPX-thread stacks in "
+              "the per OS-thread stack caches for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
+            },
 #endif
             { "/threads/count/objects", performance_counters::counter_raw,
               "returns the overall number of created HPX-thread objects for "
@@ -1409,19 +1616,36 @@ namespace hpx { namespace threads
               counts_creator,
               &performance_counters::locality_thread_counter_discoverer,
               ""
+            },
+            { "/threads/count/stolen-from-numa-domain", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads taken from the shared queue of the NUMA domain of the stealing worker thread "
+              "for the referenced locality (--hpx:queuing=numa_hierarchy only)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-from-core", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads taken from the queues of other cores of the NUMA domain of the stealing worker thread "
+              "for the referenced locality (--hpx:queuing=numa_hierarchy only)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-from-remote-numa-domain", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads taken from any queue of a NUMA domain other than the one of the stealing worker thread "
+              "for the referenced locality (--hpx:queuing=numa_hierarchy only)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
     }
 
-    template <typename SchedulingPolicy, typename NotificationPolicy>
-    void threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
-        idle_callback(std::size_t num_thread)
-    {
-        scheduler_.idle_callback(num_thread);
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     template <typename SchedulingPolicy, typename NotificationPolicy>
     void threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
@@ -1436,7 +1660,7 @@ namespace hpx { namespace threads
         detail::scheduling_loop(num_thread, scheduler_, state_,
             executed_threads_[num_thread], executed_thread_phases_[num_thread],
             tfunc_times[num_thread], exec_times[num_thread],
-            util::bind(&threadmanager_impl::idle_callback, this, num_thread));
+            park_times[num_thread]);
 
 #if HPX_DEBUG != 0
         // the OS thread is allowed to exit only if no more HPX threads exist
@@ -1470,6 +1694,9 @@ namespace hpx { namespace threads
         executed_thread_phases_.resize(num_threads);
         tfunc_times.resize(num_threads);
         exec_times.resize(num_threads);
+        park_times.resize(num_threads);
+
+        scheduler_.set_idle_parameters(detail::get_idle_parameters());
 
         try {
             // run threads and wait for initialization to complete
@@ -1544,7 +1771,7 @@ namespace hpx { namespace threads
         if (!threads_.empty()) {
             if (state_.load() == running) {
                 state_.store(stopping);
-                do_some_work();         // make sure we're not waiting
+                scheduler_.unpark_all();    // make sure we're not waiting
             }
 
             if (blocking) {
@@ -1552,7 +1779,7 @@ namespace hpx { namespace threads
                 {
                     // make sure no OS thread is waiting
                     LTM_(info) << "stop: notify_all";
-                    do_some_work();
+                    scheduler_.unpark_all();
 
                     LTM_(info) << "stop(" << i << "): join"; //-V128
 
@@ -1562,6 +1789,11 @@ namespace hpx { namespace threads
                 }
                 threads_.clear();
 
+                // drop all timers which did not expire anymore, they refer
+                // to threads owned by the scheduler
+                LTM_(info) << "stop: clearing timers";
+                scheduler_.get_timer_wheel().clear();
+
                 LTM_(info) << "stop: stopping timer pool";
                 timer_pool_.stop();             // stop timer pool as well
                 if (blocking) {
@@ -1655,6 +1887,53 @@ namespace hpx { namespace threads
         return boost::int64_t(10000. * percent);   // 0.01 percent
     }
 
+    template <typename SchedulingPolicy, typename NotificationPolicy>
+    boost::int64_t threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
+        avg_park_rate(bool parked, bool reset)
+    {
+        double const park_total =
+            std::accumulate(park_times.begin(), park_times.end(), 0.);
+        double const exec_total =
+            std::accumulate(exec_times.begin(), exec_times.end(), 0.);
+        double const tfunc_total =
+            std::accumulate(tfunc_times.begin(), tfunc_times.end(), 0.);
+
+        if (reset) {
+            std::fill(park_times.begin(), park_times.end(), 0);
+            std::fill(exec_times.begin(), exec_times.end(), 0);
+            std::fill(tfunc_times.begin(), tfunc_times.end(), 0);
+        }
+
+        if (std::abs(tfunc_total) < 1e-16)   // avoid division by zero
+            return parked ? 0LL : 10000LL;
+
+        double const percent = parked ? (park_total / tfunc_total) :
+            (1. - ((exec_total + park_total) / tfunc_total));
+        return boost::int64_t(10000. * percent);    // 0.01 percent
+    }
+
+    template <typename SchedulingPolicy, typename NotificationPolicy>
+    boost::int64_t threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
+        avg_park_rate(std::size_t num_thread, bool parked, bool reset)
+    {
+        double const park_time = static_cast<double>(park_times[num_thread]);
+        double const exec_time = static_cast<double>(exec_times[num_thread]);
+        double const tfunc_time = static_cast<double>(tfunc_times[num_thread]);
+
+        if (reset) {
+            park_times[num_thread] = 0;
+            exec_times[num_thread] = 0;
+            tfunc_times[num_thread] = 0;
+        }
+
+        if (std::abs(tfunc_time) < 1e-16)   // avoid division by zero
+            return parked ? 0LL : 10000LL;
+
+        double const percent = parked ? (park_time / tfunc_time) :
+            (1. - ((exec_time + park_time) / tfunc_time));
+        return boost::int64_t(10000. * percent);   // 0.01 percent
+    }
+
 #if HPX_THREAD_MAINTAIN_CREATION_AND_CLEANUP_RATES
     template <typename SchedulingPolicy, typename NotificationPolicy>
     boost::int64_t threadmanager_impl<SchedulingPolicy, NotificationPolicy>::
@@ -1715,6 +1994,10 @@ namespace hpx { namespace threads
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::local_queue_scheduler<>,
     hpx::threads::policies::callback_notifier>;
+
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::chase_lev_local_queue_scheduler,
+    hpx::threads::policies::callback_notifier>;
 #endif
 
 #if defined(HPX_STATIC_PRIORITY_SCHEDULER)
@@ -1733,6 +2016,10 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler,
     hpx::threads::policies::callback_notifier>;
 
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler,
+    hpx::threads::policies::callback_notifier>;
+
 #if defined(HPX_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
@@ -1740,6 +2027,13 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::callback_notifier>;
 #endif
 
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_hierarchy_scheduler.hpp>
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::numa_hierarchy_scheduler<>,
+    hpx::threads::policies::callback_notifier>;
+#endif
+
 #if defined(HPX_PERIODIC_PRIORITY_SCHEDULER)
 #include <hpx/runtime/threads/policies/periodic_priority_queue_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
@@ -698,6 +698,10 @@ namespace hpx {
 template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::local_queue_scheduler<>,
     hpx::threads::policies::callback_notifier>;
+
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::chase_lev_local_queue_scheduler,
+    hpx::threads::policies::callback_notifier>;
 #endif
 
 #if defined(HPX_STATIC_PRIORITY_SCHEDULER)
@@ -716,6 +720,10 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler,
     hpx::threads::policies::callback_notifier>;
 
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler,
+    hpx::threads::policies::callback_notifier>;
+
 #if defined(HPX_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::runtime_impl<
@@ -723,6 +731,13 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::callback_notifier>;
 #endif
 
+#if defined(HPX_NUMA_HIERARCHY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_hierarchy_scheduler.hpp>
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::numa_hierarchy_scheduler<>,
+    hpx::threads::policies::callback_notifier>;
+#endif
+
 #if defined(HPX_PERIODIC_PRIORITY_SCHEDULER)
 #include <hpx/runtime/threads/policies/periodic_priority_queue_scheduler.hpp>
 template class HPX_EXPORT hpx::runtime_impl<
@@ -0,0 +1,192 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(BOOST_WINDOWS) && !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
+
+#include <unistd.h>
+
+#include <hpx/util/coroutine/detail/posix_utility.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+
+namespace hpx { namespace util { namespace coroutines { namespace detail { namespace posix
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // this global (urghhh) variable is used to control whether stacks should
+    // be backed by transparent huge pages
+    HPX_EXPORT bool use_huge_pages = false;
+
+    // this global variable holds the maximum number of stacks kept in the
+    // stack cache of each OS thread
+    HPX_EXPORT std::size_t stack_cache_high_water_mark = 64;
+
+    namespace
+    {
+        boost::atomic<boost::uint64_t> stack_allocations(0);
+        boost::atomic<boost::uint64_t> stack_reuses(0);
+        boost::atomic<boost::uint64_t> stack_cache_bytes(0);
+    }
+
+    boost::uint64_t get_stack_allocation_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_allocations, reset);
+    }
+
+    boost::uint64_t get_stack_reuse_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_reuses, reset);
+    }
+
+    boost::uint64_t get_stack_cache_bytes(bool)
+    {
+        // this is a gauge, it can't be reset
+        return stack_cache_bytes.load(boost::memory_order_relaxed);
+    }
+
+    void increment_stack_allocation_count()
+    {
+        ++stack_allocations;
+    }
+
+#if defined(HPX_USE_MMAP) && defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The stacks cached by one OS thread, grouped by their size. There
+        // are only very few different stack sizes in use (see
+        // thread_stacksize), a linear search is therefore sufficient.
+        class stack_cache : boost::noncopyable
+        {
+            struct bucket
+            {
+                explicit bucket(std::size_t size)
+                  : size_(size)
+                {}
+
+                std::size_t size_;
+                std::vector<void*> stacks_;
+            };
+
+        public:
+            stack_cache()
+              : count_(0)
+            {}
+
+            ~stack_cache()
+            {
+                for (std::size_t i = 0; i != buckets_.size(); ++i)
+                {
+                    bucket& b = buckets_[i];
+                    for (std::size_t j = 0; j != b.stacks_.size(); ++j)
+                        unmap_stack(b.stacks_[j], b.size_);
+                    stack_cache_bytes -= b.size_ * b.stacks_.size();
+                }
+            }
+
+            void* get(std::size_t size)
+            {
+                bucket* b = find_bucket(size);
+                if (0 == b || b->stacks_.empty())
+                    return 0;
+
+                void* stack = b->stacks_.back();
+                b->stacks_.pop_back();
+                --count_;
+
+                stack_cache_bytes -= size;
+                ++stack_reuses;
+                return stack;
+            }
+
+            bool put(void* stack, std::size_t size)
+            {
+                if (count_ >= stack_cache_high_water_mark)
+                    return false;
+
+                bucket* b = find_bucket(size);
+                if (0 == b)
+                {
+                    buckets_.push_back(bucket(size));
+                    b = &buckets_.back();
+                }
+
+                b->stacks_.push_back(stack);
+                ++count_;
+
+                stack_cache_bytes += size;
+                return true;
+            }
+
+        private:
+            bucket* find_bucket(std::size_t size)
+            {
+                for (std::size_t i = 0; i != buckets_.size(); ++i)
+                {
+                    if (buckets_[i].size_ == size)
+                        return &buckets_[i];
+                }
+                return 0;
+            }
+
+            std::vector<bucket> buckets_;
+            std::size_t count_;
+        };
+
+        struct stack_cache_tag {};
+        util::thread_specific_ptr<stack_cache, stack_cache_tag> cache_;
+    }
+
+    void* get_cached_stack(std::size_t size)
+    {
+        stack_cache* cache = cache_.get();
+        if (0 == cache)
+            return 0;
+        return cache->get(size);
+    }
+
+    bool cache_stack(void* stack, std::size_t size)
+    {
+        if (0 == stack_cache_high_water_mark)
+            return false;
+
+        stack_cache* cache = cache_.get();
+        if (0 == cache)
+        {
+            cache = new stack_cache;
+            cache_.reset(cache);
+        }
+        return cache->put(stack, size);
+    }
+
+    void release_cached_stacks()
+    {
+        cache_.reset();
+    }
+#else
+    void* get_cached_stack(std::size_t)
+    {
+        return 0;
+    }
+
+    bool cache_stack(void*, std::size_t)
+    {
+        return false;
+    }
+
+    void release_cached_stacks()
+    {
+    }
+#endif
+}}}}}
+
+#endif
@@ -20,6 +20,40 @@
 namespace hpx { namespace util
 {
     naming::gid_type unique_id_ranges::get_id(std::size_t count)
+    {
+        std::size_t const num_thread = hpx::get_worker_thread_num();
+        if (num_thread == std::size_t(-1) || count > local_range_limit)
+            return get_shared_id(count);
+
+        local_range& r = local_ranges_[num_thread % num_local_ranges];
+        mutex_type::scoped_lock l(r.mtx_);
+
+        while (!r.lower_ || (r.lower_ + count) > r.upper_)
+        {
+            r.lower_ = naming::invalid_gid;
+
+            naming::gid_type lower;
+
+            {
+                scoped_unlock<mutex_type::scoped_lock> ul(l);
+                lower = get_shared_id(local_range_delta);
+            }
+
+            // we ignore the result if some other thread has already set the
+            // new lower range
+            if (!r.lower_)
+            {
+                r.lower_ = lower;
+                r.upper_ = lower + local_range_delta;
+            }
+        }
+
+        naming::gid_type result = r.lower_;
+        r.lower_ += count;
+        return result;
+    }
+
+    naming::gid_type unique_id_ranges::get_shared_id(std::size_t count)
     {
         // create a new id
         mutex_type::scoped_lock l(mtx_);
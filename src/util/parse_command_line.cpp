@@ -446,16 +446,19 @@ namespace hpx { namespace util
                  "the number of total cores in the system)")
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
-                  "'local', 'priority_local', 'priority_abp', "
-                  "'hierarchy', 'static' and 'periodic' (default: 'priority_local'; "
-                  "all option values can be abbreviated)")
+                  "'local', 'local_chase_lev', 'priority_local', 'priority_abp', "
+                  "'priority_chase_lev', 'hierarchy', 'numa_hierarchy', "
+                  "'static' and 'periodic' "
+                  "(default: 'priority_local'; all option values can be "
+                  "abbreviated)")
                 ("hpx:hierarchy-arity", value<std::size_t>(),
                   "the arity of the of the thread queue tree, valid for "
                    "--hpx:queuing=hierarchy only (default: 2)")
                 ("hpx:high-priority-threads", value<std::size_t>(),
                   "the number of operating system threads maintaining a high "
                   "priority queue (default: number of OS threads), valid for "
-                  "--hpx:queuing=priority_local and --hpx:queuing=priority_abp only)")
+                  "--hpx:queuing=priority_local, --hpx:queuing=priority_abp, and "
+                  "--hpx:queuing=priority_chase_lev only)")
                 ("hpx:numa-sensitive",
                   "makes the priority_local scheduler NUMA sensitive")
             ;
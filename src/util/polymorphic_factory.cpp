@@ -13,6 +13,7 @@
 #include <hpx/util/jenkins_hash.hpp>
 
 #include <boost/foreach.hpp>
+#include <boost/format.hpp>
 
 namespace hpx { namespace actions
 {
@@ -53,16 +54,42 @@ namespace hpx { namespace util
         return ctor_map_.end();
     }
 
+    template <typename Base>
+    boost::uint32_t polymorphic_factory<Base>::locate_id(boost::uint32_t hash,
+            std::string const& name) const
+    {
+        typedef std::pair<
+            typename id_map::const_iterator, typename id_map::const_iterator
+        > equal_range_type;
+
+        // the table might contain names unknown to this locality, always
+        // compare the names
+        equal_range_type r = ids_.equal_range(hash);
+        for (typename id_map::const_iterator it = r.first; it != r.second; ++it)
+        {
+            if (names_[(*it).second] == name)
+                return (*it).second;
+        }
+        return invalid_id;
+    }
+
     template <typename Base>
     boost::shared_ptr<Base> polymorphic_factory<Base>::create(
         std::string const & name)
     {
-        polymorphic_factory const & factory = polymorphic_factory::get_instance();
-        typename ctor_map::const_iterator it = factory.locate(
-            util::jenkins_hash()(name), name);
+        polymorphic_factory & factory = polymorphic_factory::get_instance();
+
+        ctor_type ctor = 0;
+        {
+            boost::mutex::scoped_lock l(factory.mtx_);
+            typename ctor_map::const_iterator it = factory.locate(
+                util::jenkins_hash()(name), name);
+            if (it != factory.ctor_map_.end())
+                ctor = (*it).second.second;
+        }
 
-        if (it != factory.ctor_map_.end())
-            return ((*it).second.second)();
+        if (ctor != 0)
+            return ctor();
 
         std::string error = "Can not find action '";
         error += name;
@@ -73,16 +100,136 @@ namespace hpx { namespace util
         return boost::shared_ptr<Base>();
     }
 
+    template <typename Base>
+    boost::shared_ptr<Base> polymorphic_factory<Base>::create(
+        boost::uint32_t id)
+    {
+        polymorphic_factory const & factory = polymorphic_factory::get_instance();
+
+        // the size of the id table never changes once it is available
+        if (factory.ids_available_.load(boost::memory_order_acquire) &&
+            id < factory.num_ids_)
+        {
+            ctor_type ctor =
+                factory.ctors_[id].load(boost::memory_order_acquire);
+            if (ctor != 0)
+                return ctor();
+        }
+
+        HPX_THROW_EXCEPTION(bad_action_code
+            , "polymorphic_factory::create"
+            , boost::str(boost::format(
+                "Can not find action with id '%1%' in type registry") % id));
+        return boost::shared_ptr<Base>();
+    }
+
+    template <typename Base>
+    boost::uint32_t polymorphic_factory<Base>::get_id(std::string const& name)
+    {
+        polymorphic_factory const & factory = polymorphic_factory::get_instance();
+
+        // the id table is immutable once it is available
+        if (!factory.ids_available_.load(boost::memory_order_acquire))
+            return invalid_id;
+
+        return factory.locate_id(util::jenkins_hash()(name), name);
+    }
+
+    template <typename Base>
+    bool polymorphic_factory<Base>::has_ids()
+    {
+        polymorphic_factory const & factory = polymorphic_factory::get_instance();
+        return factory.ids_available_.load(boost::memory_order_acquire);
+    }
+
+    template <typename Base>
+    void polymorphic_factory<Base>::assign_ids()
+    {
+        polymorphic_factory & factory = polymorphic_factory::get_instance();
+
+        boost::mutex::scoped_lock l(factory.mtx_);
+        if (factory.ids_available_.load(boost::memory_order_relaxed))
+            return;
+
+        factory.num_ids_ = factory.ctor_map_.size();
+        factory.ctors_.reset(new boost::atomic<ctor_type>[factory.num_ids_]);
+        factory.names_.reserve(factory.num_ids_);
+
+        typedef typename ctor_map::value_type value_type;
+        BOOST_FOREACH(value_type const& v, factory.ctor_map_)
+        {
+            boost::uint32_t id =
+                static_cast<boost::uint32_t>(factory.names_.size());
+
+            factory.ctors_[id].store(v.second.second,
+                boost::memory_order_relaxed);
+            factory.names_.push_back(v.second.first);
+            factory.ids_.insert(std::make_pair(v.first, id));
+        }
+
+        factory.ids_available_.store(true, boost::memory_order_release);
+    }
+
+    template <typename Base>
+    std::vector<std::string> polymorphic_factory<Base>::get_names()
+    {
+        polymorphic_factory & factory = polymorphic_factory::get_instance();
+
+        boost::mutex::scoped_lock l(factory.mtx_);
+        return factory.names_;
+    }
+
+    template <typename Base>
+    void polymorphic_factory<Base>::set_ids(
+        std::vector<std::string> const& names)
+    {
+        polymorphic_factory & factory = polymorphic_factory::get_instance();
+
+        boost::mutex::scoped_lock l(factory.mtx_);
+        if (factory.ids_available_.load(boost::memory_order_relaxed))
+            return;
+
+        factory.num_ids_ = names.size();
+        factory.ctors_.reset(new boost::atomic<ctor_type>[factory.num_ids_]);
+        factory.names_ = names;
+
+        for (std::size_t i = 0; i != names.size(); ++i)
+        {
+            boost::uint32_t hash = util::jenkins_hash()(names[i]);
+            factory.ids_.insert(
+                std::make_pair(hash, static_cast<boost::uint32_t>(i)));
+
+            // types not known here yet keep a null entry in the table, the
+            // entry is filled in if the type gets registered later on
+            typename ctor_map::const_iterator it = factory.locate(hash, names[i]);
+            factory.ctors_[i].store(
+                it != factory.ctor_map_.end() ? (*it).second.second : 0,
+                boost::memory_order_relaxed);
+        }
+
+        factory.ids_available_.store(true, boost::memory_order_release);
+    }
+
     template <typename Base>
     void polymorphic_factory<Base>::add_factory_function(
         std::string const & name, ctor_type ctor)
     {
+        boost::mutex::scoped_lock l(mtx_);
+
         boost::uint32_t hash = util::jenkins_hash()(name);
         typename ctor_map::const_iterator it = locate(hash, name);
         if (it != ctor_map_.end())
             return;
 
         ctor_map_.insert(std::make_pair(hash, std::make_pair(name, ctor)));
+
+        // the id table may have reserved an id for this type already
+        if (ids_available_.load(boost::memory_order_relaxed))
+        {
+            boost::uint32_t id = locate_id(hash, name);
+            if (id != invalid_id)
+                ctors_[id].store(ctor, boost::memory_order_release);
+        }
     }
 
     template <typename Base>
@@ -121,8 +121,20 @@ namespace hpx { namespace util
                 BOOST_PP_STRINGIZE(HPX_HUGE_STACK_SIZE) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "use_huge_pages = ${HPX_USE_HUGE_PAGES:0}",
+            "cache_high_water_mark = ${HPX_STACK_CACHE_HIGH_WATER_MARK:64}",
 #endif
 
+            "[hpx.idle]",
+#if defined(HPX_THREAD_BACKOFF_ON_IDLE)
+            "policy = ${HPX_IDLE_POLICY:park}",
+#else
+            "policy = ${HPX_IDLE_POLICY:spin}",
+#endif
+            "spin_count = ${HPX_IDLE_SPIN_COUNT:1000}",
+            "max_backoff = ${HPX_IDLE_MAX_BACKOFF:1000}",
+            "park_timeout = ${HPX_IDLE_PARK_TIMEOUT:100}",
+
             "[hpx.threadpools]",
             "io_pool_size = ${HPX_NUM_IO_POOL_THREADS:"
                 BOOST_PP_STRINGIZE(HPX_NUM_IO_POOL_THREADS) "}",
@@ -166,6 +178,8 @@ namespace hpx { namespace util
                 "${HPX_AGAS_MAX_PENDING_REFCNT_REQUESTS:"
                 BOOST_PP_STRINGIZE(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS)
                 "}",
+            "refcnt_flush_interval = ${HPX_AGAS_REFCNT_FLUSH_INTERVAL:"
+                BOOST_PP_STRINGIZE(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL) "}",
             "service_mode = hosted",
             "dedicated_server = 0",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
@@ -318,6 +332,11 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         coroutines::detail::posix::use_guard_pages = init_use_stack_guard_pages();
+#if !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
+        coroutines::detail::posix::use_huge_pages = init_use_stack_huge_pages();
+        coroutines::detail::posix::stack_cache_high_water_mark =
+            init_stack_cache_high_water_mark();
+#endif
 #endif
 #if HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -372,6 +391,11 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         coroutines::detail::posix::use_guard_pages = init_use_stack_guard_pages();
+#if !defined(HPX_HAVE_GENERIC_CONTEXT_COROUTINES)
+        coroutines::detail::posix::use_huge_pages = init_use_stack_huge_pages();
+        coroutines::detail::posix::stack_cache_high_water_mark =
+            init_stack_cache_high_water_mark();
+#endif
 #endif
 #if HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -616,6 +640,22 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    // Get the interval (in milliseconds) after which pending reference
+    // count decrements are sent to AGAS, zero disables periodic flushing.
+    std::size_t
+    runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (NULL != sec) {
+                return boost::lexical_cast<std::size_t>(
+                    sec->get_entry("refcnt_flush_interval",
+                        HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL));
+            }
+        }
+        return HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL;
+    }
+
     // Get whether the AGAS server is running as a dedicated runtime.
     // This decides whether the AGAS actions are executed with normal
     // priority (if dedicated) or with high priority (non-dedicated)
@@ -791,6 +831,30 @@ namespace hpx { namespace util
         }
         return true;    // default is true
     }
+
+    bool runtime_configuration::init_use_stack_huge_pages() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (NULL != sec) {
+                return boost::lexical_cast<int>(
+                    sec->get_entry("use_huge_pages", "0")) != 0;
+            }
+        }
+        return false;   // default is false
+    }
+
+    std::size_t runtime_configuration::init_stack_cache_high_water_mark() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (NULL != sec) {
+                return boost::lexical_cast<std::size_t>(
+                    sec->get_entry("cache_high_water_mark", "64"));
+            }
+        }
+        return 64;      // default is to cache 64 stacks per OS thread
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
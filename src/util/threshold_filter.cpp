@@ -0,0 +1,399 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+#include <hpx/runtime/actions/guid_initialization.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/static.hpp>
+#include <hpx/util/threshold_filter.hpp>
+#include <hpx/util/void_cast.hpp>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <map>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_SERIALIZATION_REGISTER_TYPE_DEFINITION(hpx::util::threshold_binary_filter);
+HPX_REGISTER_BASE_HELPER(hpx::util::threshold_binary_filter,
+    threshold_binary_filter);
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::size_t get_compression_threshold()
+        {
+            static std::size_t threshold =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.parcel.compression_threshold",
+                    HPX_PARCEL_COMPRESSION_THRESHOLD));
+            return threshold;
+        }
+
+        std::size_t get_compression_max_ratio()
+        {
+            static std::size_t max_ratio =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.parcel.compression_max_ratio",
+                    HPX_PARCEL_COMPRESSION_MAX_RATIO));
+            return max_ratio;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The statistics of all actions using the threshold_binary_filter,
+        // the entries are never removed.
+        class compression_statistics_map
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef std::map<
+                    std::string, boost::shared_ptr<compression_statistics>
+                > statistics_map_type;
+
+        public:
+            compression_statistics& get(std::string const& action_name)
+            {
+                mutex_type::scoped_lock l(mtx_);
+                statistics_map_type::iterator it = statistics_.find(action_name);
+                if (it == statistics_.end())
+                {
+                    it = statistics_.insert(statistics_map_type::value_type(
+                        action_name, boost::shared_ptr<compression_statistics>(
+                            new compression_statistics()))).first;
+                }
+                return *it->second;
+            }
+
+            // the statistics accumulated over all actions
+            compression_statistics& total()
+            {
+                return total_;
+            }
+
+        private:
+            mutex_type mtx_;
+            statistics_map_type statistics_;
+            compression_statistics total_;
+        };
+
+        struct compression_statistics_map_tag {};
+
+        compression_statistics_map& get_compression_statistics_map()
+        {
+            util::static_<
+                compression_statistics_map, compression_statistics_map_tag
+            > statistics;
+            return statistics.get();
+        }
+
+        // account for a message in the statistics of its action and in the
+        // overall statistics
+        void add_compression_data(compression_statistics* stats,
+            std::size_t raw_bytes, std::size_t sent_bytes, boost::int64_t time,
+            bool compressed)
+        {
+            if (stats)
+                stats->add_data(raw_bytes, sent_bytes, time, compressed);
+
+            get_compression_statistics_map().total().add_data(
+                raw_bytes, sent_bytes, time, compressed);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The name of the action is specified as the counter parameter, the
+        // counter refers to all actions if no parameter is given.
+        naming::gid_type compression_counter_creator(
+            performance_counters::counter_info const& info,
+            boost::int64_t (compression_statistics::*f)(bool), error_code& ec)
+        {
+            performance_counters::counter_path_elements paths;
+            performance_counters::get_counter_path_elements(
+                info.fullname_, paths, ec);
+            if (ec) return naming::invalid_gid;
+
+            compression_statistics_map& m = get_compression_statistics_map();
+            compression_statistics& s = paths.parameters_.empty() ?
+                m.total() : m.get(paths.parameters_);
+
+            return performance_counters::locality_raw_counter_creator(
+                info, boost::bind(f, &s, ::_1), ec);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void compression_statistics::add_data(std::size_t raw_bytes,
+        std::size_t sent_bytes, boost::int64_t time, bool compressed)
+    {
+        raw_bytes_ += static_cast<boost::int64_t>(raw_bytes);
+        sent_bytes_ += static_cast<boost::int64_t>(sent_bytes);
+        time_ += time;
+        if (compressed)
+            ++compressed_;
+        else
+            ++uncompressed_;
+    }
+
+    boost::int64_t compression_statistics::get_compression_ratio(bool reset)
+    {
+        boost::int64_t raw_bytes = util::get_and_reset_value(raw_bytes_, reset);
+        boost::int64_t sent_bytes = util::get_and_reset_value(sent_bytes_, reset);
+        return sent_bytes ? (raw_bytes * 100) / sent_bytes : 0;
+    }
+
+    boost::int64_t compression_statistics::get_compression_time(bool reset)
+    {
+        return util::get_and_reset_value(time_, reset);
+    }
+
+    boost::int64_t compression_statistics::get_compressed_count(bool reset)
+    {
+        return util::get_and_reset_value(compressed_, reset);
+    }
+
+    boost::int64_t compression_statistics::get_uncompressed_count(bool reset)
+    {
+        return util::get_and_reset_value(uncompressed_, reset);
+    }
+
+    compression_statistics& get_compression_statistics(
+        std::string const& action_name)
+    {
+        return detail::get_compression_statistics_map().get(action_name);
+    }
+
+    void register_compression_counter_types()
+    {
+        performance_counters::generic_counter_type_data const counter_types[] =
+        {
+            { "/compression/ratio",
+              performance_counters::counter_raw,
+              "returns the size of the data serialized for the actions using "
+                  "threshold compression in percent of the size of the data "
+                  "actually sent (the action name can be specified as the "
+                  "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&detail::compression_counter_creator, _1,
+                  &compression_statistics::get_compression_ratio, _2),
+              &performance_counters::locality_counter_discoverer,
+              "%"
+            },
+            { "/compression/time/compress",
+              performance_counters::counter_raw,
+              "returns the overall time spent compressing the data of the "
+                  "actions using threshold compression (the action name can "
+                  "be specified as the counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&detail::compression_counter_creator, _1,
+                  &compression_statistics::get_compression_time, _2),
+              &performance_counters::locality_counter_discoverer,
+              "ns"
+            },
+            { "/compression/count/compressed",
+              performance_counters::counter_raw,
+              "returns the number of messages of the actions using threshold "
+                  "compression which were sent compressed (the action name "
+                  "can be specified as the counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&detail::compression_counter_creator, _1,
+                  &compression_statistics::get_compressed_count, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/compression/count/uncompressed",
+              performance_counters::counter_raw,
+              "returns the number of messages of the actions using threshold "
+                  "compression which were sent uncompressed (the action name "
+                  "can be specified as the counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              boost::bind(&detail::compression_counter_creator, _1,
+                  &compression_statistics::get_uncompressed_count, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    threshold_binary_filter::threshold_binary_filter(binary_filter* next_filter,
+            compression_statistics* stats, std::size_t threshold,
+            std::size_t max_ratio)
+      : next_filter_(next_filter), stats_(stats),
+        threshold_(threshold == std::size_t(-1) ?
+            detail::get_compression_threshold() : threshold),
+        max_ratio_(max_ratio == std::size_t(-1) ?
+            detail::get_compression_max_ratio() : max_ratio),
+        prepared_(false), mode_(data_uncompressed), data_(0), size_(0),
+        current_(0)
+    {}
+
+    threshold_binary_filter::~threshold_binary_filter()
+    {
+        hpx::actions::detail::guid_initialization<threshold_binary_filter>();
+    }
+
+    void threshold_binary_filter::register_base()
+    {
+        util::void_cast_register_nonvirt<
+            threshold_binary_filter, util::binary_filter>();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void threshold_binary_filter::set_max_length(std::size_t size)
+    {
+        buffer_.reserve(size);
+    }
+
+    void threshold_binary_filter::save(void const* src, std::size_t src_count)
+    {
+        char const* src_begin = static_cast<char const*>(src);
+        buffer_.insert(buffer_.end(), src_begin, src_begin+src_count);
+    }
+
+    // Compress the collected data using the wrapped filter, but only if
+    // there is enough data. The compressed data is dropped again if it is not
+    // sufficiently smaller than the original data.
+    void threshold_binary_filter::compress_data()
+    {
+        mode_ = data_uncompressed;
+        if (!next_filter_ || buffer_.size() < threshold_ || buffer_.empty())
+        {
+            detail::add_compression_data(stats_, buffer_.size(),
+                buffer_.size(), 0, false);
+            return;
+        }
+
+        boost::uint64_t start = util::high_resolution_clock::now();
+
+        next_filter_->set_max_length(buffer_.size());
+        next_filter_->save(buffer_.data(), buffer_.size());
+
+        // most filters need slightly more space than the original data in
+        // the worst case
+        compressed_.resize(buffer_.size() + buffer_.size() / 8 + 64);
+
+        std::size_t current = 0;
+        std::size_t written = 0;
+        do {
+            bool flushed = next_filter_->flush(&compressed_[current],
+                compressed_.size()-current, written);
+
+            current += written;
+            if (flushed)
+                break;
+
+            compressed_.resize(compressed_.size()*2);
+
+        } while (true);
+
+        compressed_.resize(current);
+
+        if (current * 100 <= buffer_.size() * max_ratio_)
+            mode_ = data_compressed;
+        else
+            compressed_.clear();
+
+        detail::add_compression_data(stats_, buffer_.size(),
+            mode_ == data_compressed ? current : buffer_.size(),
+            boost::int64_t(util::high_resolution_clock::now() - start),
+            mode_ == data_compressed);
+    }
+
+    bool threshold_binary_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        if (!prepared_)
+        {
+            compress_data();
+            prepared_ = true;
+        }
+
+        std::vector<char> const& data =
+            (mode_ == data_compressed) ? compressed_ : buffer_;
+
+        // the data is written in one go, including the leading byte
+        // describing it
+        if (data.size() + 1 > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        char* dst_begin = static_cast<char*>(dst);
+        *dst_begin = static_cast<char>(mode_);
+        if (!data.empty())
+            std::memcpy(dst_begin + 1, data.data(), data.size());
+
+        written = data.size() + 1;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t threshold_binary_filter::init_data(char const* buffer,
+        std::size_t size, std::size_t buffer_size)
+    {
+        if (size == 0)
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is too short"));
+            return 0;
+        }
+
+        mode_ = static_cast<data_mode>(*buffer);
+        if (mode_ == data_compressed && next_filter_)
+            return next_filter_->init_data(buffer + 1, size - 1, buffer_size);
+
+        if (mode_ != data_uncompressed)
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is corrupted"));
+            return 0;
+        }
+
+        // the uncompressed data is read directly from the buffer, which is
+        // kept alive by the archive as long as this filter is in use
+        data_ = buffer + 1;
+        size_ = size - 1;
+        current_ = 0;
+        return size_;
+    }
+
+    void threshold_binary_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (mode_ == data_compressed)
+        {
+            next_filter_->load(dst, dst_count);
+            return;
+        }
+
+        if (current_+dst_count > size_)
+        {
+            BOOST_THROW_EXCEPTION(
+                boost::archive::archive_exception(
+                    boost::archive::archive_exception::input_stream_error,
+                    "archive data bstream is too short"));
+            return;
+        }
+
+        std::memcpy(dst, data_ + current_, dst_count);
+        current_ += dst_count;
+    }
+}}
@@ -120,6 +120,11 @@ namespace hpx
 #else
         strm << "  HPX_HAVE_COMPRESSION_BZIP2=OFF\n";
 #endif
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+        strm << "  HPX_HAVE_COMPRESSION_LZ4=ON\n";
+#else
+        strm << "  HPX_HAVE_COMPRESSION_LZ4=OFF\n";
+#endif
 #if defined(HPX_HAVE_COMPRESSION_SNAPPY)
         strm << "  HPX_HAVE_COMPRESSION_SNAPPY=ON\n";
 #else
@@ -140,6 +145,11 @@ namespace hpx
 #else
         strm << "  HPX_HAVE_PARCELPORT_IPC=OFF\n";
 #endif
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+        strm << "  HPX_HAVE_PARCELPORT_SHMEM=ON\n";
+#else
+        strm << "  HPX_HAVE_PARCELPORT_SHMEM=OFF\n";
+#endif
 #if defined(HPX_HAVE_PARCELPORT_IBVERBS)
         strm << "  HPX_HAVE_PARCELPORT_IBVERBS=ON\n";
 #else
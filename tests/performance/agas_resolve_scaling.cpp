@@ -0,0 +1,160 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of the AGAS primary namespace
+// while all localities concurrently resolve global ids of objects living on
+// all other localities. Every request is answered by the primary namespace
+// instance owning the id, which bypasses the local address cache.
+//
+// Run it with an increasing number of localities to see how the resolve
+// throughput scales, for instance by starting several processes on the
+// same node:
+//
+//     agas_resolve_scaling --hpx:localities=4 --hpx:node=0 &
+//     agas_resolve_scaling --hpx:localities=4 --hpx:node=1 &
+//     agas_resolve_scaling --hpx:localities=4 --hpx:node=2 &
+//     agas_resolve_scaling --hpx:localities=4 --hpx:node=3
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/serialization/vector.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::naming::id_type;
+using hpx::unique_future;
+using hpx::util::high_resolution_timer;
+
+///////////////////////////////////////////////////////////////////////////////
+struct null_server
+  : hpx::components::managed_component_base<null_server>
+{};
+
+typedef hpx::components::managed_component<null_server> server_type;
+HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(server_type, null_server);
+
+///////////////////////////////////////////////////////////////////////////////
+// Resolve the given ids over and over again, returns the elapsed time.
+double resolve_ids(std::vector<id_type> const& ids, boost::uint64_t count)
+{
+    std::vector<unique_future<id_type> > futures;
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+    {
+        // get_colocation_id always asks the owning primary namespace
+        futures.push_back(hpx::get_colocation_id(ids[i % ids.size()]));
+    }
+
+    hpx::wait_all(futures);
+
+    // stop the clock
+    return walltime.elapsed();
+}
+
+HPX_PLAIN_ACTION(resolve_ids, resolve_ids_action)
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        boost::uint64_t const count = vm["requests"].as<boost::uint64_t>();
+        std::size_t const objects = vm["objects"].as<std::size_t>();
+        bool const csv = vm.count("csv") != 0;
+
+        if (HPX_UNLIKELY(0 == count))
+            throw std::logic_error("error: count of 0 requests specified\n");
+        if (HPX_UNLIKELY(0 == objects))
+            throw std::logic_error("error: count of 0 objects specified\n");
+
+        std::vector<id_type> localities = hpx::find_all_localities();
+
+        // create the objects on all localities, interleaved such that
+        // consecutive requests go to different primary namespace instances
+        std::vector<unique_future<id_type> > created;
+        created.reserve(objects * localities.size());
+        for (std::size_t i = 0; i != objects; ++i)
+        {
+            for (std::size_t j = 0; j != localities.size(); ++j)
+                created.push_back(hpx::components::new_<null_server>(localities[j]));
+        }
+
+        std::vector<id_type> ids;
+        ids.reserve(created.size());
+        for (std::size_t i = 0; i != created.size(); ++i)
+            ids.push_back(created[i].get());
+
+        // run the requests on all localities concurrently
+        std::vector<unique_future<double> > futures;
+        futures.reserve(localities.size());
+        for (std::size_t j = 0; j != localities.size(); ++j)
+        {
+            futures.push_back(
+                hpx::async<resolve_ids_action>(localities[j], ids, count));
+        }
+
+        double duration = 0.;
+        for (std::size_t j = 0; j != futures.size(); ++j)
+            duration = (std::max)(duration, futures[j].get());
+
+        boost::uint64_t const total = count * localities.size();
+        if (csv)
+        {
+            hpx::cout
+                << (boost::format("%1%,%2%,%3%,%4%\n")
+                    % localities.size() % total % duration % (total / duration))
+                << hpx::flush;
+        }
+        else
+        {
+            hpx::cout
+                << (boost::format("localities: %1%, resolved %2% ids in %3% "
+                        "seconds (%4% resolves per second)\n")
+                    % localities.size() % total % duration % (total / duration))
+                << hpx::flush;
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "requests"
+        , value<boost::uint64_t>()->default_value(100000)
+        , "number of resolve requests issued by each locality")
+
+        ( "objects"
+        , value<std::size_t>()->default_value(100)
+        , "number of objects to create on each locality")
+
+        ( "csv"
+        , "output results as csv (format: localities,count,duration,rate)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -6,11 +6,14 @@
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/util/function.hpp>
+#include <hpx/util/unique_function.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 
 #include "worker_timed.hpp"
 
+#include <cstdlib>
 #include <functional>
+#include <new>
 
 #include <boost/function.hpp>
 #include <boost/program_options.hpp>
@@ -25,6 +28,24 @@ using boost::program_options::notify;
 boost::uint64_t iterations = 500000;
 boost::uint64_t delay = 5;
 
+///////////////////////////////////////////////////////////////////////////////
+// count the heap allocations done while wrapping the function objects
+boost::uint64_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (0 == p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    std::free(p);
+}
+
 struct foo
 {
     void operator()() const
@@ -35,6 +56,25 @@ struct foo
     template <typename Archive> void serialize(Archive&, unsigned int) {}
 };
 
+// has the size of the function objects created by a typical async: a bound
+// action (or function) with a couple of arguments
+struct bound_foo
+{
+    bound_foo()
+    {
+        args[0] = args[1] = args[2] = 0;
+    }
+
+    void operator()() const
+    {
+        worker_timed(delay);
+    }
+
+    template <typename Archive> void serialize(Archive&, unsigned int) {}
+
+    boost::uint64_t args[3];
+};
+
 template <typename F>
 void run(F const & f, boost::uint64_t local_iterations)
 {
@@ -49,6 +89,27 @@ void run(F const & f, boost::uint64_t local_iterations)
               << ((elapsed/i)*1e9) << " ns\n";
 }
 
+// wrap (and invoke) a new function object on each iteration, this is what
+// happens for every task created
+template <typename F, typename Functor>
+void run_wrapped(Functor const & fo, boost::uint64_t local_iterations)
+{
+    boost::uint64_t i = 0;
+    boost::uint64_t const start_allocations = allocations;
+    hpx::util::high_resolution_timer t;
+
+    for (; i < local_iterations; ++i)
+    {
+        F f(fo);
+        f();
+    }
+
+    double elapsed = t.elapsed();
+    std::cout << " walltime/iteration: "
+              << ((elapsed/i)*1e9) << " ns, allocations/iteration: "
+              << (double(allocations - start_allocations)/i) << "\n";
+}
+
 int app_main(
     variables_map& vm
     )
@@ -79,6 +140,35 @@ int app_main(
         run(f, iterations);
     }
 
+    {
+        std::cout << "\nwrapping a bound function object ("
+                  << sizeof(bound_foo) << " bytes)\n";
+
+        bound_foo f;
+        std::cout << "baseline";
+        run(f, iterations);
+    }
+    {
+        std::cout << "hpx::util::unique_function";
+        run_wrapped<hpx::util::unique_function<void()> >(bound_foo(), iterations);
+    }
+    {
+        std::cout << "hpx::util::function (non-serializable)";
+        run_wrapped<hpx::util::function<void(), void, void> >(bound_foo(), iterations);
+    }
+    {
+        std::cout << "hpx::util::function (serializable)";
+        run_wrapped<hpx::util::function<void()> >(bound_foo(), iterations);
+    }
+    {
+        std::cout << "boost::function";
+        run_wrapped<boost::function<void()> >(bound_foo(), iterations);
+    }
+    {
+        std::cout << "std::function";
+        run_wrapped<std::function<void()> >(bound_foo(), iterations);
+    }
+
     return 0;
 }
 
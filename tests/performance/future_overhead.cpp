@@ -13,6 +13,7 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/local/promise.hpp>
 
 #include <stdexcept>
 
@@ -122,6 +123,52 @@ void measure_function_futures(boost::uint64_t count, bool csv)
               << flush;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+double increment(unique_future<double> f)
+{
+    return f.get() + 1.;
+}
+
+// Attach a chain of continuations to a future and measure the time it takes
+// to run all of them once the first future becomes ready.
+void measure_continuation_chain(char const* name,
+    BOOST_SCOPED_ENUM(hpx::launch) policy, boost::uint64_t length, bool csv)
+{
+    hpx::lcos::local::promise<double> p;
+    unique_future<double> f = p.get_future();
+
+    for (boost::uint64_t i = 0; i < length; ++i)
+        f = f.then(policy, &increment);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    p.set_value(0.);
+    double const result = f.get();
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (HPX_UNLIKELY(result != double(length)))
+        throw std::logic_error("error: continuation chain computed a wrong result\n");
+
+    global_scratch += result;
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%,%3%\n")
+                % name
+                % length
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("executed a chain of %1% continuations "
+                    "(%2%) in %3% seconds\n")
+                % length
+                % name
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -137,6 +184,17 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+
+        const boost::uint64_t length = vm["chain-length"].as<boost::uint64_t>();
+        if (0 != length)
+        {
+            measure_continuation_chain("launch::sync", hpx::launch::sync,
+                length, vm.count("csv") != 0);
+            measure_continuation_chain("launch::all", hpx::launch::all,
+                length, vm.count("csv") != 0);
+            measure_continuation_chain("launch::async", hpx::launch::async,
+                length, vm.count("csv") != 0);
+        }
     }
 
     finalize();
@@ -161,8 +219,14 @@ int main(
         , value<boost::uint64_t>()->default_value(0)
         , "number of iterations in the delay loop")
 
+        ( "chain-length"
+        , value<boost::uint64_t>()->default_value(10000)
+        , "number of continuations chained to a single future "
+          "(0: skip the continuation benchmarks)")
+
         ( "csv"
-        , "output results as csv (format: count,duration)")
+        , "output results as csv (format: count,duration and "
+          "policy,chain length,duration for the continuation chains)")
         ;
 
     // Initialize and run HPX.
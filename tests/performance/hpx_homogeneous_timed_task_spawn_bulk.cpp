@@ -0,0 +1,172 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This variant of the homogeneous timed task spawn benchmark measures the
+// rate at which HPX-threads can be spawned from a single thread. It compares
+// creating all tasks at once (threads::register_work_bulk) with creating them
+// one by one (threads::register_work_nullary).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/local/event.hpp>
+
+#include "worker_timed.hpp"
+
+#include <stdexcept>
+
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::init;
+using hpx::finalize;
+using hpx::get_os_thread_count;
+
+using hpx::threads::register_work_bulk;
+using hpx::threads::register_work_nullary;
+
+using hpx::util::high_resolution_timer;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+// Command-line variables.
+boost::uint64_t tasks = 10000000;
+boost::uint64_t delay = 0;
+bool header = true;
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<boost::uint64_t> outstanding_tasks(0);
+hpx::lcos::local::event all_done;
+
+void invoke_worker_timed()
+{
+    worker_timed(delay);
+
+    if (--outstanding_tasks == 0)
+        all_done.set();
+}
+
+void invoke_worker_timed_indexed(std::size_t)
+{
+    invoke_worker_timed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void print_results(
+    char const* mode
+  , boost::uint64_t cores
+  , double spawn_time
+  , double walltime
+    )
+{
+    if (header)
+    {
+        cout << "Mode,OS-threads,Tasks,Delay (iterations),"
+                "Spawn Walltime (seconds),Spawn Rate (tasks/second),"
+                "Total Walltime (seconds)\n"
+             << flush;
+        header = false;
+    }
+
+    std::string const mode_str = boost::str(boost::format("%s,") % mode);
+    std::string const cores_str = boost::str(boost::format("%lu,") % cores);
+    std::string const tasks_str = boost::str(boost::format("%lu,") % tasks);
+    std::string const delay_str = boost::str(boost::format("%lu,") % delay);
+
+    cout << ( boost::format("%-21s %-21s %-21s %-21s %10.12s, %10.12s, %10.12s\n")
+            % mode_str % cores_str % tasks_str % delay_str
+            % spawn_time % (tasks / spawn_time) % walltime) << flush;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void measure_bulk(boost::uint64_t cores)
+{
+    outstanding_tasks.store(tasks);
+    all_done.reset();
+
+    high_resolution_timer t;
+
+    register_work_bulk(tasks, &invoke_worker_timed_indexed,
+        "invoke_worker_timed");
+
+    double spawn_time = t.elapsed();
+
+    all_done.wait();
+    print_results("bulk", cores, spawn_time, t.elapsed());
+}
+
+void measure_single(boost::uint64_t cores)
+{
+    outstanding_tasks.store(tasks);
+    all_done.reset();
+
+    high_resolution_timer t;
+
+    for (boost::uint64_t i = 0; i < tasks; ++i)
+        register_work_nullary(&invoke_worker_timed, "invoke_worker_timed");
+
+    double spawn_time = t.elapsed();
+
+    all_done.wait();
+    print_results("single", cores, spawn_time, t.elapsed());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    if (vm.count("no-header"))
+        header = false;
+
+    if (0 == tasks)
+        throw std::invalid_argument("count of 0 tasks specified\n");
+
+    boost::uint64_t const os_thread_count = get_os_thread_count();
+
+    measure_bulk(os_thread_count);
+
+    if (!vm.count("no-baseline"))
+        measure_single(os_thread_count);
+
+    return finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "tasks"
+        , value<boost::uint64_t>(&tasks)->default_value(10000000)
+        , "number of tasks to invoke")
+
+        ( "delay"
+        , value<boost::uint64_t>(&delay)->default_value(0)
+        , "number of iterations in the delay loop")
+
+        ( "no-baseline"
+        , "do not measure spawning the tasks one by one")
+
+        ( "no-header"
+        , "do not print out the csv header row")
+        ;
+
+    // Initialize and run HPX.
+    return init(cmdline, argc, argv);
+}
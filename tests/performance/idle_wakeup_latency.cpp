@@ -0,0 +1,134 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time it takes for an idle worker thread to pick
+// up new work. Run it with the different idle policies to compare them, e.g.:
+//
+//   idle_wakeup_latency -t2 -Ihpx.idle.policy=spin
+//   idle_wakeup_latency -t2 -Ihpx.idle.policy=park
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_clock;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+void record_wakeup(hpx::lcos::local::promise<boost::uint64_t>* p)
+{
+    p->set_value(high_resolution_clock::now());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        boost::uint64_t const iterations = vm["iterations"].as<boost::uint64_t>();
+        boost::uint64_t const delay = vm["delay"].as<boost::uint64_t>();
+        std::size_t const num_threads = hpx::get_os_thread_count();
+
+        if (HPX_UNLIKELY(0 == iterations))
+            throw std::logic_error("error: count of 0 iterations specified\n");
+
+        if (HPX_UNLIKELY(num_threads < 2))
+            throw std::logic_error("error: this benchmark needs at least "
+                "two worker threads\n");
+
+        std::vector<double> latencies;
+        latencies.reserve(iterations);
+
+        for (boost::uint64_t i = 0; i < iterations; ++i)
+        {
+            // let all other worker threads become idle
+            hpx::this_thread::suspend(boost::posix_time::milliseconds(delay));
+
+            // schedule the work on a worker thread different from ours
+            std::size_t target = (hpx::get_worker_thread_num() + 1) % num_threads;
+
+            hpx::lcos::local::promise<boost::uint64_t> p;
+            hpx::unique_future<boost::uint64_t> f = p.get_future();
+
+            boost::uint64_t start = high_resolution_clock::now();
+            hpx::threads::register_work_nullary(
+                hpx::util::bind(&record_wakeup, &p), "record_wakeup",
+                hpx::threads::pending, hpx::threads::thread_priority_normal,
+                target);
+
+            latencies.push_back(double(f.get() - start) / 1e3);   // [us]
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        double const mean =
+            std::accumulate(latencies.begin(), latencies.end(), 0.) /
+                latencies.size();
+        double const median = latencies[latencies.size() / 2];
+        double const p99 = latencies[(latencies.size() * 99) / 100];
+
+        if (vm.count("csv"))
+            cout << ( boost::format("%1%,%2%,%3%,%4%,%5%\n")
+                    % iterations
+                    % delay
+                    % mean
+                    % median
+                    % p99)
+                  << flush;
+        else
+            cout << ( boost::format("wake-up latency after %1% ms idle "
+                        "(%2% samples): mean %3% us, median %4% us, "
+                        "99th percentile %5% us\n")
+                    % delay
+                    % iterations
+                    % mean
+                    % median
+                    % p99)
+                  << flush;
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "iterations"
+        , value<boost::uint64_t>()->default_value(1000)
+        , "number of wake-ups to measure")
+
+        ( "delay"
+        , value<boost::uint64_t>()->default_value(10)
+        , "time to stay idle before each wake-up [ms]")
+
+        ( "csv"
+        , "output results as csv "
+          "(format: iterations,delay,mean,median,99th percentile)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,224 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the overhead of invoking an action on a target
+// living on the same locality with the overhead of asynchronously invoking
+// a plain function.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::naming::id_type;
+using hpx::unique_future;
+using hpx::util::high_resolution_timer;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the delay from being optimized away
+double global_scratch = 0;
+boost::uint64_t num_iterations = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+double null_function()
+{
+    double d = 0.;
+    for (boost::uint64_t i = 0; i < num_iterations; ++i)
+        d += 1. / (2. * i + 1.);
+    return d;
+}
+
+HPX_PLAIN_ACTION(null_function, null_action)
+
+///////////////////////////////////////////////////////////////////////////////
+struct null_server
+  : hpx::components::managed_component_base<null_server>
+{
+    double call() const
+    {
+        return null_function();
+    }
+
+    HPX_DEFINE_COMPONENT_CONST_ACTION(null_server, call);
+};
+
+typedef hpx::components::managed_component<null_server> server_type;
+HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(server_type, null_server);
+
+typedef null_server::call_action call_action;
+HPX_REGISTER_ACTION_DECLARATION(call_action);
+HPX_REGISTER_ACTION(call_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void print_result(char const* name, boost::uint64_t count, double duration,
+    bool csv)
+{
+    if (csv)
+    {
+        hpx::cout
+            << (boost::format("%1%,%2%,%3%,%4%\n")
+                % name % count % duration % (duration * 1e9 / count))
+            << hpx::flush;
+    }
+    else
+    {
+        hpx::cout
+            << (boost::format("%1%: invoked %2% futures in %3% seconds "
+                    "(%4% ns per future)\n")
+                % name % count % duration % (duration * 1e9 / count))
+            << hpx::flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// create all futures first and wait for all of them afterwards
+template <typename F>
+double measure_throughput(boost::uint64_t count, F const& f)
+{
+    std::vector<unique_future<double> > futures;
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+        futures.push_back(f());
+
+    hpx::wait_all(futures);
+
+    // stop the clock
+    double const duration = walltime.elapsed();
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+        global_scratch += futures[i].get();
+
+    return duration;
+}
+
+// wait for each of the futures before creating the next one
+template <typename F>
+double measure_latency(boost::uint64_t count, F const& f)
+{
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+        global_scratch += f().get();
+
+    // stop the clock
+    return walltime.elapsed();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct invoke_function
+{
+    typedef unique_future<double> result_type;
+
+    result_type operator()() const
+    {
+        return hpx::async(&null_function);
+    }
+};
+
+struct invoke_plain_action
+{
+    typedef unique_future<double> result_type;
+
+    invoke_plain_action(id_type const& id) : id_(id) {}
+
+    result_type operator()() const
+    {
+        return hpx::async<null_action>(id_);
+    }
+
+    id_type id_;
+};
+
+struct invoke_component_action
+{
+    typedef unique_future<double> result_type;
+
+    invoke_component_action(id_type const& id) : id_(id) {}
+
+    result_type operator()() const
+    {
+        return hpx::async<call_action>(id_);
+    }
+
+    id_type id_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        num_iterations = vm["delay-iterations"].as<boost::uint64_t>();
+
+        boost::uint64_t const count = vm["futures"].as<boost::uint64_t>();
+        bool const csv = vm.count("csv") != 0;
+
+        if (HPX_UNLIKELY(0 == count))
+            throw std::logic_error("error: count of 0 futures specified\n");
+
+        id_type const here = hpx::find_here();
+        id_type const component =
+            hpx::components::new_<null_server>(here).get();
+
+        invoke_function f;
+        invoke_plain_action pa(here);
+        invoke_component_action ca(component);
+
+        print_result("throughput async(f)", count,
+            measure_throughput(count, f), csv);
+        print_result("throughput async(plain_action, here)", count,
+            measure_throughput(count, pa), csv);
+        print_result("throughput async(component_action, id)", count,
+            measure_throughput(count, ca), csv);
+
+        print_result("latency async(f)", count,
+            measure_latency(count, f), csv);
+        print_result("latency async(plain_action, here)", count,
+            measure_latency(count, pa), csv);
+        print_result("latency async(component_action, id)", count,
+            measure_latency(count, ca), csv);
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "futures"
+        , value<boost::uint64_t>()->default_value(100000)
+        , "number of futures to invoke for each of the benchmarks")
+
+        ( "delay-iterations"
+        , value<boost::uint64_t>()->default_value(0)
+        , "number of iterations in the delay loop")
+
+        ( "csv"
+        , "output results as csv (format: name,count,duration,ns per future)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -6,10 +6,12 @@
 #include <hpx/hpx_init.hpp>
 #include <hpx/include/actions.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/polymorphic_factory.hpp>
 #include <hpx/util/serialize_buffer.hpp>
 
 #include <hpx/include/iostreams.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/format.hpp>
 
 // This function will never be called
@@ -19,7 +21,47 @@ int test_function(hpx::util::serialize_buffer<double> const& b)
 }
 HPX_PLAIN_ACTION(test_function, test_action)
 
+// size of the serialized parcel (as measured by the last iteration)
+boost::atomic<std::size_t> parcel_size(0);
+
 ///////////////////////////////////////////////////////////////////////////////
+hpx::parcelset::parcel roundtrip(hpx::parcelset::parcel const& outp,
+    std::vector<hpx::util::serialization_chunk>* chunks,
+    int in_archive_flags, int out_archive_flags)
+{
+    boost::uint32_t dest_locality_id = outp.get_destination_locality_id();
+
+    std::size_t arg_size = hpx::traits::get_type_size(outp);
+    std::vector<char> out_buffer;
+
+    out_buffer.resize(arg_size + HPX_PARCEL_SERIALIZATION_OVERHEAD);
+
+    {
+        // create an output archive and serialize the parcel
+        hpx::util::portable_binary_oarchive archive(
+            out_buffer, chunks, dest_locality_id, 0, out_archive_flags);
+        archive << outp;
+
+        arg_size = archive.bytes_written();
+    }
+
+    hpx::parcelset::parcel inp;
+
+    {
+        // create an input archive and deserialize the parcel
+        hpx::util::portable_binary_iarchive archive(
+            out_buffer, chunks, arg_size, in_archive_flags);
+
+        archive >> inp;
+    }
+
+    if (chunks)
+        chunks->clear();
+
+    parcel_size.store(arg_size);
+    return inp;
+}
+
 double benchmark_serialization(std::size_t data_size, std::size_t iterations,
     bool continuation, bool zerocopy)
 {
@@ -98,38 +140,14 @@ double benchmark_serialization(std::size_t data_size, std::size_t iterations,
     if (zerocopy)
         chunks = new std::vector<hpx::util::serialization_chunk>();
 
-    boost::uint32_t dest_locality_id = outp.get_destination_locality_id();
+    // The first parcel received from a locality having the action id tables
+    // enables sending action ids to it (here: to ourselves).
+    roundtrip(outp, chunks, in_archive_flags, out_archive_flags);
+
     hpx::util::high_resolution_timer t;
 
     for (std::size_t i = 0; i != iterations; ++i)
-    {
-        std::size_t arg_size = hpx::traits::get_type_size(outp);
-        std::vector<char> out_buffer;
-
-        out_buffer.resize(arg_size + HPX_PARCEL_SERIALIZATION_OVERHEAD);
-
-        {
-            // create an output archive and serialize the parcel
-            hpx::util::portable_binary_oarchive archive(
-                out_buffer, chunks, dest_locality_id, 0, out_archive_flags);
-            archive << outp;
-
-            arg_size = archive.bytes_written();
-        }
-
-        hpx::parcelset::parcel inp;
-
-        {
-            // create an input archive and deserialize the parcel
-            hpx::util::portable_binary_iarchive archive(
-                out_buffer, chunks, arg_size, in_archive_flags);
-
-            archive >> inp;
-        }
-
-        if (chunks)
-            chunks->clear();
-    }
+        roundtrip(outp, chunks, in_archive_flags, out_archive_flags);
 
     return t.elapsed();
 }
@@ -145,6 +163,15 @@ int hpx_main(boost::program_options::variables_map& vm)
     bool continuation = vm.count("continuation") != 0;
     bool zerocopy = vm.count("zerocopy") != 0;
 
+    if (vm.count("action-ids"))
+    {
+        // use numeric ids instead of the action and continuation names
+        hpx::util::polymorphic_factory<
+            hpx::actions::base_action>::assign_ids();
+        hpx::util::polymorphic_factory<
+            hpx::actions::continuation>::assign_ids();
+    }
+
     std::vector<hpx::unique_future<double> > timings;
     for (std::size_t i = 0; i != concurrency; ++i)
     {
@@ -158,10 +185,12 @@ int hpx_main(boost::program_options::variables_map& vm)
         overall_time += timings[i].get();
 
     if (print_header)
-        hpx::cout << "datasize,testcount,time/test[ns]\n" << hpx::flush;
+        hpx::cout << "datasize,testcount,time/test[ns],parcelsize[bytes]\n"
+                  << hpx::flush;
 
-    hpx::cout << (boost::format("%d,%d,%f\n") %
-        data_size % iterations % (overall_time / concurrency)) << hpx::flush;
+    hpx::cout << (boost::format("%d,%d,%f,%d\n") %
+        data_size % iterations % (overall_time / concurrency) %
+        parcel_size.load()) << hpx::flush;
 
     return hpx::finalize();
 }
@@ -191,6 +220,9 @@ int main(int argc, char* argv[])
         ( "zerocopy"
         , "use zero copy serialization of bitwise copyable arguments")
 
+        ( "action-ids"
+        , "send numeric action ids instead of the action names")
+
         ( "no-header"
         , "do not print out the csv header row")
         ;
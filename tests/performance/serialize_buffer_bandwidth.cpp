@@ -0,0 +1,138 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the bandwidth achieved while sending large
+// util::serialize_buffer arguments to a remote locality (1KB to 64MB by
+// default). Run it on two localities. The difference made by the zero-copy
+// receive path can be seen by disabling the zero-copy optimizations using
+// -Ihpx.parcel.zero_copy_optimization=0.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/serialize_buffer.hpp>
+
+#include <boost/format.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::cout;
+using hpx::flush;
+
+typedef hpx::util::serialize_buffer<char> buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t receive(buffer_type const& buffer)
+{
+    return buffer.size();
+}
+HPX_PLAIN_ACTION(receive, receive_action)
+
+///////////////////////////////////////////////////////////////////////////////
+double measure_bandwidth(hpx::naming::id_type const& dest, char* data,
+    std::size_t size, std::size_t window, std::size_t iterations)
+{
+    buffer_type buffer(data, size, buffer_type::reference);
+
+    std::vector<hpx::unique_future<std::size_t> > futures;
+    futures.reserve(window);
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        for (std::size_t j = 0; j != window; ++j)
+            futures.push_back(hpx::async<receive_action>(dest, buffer));
+
+        hpx::wait_all(futures);
+        futures.clear();
+    }
+
+    // [MB/s]
+    return (double(size) * window * iterations) / (t.elapsed() * 1024 * 1024);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::size_t const min_size = vm["min-size"].as<std::size_t>();
+    std::size_t const max_size = vm["max-size"].as<std::size_t>();
+    std::size_t const window = vm["window"].as<std::size_t>();
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+
+    std::vector<hpx::naming::id_type> localities =
+        hpx::find_remote_localities();
+
+    hpx::naming::id_type dest = hpx::find_here();
+    if (localities.empty())
+    {
+        cout << "warning: no remote locality available, the parcels will "
+                "not be serialized\n" << flush;
+    }
+    else
+    {
+        dest = localities[0];
+    }
+
+    boost::scoped_array<char> data(new char[max_size]);
+    std::fill(data.get(), data.get() + max_size, 'x');
+
+    if (!vm.count("no-header"))
+        cout << "size[bytes],bandwidth[MB/s]\n" << flush;
+
+    for (std::size_t size = min_size; size <= max_size; size *= 2)
+    {
+        // keep the overall amount of data per message size in check
+        std::size_t iter = (std::max)(std::size_t(1),
+            iterations * min_size / size);
+
+        double bandwidth = measure_bandwidth(dest, data.get(), size,
+            window, iter);
+
+        cout << (boost::format("%d,%f\n") % size % bandwidth) << flush;
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "min-size"
+        , value<std::size_t>()->default_value(1024)
+        , "smallest message size to measure [bytes]")
+
+        ( "max-size"
+        , value<std::size_t>()->default_value(64 * 1024 * 1024)
+        , "largest message size to measure [bytes]")
+
+        ( "window"
+        , value<std::size_t>()->default_value(8)
+        , "number of messages in flight concurrently")
+
+        ( "iterations"
+        , value<std::size_t>()->default_value(10000)
+        , "number of iterations for the smallest message size")
+
+        ( "no-header"
+        , "do not print out the csv header row")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,220 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overheads of the timer wheel used by the
+// schedulers for timed thread state changes (timed suspension, futures
+// becoming ready at a given point in time, etc.) compared to the asio
+// deadline_timers used before. It adds a large number of outstanding
+// timeouts, cancels every other one and waits for the remaining ones to
+// expire.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/random.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_clock;
+using hpx::threads::detail::timer_wheel;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+boost::uint64_t fired = 0;
+
+void on_timer()
+{
+    ++fired;
+}
+
+void on_deadline(boost::system::error_code const& ec)
+{
+    if (!ec)
+        ++fired;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct timings
+{
+    double add_;        // [ns] per timer
+    double cancel_;     // [ns] per canceled timer
+    double expire_;     // [s] until all timers have expired
+};
+
+void print_timings(variables_map& vm, char const* name, boost::uint64_t count,
+    boost::uint64_t max_delay, timings const& t)
+{
+    if (vm.count("csv"))
+        cout << ( boost::format("%1%,%2%,%3%,%4%,%5%,%6%\n")
+                % name
+                % count
+                % max_delay
+                % t.add_
+                % t.cancel_
+                % t.expire_)
+              << flush;
+    else
+        cout << ( boost::format("%1%: %2% timers (up to %3% ms): "
+                    "add %4% ns, cancel %5% ns, all expired after %6% s\n")
+                % name
+                % count
+                % max_delay
+                % t.add_
+                % t.cancel_
+                % t.expire_)
+              << flush;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+timings measure_timer_wheel(std::vector<boost::uint64_t> const& delays)
+{
+    timings t;
+    std::size_t const count = delays.size();
+
+    timer_wheel wheel;
+    std::vector<timer_wheel::timer_id> ids;
+    ids.reserve(count);
+
+    fired = 0;
+
+    boost::uint64_t start = high_resolution_clock::now();
+    for (std::size_t i = 0; i != count; ++i)
+        ids.push_back(wheel.add_after(delays[i], &on_timer));
+    t.add_ = double(high_resolution_clock::now() - start) / count;
+
+    start = high_resolution_clock::now();
+    for (std::size_t i = 0; i < count; i += 2)
+        wheel.cancel(ids[i]);
+    t.cancel_ = double(high_resolution_clock::now() - start) / (count / 2);
+
+    ids.clear();
+
+    start = high_resolution_clock::now();
+    while (!wheel.empty())
+        wheel.poll();
+    t.expire_ = double(high_resolution_clock::now() - start) / 1e9;
+
+    if (fired != count / 2)
+        throw std::logic_error("error: unexpected number of fired timers\n");
+
+    return t;
+}
+
+timings measure_deadline_timer(std::vector<boost::uint64_t> const& delays)
+{
+    typedef boost::shared_ptr<boost::asio::deadline_timer> timer_ptr;
+
+    timings t;
+    std::size_t const count = delays.size();
+
+    boost::asio::io_service io_service;
+    std::vector<timer_ptr> timers;
+    timers.reserve(count);
+
+    fired = 0;
+
+    boost::uint64_t start = high_resolution_clock::now();
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        timer_ptr timer(new boost::asio::deadline_timer(io_service,
+            boost::posix_time::microseconds(delays[i] / 1000)));
+        timer->async_wait(&on_deadline);
+        timers.push_back(timer);
+    }
+    t.add_ = double(high_resolution_clock::now() - start) / count;
+
+    start = high_resolution_clock::now();
+    for (std::size_t i = 0; i < count; i += 2)
+        timers[i]->cancel();
+    t.cancel_ = double(high_resolution_clock::now() - start) / (count / 2);
+
+    start = high_resolution_clock::now();
+    io_service.run();
+    t.expire_ = double(high_resolution_clock::now() - start) / 1e9;
+
+    if (fired != count / 2)
+        throw std::logic_error("error: unexpected number of fired timers\n");
+
+    return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        boost::uint64_t const count = vm["timers"].as<boost::uint64_t>();
+        boost::uint64_t const max_delay = vm["max-delay"].as<boost::uint64_t>();
+
+        if (HPX_UNLIKELY(count < 2))
+            throw std::logic_error("error: at least two timers are required\n");
+
+        // all timeouts are spread uniformly over the given interval
+        boost::random::mt19937 gen(vm["seed"].as<boost::uint32_t>());
+        boost::random::uniform_int_distribution<boost::uint64_t>
+            dist(0, max_delay * 1000000);
+
+        std::vector<boost::uint64_t> delays;
+        delays.reserve(count);
+        for (boost::uint64_t i = 0; i != count; ++i)
+            delays.push_back(dist(gen));
+
+        print_timings(vm, "timer_wheel", count, max_delay,
+            measure_timer_wheel(delays));
+
+        if (!vm.count("no-baseline"))
+        {
+            print_timings(vm, "deadline_timer", count, max_delay,
+                measure_deadline_timer(delays));
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "timers"
+        , value<boost::uint64_t>()->default_value(1000000)
+        , "number of outstanding timeouts to create")
+
+        ( "max-delay"
+        , value<boost::uint64_t>()->default_value(1000)
+        , "maximal delay of the created timeouts [ms]")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator")
+
+        ( "no-baseline"
+        , "do not measure the asio deadline_timer baseline")
+
+        ( "csv"
+        , "output results as csv "
+          "(format: name,timers,max delay,add,cancel,expire)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,60 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/runtime/agas/credit_deltas.hpp>
+
+#include <boost/integer_traits.hpp>
+
+#include <vector>
+
+using hpx::naming::gid_type;
+using hpx::agas::credit_deltas;
+
+int main()
+{
+    boost::uint64_t const max_lsb =
+        boost::integer_traits<boost::uint64_t>::const_max;
+
+    credit_deltas deltas;
+    HPX_TEST(deltas.empty());
+
+    deltas.add(gid_type(1, 100), gid_type(1, 100), 1);
+    deltas.add(gid_type(1, 101), gid_type(1, 164), 0x80000000ll);
+    deltas.add(gid_type(5, max_lsb - 1), gid_type(6, 1), 42);   // two msbs
+    deltas.add(gid_type(6, 1000), gid_type(6, 1000), 7);
+
+    HPX_TEST_EQ(deltas.size(), std::size_t(5));
+
+    // closely allocated ids are encoded with a couple of bytes each
+    HPX_TEST(deltas.encoded_size() < 5 * 16);
+
+    std::vector<credit_deltas::entry> entries;
+    deltas.decode(entries);
+    HPX_TEST_EQ(entries.size(), std::size_t(5));
+
+    HPX_TEST_EQ(entries[0].lower_, gid_type(1, 100));
+    HPX_TEST_EQ(entries[0].upper_, gid_type(1, 100));
+    HPX_TEST_EQ(entries[0].credits_, 1);
+
+    HPX_TEST_EQ(entries[1].lower_, gid_type(1, 101));
+    HPX_TEST_EQ(entries[1].upper_, gid_type(1, 164));
+    HPX_TEST_EQ(entries[1].credits_, 0x80000000ll);
+
+    HPX_TEST_EQ(entries[2].lower_, gid_type(5, max_lsb - 1));
+    HPX_TEST_EQ(entries[2].upper_, gid_type(5, max_lsb));
+    HPX_TEST_EQ(entries[2].credits_, 42);
+
+    HPX_TEST_EQ(entries[3].lower_, gid_type(6, 0));
+    HPX_TEST_EQ(entries[3].upper_, gid_type(6, 1));
+    HPX_TEST_EQ(entries[3].credits_, 42);
+
+    HPX_TEST_EQ(entries[4].lower_, gid_type(6, 1000));
+    HPX_TEST_EQ(entries[4].upper_, gid_type(6, 1000));
+    HPX_TEST_EQ(entries[4].credits_, 7);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,162 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+using hpx::naming::gid_type;
+using hpx::naming::locality;
+using hpx::agas::gva;
+using hpx::agas::gva_cache;
+
+///////////////////////////////////////////////////////////////////////////////
+void resolve_and_update(gva_cache& cache, locality const& l, std::size_t seed)
+{
+    gid_type other;
+    boost::uint64_t other_count = 0;
+
+    for (boost::uint64_t i = 0; i != 100000; ++i)
+    {
+        boost::uint64_t const id = (i * 7919 + seed) % 5000;
+
+        gid_type base;
+        gva g;
+        if (cache.get_entry(gid_type(3, id), base, g))
+        {
+            // never see a partially written entry
+            HPX_TEST_EQ(base.get_lsb(), id);
+            HPX_TEST_EQ(g.lva(), id * 16);
+            HPX_TEST(g.endpoint == l);
+        }
+        else
+        {
+            cache.update(gid_type(3, id), 1, gva(l, 1, 1, id * 16),
+                other, other_count);
+        }
+    }
+}
+
+int main()
+{
+    locality const l1("127.0.0.1", 7910);
+    locality const l2("127.0.0.1", 7911);
+
+    gid_type other;
+    boost::uint64_t other_count = 0;
+
+    { // single ids
+        gva_cache cache(16);
+        HPX_TEST_EQ(cache.capacity(), std::size_t(16));
+
+        HPX_TEST(cache.insert(gid_type(1, 100), 1, gva(l1, 7, 1, 1000),
+            other, other_count));
+
+        gid_type base;
+        gva g;
+        HPX_TEST(cache.get_entry(gid_type(1, 100), base, g));
+        HPX_TEST_EQ(base, gid_type(1, 100));
+        HPX_TEST_EQ(g.lva(), 1000ULL);
+        HPX_TEST_EQ(g.type, 7);
+        HPX_TEST(g.endpoint == l1);
+
+        HPX_TEST(!cache.get_entry(gid_type(1, 101), base, g));
+        HPX_TEST(!cache.get_entry(gid_type(2, 100), base, g));
+
+        // insert does not change an existing entry, update does
+        HPX_TEST(cache.insert(gid_type(1, 100), 1, gva(l2, 7, 1, 2000),
+            other, other_count));
+        HPX_TEST(cache.get_entry(gid_type(1, 100), base, g));
+        HPX_TEST_EQ(g.lva(), 1000ULL);
+
+        HPX_TEST(cache.update(gid_type(1, 100), 1, gva(l2, 7, 1, 2000),
+            other, other_count));
+        HPX_TEST(cache.get_entry(gid_type(1, 100), base, g));
+        HPX_TEST_EQ(g.lva(), 2000ULL);
+        HPX_TEST(g.endpoint == l2);
+
+        HPX_TEST_EQ(cache.hits(false), std::size_t(3));
+        HPX_TEST_EQ(cache.misses(false), std::size_t(2));
+
+        cache.clear();
+        HPX_TEST(!cache.get_entry(gid_type(1, 100), base, g));
+    }
+
+    { // ranges spanning several blocks
+        gva_cache cache(64);
+
+        gid_type const lower(2, (1 << gva_cache::block_bits) - 10);
+        HPX_TEST(cache.update(lower, 20, gva(l1, 3, 20, 5000, 8),
+            other, other_count));
+
+        gid_type base;
+        gva g;
+        HPX_TEST(cache.get_entry(lower + 19, base, g));
+        HPX_TEST_EQ(base, lower);
+        HPX_TEST_EQ(g.count, 20ULL);
+        HPX_TEST_EQ(g.lva(lower + 19, base), 5000ULL + 19 * 8);
+        HPX_TEST(!cache.get_entry(lower + 20, base, g));
+
+        // overlapping with a different range is rejected
+        HPX_TEST(!cache.update(lower + 5, 4, gva(l1, 3, 4, 1),
+            other, other_count));
+        HPX_TEST_EQ(other, lower);
+        HPX_TEST_EQ(other_count, 20ULL);
+    }
+
+    { // a rejected range is not stored in any of its blocks
+        gva_cache cache(64);
+
+        boost::uint64_t const block_size = 1ULL << gva_cache::block_bits;
+
+        // cached in the third block only
+        gid_type const upper(4, 2 * block_size + 5);
+        HPX_TEST(cache.update(upper, 10, gva(l1, 3, 10, 1000),
+            other, other_count));
+
+        // covers the second and third block, conflicts in the third one
+        gid_type const lower(4, 2 * block_size - 100);
+        HPX_TEST(!cache.update(lower, 200, gva(l2, 3, 200, 2000),
+            other, other_count));
+        HPX_TEST_EQ(other, upper);
+        HPX_TEST_EQ(other_count, 10ULL);
+
+        gid_type base;
+        gva g;
+        HPX_TEST(!cache.get_entry(lower, base, g));
+        HPX_TEST(!cache.get_entry(lower + 50, base, g));
+
+        HPX_TEST(cache.get_entry(upper + 9, base, g));
+        HPX_TEST_EQ(base, upper);
+        HPX_TEST_EQ(g.lva(), 1000ULL);
+        HPX_TEST(g.endpoint == l1);
+
+        // the same holds for insert
+        HPX_TEST(!cache.insert(lower, 200, gva(l2, 3, 200, 2000),
+            other, other_count));
+        HPX_TEST(!cache.get_entry(lower + 50, base, g));
+    }
+
+    { // concurrent lookups and updates, this evicts entries all the time
+        gva_cache cache(1024);
+
+        boost::thread_group threads;
+        for (std::size_t i = 0; i != 4; ++i)
+        {
+            threads.create_thread(
+                boost::bind(&resolve_and_update, boost::ref(cache), l1, i));
+        }
+        threads.join_all();
+
+        HPX_TEST(cache.evictions(false) != 0);
+        HPX_TEST_EQ(cache.hits(false) + cache.misses(false),
+            std::size_t(4 * 100000));
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,131 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/plain_actions.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::string make_name(char const* base, std::size_t i)
+{
+    return std::string("/test/symbol_names/") + base +
+        boost::lexical_cast<std::string>(i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::id_type unregister_name(std::string const& name)
+{
+    return hpx::agas::unregister_name_sync(name);
+}
+HPX_PLAIN_ACTION(unregister_name, unregister_name_action);
+
+// The symbol namespace instance owning the name pushes the invalidation
+// asynchronously, give it some time to arrive. resolve_name answers from the
+// symbol cache as long as the name was not invalidated.
+bool wait_for_invalidation(std::string const& name)
+{
+    for (int i = 0; i != 1000; ++i)
+    {
+        if (!hpx::agas::resolve_name(name).get())
+            return true;
+        hpx::this_thread::sleep_for(boost::posix_time::milliseconds(10));
+    }
+    return false;
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // wait for names which are registered later on
+    std::vector<hpx::unique_future<hpx::id_type> > registered;
+    for (std::size_t i = 0; i != localities.size(); ++i)
+        registered.push_back(hpx::agas::when_registered(make_name("late", i)));
+
+    // names are distributed over the symbol namespace instances of all
+    // localities, resolve them with a single call
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        names.push_back(make_name("name", i));
+        HPX_TEST(hpx::agas::register_name_sync(names.back(), localities[i]));
+    }
+    names.push_back(make_name("unknown", 0));
+
+    for (int pass = 0; pass != 2; ++pass)   // the second pass hits the cache
+    {
+        std::vector<hpx::id_type> ids = hpx::agas::resolve_names(names).get();
+        HPX_TEST_EQ(ids.size(), names.size());
+
+        for (std::size_t i = 0; i != localities.size(); ++i)
+        {
+            HPX_TEST_EQ(ids[i], localities[i]);
+            HPX_TEST_EQ(hpx::agas::resolve_name_sync(names[i]), localities[i]);
+        }
+        HPX_TEST_EQ(ids.back(), hpx::naming::invalid_id);
+    }
+
+    // an unregistered name is removed from the cache
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        HPX_TEST_EQ(hpx::agas::unregister_name_sync(names[i]), localities[i]);
+        HPX_TEST(!hpx::agas::resolve_name_sync(names[i]));
+    }
+
+    // a name unregistered on another locality is removed from the cache of
+    // this locality as well
+    std::vector<hpx::id_type> remote_localities = hpx::find_remote_localities();
+    if (!remote_localities.empty())
+    {
+        for (std::size_t i = 0; i != localities.size(); ++i)
+        {
+            std::string const name = make_name("remote", i);
+            HPX_TEST(hpx::agas::register_name_sync(name, localities[i]));
+
+            // put the name into the symbol cache of this locality
+            HPX_TEST_EQ(hpx::agas::resolve_name(name).get(), localities[i]);
+            HPX_TEST_EQ(hpx::agas::resolve_name(name).get(), localities[i]);
+
+            unregister_name_action act;
+            HPX_TEST_EQ(act(remote_localities[0], name), localities[i]);
+
+            HPX_TEST_MSG(wait_for_invalidation(name),
+                "name unregistered on a remote locality is still cached");
+        }
+    }
+
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        HPX_TEST(!registered[i].is_ready());
+        HPX_TEST(hpx::agas::register_name_sync(make_name("late", i),
+            localities[i]));
+    }
+
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        HPX_TEST_EQ(registered[i].get(), localities[i]);
+        hpx::agas::unregister_name_sync(make_name("late", i));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,98 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the ids handed out by util::unique_id_ranges are unique if
+// requested concurrently from several worker threads, across the refills of
+// the per-thread ranges as well as of the shared range.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/util/generate_unique_ids.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using hpx::naming::gid_type;
+
+typedef std::pair<gid_type, std::size_t> id_block;
+
+///////////////////////////////////////////////////////////////////////////////
+// Each task requests enough ids to refill its per-thread range (0x100000 ids)
+// a couple of times. Every 16th request is too large for the per-thread
+// range and is served from the shared range directly.
+std::size_t const num_tasks = 16;
+std::size_t const num_iterations = 64;
+std::size_t const block_size = 0x8000;
+std::size_t const large_block_size = 0x20000;
+
+std::vector<id_block> allocate_ids(hpx::util::unique_id_ranges* ids)
+{
+    std::vector<id_block> result;
+    result.reserve(2 * num_iterations);
+
+    for (std::size_t i = 0; i != num_iterations; ++i)
+    {
+        result.push_back(id_block(ids->get_id(), 1));
+        result.push_back(id_block(ids->get_id(block_size), block_size));
+
+        if (i % 16 == 15)
+        {
+            result.push_back(id_block(
+                ids->get_id(large_block_size), large_block_size));
+        }
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    hpx::util::unique_id_ranges ids;
+
+    std::vector<hpx::unique_future<std::vector<id_block> > > futures;
+    futures.reserve(num_tasks);
+
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        futures.push_back(hpx::async(&allocate_ids, &ids));
+
+    std::vector<id_block> blocks;
+    std::size_t num_ids = 0;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        std::vector<id_block> r = futures[i].get();
+        for (std::size_t j = 0; j != r.size(); ++j)
+        {
+            HPX_TEST(r[j].first);
+            num_ids += r[j].second;
+        }
+        blocks.insert(blocks.end(), r.begin(), r.end());
+    }
+
+    // more ids than a single shared range (0x1000000) holds have been handed
+    // out, so the shared range has been refilled from AGAS as well
+    HPX_TEST(num_ids > std::size_t(0x1000000));
+
+    // no two blocks may overlap
+    std::sort(blocks.begin(), blocks.end());
+    for (std::size_t i = 1; i < blocks.size(); ++i)
+    {
+        HPX_TEST_MSG(blocks[i - 1].first + blocks[i - 1].second <=
+            blocks[i].first, "overlapping id blocks");
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
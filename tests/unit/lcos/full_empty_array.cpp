@@ -0,0 +1,217 @@
+//  Copyright (c) 2007-2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/detail/full_empty_cell.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::lcos::detail::full_empty_array;
+using hpx::lcos::detail::full_empty_cell;
+
+///////////////////////////////////////////////////////////////////////////////
+// every producer writes the values (i * size + j) into all elements of the
+// array, every consumer empties all elements of the array once per producer
+void produce(full_empty_array<std::size_t>& a, std::size_t i)
+{
+    for (std::size_t j = 0; j != a.size(); ++j)
+        a.write(j, i * a.size() + j);
+}
+
+void consume(full_empty_array<std::size_t>& a, boost::atomic<std::size_t>& sum)
+{
+    for (std::size_t j = 0; j != a.size(); ++j)
+    {
+        std::size_t v = 0;
+        a.read_and_empty(j, v);
+        HPX_TEST_EQ(v % a.size(), j);
+        sum += v;
+    }
+}
+
+void read_full(full_empty_array<std::size_t>& a, boost::atomic<std::size_t>& sum)
+{
+    for (std::size_t j = 0; j != a.size(); ++j)
+    {
+        std::size_t v = 0;
+        a.read(j, v);
+        sum += v;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_producer_consumer(std::size_t size, std::size_t count)
+{
+    full_empty_array<std::size_t> a(size);
+    for (std::size_t j = 0; j != size; ++j)
+        HPX_TEST(a.is_empty(j));
+
+    boost::atomic<std::size_t> sum(0);
+
+    std::vector<hpx::unique_future<void> > futures;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        futures.push_back(hpx::async(&consume, boost::ref(a), boost::ref(sum)));
+        futures.push_back(hpx::async(&produce, boost::ref(a), i));
+    }
+    hpx::wait_all(futures);
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i != count; ++i)
+        for (std::size_t j = 0; j != size; ++j)
+            expected += i * size + j;
+
+    HPX_TEST_EQ(sum.load(), expected);
+    for (std::size_t j = 0; j != size; ++j)
+        HPX_TEST(a.is_empty(j));
+}
+
+void test_readers(std::size_t size, std::size_t count)
+{
+    full_empty_array<std::size_t> a(size);
+    boost::atomic<std::size_t> sum(0);
+
+    // all readers block until the elements become full
+    std::vector<hpx::unique_future<void> > futures;
+    for (std::size_t i = 0; i != count; ++i)
+        futures.push_back(hpx::async(&read_full, boost::ref(a), boost::ref(sum)));
+
+    for (std::size_t j = 0; j != size; ++j)
+        a.set(j, j);
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(sum.load(), count * (size * (size - 1) / 2));
+    for (std::size_t j = 0; j != size; ++j)
+        HPX_TEST(!a.is_empty(j));
+}
+
+void test_initialized(std::size_t size)
+{
+    full_empty_array<std::size_t> a(size, 42);
+    for (std::size_t j = 0; j != size; ++j)
+    {
+        HPX_TEST(!a.is_empty(j));
+
+        std::size_t v = 0;
+        a.read_and_empty(j, v);
+        HPX_TEST_EQ(v, std::size_t(42));
+        HPX_TEST(a.is_empty(j));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void wait_for_cell(full_empty_cell<void>& c, boost::atomic<std::size_t>& count)
+{
+    c.read();
+    ++count;
+}
+
+void test_void_cell(std::size_t count)
+{
+    full_empty_cell<void> c;
+    boost::atomic<std::size_t> woken(0);
+
+    std::vector<hpx::unique_future<void> > futures;
+    for (std::size_t i = 0; i != count; ++i)
+        futures.push_back(hpx::async(&wait_for_cell, boost::ref(c),
+            boost::ref(woken)));
+
+    c.set();
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(woken.load(), count);
+    HPX_TEST(!c.is_empty());
+
+    c.read_and_empty();
+    HPX_TEST(c.is_empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void interrupted_read(full_empty_cell<std::size_t>& c,
+    boost::atomic<bool>& interrupted)
+{
+    try {
+        std::size_t v = 0;
+        c.read(v);
+    }
+    catch (hpx::thread_interrupted const&) {
+        interrupted = true;
+    }
+}
+
+void read_value(full_empty_cell<std::size_t>& c, std::size_t& v)
+{
+    c.read(v);
+}
+
+void test_interrupted_read()
+{
+    full_empty_cell<std::size_t> c;
+    boost::atomic<bool> interrupted(false);
+
+    hpx::thread t(&interrupted_read, boost::ref(c), boost::ref(interrupted));
+    while (!c.is_used())
+        hpx::this_thread::yield();
+
+    // a second reader keeps waiting after the first one was interrupted
+    std::size_t v = 0;
+    hpx::unique_future<void> f = hpx::async(&read_value, boost::ref(c),
+        boost::ref(v));
+
+    t.interrupt();
+    t.join();
+    HPX_TEST(interrupted.load());
+
+    // the interrupted reader must not be referenced by the cell anymore
+    c.set(std::size_t(42));
+    f.get();
+
+    HPX_TEST_EQ(v, std::size_t(42));
+    HPX_TEST(!c.is_empty());
+    HPX_TEST(!c.is_used());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::size_t size = vm["size"].as<std::size_t>();
+    std::size_t count = vm["count"].as<std::size_t>();
+
+    test_producer_consumer(size, count);
+    test_readers(size, count);
+    test_initialized(size);
+    test_void_cell(count);
+    test_interrupted_read();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("size", value<std::size_t>()->default_value(1000),
+            "number of elements in the full/empty array")
+        ("count", value<std::size_t>()->default_value(10),
+            "number of producers and consumers to create")
+        ;
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(cmdline, argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
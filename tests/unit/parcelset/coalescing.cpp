@@ -0,0 +1,129 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the adaptive mode of the coalescing message handler: parcels sent in
+// a burst are combined into batches of at most num_messages parcels, and a
+// partially filled batch is flushed once its deadline expires.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parcel_coalescing.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/format.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// at most 16 parcels per message, parcels are held back for at most 100ms
+std::size_t const num_messages = 16;
+std::size_t const interval = 100000;        // [us]
+
+void ping() {}
+HPX_PLAIN_ACTION(ping, ping_action);
+HPX_ACTION_USES_MESSAGE_COALESCING(ping_action, "ping_action",
+    num_messages, interval);
+
+///////////////////////////////////////////////////////////////////////////////
+boost::int64_t query_counter(char const* name)
+{
+    using hpx::performance_counters::stubs::performance_counter;
+
+    std::string const path = boost::str(
+        boost::format("/coalescing{locality#%d/total}/%s") %
+            hpx::get_locality_id() % name);
+
+    hpx::id_type id = hpx::performance_counters::get_counter(path);
+    return performance_counter::get_typed_value<boost::int64_t>(id, true);
+}
+
+boost::int64_t average_batch_size()
+{
+    return query_counter("count/average-parcels-per-message");
+}
+
+boost::int64_t average_added_latency()
+{
+    return query_counter("time/average-added-latency");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A burst of parcels fills batches up to the threshold. The number of parcels
+// is not a multiple of the batch size, the last batch is sent only after its
+// deadline expired.
+void test_batching(hpx::id_type const& there)
+{
+    average_batch_size();
+    average_added_latency();
+
+    std::size_t const count = 1000;
+
+    std::vector<hpx::unique_future<void> > futures;
+    futures.reserve(count);
+
+    for (std::size_t i = 0; i != count; ++i)
+        futures.push_back(hpx::async<ping_action>(there));
+
+    hpx::wait_all(futures);
+
+    boost::int64_t batch_size = average_batch_size();
+    HPX_TEST_MSG(batch_size > 1, "parcels were not combined");
+    HPX_TEST(batch_size <= boost::int64_t(num_messages));
+
+    // no parcel is held back longer than the interval
+    HPX_TEST(average_added_latency() <= boost::int64_t(interval) * 1000);
+}
+
+// Parcels arriving less often than the interval are not combined. They are
+// either sent right away or flushed on their own once their deadline expired.
+void test_flush(hpx::id_type const& there)
+{
+    average_batch_size();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::unique_future<void> f = hpx::async<ping_action>(there);
+        HPX_TEST(f.wait_for(boost::posix_time::seconds(10)) ==
+            hpx::lcos::future_status::ready);
+        f.get();
+
+        hpx::this_thread::suspend(boost::posix_time::milliseconds(
+            2 * interval / 1000));
+    }
+
+    HPX_TEST_EQ(average_batch_size(), 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    if (!localities.empty())
+    {
+        test_batching(localities[0]);
+        test_flush(localities[0]);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.plugins.coalescing_message_handler.adaptive=1");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,103 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/serialization/vector.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Every parcel carries its sequence number and a payload derived from it.
+// A message which was cut at the wrong place, or mixed up with another
+// message of the same gathered write, does not decode to a matching pair.
+std::vector<double> make_payload(std::size_t seq)
+{
+    std::vector<double> payload((seq % 17) * 100 + 1);
+    for (std::size_t i = 0; i != payload.size(); ++i)
+        payload[i] = double(seq * 10000 + i);
+    return payload;
+}
+
+std::size_t check_payload(std::size_t seq, std::vector<double> const& payload)
+{
+    if (payload != make_payload(seq))
+        return std::size_t(-1);
+    return seq;
+}
+HPX_PLAIN_ACTION(check_payload);
+
+///////////////////////////////////////////////////////////////////////////////
+boost::int64_t message_count()
+{
+    return hpx::get_runtime().get_parcel_handler().get_message_send_count(
+        hpx::parcelset::connection_tcp, false);
+}
+
+boost::int64_t write_count()
+{
+    return hpx::get_runtime().get_parcel_handler().get_message_write_count(
+        hpx::parcelset::connection_tcp, false);
+}
+
+void test_gathered_writes(hpx::id_type const& there, std::size_t count)
+{
+    boost::int64_t messages = message_count();
+    boost::int64_t writes = write_count();
+
+    // the parcels pile up on the connection while it is busy, they are sent
+    // as several messages per write
+    std::vector<hpx::unique_future<std::size_t> > futures;
+    futures.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        futures.push_back(
+            hpx::async<check_payload_action>(there, i, make_payload(i)));
+    }
+
+    // every parcel arrived exactly once and intact
+    for (std::size_t i = 0; i != count; ++i)
+        HPX_TEST_EQ(futures[i].get(), i);
+
+    messages = message_count() - messages;
+    writes = write_count() - writes;
+
+    HPX_TEST(messages != 0);
+    HPX_TEST(writes != 0);
+    HPX_TEST(writes < messages);
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    for (std::size_t i = 0; i != localities.size(); ++i)
+        test_gathered_writes(localities[i], 1000);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // split the pending parcels into small messages, a single write takes
+    // at most 16 buffers
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.parcel.gather_message_size=1024");
+    cfg.push_back("hpx.parcel.gather_max_buffers=16");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,96 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/serialization/vector.hpp>
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> echo(std::vector<char> const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo);
+
+std::vector<char> make_data(std::size_t size, std::size_t seed)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = static_cast<char>(seed + i * 7);
+    return data;
+}
+
+std::size_t shmem_send_count()
+{
+    return hpx::get_runtime().get_parcel_handler().get_parcel_send_count(
+        hpx::parcelset::connection_shmem, false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The sizes below cover messages stored inline in a slot, messages stored in
+// the arena, and messages which are split as they do not fit into a quarter
+// of the arena (see the configuration in main).
+void test_echo(hpx::id_type const& there, std::size_t size, std::size_t count)
+{
+    std::vector<hpx::unique_future<std::vector<char> > > futures;
+    futures.reserve(count);
+
+    for (std::size_t i = 0; i != count; ++i)
+        futures.push_back(hpx::async<echo_action>(there, make_data(size, i)));
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        std::vector<char> data = futures[i].get();
+        HPX_TEST(data == make_data(size, i));
+    }
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    std::size_t sent = shmem_send_count();
+
+    std::size_t const sizes[] =
+    {
+        0, 16, 1000, 4000, 100000, 300000, 2000000
+    };
+
+    for (std::size_t i = 0; i != sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        for (std::size_t j = 0; j != localities.size(); ++j)
+            test_echo(localities[j], sizes[i], 50);
+    }
+
+    // the parcels were actually sent through the shmem parcelport
+    HPX_TEST(shmem_send_count() > sent);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // use a small arena to exercise the splitting of large messages
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.parcel.shmem.enable=1");
+    cfg.push_back("hpx.parcel.shmem.num_slots=16");
+    cfg.push_back("hpx.parcel.shmem.arena_size=1048576");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
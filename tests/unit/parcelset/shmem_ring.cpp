@@ -0,0 +1,214 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/parcelset/policies/shmem/ring.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+
+using hpx::parcelset::policies::shmem::ring;
+using hpx::parcelset::policies::shmem::slot_header;
+
+///////////////////////////////////////////////////////////////////////////////
+// The ring and its slots normally live in a shared memory segment, for the
+// tests below ordinary memory is sufficient.
+struct test_ring
+{
+    test_ring(std::size_t num_slots, std::size_t slot_size)
+      : ring_(num_slots, slot_size),
+        storage_(num_slots * slot_size / sizeof(boost::uint64_t))
+    {}
+
+    char* slots()
+    {
+        return reinterpret_cast<char*>(&storage_[0]);
+    }
+
+    bool push(boost::uint64_t value)
+    {
+        slot_header* slot = ring_.try_reserve(slots());
+        if (0 == slot)
+            return false;
+
+        slot->size_ = value;
+        slot->handle_ = slot_header::inline_data;
+        ring_.commit();
+        return true;
+    }
+
+    bool pop(boost::uint64_t& value)
+    {
+        slot_header* slot = ring_.front(slots());
+        if (0 == slot)
+            return false;
+
+        value = slot->size_;
+        ring_.pop();
+        return true;
+    }
+
+    ring ring_;
+    std::vector<boost::uint64_t> storage_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_empty_and_full(std::size_t num_slots)
+{
+    test_ring r(num_slots, 64);
+    HPX_TEST(r.ring_.empty());
+
+    boost::uint64_t value = 0;
+    HPX_TEST(!r.pop(value));
+
+    // the ring takes exactly num_slots entries
+    for (std::size_t i = 0; i != num_slots; ++i)
+        HPX_TEST(r.push(i));
+
+    HPX_TEST(!r.ring_.empty());
+    HPX_TEST(!r.push(num_slots));
+
+    // releasing one slot makes room for exactly one more entry
+    HPX_TEST(r.pop(value));
+    HPX_TEST_EQ(value, boost::uint64_t(0));
+    HPX_TEST(r.push(num_slots));
+    HPX_TEST(!r.push(num_slots + 1));
+
+    for (std::size_t i = 1; i != num_slots + 1; ++i)
+    {
+        HPX_TEST(r.pop(value));
+        HPX_TEST_EQ(value, boost::uint64_t(i));
+    }
+
+    HPX_TEST(r.ring_.empty());
+    HPX_TEST(!r.pop(value));
+}
+
+void test_wraparound(std::size_t num_slots)
+{
+    test_ring r(num_slots, 64);
+
+    // the head and tail counters pass the end of the ring many times, with
+    // the ring being partially filled at each point
+    boost::uint64_t pushed = 0, popped = 0;
+    for (std::size_t round = 0; round != 10 * num_slots; ++round)
+    {
+        std::size_t count = round % num_slots + 1;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (!r.push(pushed))
+                break;
+            ++pushed;
+        }
+
+        for (std::size_t i = 0; i != (count + 1) / 2; ++i)
+        {
+            boost::uint64_t value = 0;
+            HPX_TEST(r.pop(value));
+            HPX_TEST_EQ(value, popped);
+            ++popped;
+        }
+    }
+
+    boost::uint64_t value = 0;
+    while (r.pop(value))
+    {
+        HPX_TEST_EQ(value, popped);
+        ++popped;
+    }
+
+    HPX_TEST_EQ(pushed, popped);
+    HPX_TEST(pushed >= 10 * num_slots);
+    HPX_TEST(r.ring_.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void produce(test_ring& r, boost::uint64_t count)
+{
+    for (boost::uint64_t i = 0; i != count; /**/)
+    {
+        if (r.push(i))
+        {
+            ++i;
+            continue;
+        }
+
+        // the ring is full, wait for the consumer to release a slot
+        boost::uint32_t seq = r.ring_.prepare_wait();
+        if (r.ring_.try_reserve(r.slots()) != 0)
+        {
+            r.ring_.cancel_wait();
+            continue;
+        }
+        r.ring_.wait(seq, 100);
+    }
+}
+
+void test_concurrent(std::size_t num_slots, boost::uint64_t count)
+{
+    test_ring r(num_slots, 64);
+    boost::thread producer(&produce, boost::ref(r), count);
+
+    // all values arrive exactly once and in order
+    boost::uint64_t expected = 0;
+    while (expected != count)
+    {
+        boost::uint64_t value = 0;
+        if (!r.pop(value))
+        {
+            boost::this_thread::yield();
+            continue;
+        }
+
+        HPX_TEST_EQ(value, expected);
+        ++expected;
+    }
+
+    producer.join();
+    HPX_TEST(r.ring_.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_wake_producer()
+{
+    test_ring r(1, 64);
+    HPX_TEST(r.push(0));
+
+    // releasing a slot after the producer has announced its wait keeps it
+    // from blocking
+    boost::uint32_t seq = r.ring_.prepare_wait();
+
+    boost::uint64_t value = 0;
+    HPX_TEST(r.pop(value));
+
+    hpx::util::high_resolution_timer t;
+    r.ring_.wait(seq, 10000);
+    HPX_TEST(t.elapsed() < 5.0);
+
+    HPX_TEST(r.push(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_empty_and_full(1);
+    test_empty_and_full(5);
+    test_empty_and_full(256);
+
+    test_wraparound(1);
+    test_wraparound(7);
+    test_wraparound(64);
+
+    test_concurrent(1, 10000);
+    test_concurrent(7, 100000);
+
+    test_wake_producer();
+
+    return hpx::util::report_errors();
+}
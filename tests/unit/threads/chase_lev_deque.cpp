@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (C) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/program_options.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <iostream>
+#include <vector>
+
+boost::lockfree::chase_lev_deque<boost::uint64_t>* deque = 0;
+std::vector<boost::atomic<boost::uint64_t>*> seen;
+
+boost::atomic<bool> done(false);
+
+boost::uint64_t threads = 2;
+boost::uint64_t items = 500000;
+
+void mark_seen(boost::uint64_t item)
+{
+    // every item has to be handed out exactly once
+    ++*seen[item];
+}
+
+void owner_thread()
+{
+    boost::uint64_t r = 0;
+
+    // the owner pushes all items and pops every other one itself
+    for (boost::uint64_t i = 0; i < items; ++i)
+    {
+        deque->push_bottom(i);
+
+        if ((i % 2) && deque->pop_bottom(r))
+            mark_seen(r);
+    }
+
+    while (deque->pop_bottom(r))
+        mark_seen(r);
+
+    done = true;
+}
+
+void thief_thread()
+{
+    boost::uint64_t r = 0;
+
+    while (!done || !deque->empty())
+    {
+        if (deque->steal_top(r))
+            mark_seen(r);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("threads,t", value<boost::uint64_t>(&threads)->default_value(2),
+         "the number of worker threads stealing objects from the deque")
+        ("items,i", value<boost::uint64_t>(&items)->default_value(500000),
+         "the number of items to push onto the deque")
+    ;
+
+    store(
+        command_line_parser(argc, argv).options(desc_cmdline).allow_unregistered().run(), vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return boost::report_errors();
+    }
+
+    // start with a small deque to exercise growing it
+    deque = new boost::lockfree::chase_lev_deque<boost::uint64_t>(16);
+
+    seen.reserve(items);
+    for (boost::uint64_t i = 0; i < items; ++i)
+        seen.push_back(new boost::atomic<boost::uint64_t>(0));
+
+    {
+        boost::thread_group tg;
+
+        for (boost::uint64_t i = 0; i != threads; ++i)
+            tg.create_thread(&thief_thread);
+
+        tg.create_thread(&owner_thread);
+
+        tg.join_all();
+    }
+
+    BOOST_TEST(deque->empty());
+
+    for (boost::uint64_t i = 0; i < items; ++i)
+    {
+        BOOST_TEST_EQ(seen[i]->load(), 1u);
+        delete seen[i];
+    }
+
+    delete deque;
+
+    return boost::report_errors();
+}
@@ -0,0 +1,57 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+void wait_for(hpx::shared_future<void> f)
+{
+    f.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    hpx::threads::executors::numa_domain_executor exec(0);
+    HPX_TEST_EQ(exec.num_pending_closures(), std::size_t(0));
+
+    hpx::lcos::local::promise<void> p;
+    hpx::shared_future<void> gate = p.get_future();
+
+    // work not submitted through the executor is not counted
+    hpx::unique_future<void> other = hpx::async(&wait_for, gate);
+
+    std::vector<hpx::unique_future<void> > closures;
+    for (std::size_t i = 0; i != 10; ++i)
+        closures.push_back(hpx::async(exec, &wait_for, gate));
+
+    HPX_TEST_EQ(exec.num_pending_closures(), std::size_t(10));
+
+    p.set_value();
+    hpx::wait_all(closures);
+    other.get();
+
+    // the statistics are updated before the closures' threads terminate
+    while (exec.num_pending_closures() != 0)
+        hpx::this_thread::yield();
+
+    HPX_TEST_EQ(exec.num_pending_closures(), std::size_t(0));
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(0, hpx::init(argc, argv), "hpx::init returned non-zero value");
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,120 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/buffer_pool.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/ref.hpp>
+
+#include <vector>
+
+typedef hpx::util::buffer_pool<char> pool_type;
+typedef pool_type::buffer_type buffer_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse()
+{
+    pool_type pool(1024*1024, 4, 2);
+
+    buffer_type buffer = pool.get_buffer(3000);
+    HPX_TEST_EQ(buffer.capacity(), std::size_t(4096));
+    HPX_TEST_EQ(pool.get_misses(false), 1);
+
+    char const* data = buffer.data();
+    buffer.resize(3000);
+
+    pool.reclaim_buffer(buffer);
+    HPX_TEST(buffer.empty());
+    HPX_TEST_EQ(pool.get_retained_bytes(), 4096);
+
+    // a smaller buffer is served from the same memory
+    buffer_type reused = pool.get_buffer(4000);
+    HPX_TEST(reused.empty());
+    HPX_TEST(reused.data() == data);
+    HPX_TEST_EQ(pool.get_hits(true), 1);
+    HPX_TEST_EQ(pool.get_hits(false), 0);
+    HPX_TEST_EQ(pool.get_retained_bytes(), 0);
+
+    // a larger one is not
+    pool.reclaim_buffer(reused);
+    buffer_type larger = pool.get_buffer(5000);
+    HPX_TEST_EQ(larger.capacity(), std::size_t(8192));
+    HPX_TEST_EQ(pool.get_misses(false), 2);
+    HPX_TEST_EQ(pool.get_retained_bytes(), 4096);
+
+    pool.clear();
+    HPX_TEST_EQ(pool.get_retained_bytes(), 0);
+}
+
+void test_bounded_retention()
+{
+    // at most 4 buffers per size class and no more than 16K overall
+    pool_type pool(16*1024, 4, 1);
+
+    std::vector<buffer_type> buffers;
+    for (int i = 0; i != 8; ++i)
+        buffers.push_back(pool.get_buffer(1024));
+
+    for (int i = 0; i != 8; ++i)
+        pool.reclaim_buffer(buffers[i]);
+    HPX_TEST_EQ(pool.get_retained_bytes(), 4*1024);
+
+    buffer_type large = pool.get_buffer(16*1024);
+    pool.reclaim_buffer(large);
+    HPX_TEST_EQ(pool.get_retained_bytes(), 4*1024);
+
+    // buffers outside of the size classes are never retained
+    buffer_type small;
+    small.reserve(100);
+    pool.reclaim_buffer(small);
+    HPX_TEST_EQ(pool.get_retained_bytes(), 4*1024);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void use_pool(pool_type& pool, std::size_t iterations)
+{
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        std::size_t size = 1024 << (i % 8);
+        buffer_type buffer = pool.get_buffer(size);
+        HPX_TEST(buffer.capacity() >= size);
+        buffer.resize(size);
+        pool.reclaim_buffer(buffer);
+    }
+}
+
+void test_concurrent_use()
+{
+    pool_type pool;
+
+    std::size_t const iterations = 10000;
+    std::vector<hpx::unique_future<void> > futures;
+    for (std::size_t i = 0; i != 2 * hpx::get_os_thread_count(); ++i)
+        futures.push_back(hpx::async(&use_pool, boost::ref(pool), iterations));
+    hpx::wait_all(futures);
+
+    HPX_TEST(pool.get_hits(false) > 0);
+    HPX_TEST_EQ(pool.get_hits(false) + pool.get_misses(false),
+        boost::int64_t(futures.size() * iterations));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_reuse();
+    test_bounded_retention();
+    test_concurrent_use();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,72 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that localities which compare equal select the same stripe of the
+// connection cache, even if only one of them carries an MPI rank.
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/naming/locality.hpp>
+#include <hpx/util/connection_cache.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/make_shared.hpp>
+
+using hpx::naming::locality;
+
+///////////////////////////////////////////////////////////////////////////////
+struct dummy_connection
+{
+    enum state
+    {
+        state_reinitialized,
+        state_reclaimed,
+        state_deleting
+    };
+
+    void set_state(state) {}
+};
+
+typedef hpx::util::connection_cache<dummy_connection, locality> cache_type;
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    cache_type cache(64, 4);
+
+    for (boost::uint16_t port = 7910; port != 7910 + 32; ++port)
+    {
+        // set_rank is a no-op if the MPI parcelport is not enabled
+        locality with_rank("127.0.0.1", port);
+        with_rank.set_rank(static_cast<boost::int16_t>(port - 7910));
+
+        locality without_rank("127.0.0.1", port);
+        without_rank.set_rank(-1);
+
+        HPX_TEST(with_rank == without_rank);
+        HPX_TEST_EQ(hash_value(with_rank), hash_value(without_rank));
+
+        // reserve space for a connection and return it to the cache
+        cache_type::connection_type conn;
+        HPX_TEST(cache.get_or_reserve(with_rank, conn));
+        HPX_TEST(!conn);
+
+        conn = boost::make_shared<dummy_connection>();
+        cache.reclaim(with_rank, conn);
+
+        // the connection is found using the equal key
+        HPX_TEST(cache.get(without_rank) == conn);
+        HPX_TEST(!cache.get(with_rank));
+
+        cache.reclaim(without_rank, conn);
+        HPX_TEST(cache.get(with_rank) == conn);
+        cache.reclaim(with_rank, conn);
+    }
+
+    HPX_TEST_EQ(cache.get_cache_hits(false), 64);
+    HPX_TEST_EQ(cache.get_cache_reclaims(false), 96);
+
+    cache.clear();
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,158 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/buffer_pool.hpp>
+#include <hpx/util/frame_ring.hpp>
+#include <hpx/util/frame_stream.hpp>
+#include <hpx/util/portable_binary_iarchive.hpp>
+#include <hpx/util/portable_binary_oarchive.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <string>
+#include <vector>
+
+typedef hpx::util::frame_ring::frame_type frame_type;
+
+hpx::util::buffer_pool<char> pool;
+
+///////////////////////////////////////////////////////////////////////////////
+void produce(hpx::util::frame_ring& frames, std::size_t frame_size,
+    std::vector<double> const& data, std::string const& str)
+{
+    hpx::util::oframe_stream stream(frames, pool, frame_size);
+    {
+        hpx::util::portable_binary_oarchive archive(stream, 0,
+            boost::archive::no_header);
+        archive << data << str;
+    }
+    stream.flush();
+
+    HPX_TEST(stream.bytes_written() > data.size() * sizeof(double));
+    HPX_TEST(stream.bytes_sent() > stream.bytes_written());
+
+    frames.close();
+}
+
+void test_round_trip(std::size_t frame_size, std::size_t max_frames)
+{
+    hpx::util::frame_ring frames(max_frames);
+
+    std::vector<double> data(100000);
+    for (std::size_t i = 0; i != data.size(); ++i)
+        data[i] = double(i);
+    std::string str("streamed");
+
+    // the frames are de-serialized while they are produced
+    hpx::unique_future<void> f = hpx::async(&produce, boost::ref(frames),
+        frame_size, boost::cref(data), boost::cref(str));
+
+    std::vector<double> received_data;
+    std::string received_str;
+    {
+        hpx::util::iframe_stream stream(frames, pool);
+        hpx::util::portable_binary_iarchive archive(stream,
+            boost::uint64_t(0), unsigned(boost::archive::no_header));
+        archive >> received_data >> received_str;
+    }
+
+    f.get();
+
+    HPX_TEST(received_data == data);
+    HPX_TEST_EQ(received_str, str);
+
+    // all frames have been consumed
+    frame_type frame;
+    HPX_TEST(!frames.pop(frame));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_abort()
+{
+    hpx::util::frame_ring frames(1);
+
+    std::vector<double> data(100000);
+    std::string str;
+
+    hpx::unique_future<void> f = hpx::async(&produce, boost::ref(frames),
+        1024, boost::cref(data), boost::cref(str));
+
+    // stop after the first frame, this makes the producer throw
+    frame_type frame;
+    HPX_TEST(frames.pop(frame));
+    frames.abort();
+
+    bool caught_exception = false;
+    try {
+        f.get();
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void set_flag(boost::atomic<int>& flag)
+{
+    ++flag;
+}
+
+void test_callbacks()
+{
+    hpx::util::frame_ring frames(1);
+    boost::atomic<int> notified(0);
+
+    // the consumer is notified once a frame becomes available
+    frame_type frame;
+    HPX_TEST_EQ(frames.try_pop(frame, boost::bind(&set_flag,
+        boost::ref(notified))), hpx::util::frame_ring::would_block);
+
+    frame_type first(10, 'a');
+    HPX_TEST_EQ(frames.try_push(first, hpx::util::frame_ring::callback_type()),
+        hpx::util::frame_ring::succeeded);
+    HPX_TEST_EQ(notified.load(), 1);
+
+    // the producer is notified once there is space for the next frame
+    frame_type second(10, 'b');
+    HPX_TEST_EQ(frames.try_push(second, boost::bind(&set_flag,
+        boost::ref(notified))), hpx::util::frame_ring::would_block);
+    HPX_TEST_EQ(second.size(), std::size_t(10));
+
+    HPX_TEST_EQ(frames.try_pop(frame, hpx::util::frame_ring::callback_type()),
+        hpx::util::frame_ring::succeeded);
+    HPX_TEST(frame == frame_type(10, 'a'));
+    HPX_TEST_EQ(notified.load(), 2);
+
+    frames.close();
+    HPX_TEST_EQ(frames.try_pop(frame, hpx::util::frame_ring::callback_type()),
+        hpx::util::frame_ring::end_of_stream);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_round_trip(1024, 1);
+    test_round_trip(4096, 4);
+    test_round_trip(1024*1024, 2);
+    test_abort();
+    test_callbacks();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,153 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/util/unique_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/scoped_ptr.hpp>
+
+#include <string>
+#include <typeinfo>
+
+///////////////////////////////////////////////////////////////////////////////
+// a function object which can be moved, but not copied
+struct move_only_add
+{
+    explicit move_only_add(int value)
+      : value_(new int(value))
+    {}
+
+    move_only_add(move_only_add && other)
+      : value_(0)
+    {
+        value_.swap(other.value_);
+    }
+
+    int operator()(int x) const
+    {
+        return *value_ + x;
+    }
+
+    boost::scoped_ptr<int> value_;
+
+private:
+    move_only_add(move_only_add const&);
+    move_only_add& operator=(move_only_add const&);
+};
+
+// a function object which is stored in place by util::function
+struct small_add
+{
+    explicit small_add(std::string const& s)
+      : s_(s)
+    {}
+
+    int operator()(int x) const
+    {
+        return int(s_.size()) + x;
+    }
+
+    std::string s_;
+};
+
+int add_one(int x)
+{
+    return x + 1;
+}
+
+#if !defined(BOOST_NO_CXX11_FINAL)
+// a function object which can't be derived from
+struct final_add final
+{
+    int operator()(int x) const
+    {
+        return x + 2;
+    }
+};
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // unique_function holds and moves non-copyable function objects
+    {
+        hpx::util::unique_function<int(int)> f = move_only_add(1);
+        HPX_TEST(!f.empty());
+        HPX_TEST_EQ(f(41), 42);
+
+        hpx::util::unique_function<int(int)> g(std::move(f));
+        HPX_TEST(f.empty());
+        HPX_TEST_EQ(g(41), 42);
+
+        f = std::move(g);
+        HPX_TEST(g.empty());
+        HPX_TEST_EQ(f(1), 2);
+
+        f.reset();
+        HPX_TEST(f.empty());
+    }
+
+    // the stored function object is accessible with its own type
+    {
+        hpx::util::unique_function<int(int)> f = move_only_add(1);
+        HPX_TEST(f.target_type() == typeid(move_only_add));
+
+        move_only_add* p = f.target<move_only_add>();
+        HPX_TEST(p != 0);
+        if (p != 0)
+            HPX_TEST_EQ(*p->value_, 1);
+        HPX_TEST(f.target<small_add>() == 0);
+
+        hpx::util::unique_function<int(int)> const& cf = f;
+        HPX_TEST(cf.target<move_only_add>() == p);
+
+        hpx::util::unique_function<int(int)> g = small_add("abc");
+        HPX_TEST(g.target_type() == typeid(small_add));
+        HPX_TEST(g.target<small_add>() != 0);
+        HPX_TEST(g.target<move_only_add>() == 0);
+    }
+
+    // unique_function holds function pointers as well
+    {
+        hpx::util::unique_function<int(int)> f = &add_one;
+        HPX_TEST_EQ(f(41), 42);
+        HPX_TEST(f.target_type() == typeid(int(*)(int)));
+        HPX_TEST(f.target<int(*)(int)>() != 0);
+    }
+
+#if !defined(BOOST_NO_CXX11_FINAL)
+    // function objects declared final are supported
+    {
+        hpx::util::unique_function<int(int)> f = final_add();
+        HPX_TEST_EQ(f(40), 42);
+        HPX_TEST(f.target<final_add>() != 0);
+    }
+#endif
+
+    // function objects stored in place survive moves and swaps
+    {
+        hpx::util::function_nonser<int(int)> f = small_add("abc");
+        hpx::util::function_nonser<int(int)> g = &add_one;
+
+        HPX_TEST(f.target<small_add>() != 0);
+        HPX_TEST_EQ(f(1), 4);
+
+        f.swap(g);
+        HPX_TEST_EQ(f(1), 2);
+        HPX_TEST_EQ(g(1), 4);
+
+        hpx::util::function_nonser<int(int)> h(std::move(g));
+        HPX_TEST(g.empty());
+        HPX_TEST_EQ(h(1), 4);
+
+        g = h;
+        HPX_TEST_EQ(g(1), 4);
+        HPX_TEST_EQ(h(1), 4);
+    }
+
+    return hpx::util::report_errors();
+}
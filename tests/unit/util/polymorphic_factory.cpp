@@ -0,0 +1,118 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the dense action ids negotiated while the localities connect and the
+// lookup of the action types by name.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/polymorphic_factory.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+typedef hpx::util::polymorphic_factory<hpx::actions::base_action> factory_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// Every locality has to use the id table created by the root locality.
+bool check_ids(std::vector<std::string> const& names)
+{
+    if (!factory_type::has_ids() || factory_type::get_names() != names)
+        return false;
+
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        if (factory_type::get_id(names[i]) != i)
+            return false;
+    }
+    return true;
+}
+HPX_PLAIN_ACTION(check_ids, check_ids_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_local_ids(std::vector<std::string> const& names)
+{
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        boost::uint32_t const id = static_cast<boost::uint32_t>(i);
+        HPX_TEST_EQ(factory_type::get_id(names[i]), id);
+
+        // the lookup by id and the fallback by name create the same type
+        boost::shared_ptr<hpx::actions::base_action> by_id =
+            factory_type::create(id);
+        boost::shared_ptr<hpx::actions::base_action> by_name =
+            factory_type::create(names[i]);
+
+        HPX_TEST(by_id);
+        HPX_TEST(by_name);
+        if (by_id && by_name)
+            HPX_TEST(typeid(*by_id) == typeid(*by_name));
+    }
+}
+
+void test_unknown(std::vector<std::string> const& names)
+{
+    std::string const unknown("/test/polymorphic_factory/unknown_type");
+    HPX_TEST_EQ(factory_type::get_id(unknown),
+        boost::uint32_t(factory_type::invalid_id));
+
+    bool caught_exception = false;
+    try {
+        factory_type::create(unknown);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try {
+        factory_type::create(static_cast<boost::uint32_t>(names.size()));
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    // the root locality assigns the ids once the other locality connects
+    HPX_TEST(factory_type::has_ids());
+
+    std::vector<std::string> names = factory_type::get_names();
+    HPX_TEST(!names.empty());
+
+    test_local_ids(names);
+    test_unknown(names);
+
+    // the remote locality uses the same id table
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    for (std::size_t i = 0; i != localities.size(); ++i)
+    {
+        check_ids_action act;
+        HPX_TEST(act(localities[i], names));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
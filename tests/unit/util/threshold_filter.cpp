@@ -0,0 +1,244 @@
+//  Copyright (c) 2014 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/binary_filter.hpp>
+#include <hpx/util/threshold_filter.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// A simple run length encoding, which compresses repetitive data well and
+// expands random data.
+struct rle_filter : hpx::util::binary_filter
+{
+    rle_filter() : current_(0) {}
+
+    void set_max_length(std::size_t size)
+    {
+        buffer_.reserve(size);
+    }
+
+    void save(void const* src, std::size_t src_count)
+    {
+        char const* begin = static_cast<char const*>(src);
+        buffer_.insert(buffer_.end(), begin, begin + src_count);
+    }
+
+    bool flush(void* dst, std::size_t dst_count, std::size_t& written)
+    {
+        std::vector<char> encoded;
+        for (std::size_t i = 0; i != buffer_.size(); /**/)
+        {
+            std::size_t run = 1;
+            while (i + run != buffer_.size() && run != 255 &&
+                   buffer_[i + run] == buffer_[i])
+            {
+                ++run;
+            }
+
+            encoded.push_back(static_cast<char>(run));
+            encoded.push_back(buffer_[i]);
+            i += run;
+        }
+
+        if (encoded.size() > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        if (!encoded.empty())
+            std::memcpy(dst, encoded.data(), encoded.size());
+        written = encoded.size();
+        return true;
+    }
+
+    std::size_t init_data(char const* buffer, std::size_t size,
+        std::size_t buffer_size)
+    {
+        buffer_.clear();
+        buffer_.reserve(buffer_size);
+        for (std::size_t i = 0; i + 1 < size; i += 2)
+        {
+            std::size_t run = static_cast<unsigned char>(buffer[i]);
+            buffer_.insert(buffer_.end(), run, buffer[i + 1]);
+        }
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    void load(void* dst, std::size_t dst_count)
+    {
+        HPX_TEST(current_ + dst_count <= buffer_.size());
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    std::vector<char> buffer_;
+    std::size_t current_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> make_repetitive_data(std::size_t size)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = static_cast<char>(i / 100);
+    return data;
+}
+
+std::vector<char> make_random_data(std::size_t size)
+{
+    std::vector<char> data(size);
+    boost::uint32_t seed = 42;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = static_cast<char>(seed >> 24);
+    }
+    return data;
+}
+
+// Run the data through a threshold_binary_filter wrapping the given filters
+// and return the (leading) byte telling whether the data was compressed.
+int round_trip(std::vector<char> const& data,
+    hpx::util::binary_filter* compress, hpx::util::binary_filter* decompress,
+    std::size_t threshold, hpx::util::compression_statistics& stats)
+{
+    std::vector<char> message;
+    {
+        hpx::util::threshold_binary_filter filter(compress, &stats,
+            threshold, 90);
+
+        filter.set_max_length(data.size());
+        if (!data.empty())
+        {
+            // the data is saved in several pieces, as the archive would do
+            std::size_t half = data.size() / 2;
+            filter.save(data.data(), half);
+            filter.save(data.data() + half, data.size() - half);
+        }
+
+        // the data is written in one go, a too small buffer is rejected
+        std::size_t written = 0;
+        char c = 0;
+        if (!data.empty())
+        {
+            HPX_TEST(!filter.flush(&c, 1, written));
+            HPX_TEST_EQ(written, std::size_t(0));
+        }
+
+        message.resize(2 * data.size() + 64);
+        HPX_TEST(filter.flush(message.data(), message.size(), written));
+        message.resize(written);
+    }
+
+    HPX_TEST(!message.empty());
+
+    hpx::util::threshold_binary_filter filter(decompress, 0, threshold, 90);
+    std::size_t size = filter.init_data(message.data(), message.size(),
+        data.size());
+    HPX_TEST_EQ(size, data.size());
+
+    std::vector<char> result(data.size());
+    if (!result.empty())
+        filter.load(result.data(), result.size());
+    HPX_TEST(result == data);
+
+    return message[0];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_threshold(hpx::util::binary_filter* (*create)(bool))
+{
+    hpx::util::compression_statistics stats;
+    std::size_t const threshold = 1000;
+
+    // below the threshold the data is sent uncompressed
+    HPX_TEST_EQ(round_trip(make_repetitive_data(threshold - 1),
+        create(true), create(false), threshold, stats), 0);
+    HPX_TEST_EQ(round_trip(std::vector<char>(),
+        create(true), create(false), threshold, stats), 0);
+    HPX_TEST_EQ(stats.get_uncompressed_count(true), 2);
+    HPX_TEST_EQ(stats.get_compressed_count(true), 0);
+
+    // at and above the threshold the data is compressed
+    HPX_TEST_EQ(round_trip(make_repetitive_data(threshold),
+        create(true), create(false), threshold, stats), 1);
+    HPX_TEST_EQ(round_trip(make_repetitive_data(100000),
+        create(true), create(false), threshold, stats), 1);
+    HPX_TEST_EQ(stats.get_compressed_count(true), 2);
+    HPX_TEST_EQ(stats.get_uncompressed_count(true), 0);
+    HPX_TEST(stats.get_compression_ratio(true) > 100);
+
+    // data which does not compress well is sent as is
+    HPX_TEST_EQ(round_trip(make_random_data(100000),
+        create(true), create(false), threshold, stats), 0);
+    HPX_TEST_EQ(stats.get_uncompressed_count(true), 1);
+    HPX_TEST_EQ(stats.get_compressed_count(true), 0);
+}
+
+void test_pass_through()
+{
+    // without a wrapped filter the data is always sent uncompressed
+    hpx::util::compression_statistics stats;
+    HPX_TEST_EQ(round_trip(make_repetitive_data(100000), 0, 0, 1000, stats), 0);
+    HPX_TEST_EQ(round_trip(make_random_data(10), 0, 0, 1000, stats), 0);
+    HPX_TEST_EQ(stats.get_uncompressed_count(true), 2);
+    HPX_TEST_EQ(stats.get_compression_ratio(true), 100);
+
+    // corrupted data is detected
+    char const corrupted[] = { 2, 'a', 'b' };
+    hpx::util::threshold_binary_filter filter;
+    bool caught = false;
+    try {
+        filter.init_data(corrupted, sizeof(corrupted), 2);
+    }
+    catch (boost::archive::archive_exception const&) {
+        caught = true;
+    }
+    HPX_TEST(caught);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::util::binary_filter* create_rle_filter(bool)
+{
+    return new rle_filter;
+}
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+hpx::util::binary_filter* create_lz4_filter(bool compress)
+{
+    return hpx::create_binary_filter("lz4_serialization_filter", compress);
+}
+#endif
+
+int hpx_main()
+{
+    test_threshold(&create_rle_filter);
+    test_pass_through();
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+    test_threshold(&create_lz4_filter);
+#endif
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}